@@ -39,6 +39,19 @@
 namespace AbcClients {
 namespace WFObjConvert {
 
+//-*****************************************************************************
+void AbcReader::parsingBegin( const std::string &iStreamName )
+{
+    m_vertices.clear();
+    m_texVertices.clear();
+    m_normals.clear();
+    m_indices.clear();
+    m_texIndices.clear();
+    m_normIndices.clear();
+    m_counts.clear();
+    m_currentObjectName = m_defaultObjectName;
+}
+
 //-*****************************************************************************
 void AbcReader::parsingEnd( const std::string &iStreamName,
                             size_t iNumLines )
@@ -141,12 +154,8 @@ void AbcReader::makeCurrentObject()
     if ( m_vertices.size() > 3 &&
          m_indices.size() > 3 &&
          m_counts.size() > 1 &&
-         m_currentObjectName.length() &&
-         !m_parentObject.getChildHeader( m_currentObjectName ) )
+         m_currentObjectName.length() )
     {
-        OPolyMesh meshObj( m_parentObject, m_currentObjectName );
-        OPolyMeshSchema &mesh = meshObj.getSchema();
-
         OPolyMeshSchema::Sample psamp;
         psamp.setPositions( V3fArraySample( m_vertices ) );
         psamp.setFaceIndices( Int32ArraySample( m_indices ) );
@@ -206,7 +215,7 @@ void AbcReader::makeCurrentObject()
                                                      kFacevaryingScope ) );
         }
 
-        mesh.set( psamp );
+        writeSample( m_currentObjectName, psamp );
     }
 
     m_indices.clear();
@@ -214,6 +223,17 @@ void AbcReader::makeCurrentObject()
     m_currentObjectName = "";
 }
 
+//-*****************************************************************************
+void AbcReader::writeSample( const std::string &iObjectName,
+                             const OPolyMeshSchema::Sample &iSamp )
+{
+    if ( !m_parentObject.getChildHeader( iObjectName ) )
+    {
+        OPolyMesh meshObj( m_parentObject, iObjectName );
+        meshObj.getSchema().set( iSamp );
+    }
+}
+
 
 } // End namespace WFObjConvert
 } // End namespace AbcClients
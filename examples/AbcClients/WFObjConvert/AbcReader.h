@@ -56,6 +56,8 @@ public:
       , m_defaultObjectName( iDefaultObjectName )
       , m_currentObjectName( iDefaultObjectName ) {}
 
+    virtual void parsingBegin( const std::string &iStreamName );
+
     virtual void parsingEnd( const std::string &iStreamName,
                              size_t iNumLines );
 
@@ -77,6 +79,12 @@ public:
 
 protected:
     void makeCurrentObject();
+
+    //! Called by makeCurrentObject with the sample for the current object.
+    //! By default this creates a new, static OPolyMesh, unless the parent
+    //! already has a child of that name.
+    virtual void writeSample( const std::string &iObjectName,
+                              const OPolyMeshSchema::Sample &iSamp );
     
     OObject m_parentObject;
     std::string m_defaultObjectName;
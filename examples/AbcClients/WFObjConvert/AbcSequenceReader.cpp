@@ -0,0 +1,419 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <AbcClients/WFObjConvert/AbcSequenceReader.h>
+#include <AbcClients/WFObjConvert/FastParser.h>
+
+#include <Alembic/Util/Tasks.h>
+
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace AbcClients {
+namespace WFObjConvert {
+
+//-*****************************************************************************
+void AbcSequenceReader::parsingBegin( const std::string &iStreamName )
+{
+    AbcReader::parsingBegin( iStreamName );
+    ++m_numFrames;
+    m_frameError.clear();
+}
+
+//-*****************************************************************************
+void AbcSequenceReader::parsingEnd( const std::string &iStreamName,
+                                    size_t iNumLines )
+{
+    AbcReader::parsingEnd( iStreamName, iNumLines );
+
+    for ( MeshMap::iterator iter = m_meshes.begin();
+          iter != m_meshes.end() && m_frameError.empty(); ++iter )
+    {
+        if ( iter->second.mesh.getSchema().getNumSamples() < m_numFrames )
+        {
+            m_frameError = "object \"" + iter->first + "\" is missing";
+        }
+    }
+
+    if ( !m_frameError.empty() )
+    {
+        std::stringstream sstr;
+        sstr << "ERROR: OBJ sequence frame " << m_numFrames << " \""
+             << iStreamName << "\": " << m_frameError
+             << ", every object must be in every frame exactly once";
+        throw std::runtime_error( sstr.str() );
+    }
+}
+
+//-*****************************************************************************
+void AbcSequenceReader::writeSample( const std::string &iObjectName,
+                                     const OPolyMeshSchema::Sample &iSamp )
+{
+    // Errors are kept for parsingEnd, so that they end the sequence
+    // rather than being reported as a syntax error of the current line.
+    if ( !m_frameError.empty() )
+    {
+        return;
+    }
+
+    MeshMap::iterator iter = m_meshes.find( iObjectName );
+    if ( iter == m_meshes.end() )
+    {
+        if ( m_numFrames > 1 )
+        {
+            m_frameError = "object \"" + iObjectName +
+                "\" is not in the first frame";
+            return;
+        }
+
+        iter = m_meshes.insert(
+            MeshMap::value_type( iObjectName, MeshState() ) ).first;
+        iter->second.mesh = OPolyMesh( m_parentObject, iObjectName,
+                                       m_timeSampling );
+    }
+    else if ( iter->second.mesh.getSchema().getNumSamples() >= m_numFrames )
+    {
+        m_frameError = "object \"" + iObjectName + "\" is in it twice";
+        return;
+    }
+
+    MeshState &state = iter->second;
+    OPolyMeshSchema::Sample samp( iSamp );
+
+    const Int32ArraySample &indices = iSamp.getFaceIndices();
+    const Int32ArraySample &counts = iSamp.getFaceCounts();
+
+    bool sameTopology = state.mesh.getSchema().getNumSamples() > 0 &&
+        state.indices.size() == indices.size() &&
+        state.counts.size() == counts.size() &&
+        std::equal( state.counts.begin(), state.counts.end(),
+                    counts.get() ) &&
+        std::equal( state.indices.begin(), state.indices.end(),
+                    indices.get() );
+
+    if ( sameTopology )
+    {
+        samp.setFaceIndices( Int32ArraySample() );
+        samp.setFaceCounts( Int32ArraySample() );
+    }
+    else
+    {
+        state.indices.assign( indices.get(), indices.get() + indices.size() );
+        state.counts.assign( counts.get(), counts.get() + counts.size() );
+    }
+
+    state.mesh.getSchema().set( samp );
+}
+
+namespace {
+
+//-*****************************************************************************
+// The mesh samples of one OBJ file, kept in memory instead of written so
+// that several frames can be parsed at once and then written in order.
+class FrameReader : public AbcReader
+{
+public:
+    struct Mesh
+    {
+        std::string name;
+        std::vector<V3f> positions;
+        std::vector<Alembic::Util::int32_t> indices;
+        std::vector<Alembic::Util::int32_t> counts;
+        std::vector<V2f> uvs;
+        std::vector<N3f> normals;
+    };
+
+    FrameReader( OObject &iNoParent, const std::string &iDefaultObjectName )
+      : AbcReader( iNoParent, iDefaultObjectName )
+      , numLines( 0 )
+      , failed( false )
+      , errorLine( 0 ) {}
+
+    virtual void parsingError( const std::string &iStreamName,
+                               const std::string &iErrorDesc,
+                               size_t iErrorLine )
+    {
+        failed = true;
+        errorDesc = iErrorDesc;
+        errorLine = iErrorLine;
+    }
+
+    virtual void parsingEnd( const std::string &iStreamName,
+                             size_t iNumLines )
+    {
+        AbcReader::parsingEnd( iStreamName, iNumLines );
+        numLines = iNumLines;
+    }
+
+    std::vector<Mesh> meshes;
+    size_t numLines;
+    bool failed;
+    std::string errorDesc;
+    size_t errorLine;
+
+protected:
+    virtual void writeSample( const std::string &iObjectName,
+                              const OPolyMeshSchema::Sample &iSamp )
+    {
+        meshes.push_back( Mesh() );
+        Mesh &mesh = meshes.back();
+        mesh.name = iObjectName;
+
+        const P3fArraySample &pos = iSamp.getPositions();
+        mesh.positions.assign( pos.get(), pos.get() + pos.size() );
+        const Int32ArraySample &indices = iSamp.getFaceIndices();
+        mesh.indices.assign( indices.get(), indices.get() + indices.size() );
+        const Int32ArraySample &counts = iSamp.getFaceCounts();
+        mesh.counts.assign( counts.get(), counts.get() + counts.size() );
+
+        const V2fArraySample &uvs = iSamp.getUVs().getVals();
+        if ( uvs.size() > 0 )
+        {
+            mesh.uvs.assign( uvs.get(), uvs.get() + uvs.size() );
+        }
+        const N3fArraySample &normals = iSamp.getNormals().getVals();
+        if ( normals.size() > 0 )
+        {
+            mesh.normals.assign( normals.get(),
+                                 normals.get() + normals.size() );
+        }
+    }
+};
+
+//-*****************************************************************************
+struct FrameTask
+{
+    const std::string *fileName;
+    FrameReader *reader;
+};
+
+//-*****************************************************************************
+void ParseFrame( FrameTask &ioTask )
+{
+    try
+    {
+        ParseOBJFast( *ioTask.reader, *ioTask.fileName, 1 );
+    }
+    catch ( std::exception &exc )
+    {
+        ioTask.reader->parsingError( *ioTask.fileName, exc.what(), 0 );
+    }
+    catch ( ... )
+    {
+        ioTask.reader->parsingError( *ioTask.fileName,
+                                     "unknown exception", 0 );
+    }
+}
+
+//-*****************************************************************************
+class ParseFrameTasks : public Alembic::Util::Tasks
+{
+public:
+    ParseFrameTasks( std::vector<FrameTask> &ioTasks ) : m_tasks( ioTasks ) {}
+
+    virtual void run( size_t iIndex ) { ParseFrame( m_tasks[iIndex] ); }
+
+private:
+    std::vector<FrameTask> &m_tasks;
+};
+
+//-*****************************************************************************
+size_t DefaultNumThreads()
+{
+    return std::max( boost::thread::hardware_concurrency(), 1U );
+}
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+std::vector<std::string> MakeOBJSequenceFileNames( const std::string &iPattern,
+                                                   int iFirst, int iLast )
+{
+    // The pattern is a user argument, so it's substituted here rather than
+    // handed to printf as a format.
+    std::string prefix;
+    std::string suffix;
+    bool zeroPad = false;
+    int width = 0;
+    bool hasField = false;
+
+    for ( size_t i = 0; i < iPattern.size(); ++i )
+    {
+        std::string &text = hasField ? suffix : prefix;
+        if ( iPattern[i] != '%' )
+        {
+            text += iPattern[i];
+            continue;
+        }
+
+        size_t j = i + 1;
+        if ( j < iPattern.size() && iPattern[j] == '%' )
+        {
+            text += '%';
+            i = j;
+            continue;
+        }
+
+        bool pad = j < iPattern.size() && iPattern[j] == '0';
+        if ( pad ) { ++j; }
+        int w = 0;
+        while ( j < iPattern.size() && iPattern[j] >= '0' &&
+                iPattern[j] <= '9' && w < 100 )
+        {
+            w = w * 10 + ( iPattern[j] - '0' );
+            ++j;
+        }
+
+        if ( hasField || j >= iPattern.size() || iPattern[j] != 'd' )
+        {
+            std::stringstream sstr;
+            sstr << "ERROR: OBJ sequence pattern \"" << iPattern
+                 << "\" must contain exactly one frame number field"
+                 << " such as %d or %04d";
+            throw std::runtime_error( sstr.str() );
+        }
+
+        hasField = true;
+        zeroPad = pad;
+        width = w;
+        i = j;
+    }
+
+    if ( !hasField )
+    {
+        std::stringstream sstr;
+        sstr << "ERROR: OBJ sequence pattern \"" << iPattern
+             << "\" has no frame number field such as %d or %04d";
+        throw std::runtime_error( sstr.str() );
+    }
+
+    std::vector<std::string> names;
+    for ( int frame = iFirst; frame <= iLast; ++frame )
+    {
+        std::stringstream sstr;
+        sstr << prefix << std::setw( width )
+             << std::setfill( zeroPad ? '0' : ' ' )
+             << ( zeroPad ? std::internal : std::right ) << frame
+             << suffix;
+        names.push_back( sstr.str() );
+    }
+    return names;
+}
+
+//-*****************************************************************************
+size_t ParseOBJSequence( AbcSequenceReader &iReadInto,
+                         const std::vector<std::string> &iFileNames,
+                         size_t iNumThreads )
+{
+    if ( iNumThreads == 0 ) { iNumThreads = DefaultNumThreads(); }
+
+    if ( iNumThreads > 1 && iFileNames.size() > 1 )
+    {
+        OObject noParent;
+
+        // Parse a window of frames at once, then write them in order before
+        // parsing the next window.
+        for ( size_t first = 0; first < iFileNames.size();
+              first += iNumThreads )
+        {
+            size_t num = std::min( iNumThreads, iFileNames.size() - first );
+
+            std::vector<FrameReader> readers( num,
+                FrameReader( noParent, iReadInto.m_defaultObjectName ) );
+            std::vector<FrameTask> tasks( num );
+            for ( size_t i = 0; i < num; ++i )
+            {
+                tasks[i].fileName = &iFileNames[first + i];
+                tasks[i].reader = &readers[i];
+            }
+
+            ParseFrameTasks parseTasks( tasks );
+            Alembic::Util::runTasks( parseTasks, num, num );
+
+            for ( size_t i = 0; i < num; ++i )
+            {
+                const std::string &name = iFileNames[first + i];
+                FrameReader &frame = readers[i];
+                if ( frame.failed )
+                {
+                    iReadInto.parsingError( name, frame.errorDesc,
+                                            frame.errorLine );
+                    return first + i;
+                }
+
+                iReadInto.parsingBegin( name );
+                for ( size_t m = 0; m < frame.meshes.size(); ++m )
+                {
+                    const FrameReader::Mesh &mesh = frame.meshes[m];
+                    OPolyMeshSchema::Sample psamp;
+                    psamp.setPositions( V3fArraySample( mesh.positions ) );
+                    psamp.setFaceIndices( Int32ArraySample( mesh.indices ) );
+                    psamp.setFaceCounts( Int32ArraySample( mesh.counts ) );
+                    if ( !mesh.uvs.empty() )
+                    {
+                        psamp.setUVs( OV2fGeomParam::Sample(
+                            V2fArraySample( mesh.uvs ), kFacevaryingScope ) );
+                    }
+                    if ( !mesh.normals.empty() )
+                    {
+                        psamp.setNormals( ON3fGeomParam::Sample(
+                            N3fArraySample( mesh.normals ),
+                            kFacevaryingScope ) );
+                    }
+                    iReadInto.writeSample( mesh.name, psamp );
+                }
+                iReadInto.parsingEnd( name, frame.numLines );
+
+                std::vector<FrameReader::Mesh>().swap( frame.meshes );
+            }
+        }
+        return iFileNames.size();
+    }
+
+    for ( size_t i = 0; i < iFileNames.size(); ++i )
+    {
+        if ( !ParseOBJFast( iReadInto, iFileNames[i], iNumThreads ) )
+        {
+            return i;
+        }
+    }
+    return iFileNames.size();
+}
+
+} // End namespace WFObjConvert
+} // End namespace AbcClients
@@ -0,0 +1,115 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _AbcClients_WFObjConvert_AbcSequenceReader_h_
+#define _AbcClients_WFObjConvert_AbcSequenceReader_h_
+
+#include <AbcClients/WFObjConvert/Foundation.h>
+#include <AbcClients/WFObjConvert/AbcReader.h>
+
+namespace AbcClients {
+namespace WFObjConvert {
+
+//-*****************************************************************************
+//! An AbcReader for numbered OBJ frames. Every file parsed into it adds
+//! one sample to the meshes it contains, so a whole sequence ends up as
+//! animated OPolyMeshes instead of one static mesh per file.
+//! When a frame's face indices and counts match the previous frame of the
+//! same mesh, they are not written again and the previous topology is
+//! reused, which also spares the array hashing on write.
+//! Sample i of every mesh is frame i, so every object must be in every
+//! frame: parsingEnd throws a std::runtime_error naming the object and
+//! the file when one is missing, new, or in a file more than once.
+class AbcSequenceReader : public AbcReader
+{
+public:
+    AbcSequenceReader( OObject &iParentObject,
+                       AbcA::TimeSamplingPtr iTimeSampling,
+                       const std::string &iDefaultObjectName = "OBJ_polymesh" )
+      : AbcReader( iParentObject, iDefaultObjectName )
+      , m_timeSampling( iTimeSampling )
+      , m_numFrames( 0 ) {}
+
+    virtual void parsingBegin( const std::string &iStreamName );
+
+    virtual void parsingEnd( const std::string &iStreamName,
+                             size_t iNumLines );
+
+protected:
+    friend size_t ParseOBJSequence( AbcSequenceReader &iReadInto,
+                                    const std::vector<std::string> &iFileNames,
+                                    size_t iNumThreads );
+
+    virtual void writeSample( const std::string &iObjectName,
+                              const OPolyMeshSchema::Sample &iSamp );
+
+    struct MeshState
+    {
+        OPolyMesh mesh;
+        std::vector<Alembic::Util::int32_t> indices;
+        std::vector<Alembic::Util::int32_t> counts;
+    };
+
+    typedef std::map<std::string, MeshState> MeshMap;
+
+    AbcA::TimeSamplingPtr m_timeSampling;
+    MeshMap m_meshes;
+
+    size_t m_numFrames;
+    std::string m_frameError;
+};
+
+//-*****************************************************************************
+//! Expands a pattern such as "mesh.%04d.obj" over the frames iFirst to
+//! iLast inclusive. The pattern must contain exactly one "%d" field,
+//! optionally zero-padded and with a width as in "%04d", and "%%" stands
+//! for a literal '%'. Any other pattern throws a std::runtime_error.
+std::vector<std::string> MakeOBJSequenceFileNames( const std::string &iPattern,
+                                                   int iFirst, int iLast );
+
+//! Parses the files into iReadInto in order, stopping at the first file
+//! that fails to parse. Returns the number of files parsed successfully.
+//! Up to iNumThreads files (0 for one per available processor) are
+//! parsed concurrently, each into memory of its own, and then written
+//! in frame order, so memory holds at most iNumThreads frames at once.
+size_t ParseOBJSequence( AbcSequenceReader &iReadInto,
+                         const std::vector<std::string> &iFileNames,
+                         size_t iNumThreads = 0 );
+
+} // End namespace WFObjConvert
+} // End namespace AbcClients
+
+#endif
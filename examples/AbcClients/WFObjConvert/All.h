@@ -38,6 +38,8 @@
 #define _AbcClients_WFObjConvert_All_h_
 
 #include <AbcClients/WFObjConvert/AbcReader.h>
+#include <AbcClients/WFObjConvert/AbcSequenceReader.h>
+#include <AbcClients/WFObjConvert/FastParser.h>
 #include <AbcClients/WFObjConvert/Foundation.h>
 #include <AbcClients/WFObjConvert/Parser.h>
 #include <AbcClients/WFObjConvert/Reader.h>
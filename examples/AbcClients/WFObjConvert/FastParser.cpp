@@ -0,0 +1,859 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <AbcClients/WFObjConvert/FastParser.h>
+#include <AbcClients/WFObjConvert/ParseReader.h>
+
+#include <Alembic/Util/Tasks.h>
+
+#include <boost/thread/once.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <locale.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#endif
+
+namespace AbcClients {
+namespace WFObjConvert {
+
+namespace {
+
+//-*****************************************************************************
+#define FAIL( TEXT )                                    \
+do                                                      \
+{                                                       \
+    std::stringstream sstr;                             \
+    sstr << TEXT;                                       \
+    ::std::runtime_error exc( sstr.str() );             \
+    throw( exc );                                       \
+}                                                       \
+while( 0 )
+
+//-*****************************************************************************
+// Chunks smaller than this aren't worth handing to another thread.
+const size_t kMinChunkSize = 1 << 20;
+
+//-*****************************************************************************
+enum RecordType
+{
+    kVertex,
+    kTexVertex,
+    kNormal,
+    kParamVertex,
+    kFace,
+    kLine,
+    kPoint,
+    kGroup,
+    kObject,
+    kMtllib,
+    kMaplib,
+    kUsemtl,
+    kUsemap,
+    kTraceObj,
+    kShadowObj,
+    kBevel,
+    kCinterp,
+    kDinterp,
+    kSmoothBool,
+    kSmoothInt,
+    kLod
+};
+
+//-*****************************************************************************
+// strtod follows LC_NUMERIC, which a host application may have set to a
+// locale with a decimal comma, while OBJ numbers always use a '.'.
+#ifndef _WIN32
+boost::once_flag g_cLocaleOnce = BOOST_ONCE_INIT;
+locale_t g_cLocale = ( locale_t )0;
+
+void CreateCLocale()
+{
+    g_cLocale = newlocale( LC_NUMERIC_MASK, "C", ( locale_t )0 );
+}
+#endif
+
+double StrtodC( const char *iStr, char **oEnd )
+{
+#ifndef _WIN32
+    boost::call_once( g_cLocaleOnce, CreateCLocale );
+    if ( g_cLocale != ( locale_t )0 )
+    {
+        return strtod_l( iStr, oEnd, g_cLocale );
+    }
+    return strtod( iStr, oEnd );
+#else
+    static _locale_t cLocale = _create_locale( LC_NUMERIC, "C" );
+    return _strtod_l( iStr, oEnd, cLocale );
+#endif
+}
+
+//-*****************************************************************************
+// One parsed statement, or a run of statements of the same kind on
+// consecutive lines, so that the millions of "v" and "f" lines of a large
+// file don't each cost a Record.
+// For points, count is the number of lines in the run and ival the
+// number of values per line, starting at begin in the chunk's values.
+// Elements are the same with index triplets instead of values.
+// For the other types, [begin, begin+count) is a range in the chunk's
+// strings, and ival holds the integer or on/off argument.
+struct Record
+{
+    RecordType type;
+    const char *text;
+    size_t line;
+    size_t begin;
+    size_t count;
+    int ival;
+};
+
+//-*****************************************************************************
+// Everything a worker thread produces for one range of lines. Index
+// triplets are stored as three consecutive values, with 0 meaning
+// "not specified" since OBJ indices are never 0.
+struct Chunk
+{
+    Chunk()
+      : begin( NULL )
+      , end( NULL )
+      , numLines( 0 )
+      , failed( false )
+      , errorText( NULL )
+      , errorLine( 0 ) {}
+
+    const char *begin;
+    const char *end;
+    size_t numLines;
+
+    std::vector<Record> records;
+    std::vector<double> values;
+    std::vector<pindex_t> indices;
+    std::vector<std::string> strings;
+
+    bool failed;
+    std::string error;
+    const char *errorText;
+    size_t errorLine;
+
+    //! Frees the parsed data once it has been replayed.
+    void release()
+    {
+        std::vector<Record>().swap( records );
+        std::vector<double>().swap( values );
+        std::vector<pindex_t>().swap( indices );
+        std::vector<std::string>().swap( strings );
+    }
+};
+
+//-*****************************************************************************
+inline bool IsBlank( char c )
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+//-*****************************************************************************
+// Tokenizes a single line, which never includes its '\n'.
+class LineScanner
+{
+public:
+    LineScanner( const char *iBegin, const char *iEnd )
+      : m_cur( iBegin ), m_end( iEnd ) {}
+
+    bool atEnd()
+    {
+        skipBlanks();
+        return m_cur == m_end;
+    }
+
+    bool token( const char *&oBegin, const char *&oEnd )
+    {
+        skipBlanks();
+        oBegin = m_cur;
+        while ( m_cur != m_end && !IsBlank( *m_cur ) ) { ++m_cur; }
+        oEnd = m_cur;
+        return oBegin != oEnd;
+    }
+
+    //! The remainder of the line, without surrounding blanks.
+    std::string rest()
+    {
+        skipBlanks();
+        const char *end = m_end;
+        while ( end != m_cur && IsBlank( *( end - 1 ) ) ) { --end; }
+        std::string ret( m_cur, end );
+        m_cur = m_end;
+        return ret;
+    }
+
+    bool number( double &oVal )
+    {
+        const char *b, *e;
+        if ( !token( b, e ) ) { return false; }
+
+        // copy into a terminated buffer so strtod can't run off the end
+        // of a memory-mapped file
+        char buf[64];
+        size_t len = e - b;
+        if ( len >= sizeof( buf ) ) { return false; }
+        memcpy( buf, b, len );
+        buf[len] = '\0';
+
+        char *stop = NULL;
+        oVal = StrtodC( buf, &stop );
+        return stop == buf + len;
+    }
+
+    bool integer( const char *&ioCur, const char *iEnd, pindex_t &oVal )
+    {
+        bool neg = false;
+        if ( ioCur != iEnd && ( *ioCur == '-' || *ioCur == '+' ) )
+        {
+            neg = *ioCur == '-';
+            ++ioCur;
+        }
+
+        if ( ioCur == iEnd || *ioCur < '0' || *ioCur > '9' ) { return false; }
+
+        pindex_t val = 0;
+        while ( ioCur != iEnd && *ioCur >= '0' && *ioCur <= '9' )
+        {
+            val = val * 10 + ( *ioCur - '0' );
+            ++ioCur;
+        }
+        oVal = neg ? -val : val;
+        return true;
+    }
+
+    bool integer( int &oVal )
+    {
+        const char *b, *e;
+        pindex_t val = 0;
+        if ( !token( b, e ) || !integer( b, e, val ) || b != e )
+        {
+            return false;
+        }
+        oVal = ( int )val;
+        return true;
+    }
+
+    //! v, v/vt, v//vn or v/vt/vn
+    bool triplet( pindex_t oVal[3] )
+    {
+        const char *b, *e;
+        if ( !token( b, e ) ) { return false; }
+
+        oVal[0] = oVal[1] = oVal[2] = 0;
+        if ( !integer( b, e, oVal[0] ) || oVal[0] == 0 ) { return false; }
+
+        for ( int i = 1; i < 3 && b != e; ++i )
+        {
+            if ( *b != '/' ) { return false; }
+            ++b;
+            if ( b != e && *b != '/' )
+            {
+                if ( !integer( b, e, oVal[i] ) || oVal[i] == 0 )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return b == e;
+    }
+
+    bool onOff( bool &oVal )
+    {
+        const char *b, *e;
+        if ( !token( b, e ) ) { return false; }
+        std::string s( b, e );
+        if ( s == "on" || s == "On" || s == "ON" ||
+             s == "true" || s == "True" || s == "TRUE" )
+        {
+            oVal = true;
+            return true;
+        }
+        if ( s == "off" || s == "Off" || s == "OFF" ||
+             s == "false" || s == "False" || s == "FALSE" )
+        {
+            oVal = false;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    void skipBlanks()
+    {
+        while ( m_cur != m_end && IsBlank( *m_cur ) ) { ++m_cur; }
+    }
+
+    const char *m_cur;
+    const char *m_end;
+};
+
+//-*****************************************************************************
+inline bool KeywordIs( const char *iBegin, const char *iEnd, const char *iWord )
+{
+    size_t len = strlen( iWord );
+    return ( size_t )( iEnd - iBegin ) == len &&
+        strncmp( iBegin, iWord, len ) == 0;
+}
+
+//-*****************************************************************************
+// Appends a point or element record, extending the previous record
+// instead when it is a run of the same kind and size ending on the line
+// just before.
+void AddRunRecord( Chunk &ioChunk, Record &ioRec, size_t iSize )
+{
+    if ( !ioChunk.records.empty() )
+    {
+        Record &last = ioChunk.records.back();
+        if ( last.type == ioRec.type && last.ival == ( int )iSize &&
+             last.line + last.count == ioRec.line )
+        {
+            ++last.count;
+            return;
+        }
+    }
+
+    ioRec.count = 1;
+    ioRec.ival = ( int )iSize;
+    ioChunk.records.push_back( ioRec );
+}
+
+//-*****************************************************************************
+void ParseLine( Chunk &ioChunk, Record &ioRec,
+                const char *iBegin, const char *iEnd )
+{
+    LineScanner scan( iBegin, iEnd );
+
+    const char *kb, *ke;
+    if ( !scan.token( kb, ke ) || *kb == '#' )
+    {
+        return;
+    }
+
+    ioRec.begin = 0;
+    ioRec.count = 0;
+    ioRec.ival = 0;
+
+    // points
+    bool isPoint = true;
+    if ( KeywordIs( kb, ke, "v" ) ) { ioRec.type = kVertex; }
+    else if ( KeywordIs( kb, ke, "vt" ) ) { ioRec.type = kTexVertex; }
+    else if ( KeywordIs( kb, ke, "vn" ) ) { ioRec.type = kNormal; }
+    else if ( KeywordIs( kb, ke, "vp" ) ) { ioRec.type = kParamVertex; }
+    else { isPoint = false; }
+
+    if ( isPoint )
+    {
+        ioRec.begin = ioChunk.values.size();
+        double val;
+        while ( !scan.atEnd() )
+        {
+            if ( !scan.number( val ) ) { FAIL( "Syntax Error" ); }
+            ioChunk.values.push_back( val );
+        }
+        size_t numVals = ioChunk.values.size() - ioRec.begin;
+        if ( numVals == 0 ) { FAIL( "Syntax Error" ); }
+        AddRunRecord( ioChunk, ioRec, numVals );
+        return;
+    }
+
+    // elements
+    size_t minCount = 0;
+    if ( KeywordIs( kb, ke, "f" ) ) { ioRec.type = kFace; minCount = 3; }
+    else if ( KeywordIs( kb, ke, "l" ) ) { ioRec.type = kLine; minCount = 2; }
+    else if ( KeywordIs( kb, ke, "p" ) ) { ioRec.type = kPoint; minCount = 1; }
+
+    if ( minCount > 0 )
+    {
+        ioRec.begin = ioChunk.indices.size();
+        pindex_t trip[3];
+        while ( !scan.atEnd() )
+        {
+            if ( !scan.triplet( trip ) ) { FAIL( "Syntax Error" ); }
+            ioChunk.indices.push_back( trip[0] );
+            ioChunk.indices.push_back( trip[1] );
+            ioChunk.indices.push_back( trip[2] );
+        }
+        size_t numTrips = ( ioChunk.indices.size() - ioRec.begin ) / 3;
+        if ( numTrips < minCount ) { FAIL( "Syntax Error" ); }
+        AddRunRecord( ioChunk, ioRec, numTrips );
+        return;
+    }
+
+    // groups, which are a list of names
+    if ( KeywordIs( kb, ke, "g" ) )
+    {
+        ioRec.type = kGroup;
+        ioRec.begin = ioChunk.strings.size();
+        const char *b, *e;
+        while ( scan.token( b, e ) )
+        {
+            ioChunk.strings.push_back( std::string( b, e ) );
+        }
+        ioRec.count = ioChunk.strings.size() - ioRec.begin;
+        if ( ioRec.count == 0 ) { FAIL( "Syntax Error" ); }
+        ioChunk.records.push_back( ioRec );
+        return;
+    }
+
+    // statements taking the rest of the line as a single name
+    bool isName = true;
+    if ( KeywordIs( kb, ke, "o" ) ) { ioRec.type = kObject; }
+    else if ( KeywordIs( kb, ke, "mtllib" ) ) { ioRec.type = kMtllib; }
+    else if ( KeywordIs( kb, ke, "maplib" ) ) { ioRec.type = kMaplib; }
+    else if ( KeywordIs( kb, ke, "usemtl" ) ) { ioRec.type = kUsemtl; }
+    else if ( KeywordIs( kb, ke, "usemap" ) ) { ioRec.type = kUsemap; }
+    else if ( KeywordIs( kb, ke, "trace_obj" ) ) { ioRec.type = kTraceObj; }
+    else if ( KeywordIs( kb, ke, "shadow_obj" ) ) { ioRec.type = kShadowObj; }
+    else { isName = false; }
+
+    if ( isName )
+    {
+        std::string name = scan.rest();
+        if ( name.empty() ) { FAIL( "Syntax Error" ); }
+        ioRec.begin = ioChunk.strings.size();
+        ioRec.count = 1;
+        ioChunk.strings.push_back( name );
+        ioChunk.records.push_back( ioRec );
+        return;
+    }
+
+    // on/off and integer statements
+    bool b = false;
+    if ( KeywordIs( kb, ke, "bevel" ) || KeywordIs( kb, ke, "cinterp" ) ||
+         KeywordIs( kb, ke, "dinterp" ) )
+    {
+        ioRec.type = *kb == 'b' ? kBevel : ( *kb == 'c' ? kCinterp : kDinterp );
+        if ( !scan.onOff( b ) || !scan.atEnd() ) { FAIL( "Syntax Error" ); }
+        ioRec.ival = b;
+    }
+    else if ( KeywordIs( kb, ke, "s" ) )
+    {
+        LineScanner probe = scan;
+        if ( probe.onOff( b ) )
+        {
+            scan = probe;
+            ioRec.type = kSmoothBool;
+            ioRec.ival = b;
+        }
+        else
+        {
+            ioRec.type = kSmoothInt;
+            if ( !scan.integer( ioRec.ival ) ) { FAIL( "Syntax Error" ); }
+        }
+        if ( !scan.atEnd() ) { FAIL( "Syntax Error" ); }
+    }
+    else if ( KeywordIs( kb, ke, "lod" ) )
+    {
+        ioRec.type = kLod;
+        if ( !scan.integer( ioRec.ival ) || !scan.atEnd() )
+        {
+            FAIL( "Syntax Error" );
+        }
+    }
+    else
+    {
+        FAIL( "Syntax Error" );
+    }
+
+    ioChunk.records.push_back( ioRec );
+}
+
+//-*****************************************************************************
+// Parses every line of a chunk, stopping at the first error.
+void ParseChunk( Chunk &ioChunk )
+{
+    const char *cur = ioChunk.begin;
+    while ( cur != ioChunk.end )
+    {
+        const char *eol = ( const char * )memchr( cur, '\n',
+                                                  ioChunk.end - cur );
+        if ( !eol ) { eol = ioChunk.end; }
+
+        Record rec;
+        rec.text = cur;
+        rec.line = ioChunk.numLines++;
+
+        try
+        {
+            ParseLine( ioChunk, rec, cur, eol );
+        }
+        catch ( std::exception &exc )
+        {
+            ioChunk.failed = true;
+            ioChunk.error = exc.what();
+            ioChunk.errorText = cur;
+            ioChunk.errorLine = rec.line;
+            return;
+        }
+
+        cur = eol == ioChunk.end ? eol : eol + 1;
+    }
+}
+
+//-*****************************************************************************
+class ParseChunkTasks : public Alembic::Util::Tasks
+{
+public:
+    ParseChunkTasks( std::vector<Chunk> &ioChunks ) : m_chunks( ioChunks ) {}
+
+    virtual void run( size_t iIndex ) { ParseChunk( m_chunks[iIndex] ); }
+
+private:
+    std::vector<Chunk> &m_chunks;
+};
+
+//-*****************************************************************************
+size_t DefaultNumThreads()
+{
+    return std::max( boost::thread::hardware_concurrency(), 1U );
+}
+
+//-*****************************************************************************
+std::string LineText( const char *iText, const char *iEnd )
+{
+    const char *eol = ( const char * )memchr( iText, '\n', iEnd - iText );
+    if ( !eol ) { eol = iEnd; }
+    while ( eol != iText && *( eol - 1 ) == '\r' ) { --eol; }
+    return std::string( iText, eol );
+}
+
+//-*****************************************************************************
+// The start of the line iNum lines after iText.
+const char *SkipLines( const char *iText, const char *iEnd, size_t iNum )
+{
+    for ( ; iNum > 0 && iText != iEnd; --iNum )
+    {
+        const char *eol = ( const char * )memchr( iText, '\n', iEnd - iText );
+        iText = eol ? eol + 1 : iEnd;
+    }
+    return iText;
+}
+
+//-*****************************************************************************
+std::string ErrorMessage( const std::string &iName, size_t iLine,
+                          const std::string &iLineText,
+                          const std::string &iReason )
+{
+    std::stringstream sstr;
+    sstr << "ERROR: OBJ stream \"" << iName
+         << "\": " << std::endl
+         << "LINE: " << iLine << std::endl
+         << "---> " << iLineText << std::endl
+         << "REASON: " << iReason << std::endl;
+    return sstr.str();
+}
+
+//-*****************************************************************************
+// Resolves an index triplet against the number of points seen so far.
+// Negative indices are relative to the end, 0 stays "not specified" (-1
+// for ParseReader), and anything that resolves before the first point is
+// clamped to 0 so that ParseReader reports it as invalid.
+inline pindex_t ResolveIndex( pindex_t iIdx, size_t iNumSoFar )
+{
+    if ( iIdx == 0 ) { return -1; }
+    if ( iIdx > 0 ) { return iIdx; }
+    pindex_t ret = ( pindex_t )iNumSoFar + iIdx;
+    return ret < 1 ? 0 : ret;
+}
+
+//-*****************************************************************************
+// Feeds the records of one chunk to the ParseReader. The counts are the
+// next 1-based index of each kind of point, and are updated as points go
+// by. Returns false if an error was reported.
+bool ReplayChunk( const Chunk &iChunk, ParseReader &ioReader,
+                  const std::string &iName, const char *iDataEnd,
+                  size_t iFirstLine, size_t &ioNumV, size_t &ioNumVt,
+                  size_t &ioNumVn )
+{
+    std::vector<double> vals;
+    std::vector<ParseReader::V3idx> elems;
+    std::vector<std::string> names;
+
+    for ( std::vector<Record>::const_iterator iter = iChunk.records.begin();
+          iter != iChunk.records.end(); ++iter )
+    {
+        const Record &rec = *iter;
+
+        // the line of the run being replayed, for error reporting
+        size_t runLine = 0;
+
+        try
+        {
+            switch ( rec.type )
+            {
+            case kVertex:
+            case kTexVertex:
+            case kNormal:
+            case kParamVertex:
+                for ( ; runLine < rec.count; ++runLine )
+                {
+                    std::vector<double>::const_iterator first =
+                        iChunk.values.begin() + rec.begin +
+                        runLine * rec.ival;
+                    vals.assign( first, first + rec.ival );
+                    if ( rec.type == kVertex )
+                    {
+                        ioReader.v( vals );
+                        ++ioNumV;
+                    }
+                    else if ( rec.type == kTexVertex )
+                    {
+                        ioReader.vt( vals );
+                        ++ioNumVt;
+                    }
+                    else if ( rec.type == kNormal )
+                    {
+                        ioReader.vn( vals );
+                        ++ioNumVn;
+                    }
+                    else
+                    {
+                        ioReader.vp( vals );
+                    }
+                }
+                break;
+
+            case kFace:
+            case kLine:
+            case kPoint:
+                elems.resize( rec.ival );
+                for ( ; runLine < rec.count; ++runLine )
+                {
+                    const pindex_t *trip = &iChunk.indices[
+                        rec.begin + 3 * runLine * rec.ival];
+                    for ( int i = 0; i < rec.ival; ++i, trip += 3 )
+                    {
+                        elems[i] = ParseReader::V3idx(
+                            ResolveIndex( trip[0], ioNumV ),
+                            ResolveIndex( trip[1], ioNumVt ),
+                            ResolveIndex( trip[2], ioNumVn ) );
+                    }
+                    if ( rec.type == kFace ) { ioReader.f( elems ); }
+                    else if ( rec.type == kLine ) { ioReader.l( elems ); }
+                    else { ioReader.p( elems ); }
+                }
+                break;
+
+            case kGroup:
+                names.assign( iChunk.strings.begin() + rec.begin,
+                              iChunk.strings.begin() + rec.begin + rec.count );
+                ioReader.g( names );
+                break;
+
+            case kObject: ioReader.o( iChunk.strings[rec.begin] ); break;
+            case kMtllib: ioReader.mtllib( iChunk.strings[rec.begin] ); break;
+            case kMaplib: ioReader.maplib( iChunk.strings[rec.begin] ); break;
+            case kUsemtl: ioReader.usemtl( iChunk.strings[rec.begin] ); break;
+            case kUsemap: ioReader.usemap( iChunk.strings[rec.begin] ); break;
+            case kTraceObj:
+                ioReader.trace_obj( iChunk.strings[rec.begin] );
+                break;
+            case kShadowObj:
+                ioReader.shadow_obj( iChunk.strings[rec.begin] );
+                break;
+
+            case kBevel: ioReader.bevel( rec.ival != 0 ); break;
+            case kCinterp: ioReader.cinterp( rec.ival != 0 ); break;
+            case kDinterp: ioReader.dinterp( rec.ival != 0 ); break;
+            case kSmoothBool: ioReader.sB( rec.ival != 0 ); break;
+            case kSmoothInt: ioReader.s( rec.ival ); break;
+            case kLod: ioReader.lod( rec.ival ); break;
+            }
+        }
+        catch ( std::exception &exc )
+        {
+            size_t line = iFirstLine + rec.line + runLine;
+            const char *text = SkipLines( rec.text, iDataEnd, runLine );
+            ioReader.error( iName,
+                            ErrorMessage( iName, line,
+                                          LineText( text, iDataEnd ),
+                                          exc.what() ),
+                            line );
+            return false;
+        }
+    }
+
+    if ( iChunk.failed )
+    {
+        size_t line = iFirstLine + iChunk.errorLine;
+        ioReader.error( iName,
+                        ErrorMessage( iName, line,
+                                      LineText( iChunk.errorText, iDataEnd ),
+                                      iChunk.error ),
+                        line );
+        return false;
+    }
+
+    return true;
+}
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+bool ParseOBJFast( Reader &iReadInto,
+                   const std::string &iName,
+                   const char *iData,
+                   size_t iSize,
+                   size_t iNumThreads )
+{
+    if ( iNumThreads == 0 ) { iNumThreads = DefaultNumThreads(); }
+
+    const char *dataEnd = iData + iSize;
+
+    // Split at line boundaries into roughly equal chunks.
+    size_t chunkSize = std::max( iSize / iNumThreads, kMinChunkSize );
+    std::vector<Chunk> chunks;
+    const char *cur = iData;
+    while ( cur != dataEnd )
+    {
+        Chunk chunk;
+        chunk.begin = cur;
+        if ( ( size_t )( dataEnd - cur ) <= chunkSize )
+        {
+            chunk.end = dataEnd;
+        }
+        else
+        {
+            const char *eol = ( const char * )memchr(
+                cur + chunkSize, '\n', dataEnd - ( cur + chunkSize ) );
+            chunk.end = eol ? eol + 1 : dataEnd;
+        }
+        chunks.push_back( chunk );
+        cur = chunks.back().end;
+    }
+
+    // Tokenize, one chunk per thread. Errors are kept in the chunks and
+    // reported when they're replayed.
+    ParseChunkTasks tasks( chunks );
+    Alembic::Util::runTasks( tasks, chunks.size(), iNumThreads );
+
+    // Replay everything in file order.
+    ParseReader reader( iReadInto );
+    reader.start( iName );
+
+    size_t numV = 1;
+    size_t numVt = 1;
+    size_t numVn = 1;
+    size_t firstLine = 1;
+    for ( size_t i = 0; i < chunks.size(); ++i )
+    {
+        if ( !ReplayChunk( chunks[i], reader, iName, dataEnd, firstLine,
+                           numV, numVt, numVn ) )
+        {
+            return false;
+        }
+        firstLine += chunks[i].numLines;
+        chunks[i].release();
+    }
+
+    reader.finish( iName, firstLine );
+    return true;
+}
+
+//-*****************************************************************************
+bool ParseOBJFast( Reader &iReadInto,
+                   const std::string &iFileName,
+                   size_t iNumThreads )
+{
+#ifndef _WIN32
+    int fd = open( iFileName.c_str(), O_RDONLY );
+    struct stat st;
+    if ( fd >= 0 && fstat( fd, &st ) == 0 )
+    {
+        size_t size = ( size_t )st.st_size;
+        void *data = NULL;
+        if ( size > 0 )
+        {
+            data = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        }
+        close( fd );
+
+        if ( data != MAP_FAILED )
+        {
+            bool ret = false;
+            try
+            {
+                ret = ParseOBJFast( iReadInto, iFileName,
+                                    ( const char * )data, size, iNumThreads );
+            }
+            catch ( ... )
+            {
+                if ( data ) { munmap( data, size ); }
+                throw;
+            }
+            if ( data ) { munmap( data, size ); }
+            return ret;
+        }
+    }
+    else if ( fd >= 0 )
+    {
+        close( fd );
+    }
+#else
+    std::ifstream fStr( iFileName.c_str(), std::ios::binary );
+    if ( fStr )
+    {
+        std::vector<char> buf( ( std::istreambuf_iterator<char>( fStr ) ),
+                               std::istreambuf_iterator<char>() );
+        return ParseOBJFast( iReadInto, iFileName,
+                             buf.empty() ? NULL : &buf[0], buf.size(),
+                             iNumThreads );
+    }
+#endif
+
+    ParseReader reader( iReadInto );
+    reader.start( iFileName );
+    std::stringstream sstr;
+    sstr << "ERROR: OBJ stream \"" << iFileName
+         << "\": " << std::endl
+         << "Couldn't open file: " << iFileName << std::endl;
+    reader.error( iFileName, sstr.str(), 0 );
+    return false;
+}
+
+} // End namespace WFObjConvert
+} // End namespace AbcClients
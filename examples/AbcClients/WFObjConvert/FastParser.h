@@ -0,0 +1,71 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _AbcClients_WFObjConvert_FastParser_h_
+#define _AbcClients_WFObjConvert_FastParser_h_
+
+#include <AbcClients/WFObjConvert/Foundation.h>
+#include <AbcClients/WFObjConvert/Reader.h>
+
+namespace AbcClients {
+namespace WFObjConvert {
+
+//-*****************************************************************************
+//! A faster alternative to ParseOBJ for large files. The buffer is split
+//! into chunks at line boundaries, the chunks are tokenized concurrently
+//! on iNumThreads worker threads, and the results are then replayed into
+//! iReadInto in file order, so the Reader sees exactly the same sequence
+//! of calls as with a serial parse. Relative (negative) element indices
+//! are resolved during the replay, once the number of preceding vertices
+//! is known.
+//! An iNumThreads of 0 uses one thread per available processor.
+//! Returns false if an error was reported to iReadInto.
+bool ParseOBJFast( Reader &iReadInto,
+                   const std::string &iName,
+                   const char *iData,
+                   size_t iSize,
+                   size_t iNumThreads = 0 );
+
+//! Memory-maps iFileName (where the platform supports it) and parses it
+//! with the buffer version above.
+bool ParseOBJFast( Reader &iReadInto,
+                   const std::string &iFileName,
+                   size_t iNumThreads = 0 );
+
+} // End namespace WFObjConvert
+} // End namespace AbcClients
+
+#endif
@@ -0,0 +1,351 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <AbcClients/WFObjConvert/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+
+namespace OBJ = AbcClients::WFObjConvert;
+namespace Abc = Alembic::AbcGeom;
+
+//-*****************************************************************************
+//! Records every call into a string, so that two parses can be compared.
+class RecordingReader : public OBJ::Reader
+{
+public:
+    RecordingReader() : m_numErrors( 0 ), m_numLines( 0 ) {}
+
+    virtual void parsingError( const std::string &iStreamName,
+                               const std::string &iErrorDesc,
+                               size_t iErrorLine )
+    {
+        ++m_numErrors;
+        m_log << "error " << iErrorLine << " " << iErrorDesc << "\n";
+    }
+
+    virtual void parsingEnd( const std::string &iStreamName,
+                             size_t iNumLines )
+    { m_numLines = iNumLines; }
+
+    virtual void v( OBJ::index_t iIndex, const Abc::V3d &iVal )
+    { m_log << "v " << iIndex << " " << iVal << "\n"; }
+
+    virtual void vt( OBJ::index_t iIndex, const Abc::V2d &iVal )
+    { m_log << "vt " << iIndex << " " << iVal << "\n"; }
+
+    virtual void vn( OBJ::index_t iIndex, const Abc::V3d &iVal )
+    { m_log << "vn " << iIndex << " " << iVal << "\n"; }
+
+    virtual void f( const IndexVec &iVertexIndices,
+                    const IndexVec &iTextureIndices,
+                    const IndexVec &iNormalIndices )
+    {
+        m_log << "f";
+        record( iVertexIndices );
+        record( iTextureIndices );
+        record( iNormalIndices );
+        m_log << "\n";
+    }
+
+    virtual void activeGroups( const StringVec &iGroupNames )
+    {
+        m_log << "g";
+        for ( size_t i = 0; i < iGroupNames.size(); ++i )
+        {
+            m_log << " " << iGroupNames[i];
+        }
+        m_log << "\n";
+    }
+
+    virtual void activeObject( const std::string &iObjectName )
+    { m_log << "o " << iObjectName << "\n"; }
+
+    virtual void smoothingGroup( int iSmoothingGroup )
+    { m_log << "s " << iSmoothingGroup << "\n"; }
+
+    void record( const IndexVec &iIndices )
+    {
+        m_log << " |";
+        for ( size_t i = 0; i < iIndices.size(); ++i )
+        {
+            m_log << " " << iIndices[i];
+        }
+    }
+
+    std::ostringstream m_log;
+    size_t m_numErrors;
+    size_t m_numLines;
+};
+
+//-*****************************************************************************
+//! A grid of quads, big enough to be split into several chunks.
+std::string makeGridOBJ( int iRes, double iOffset )
+{
+    std::ostringstream obj;
+    obj << "# grid\no grid\ng grid\ns 1\n";
+
+    for ( int j = 0; j < iRes; ++j )
+    {
+        for ( int i = 0; i < iRes; ++i )
+        {
+            obj << "v " << i << " " << j << " " << iOffset << "\n";
+            obj << "vt " << i / ( double )iRes << " "
+                << j / ( double )iRes << "\n";
+            obj << "vn 0 0 1\n";
+        }
+    }
+
+    for ( int j = 0; j < iRes - 1; ++j )
+    {
+        for ( int i = 0; i < iRes - 1; ++i )
+        {
+            int a = j * iRes + i + 1;
+            int b = a + 1;
+            int c = b + iRes;
+            int d = a + iRes;
+            obj << "f " << a << "/" << a << "/" << a << " "
+                << b << "/" << b << "/" << b << " "
+                << c << "/" << c << "/" << c << " "
+                << d << "/" << d << "/" << d << "\n";
+        }
+    }
+
+    return obj.str();
+}
+
+//-*****************************************************************************
+void fastParserMatchesSerialTest()
+{
+    std::string obj = makeGridOBJ( 300, 0.0 );
+    TESTING_ASSERT( obj.size() > 4 * 1024 * 1024 );
+
+    RecordingReader serial;
+    std::istringstream stream( obj );
+    OBJ::ParseOBJ( serial, "grid", stream );
+
+    for ( size_t numThreads = 1; numThreads <= 4; ++numThreads )
+    {
+        RecordingReader fast;
+        TESTING_ASSERT( OBJ::ParseOBJFast( fast, "grid", obj.data(),
+                                           obj.size(), numThreads ) );
+        TESTING_ASSERT( fast.m_numErrors == 0 );
+        TESTING_ASSERT( fast.m_numLines == serial.m_numLines );
+        TESTING_ASSERT( fast.m_log.str() == serial.m_log.str() );
+    }
+}
+
+//-*****************************************************************************
+void fastParserRelativeIndicesTest()
+{
+    std::string absolute = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\n"
+        "v 0 1 0\nf 3 4 1\n";
+    std::string relative = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf -3 -2 -1\n"
+        "v 0 1 0\nf -2 -1 -4\n";
+
+    RecordingReader a;
+    RecordingReader b;
+    TESTING_ASSERT( OBJ::ParseOBJFast( a, "abs", absolute.data(),
+                                       absolute.size() ) );
+    TESTING_ASSERT( OBJ::ParseOBJFast( b, "rel", relative.data(),
+                                       relative.size() ) );
+    TESTING_ASSERT( a.m_log.str() == b.m_log.str() );
+
+    std::string bad = "v 0 0 0\nf 1 2 x\n";
+    RecordingReader c;
+    TESTING_ASSERT( !OBJ::ParseOBJFast( c, "bad", bad.data(), bad.size() ) );
+    TESTING_ASSERT( c.m_numErrors == 1 );
+
+    // an error in the middle of a run of faces reports the right line
+    std::string badIndex = "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+        "f 1 2 3\nf 1 2 3\nf 1 2 9\nf 1 2 3\n";
+    RecordingReader d;
+    std::istringstream stream( badIndex );
+    OBJ::ParseOBJ( d, "badIndex", stream );
+    RecordingReader e;
+    TESTING_ASSERT( !OBJ::ParseOBJFast( e, "badIndex", badIndex.data(),
+                                        badIndex.size() ) );
+    TESTING_ASSERT( e.m_numErrors == 1 );
+    TESTING_ASSERT( d.m_log.str() == e.m_log.str() );
+}
+
+//-*****************************************************************************
+void sequencePatternTest()
+{
+    std::vector<std::string> files =
+        OBJ::MakeOBJSequenceFileNames( "a%%_%3d.obj", 9, 10 );
+    TESTING_ASSERT( files.size() == 2 );
+    TESTING_ASSERT( files[0] == "a%_  9.obj" );
+    TESTING_ASSERT( files[1] == "a%_ 10.obj" );
+
+    files = OBJ::MakeOBJSequenceFileNames( "f%03d", -1, -1 );
+    TESTING_ASSERT( files[0] == "f-01" );
+
+    const char *badPatterns[] = { "f.obj", "f%s.obj", "f%d%d.obj",
+                                  "f%n.obj", "f%", "f%-4d.obj" };
+    for ( size_t i = 0; i < sizeof( badPatterns ) / sizeof( char * ); ++i )
+    {
+        bool threw = false;
+        try
+        {
+            OBJ::MakeOBJSequenceFileNames( badPatterns[i], 1, 2 );
+        }
+        catch ( std::runtime_error & )
+        {
+            threw = true;
+        }
+        TESTING_ASSERT( threw );
+    }
+}
+
+//-*****************************************************************************
+void sequenceTest( size_t iNumThreads )
+{
+    std::string pattern = "fastParserTest.%04d.obj";
+    std::vector<std::string> files =
+        OBJ::MakeOBJSequenceFileNames( pattern, 1, 3 );
+    TESTING_ASSERT( files.size() == 3 );
+    TESTING_ASSERT( files[0] == "fastParserTest.0001.obj" );
+
+    for ( size_t i = 0; i < files.size(); ++i )
+    {
+        std::string obj = makeGridOBJ( 4, ( double )i );
+        FILE *f = fopen( files[i].c_str(), "wb" );
+        TESTING_ASSERT( f != NULL );
+        fwrite( obj.data(), 1, obj.size(), f );
+        fclose( f );
+    }
+
+    std::string archiveName = "fastParserTest.abc";
+    {
+        Abc::OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
+                               archiveName );
+        Abc::TimeSamplingPtr ts( new Abc::TimeSampling( 1.0 / 24.0, 0.0 ) );
+        archive.addTimeSampling( *ts );
+
+        Abc::OObject top( archive, Abc::kTop );
+        OBJ::AbcSequenceReader reader( top, ts );
+        TESTING_ASSERT( OBJ::ParseOBJSequence( reader, files,
+                                               iNumThreads ) == 3 );
+    }
+
+    for ( size_t i = 0; i < files.size(); ++i )
+    {
+        remove( files[i].c_str() );
+    }
+
+    Abc::IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(),
+                           archiveName );
+    Abc::IObject top = archive.getTop();
+    TESTING_ASSERT( top.getNumChildren() == 1 );
+
+    Abc::IPolyMesh mesh( top, top.getChildHeader( 0 ).getName() );
+    Abc::IPolyMeshSchema &schema = mesh.getSchema();
+    TESTING_ASSERT( schema.getNumSamples() == 3 );
+    TESTING_ASSERT( schema.getFaceIndicesProperty().isConstant() );
+    TESTING_ASSERT( schema.getFaceCountsProperty().isConstant() );
+    TESTING_ASSERT( !schema.getPositionsProperty().isConstant() );
+
+    Abc::IPolyMeshSchema::Sample samp;
+    schema.get( samp, Abc::ISampleSelector( ( Abc::index_t )2 ) );
+    TESTING_ASSERT( samp.getPositions()->size() == 16 );
+    TESTING_ASSERT( samp.getFaceCounts()->size() == 9 );
+    TESTING_ASSERT( ( *samp.getPositions() )[0].z == 2.0f );
+}
+
+//-*****************************************************************************
+void sequenceMissingObjectTest( size_t iNumThreads )
+{
+    std::string pattern = "fastParserMissing.%d.obj";
+    std::vector<std::string> files =
+        OBJ::MakeOBJSequenceFileNames( pattern, 1, 3 );
+
+    for ( size_t i = 0; i < files.size(); ++i )
+    {
+        std::string obj = makeGridOBJ( 4, ( double )i );
+        if ( i == 1 )
+        {
+            // the second frame names its object differently
+            obj.replace( obj.find( "o grid" ), 6, "o other" );
+        }
+        FILE *f = fopen( files[i].c_str(), "wb" );
+        TESTING_ASSERT( f != NULL );
+        fwrite( obj.data(), 1, obj.size(), f );
+        fclose( f );
+    }
+
+    std::string archiveName = "fastParserMissing.abc";
+    bool threw = false;
+    try
+    {
+        Abc::OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
+                               archiveName );
+        Abc::TimeSamplingPtr ts( new Abc::TimeSampling( 1.0 / 24.0, 0.0 ) );
+        archive.addTimeSampling( *ts );
+
+        Abc::OObject top( archive, Abc::kTop );
+        OBJ::AbcSequenceReader reader( top, ts );
+        OBJ::ParseOBJSequence( reader, files, iNumThreads );
+    }
+    catch ( std::runtime_error &exc )
+    {
+        threw = std::string( exc.what() ).find( "\"other\"" ) !=
+            std::string::npos;
+    }
+    TESTING_ASSERT( threw );
+
+    for ( size_t i = 0; i < files.size(); ++i )
+    {
+        remove( files[i].c_str() );
+    }
+    remove( archiveName.c_str() );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    fastParserMatchesSerialTest();
+    fastParserRelativeIndicesTest();
+    sequencePatternTest();
+    sequenceTest( 1 );
+    sequenceTest( 2 );
+    sequenceMissingObjectTest( 1 );
+    sequenceMissingObjectTest( 3 );
+    return 0;
+}
@@ -72,25 +72,78 @@ public:
     }
 };
 
+//-*****************************************************************************
+void usage( const char *iProgName )
+{
+    std::cerr << "USAGE: " << iProgName << " [-j numThreads] <objFile> <abcFile>"
+              << std::endl
+              << "       " << iProgName << " [-j numThreads] -seq <pattern> "
+              << "<firstFrame> <lastFrame> <fps> <abcFile>" << std::endl
+              << "  <pattern> has one frame field, e.g. mesh.%04d.obj"
+              << std::endl;
+}
+
 //-*****************************************************************************
 int main( int argc, char *argv[] )
 {
-    if ( argc != 3 )
+    std::vector<std::string> args( argv + 1, argv + argc );
+
+    size_t numThreads = 0;
+    if ( args.size() >= 2 && args[0] == "-j" )
+    {
+        numThreads = ( size_t )atoi( args[1].c_str() );
+        args.erase( args.begin(), args.begin() + 2 );
+    }
+
+    bool sequence = !args.empty() && args[0] == "-seq";
+    if ( ( sequence && args.size() != 6 ) || ( !sequence && args.size() != 2 ) )
     {
-        std::cerr << "USAGE: " << argv[0] << " <objFile> <abcFile>"
-                  << std::endl;
+        usage( argv[0] );
         return -1;
     }
 
     try
     {
         Abc::OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
-                               argv[2] );
+                               args.back() );
         Abc::OObject topObj( archive, Abc::kTop );
 
-        MyReader reader( topObj );
-        
-        OBJ::ParseOBJ( reader, argv[1] );
+        if ( sequence )
+        {
+            int first = atoi( args[2].c_str() );
+            int last = atoi( args[3].c_str() );
+            double fps = atof( args[4].c_str() );
+            if ( fps <= 0.0 || last < first )
+            {
+                usage( argv[0] );
+                return -1;
+            }
+
+            Abc::TimeSamplingPtr ts( new Abc::TimeSampling( 1.0 / fps,
+                                                            first / fps ) );
+            archive.addTimeSampling( *ts );
+
+            OBJ::AbcSequenceReader reader( topObj, ts );
+            std::vector<std::string> files =
+                OBJ::MakeOBJSequenceFileNames( args[1], first, last );
+
+            size_t numParsed = OBJ::ParseOBJSequence( reader, files,
+                                                      numThreads );
+            if ( numParsed != files.size() )
+            {
+                std::cerr << "Failed to parse " << files[numParsed]
+                          << std::endl;
+                exit( -1 );
+            }
+
+            std::cout << "Converted " << numParsed << " frames." << std::endl;
+        }
+        else
+        {
+            MyReader reader( topObj );
+
+            OBJ::ParseOBJFast( reader, args[0], numThreads );
+        }
     }
     catch ( std::exception &exc )
     {
@@ -0,0 +1,712 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/Tasks.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+namespace Abc  = ::Alembic::AbcGeom;
+namespace AbcA = ::Alembic::AbcCoreAbstract;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+
+typedef Alembic::Util::uint64_t uint64_t;
+
+//-*****************************************************************************
+void usage( const char *iProgName )
+{
+    std::cerr << "USAGE: " << iProgName << " [options] [inFile]" << std::endl
+              << std::endl
+              << "Times writing and reading an Alembic archive.  Without "
+              << "inFile a synthetic" << std::endl
+              << "Ogawa archive is written first, to -out, and read back."
+              << std::endl << std::endl
+              << "  -objects N   meshes to write (default 200)" << std::endl
+              << "  -depth N     levels of transforms above them (default 2)"
+              << std::endl
+              << "  -width N     children of each transform (default 4)"
+              << std::endl
+              << "  -points N    points per mesh (default 1000)" << std::endl
+              << "  -samples N   samples of every mesh (default 24)"
+              << std::endl
+              << "  -strings N   string properties and metadata entries per "
+              << "mesh (default 2)" << std::endl
+              << "  -dedup R     fraction of meshes which all share the same "
+              << "points (default 0.25)" << std::endl
+              << "  -threads L   comma separated reader thread counts "
+              << "(default 1,2,4)" << std::endl
+              << "  -out FILE    the synthetic archive (default abcbench.abc)"
+              << std::endl
+              << "  -keep        don't remove the synthetic archive"
+              << std::endl
+              << "  -json FILE   also write the results to FILE as JSON"
+              << std::endl
+              << "  -label STR   tags the JSON results, a commit id say"
+              << std::endl;
+}
+
+//-*****************************************************************************
+struct Config
+{
+    Config()
+      : numObjects( 200 )
+      , depth( 2 )
+      , width( 4 )
+      , numPoints( 1000 )
+      , numSamples( 24 )
+      , numStrings( 2 )
+      , dedup( 0.25 )
+    {
+        threads.push_back( 1 );
+        threads.push_back( 2 );
+        threads.push_back( 4 );
+    }
+
+    std::size_t numObjects;
+    std::size_t depth;
+    std::size_t width;
+    std::size_t numPoints;
+    std::size_t numSamples;
+    std::size_t numStrings;
+    double dedup;
+    std::vector<std::size_t> threads;
+};
+
+//-*****************************************************************************
+struct Result
+{
+    Result( const std::string &iName, double iValue, const std::string &iUnit )
+      : name( iName ), value( iValue ), unit( iUnit ) {}
+
+    std::string name;
+    double value;
+    std::string unit;
+};
+
+typedef std::vector<Result> ResultVec;
+
+//-*****************************************************************************
+double now()
+{
+    timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//-*****************************************************************************
+uint64_t fileSize( const std::string &iName )
+{
+    struct stat s;
+    if ( stat( iName.c_str(), &s ) != 0 )
+    {
+        return 0;
+    }
+    return s.st_size;
+}
+
+//-*****************************************************************************
+// A tree of transforms iDepth deep and iWidth wide, the meshes go under the
+// transforms at the bottom.
+void makeTransforms( Abc::OObject iParent, std::size_t iDepth,
+                     std::size_t iWidth, std::vector<Abc::OObject> &oLeaves )
+{
+    if ( iDepth == 0 )
+    {
+        oLeaves.push_back( iParent );
+        return;
+    }
+
+    for ( std::size_t i = 0; i < iWidth; ++i )
+    {
+        std::ostringstream name;
+        name << "xform" << i;
+        Abc::OXform xform( iParent, name.str() );
+
+        Abc::XformSample samp;
+        samp.setTranslation( Imath::V3d( i, iDepth, 0.0 ) );
+        xform.getSchema().set( samp );
+
+        makeTransforms( xform, iDepth - 1, iWidth, oLeaves );
+    }
+}
+
+//-*****************************************************************************
+// The shared meshes all write exactly the same points every sample, so Ogawa
+// only stores them once.  The rest move a little every sample.
+void writeSynthetic( const std::string &iName, const Config &iConfig )
+{
+    Abc::OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+    Abc::TimeSampling ts( 1.0 / 24.0, 0.0 );
+    Alembic::Util::uint32_t tsIndex = archive.addTimeSampling( ts );
+
+    std::vector<Abc::OObject> leaves;
+    makeTransforms( archive.getTop(), iConfig.depth,
+                    std::max( iConfig.width, ( std::size_t ) 1 ), leaves );
+
+    std::vector<Abc::OPolyMesh> meshes;
+    std::vector<bool> shared;
+    std::vector< std::vector<Abc::OStringProperty> > strings;
+    for ( std::size_t i = 0; i < iConfig.numObjects; ++i )
+    {
+        Abc::MetaData md;
+        for ( std::size_t k = 0; k < iConfig.numStrings; ++k )
+        {
+            std::ostringstream key, value;
+            key << "bench" << k;
+            value << "metadata value " << k << " of mesh " << i;
+            md.set( key.str(), value.str() );
+        }
+
+        std::ostringstream name;
+        name << "mesh" << i;
+        meshes.push_back( Abc::OPolyMesh( leaves[i % leaves.size()],
+                                          name.str(), tsIndex, md ) );
+
+        // spread the shared ones out evenly
+        shared.push_back( std::floor( ( i + 1 ) * iConfig.dedup ) >
+                          std::floor( i * iConfig.dedup ) );
+
+        Abc::OCompoundProperty user =
+            meshes.back().getSchema().getUserProperties();
+        strings.push_back( std::vector<Abc::OStringProperty>() );
+        for ( std::size_t k = 0; k < iConfig.numStrings; ++k )
+        {
+            std::ostringstream propName;
+            propName << "label" << k;
+            strings.back().push_back(
+                Abc::OStringProperty( user, propName.str(), tsIndex ) );
+        }
+    }
+
+    std::size_t numPoints = std::max( iConfig.numPoints,
+                                      ( std::size_t ) 3 );
+    std::vector<Imath::V3f> base( numPoints );
+    for ( std::size_t p = 0; p < numPoints; ++p )
+    {
+        base[p] = Imath::V3f( p % 100, p / 100, ( p * 7 ) % 13 );
+    }
+
+    std::vector<Alembic::Util::int32_t> indices( numPoints - numPoints % 3 );
+    for ( std::size_t p = 0; p < indices.size(); ++p )
+    {
+        indices[p] = p;
+    }
+    std::vector<Alembic::Util::int32_t> counts( indices.size() / 3, 3 );
+
+    std::vector<Imath::V3f> points( numPoints );
+    for ( std::size_t s = 0; s < iConfig.numSamples; ++s )
+    {
+        for ( std::size_t i = 0; i < meshes.size(); ++i )
+        {
+            const std::vector<Imath::V3f> *p = &base;
+            if ( !shared[i] )
+            {
+                Imath::V3f offset( s * 0.01f, i, 0.0f );
+                for ( std::size_t j = 0; j < numPoints; ++j )
+                {
+                    points[j] = base[j] + offset;
+                }
+                p = &points;
+            }
+
+            Abc::P3fArraySample pos( *p );
+            if ( s == 0 )
+            {
+                meshes[i].getSchema().set( Abc::OPolyMeshSchema::Sample( pos,
+                    Abc::Int32ArraySample( indices ),
+                    Abc::Int32ArraySample( counts ) ) );
+            }
+            else
+            {
+                meshes[i].getSchema().set(
+                    Abc::OPolyMeshSchema::Sample( pos ) );
+            }
+
+            for ( std::size_t k = 0; k < strings[i].size(); ++k )
+            {
+                std::ostringstream value;
+                value << "string " << k << " of mesh " << i
+                      << " at sample " << s;
+                strings[i][k].set( value.str() );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+// Every scalar and array property, with how many objects there are
+void gatherProperties( AbcA::CompoundPropertyReaderPtr iProps,
+                       std::vector<AbcA::BasePropertyReaderPtr> &oProps )
+{
+    for ( std::size_t i = 0; i < iProps->getNumProperties(); ++i )
+    {
+        AbcA::BasePropertyReaderPtr prop = iProps->getProperty( i );
+        if ( prop->isCompound() )
+        {
+            gatherProperties( prop->asCompoundPtr(), oProps );
+        }
+        else
+        {
+            oProps.push_back( prop );
+        }
+    }
+}
+
+//-*****************************************************************************
+std::size_t gatherObjects( AbcA::ObjectReaderPtr iObj,
+                           std::vector<AbcA::BasePropertyReaderPtr> &oProps )
+{
+    gatherProperties( iObj->getProperties(), oProps );
+
+    std::size_t numObjects = 1;
+    for ( std::size_t i = 0; i < iObj->getNumChildren(); ++i )
+    {
+        numObjects += gatherObjects( iObj->getChild( i ), oProps );
+    }
+    return numObjects;
+}
+
+//-*****************************************************************************
+// Reads sample iIndex of a scalar or array property, returns its size
+uint64_t readSample( AbcA::BasePropertyReaderPtr iProp,
+                     AbcA::index_t iIndex )
+{
+    const AbcA::DataType &dataType = iProp->getDataType();
+    if ( iProp->isArray() )
+    {
+        AbcA::ArraySamplePtr samp;
+        iProp->asArrayPtr()->getSample( iIndex, samp );
+        return samp->getDimensions().numPoints() * dataType.getNumBytes();
+    }
+
+    AbcA::ScalarPropertyReaderPtr scalar = iProp->asScalarPtr();
+    if ( dataType.getPod() == Alembic::Util::kStringPOD )
+    {
+        std::vector<std::string> strs( dataType.getExtent() );
+        scalar->getSample( iIndex, &strs.front() );
+        return strs[0].size();
+    }
+    else if ( dataType.getPod() == Alembic::Util::kWstringPOD )
+    {
+        std::vector<std::wstring> strs( dataType.getExtent() );
+        scalar->getSample( iIndex, &strs.front() );
+        return strs[0].size() * sizeof( wchar_t );
+    }
+
+    std::vector<char> buf( dataType.getNumBytes() );
+    scalar->getSample( iIndex, &buf.front() );
+    return buf.size();
+}
+
+//-*****************************************************************************
+std::size_t getNumSamples( AbcA::BasePropertyReaderPtr iProp )
+{
+    if ( iProp->isArray() )
+    {
+        return iProp->asArrayPtr()->getNumSamples();
+    }
+    return iProp->asScalarPtr()->getNumSamples();
+}
+
+//-*****************************************************************************
+// Task t reads every numTasks'th property starting at t, all of its samples
+class ReadTasks : public Alembic::Util::Tasks
+{
+public:
+    ReadTasks( const std::vector<AbcA::BasePropertyReaderPtr> &iProps,
+               std::size_t iNumTasks )
+      : props( iProps )
+      , numBytes( iNumTasks, 0 )
+      , numSamples( iNumTasks, 0 )
+    {}
+
+    virtual void run( std::size_t iIndex )
+    {
+        for ( std::size_t i = iIndex; i < props.size();
+              i += numBytes.size() )
+        {
+            std::size_t n = getNumSamples( props[i] );
+            for ( std::size_t s = 0; s < n; ++s )
+            {
+                numBytes[iIndex] += readSample( props[i], s );
+                ++numSamples[iIndex];
+            }
+        }
+    }
+
+    const std::vector<AbcA::BasePropertyReaderPtr> &props;
+    std::vector<uint64_t> numBytes;
+    std::vector<uint64_t> numSamples;
+};
+
+//-*****************************************************************************
+void benchOpen( const std::string &iName, ResultVec &oResults )
+{
+    const std::size_t numOpens = 10;
+    AbcF::IFactory factory;
+
+    double start = now();
+    for ( std::size_t i = 0; i < numOpens; ++i )
+    {
+        Abc::IArchive archive = factory.getArchive( iName );
+        if ( !archive.valid() )
+        {
+            throw std::runtime_error( "Could not open " + iName );
+        }
+    }
+    oResults.push_back( Result( "open",
+        ( now() - start ) / numOpens * 1000.0, "ms" ) );
+}
+
+//-*****************************************************************************
+void benchTraverse( const std::string &iName, ResultVec &oResults )
+{
+    AbcF::IFactory factory;
+    Abc::IArchive archive = factory.getArchive( iName );
+
+    std::vector<AbcA::BasePropertyReaderPtr> props;
+    double start = now();
+    std::size_t numObjects = gatherObjects( archive.getTop().getPtr(), props );
+    double elapsed = now() - start;
+
+    oResults.push_back( Result( "traverse", elapsed * 1000.0, "ms" ) );
+    oResults.push_back( Result( "traverse_objects", numObjects, "objects" ) );
+    oResults.push_back( Result( "traverse_properties", props.size(),
+                                "properties" ) );
+}
+
+//-*****************************************************************************
+// All the samples of every property, split between iNumThreads threads
+// which share one archive.
+void benchRead( const std::string &iName, std::size_t iNumThreads,
+                ResultVec &oResults )
+{
+    AbcF::IFactory factory;
+    factory.setOgawaNumStreams( iNumThreads );
+    Abc::IArchive archive = factory.getArchive( iName );
+
+    std::vector<AbcA::BasePropertyReaderPtr> props;
+    gatherObjects( archive.getTop().getPtr(), props );
+
+    ReadTasks tasks( props, iNumThreads );
+
+    double start = now();
+    Alembic::Util::runTasks( tasks, iNumThreads, iNumThreads );
+    double elapsed = now() - start;
+
+    uint64_t numBytes = 0;
+    uint64_t numSamples = 0;
+    for ( std::size_t i = 0; i < iNumThreads; ++i )
+    {
+        numBytes += tasks.numBytes[i];
+        numSamples += tasks.numSamples[i];
+    }
+
+    std::ostringstream name;
+    name << "read_t" << iNumThreads;
+    oResults.push_back( Result( name.str() + "_samples",
+                                numSamples / elapsed, "samples/s" ) );
+    oResults.push_back( Result( name.str() + "_bytes",
+                                numBytes / elapsed / 1048576.0, "MB/s" ) );
+}
+
+//-*****************************************************************************
+// Hashing the array samples the way writers do to find duplicates, and
+// converting the float ones to double.  Only that part is timed.
+void benchArrays( const std::string &iName, ResultVec &oResults )
+{
+    AbcF::IFactory factory;
+    Abc::IArchive archive = factory.getArchive( iName );
+
+    std::vector<AbcA::BasePropertyReaderPtr> props;
+    gatherObjects( archive.getTop().getPtr(), props );
+
+    double hashTime = 0.0;
+    uint64_t hashBytes = 0;
+    double convertTime = 0.0;
+    uint64_t convertBytes = 0;
+    std::vector<double> converted;
+
+    for ( std::size_t i = 0; i < props.size(); ++i )
+    {
+        if ( !props[i]->isArray() )
+        {
+            continue;
+        }
+
+        AbcA::ArrayPropertyReaderPtr prop = props[i]->asArrayPtr();
+        const AbcA::DataType &dataType = prop->getDataType();
+        for ( std::size_t s = 0; s < prop->getNumSamples(); ++s )
+        {
+            AbcA::ArraySamplePtr samp;
+            prop->getSample( s, samp );
+            uint64_t numBytes =
+                samp->getDimensions().numPoints() * dataType.getNumBytes();
+
+            double start = now();
+            samp->getKey();
+            hashTime += now() - start;
+            hashBytes += numBytes;
+
+            if ( dataType.getPod() != Alembic::Util::kFloat32POD ||
+                 numBytes == 0 )
+            {
+                continue;
+            }
+
+            converted.resize( samp->getDimensions().numPoints() *
+                              dataType.getExtent() );
+            start = now();
+            prop->getAs( s, &converted.front(), Alembic::Util::kFloat64POD );
+            convertTime += now() - start;
+            convertBytes += numBytes;
+        }
+    }
+
+    if ( hashTime > 0.0 )
+    {
+        oResults.push_back( Result( "hash",
+            hashBytes / hashTime / 1048576.0, "MB/s" ) );
+    }
+
+    if ( convertTime > 0.0 )
+    {
+        oResults.push_back( Result( "pod_convert",
+            convertBytes / convertTime / 1048576.0, "MB/s" ) );
+    }
+}
+
+//-*****************************************************************************
+std::string jsonString( const std::string &iStr )
+{
+    std::string ret = "\"";
+    for ( std::size_t i = 0; i < iStr.size(); ++i )
+    {
+        if ( iStr[i] == '"' || iStr[i] == '\\' )
+        {
+            ret += '\\';
+        }
+        ret += iStr[i];
+    }
+    return ret + "\"";
+}
+
+//-*****************************************************************************
+void writeJson( std::ostream &iOut, const std::string &iLabel,
+                const std::string &iFile, const Config &iConfig,
+                bool iSynthetic, const ResultVec &iResults )
+{
+    iOut << "{" << std::endl
+         << "  \"label\": " << jsonString( iLabel ) << "," << std::endl
+         << "  \"file\": " << jsonString( iFile ) << "," << std::endl;
+
+    if ( iSynthetic )
+    {
+        iOut << "  \"config\": {"
+             << " \"objects\": " << iConfig.numObjects
+             << ", \"depth\": " << iConfig.depth
+             << ", \"width\": " << iConfig.width
+             << ", \"points\": " << iConfig.numPoints
+             << ", \"samples\": " << iConfig.numSamples
+             << ", \"strings\": " << iConfig.numStrings
+             << ", \"dedup\": " << iConfig.dedup << " }," << std::endl;
+    }
+
+    iOut << "  \"results\": [" << std::endl;
+    for ( std::size_t i = 0; i < iResults.size(); ++i )
+    {
+        iOut << "    { \"name\": " << jsonString( iResults[i].name )
+             << ", \"value\": " << iResults[i].value
+             << ", \"unit\": " << jsonString( iResults[i].unit ) << " }"
+             << ( i + 1 < iResults.size() ? "," : "" ) << std::endl;
+    }
+    iOut << "  ]" << std::endl << "}" << std::endl;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    Config config;
+    std::string outName = "abcbench.abc";
+    std::string jsonName;
+    std::string label;
+    bool keep = false;
+    std::vector<std::string> args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ( arg == "-objects" && hasValue )
+        {
+            config.numObjects = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-depth" && hasValue )
+        {
+            config.depth = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-width" && hasValue )
+        {
+            config.width = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-points" && hasValue )
+        {
+            config.numPoints = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-samples" && hasValue )
+        {
+            config.numSamples = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-strings" && hasValue )
+        {
+            config.numStrings = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-dedup" && hasValue )
+        {
+            config.dedup = atof( argv[++i] );
+        }
+        else if ( arg == "-threads" && hasValue )
+        {
+            config.threads.clear();
+            std::istringstream list( argv[++i] );
+            std::string count;
+            while ( std::getline( list, count, ',' ) )
+            {
+                if ( atol( count.c_str() ) > 0 )
+                {
+                    config.threads.push_back( atol( count.c_str() ) );
+                }
+            }
+        }
+        else if ( arg == "-out" && hasValue )
+        {
+            outName = argv[++i];
+        }
+        else if ( arg == "-json" && hasValue )
+        {
+            jsonName = argv[++i];
+        }
+        else if ( arg == "-label" && hasValue )
+        {
+            label = argv[++i];
+        }
+        else if ( arg == "-keep" )
+        {
+            keep = true;
+        }
+        else if ( arg == "-h" || arg == "--help" )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else
+        {
+            args.push_back( arg );
+        }
+    }
+
+    if ( args.size() > 1 || config.numSamples == 0 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    bool synthetic = args.empty();
+    std::string fileName = synthetic ? outName : args[0];
+    ResultVec results;
+
+    try
+    {
+        if ( synthetic )
+        {
+            double start = now();
+            writeSynthetic( fileName, config );
+            double elapsed = now() - start;
+
+            uint64_t size = fileSize( fileName );
+            results.push_back( Result( "write", elapsed * 1000.0, "ms" ) );
+            results.push_back( Result( "write_bytes",
+                size / elapsed / 1048576.0, "MB/s" ) );
+            results.push_back( Result( "file_size", size, "bytes" ) );
+        }
+
+        benchOpen( fileName, results );
+        benchTraverse( fileName, results );
+        for ( std::size_t i = 0; i < config.threads.size(); ++i )
+        {
+            benchRead( fileName, config.threads[i], results );
+        }
+        benchArrays( fileName, results );
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if ( synthetic && !keep )
+    {
+        remove( fileName.c_str() );
+    }
+
+    for ( std::size_t i = 0; i < results.size(); ++i )
+    {
+        std::cout << results[i].name << ": " << results[i].value << " "
+                  << results[i].unit << std::endl;
+    }
+
+    if ( !jsonName.empty() )
+    {
+        std::ofstream json( jsonName.c_str() );
+        writeJson( json, label, fileName, config, synthetic, results );
+        if ( !json )
+        {
+            std::cerr << "Could not write " << jsonName << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
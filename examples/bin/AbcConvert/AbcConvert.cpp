@@ -39,107 +39,6 @@
 #include <Alembic/AbcCoreHDF5/All.h>
 #include <Alembic/AbcCoreOgawa/All.h>
 
-void copyProps(Alembic::Abc::ICompoundProperty & iRead,
-    Alembic::Abc::OCompoundProperty & iWrite)
-{
-    std::size_t numChildren = iRead.getNumProperties();
-    for (std::size_t i = 0; i < numChildren; ++i)
-    {
-        Alembic::AbcCoreAbstract::PropertyHeader header =
-            iRead.getPropertyHeader(i);
-        if (header.isArray())
-        {
-            Alembic::Abc::IArrayProperty inProp(iRead, header.getName());
-            Alembic::Abc::OArrayProperty outProp(iWrite, header.getName(),
-                header.getDataType(), header.getMetaData(),
-                header.getTimeSampling());
-
-            std::size_t numSamples = inProp.getNumSamples();
-
-            for (std::size_t j = 0; j < numSamples; ++j)
-            {
-                Alembic::AbcCoreAbstract::ArraySamplePtr samp;
-                Alembic::Abc::ISampleSelector sel(
-                    (Alembic::Abc::index_t) j);
-                inProp.get(samp, sel);
-                outProp.set(*samp);
-            }
-        }
-        else if (header.isScalar())
-        {
-            Alembic::Abc::IScalarProperty inProp(iRead, header.getName());
-            Alembic::Abc::OScalarProperty outProp(iWrite, header.getName(),
-                header.getDataType(), header.getMetaData(),
-                header.getTimeSampling());
-
-            std::size_t numSamples = inProp.getNumSamples();
-            std::vector<std::string> sampStrVec;
-            std::vector<std::wstring> sampWStrVec;
-            if (header.getDataType().getPod() ==
-                Alembic::AbcCoreAbstract::kStringPOD)
-            {
-                sampStrVec.resize(header.getDataType().getExtent());
-            }
-            else if (header.getDataType().getPod() ==
-                     Alembic::AbcCoreAbstract::kWstringPOD)
-            {
-                sampWStrVec.resize(header.getDataType().getExtent());
-            }
-
-            char samp[4096];
-
-            for (std::size_t j = 0; j < numSamples; ++j)
-            {
-                Alembic::Abc::ISampleSelector sel(
-                    (Alembic::Abc::index_t) j);
-
-                if (header.getDataType().getPod() ==
-                    Alembic::AbcCoreAbstract::kStringPOD)
-                {
-                    inProp.get(&sampStrVec.front(), sel);
-                    outProp.set(&sampStrVec.front());
-                }
-                else if (header.getDataType().getPod() ==
-                    Alembic::AbcCoreAbstract::kWstringPOD)
-                {
-                    inProp.get(&sampWStrVec.front(), sel);
-                    outProp.set(&sampWStrVec.front());
-                }
-                else
-                {
-                    inProp.get(samp, sel);
-                    outProp.set(samp);
-                }
-            }
-        }
-        else if (header.isCompound())
-        {
-            Alembic::Abc::OCompoundProperty outProp(iWrite,
-                header.getName(), header.getMetaData());
-            Alembic::Abc::ICompoundProperty inProp(iRead, header.getName());
-            copyProps(inProp, outProp);
-        }
-    }
-}
-
-void copyObject(Alembic::Abc::IObject & iIn,
-    Alembic::Abc::OObject & iOut)
-{
-    std::size_t numChildren = iIn.getNumChildren();
-
-    Alembic::Abc::ICompoundProperty inProps = iIn.getProperties();
-    Alembic::Abc::OCompoundProperty outProps = iOut.getProperties();
-    copyProps(inProps, outProps);
-
-    for (std::size_t i = 0; i < numChildren; ++i)
-    {
-        Alembic::Abc::IObject childIn(iIn.getChild(i));
-        Alembic::Abc::OObject childOut(iOut, childIn.getName(),
-                                       childIn.getMetaData());
-        copyObject(childIn, childOut);
-    }
-}
-
 int main(int argc, char *argv[])
 {
 
@@ -224,7 +123,7 @@ int main(int argc, char *argv[])
         }
 
         Alembic::Abc::OObject outTop = outArchive.getTop();
-        copyObject(inTop, outTop);
+        Alembic::Abc::CopyObject(inTop, outTop);
         return 0;
     }
 
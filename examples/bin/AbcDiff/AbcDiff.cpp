@@ -0,0 +1,211 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreFactory/All.h>
+
+#include <iostream>
+#include <stdlib.h>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+
+//-*****************************************************************************
+void usage( const char *iProgName )
+{
+    std::cerr << "USAGE: " << iProgName
+              << " [-v] [-n maxDifferences] [-nohash] [-hierarchy]"
+              << " <fileA> <fileB> [objectPath]" << std::endl
+              << std::endl
+              << "Compares two Alembic archives (or the subtrees at "
+              << "objectPath) and prints" << std::endl
+              << "what differs. Identical Ogawa subtrees are skipped using "
+              << "their stored hashes" << std::endl
+              << "and samples are compared by key wherever possible."
+              << std::endl << std::endl
+              << "  -v          print how much work the comparison did"
+              << std::endl
+              << "  -n N        stop after N differences" << std::endl
+              << "  -nohash     don't skip subtrees by hash" << std::endl
+              << "  -hierarchy  only compare objects, properties and sample "
+              << "counts" << std::endl << std::endl
+              << "Exits with 0 if the archives match, 1 if they differ and "
+              << "2 on error." << std::endl;
+}
+
+//-*****************************************************************************
+// Walks down iPath from the top of iArchive, returns an invalid object
+// if any part of the path doesn't exist.
+Abc::IObject findObject( Abc::IArchive &iArchive, const std::string &iPath )
+{
+    Abc::IObject obj = iArchive.getTop();
+
+    std::size_t start = 0;
+    while ( obj.valid() && start < iPath.size() )
+    {
+        std::size_t end = iPath.find( '/', start );
+        if ( end == std::string::npos )
+        {
+            end = iPath.size();
+        }
+
+        if ( end > start )
+        {
+            std::string name = iPath.substr( start, end - start );
+            if ( obj.getChildHeader( name ) )
+            {
+                obj = Abc::IObject( obj, name );
+            }
+            else
+            {
+                obj.reset();
+            }
+        }
+
+        start = end + 1;
+    }
+
+    return obj;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    Abc::ArchiveDiffOptions options;
+    bool verbose = false;
+    std::vector<std::string> args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        if ( arg == "-v" )
+        {
+            verbose = true;
+        }
+        else if ( arg == "-nohash" )
+        {
+            options.useHashes = false;
+        }
+        else if ( arg == "-hierarchy" )
+        {
+            options.compareSamples = false;
+        }
+        else if ( arg == "-n" && i + 1 < argc )
+        {
+            options.maxDifferences = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-h" || arg == "--help" )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else
+        {
+            args.push_back( arg );
+        }
+    }
+
+    if ( args.size() != 2 && args.size() != 3 )
+    {
+        usage( argv[0] );
+        return 2;
+    }
+
+    try
+    {
+        AbcF::IFactory factory;
+
+        Abc::IArchive archiveA = factory.getArchive( args[0] );
+        Abc::IArchive archiveB = factory.getArchive( args[1] );
+
+        if ( !archiveA.valid() || !archiveB.valid() )
+        {
+            std::cerr << "Could not open "
+                      << ( archiveA.valid() ? args[1] : args[0] )
+                      << std::endl;
+            return 2;
+        }
+
+        std::string path = args.size() == 3 ? args[2] : "/";
+        Abc::IObject objA = findObject( archiveA, path );
+        Abc::IObject objB = findObject( archiveB, path );
+
+        if ( !objA.valid() || !objB.valid() )
+        {
+            std::cerr << "Object " << path << " not found in "
+                      << ( objA.valid() ? args[1] : args[0] ) << std::endl;
+            return 2;
+        }
+
+        Abc::ArchiveDifferences differences;
+        Abc::ArchiveDiffStats stats;
+        bool same = Abc::DiffObjects( objA, objB, differences, options,
+                                      &stats );
+
+        for ( std::size_t i = 0; i < differences.size(); ++i )
+        {
+            const Abc::ArchiveDifference &diff = differences[i];
+            std::cout << Abc::GetArchiveDifferenceTypeName( diff.type )
+                      << ": " << diff.path;
+            if ( diff.type == Abc::ArchiveDifference::kSampleChanged )
+            {
+                std::cout << " [" << diff.sampleIndex << "]";
+            }
+            std::cout << std::endl;
+        }
+
+        if ( verbose )
+        {
+            std::cout << "objects visited: " << stats.numObjects
+                      << std::endl
+                      << "properties skipped by hash: "
+                      << stats.numPropertiesSkipped << std::endl
+                      << "children skipped by hash: "
+                      << stats.numChildrenSkipped << std::endl
+                      << "samples compared by key: "
+                      << stats.numSamplesComparedByKey << std::endl
+                      << "samples compared by content: "
+                      << stats.numSamplesComparedByContent << std::endl;
+        }
+
+        return same ? 0 : 1;
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,328 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcA = ::Alembic::AbcCoreAbstract;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+
+typedef Alembic::Util::uint64_t uint64_t;
+
+//-*****************************************************************************
+void usage( const char *iProgName )
+{
+    std::cerr << "USAGE: " << iProgName
+              << " [-noreport] [-frames N] <inFile> <outFile>" << std::endl
+              << std::endl
+              << "Rewrites an Alembic archive as Ogawa with the samples of "
+              << "every property" << std::endl
+              << "grouped by time and the hierarchy at the end of the file, "
+              << "so that playing" << std::endl
+              << "it back frame by frame reads the file nearly sequentially."
+              << std::endl << std::endl
+              << "  -noreport  don't measure the per-frame read locality"
+              << std::endl
+              << "  -frames N  measure at most N frames (default 1000)"
+              << std::endl;
+}
+
+//-*****************************************************************************
+// A file buffer which remembers every read, so we can see which parts of
+// the file reading one frame touches.
+class RecordingBuf : public std::streambuf
+{
+public:
+    RecordingBuf( const std::string &iName ) : m_pos( 0 )
+    {
+        m_file.open( iName.c_str(), std::ios::in | std::ios::binary );
+    }
+
+    typedef std::pair<uint64_t, uint64_t> Read;
+    std::vector<Read> reads;
+
+protected:
+    virtual pos_type seekoff( off_type iOff, std::ios_base::seekdir iDir,
+                              std::ios_base::openmode iMode )
+    {
+        pos_type pos = m_file.pubseekoff( iOff, iDir, iMode );
+        if ( pos != pos_type( off_type( -1 ) ) )
+        {
+            m_pos = pos;
+        }
+        return pos;
+    }
+
+    virtual pos_type seekpos( pos_type iPos, std::ios_base::openmode iMode )
+    {
+        return seekoff( off_type( iPos ), std::ios_base::beg, iMode );
+    }
+
+    virtual std::streamsize xsgetn( char *oBuf, std::streamsize iSize )
+    {
+        std::streamsize numRead = m_file.sgetn( oBuf, iSize );
+        reads.push_back( Read( m_pos, numRead ) );
+        m_pos += numRead;
+        return numRead;
+    }
+
+private:
+    std::filebuf m_file;
+    uint64_t m_pos;
+};
+
+//-*****************************************************************************
+void readProperties( Abc::ICompoundProperty iProps,
+                     const Abc::ISampleSelector &iSel )
+{
+    for ( std::size_t i = 0; i < iProps.getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader &header = iProps.getPropertyHeader( i );
+        if ( header.isCompound() )
+        {
+            readProperties( Abc::ICompoundProperty( iProps,
+                header.getName() ), iSel );
+        }
+        else if ( header.isArray() )
+        {
+            AbcA::ArraySamplePtr samp;
+            Abc::IArrayProperty( iProps, header.getName() ).get( samp, iSel );
+        }
+        else
+        {
+            const AbcA::DataType &dataType = header.getDataType();
+            Abc::IScalarProperty prop( iProps, header.getName() );
+            if ( dataType.getPod() == Alembic::Util::kStringPOD )
+            {
+                std::vector<std::string> strs( dataType.getExtent() );
+                prop.get( &strs.front(), iSel );
+            }
+            else if ( dataType.getPod() == Alembic::Util::kWstringPOD )
+            {
+                std::vector<std::wstring> strs( dataType.getExtent() );
+                prop.get( &strs.front(), iSel );
+            }
+            else
+            {
+                std::vector<char> buf( dataType.getNumBytes() );
+                prop.get( &buf.front(), iSel );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+void readObject( Abc::IObject iObj, const Abc::ISampleSelector &iSel )
+{
+    readProperties( iObj.getProperties(), iSel );
+    for ( std::size_t i = 0; i < iObj.getNumChildren(); ++i )
+    {
+        readObject( iObj.getChild( i ), iSel );
+    }
+}
+
+//-*****************************************************************************
+// Reads every sample of iName frame by frame and prints how many separate
+// regions of the file each frame touched (reads less than 4k apart count as
+// one region) and how far apart the first and last byte read were.
+void reportLocality( const std::string &iName, std::size_t iMaxFrames )
+{
+    RecordingBuf buf( iName );
+    std::istream stream( &buf );
+    std::vector<std::istream *> streams( 1, &stream );
+
+    Abc::IArchive archive( Alembic::AbcCoreOgawa::ReadArchive( streams ),
+                           iName );
+
+    std::vector<Abc::chrono_t> times;
+    for ( Alembic::Util::uint32_t i = 0; i < archive.getNumTimeSamplings();
+          ++i )
+    {
+        AbcA::TimeSamplingPtr ts = archive.getTimeSampling( i );
+        Abc::index_t maxSamples =
+            archive.getMaxNumSamplesForTimeSamplingIndex( i );
+        for ( Abc::index_t j = 0; j < maxSamples; ++j )
+        {
+            times.push_back( ts->getSampleTime( j ) );
+        }
+    }
+    std::sort( times.begin(), times.end() );
+    times.erase( std::unique( times.begin(), times.end() ), times.end() );
+    if ( times.size() > iMaxFrames )
+    {
+        times.resize( iMaxFrames );
+    }
+
+    // headers and child tables are read up front, not per frame
+    readObject( archive.getTop(), Abc::ISampleSelector() );
+
+    double totalRegions = 0.0;
+    double totalSpan = 0.0;
+    double totalBytes = 0.0;
+    std::size_t maxRegions = 0;
+    for ( std::size_t f = 0; f < times.size(); ++f )
+    {
+        buf.reads.clear();
+        readObject( archive.getTop(), Abc::ISampleSelector( times[f] ) );
+
+        std::vector<RecordingBuf::Read> reads = buf.reads;
+        if ( reads.empty() )
+        {
+            continue;
+        }
+        std::sort( reads.begin(), reads.end() );
+
+        std::size_t numRegions = 1;
+        uint64_t bytes = reads[0].second;
+        uint64_t end = reads[0].first + reads[0].second;
+        for ( std::size_t i = 1; i < reads.size(); ++i )
+        {
+            if ( reads[i].first > end + 4096 )
+            {
+                ++numRegions;
+            }
+            bytes += reads[i].second;
+            end = std::max( end, reads[i].first + reads[i].second );
+        }
+
+        totalRegions += numRegions;
+        totalSpan += end - reads[0].first;
+        totalBytes += bytes;
+        maxRegions = std::max( maxRegions, numRegions );
+    }
+
+    double numFrames = times.empty() ? 1.0 : ( double ) times.size();
+    std::cout << iName << ": " << times.size() << " frames" << std::endl
+              << "  regions per frame: " << totalRegions / numFrames
+              << " (max " << maxRegions << ")" << std::endl
+              << "  bytes read per frame: " << totalBytes / numFrames
+              << std::endl
+              << "  span per frame: " << totalSpan / numFrames << " bytes"
+              << std::endl;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    bool report = true;
+    std::size_t maxFrames = 1000;
+    std::vector<std::string> args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        if ( arg == "-noreport" )
+        {
+            report = false;
+        }
+        else if ( arg == "-frames" && i + 1 < argc )
+        {
+            maxFrames = ( std::size_t ) atol( argv[++i] );
+        }
+        else if ( arg == "-h" || arg == "--help" )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else
+        {
+            args.push_back( arg );
+        }
+    }
+
+    if ( args.size() != 2 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    if ( args[0] == args[1] )
+    {
+        std::cerr << "inFile and outFile must not be the same!" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        AbcF::IFactory factory;
+        AbcF::IFactory::CoreType coreType;
+        Abc::ArchiveRepackStats stats;
+
+        {
+            Abc::IArchive in = factory.getArchive( args[0], coreType );
+            if ( !in.valid() )
+            {
+                std::cerr << "Could not open " << args[0] << std::endl;
+                return 1;
+            }
+
+            // version 0 so that any Ogawa reader can read the result
+            Abc::OArchive out( Alembic::AbcCoreOgawa::WriteArchive( 0, true ),
+                               args[1], in.getTop().getMetaData(),
+                               Abc::ErrorHandler::kThrowPolicy );
+
+            Abc::RepackArchive( in, out, &stats );
+        }
+
+        std::cout << "repacked " << stats.numObjects << " objects, "
+                  << stats.numProperties << " properties and "
+                  << stats.numSamples << " samples over "
+                  << stats.numTimes << " times" << std::endl;
+
+        if ( report )
+        {
+            if ( coreType == AbcF::IFactory::kOgawa )
+            {
+                reportLocality( args[0], maxFrames );
+            }
+            reportLocality( args[1], maxFrames );
+        }
+    }
+    catch ( std::exception &e )
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -42,8 +42,9 @@ using namespace AbcOpenGL;
 
 //-*****************************************************************************
 Transport::Transport( const std::string &iAbcFileName,
-                      chrono_t iFramesPerSecond )
-  : m_scene( iAbcFileName )
+                      chrono_t iFramesPerSecond,
+                      size_t iNumThreads )
+  : m_scene( iAbcFileName, true, iNumThreads )
   , m_framesPerSecond( iFramesPerSecond )
   , m_secondsPerFrame( 1.0f / iFramesPerSecond )
   , m_currentSeconds( m_scene.getMinTime() )
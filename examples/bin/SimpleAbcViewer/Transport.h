@@ -48,7 +48,8 @@ class Transport
 {
 public:
     Transport( const std::string &iAbcFileName,
-               chrono_t iFps );
+               chrono_t iFps,
+               size_t iNumThreads = 0 );
 
     void draw( SceneState &iState )
     {
@@ -90,6 +91,9 @@ public:
 
     const std::string &getFileName() const
     { return m_scene.getFileName(); }
+
+    size_t getNumThreads() const
+    { return m_scene.getNumThreads(); }
     
     int getCurrentFrame() const
     {
@@ -36,6 +36,10 @@
 
 #include "Viewer.h"
 
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
 //-*****************************************************************************
 namespace SimpleAbcViewer {
 
@@ -70,7 +74,8 @@ void init_surface( void )
         delete g_transport;
         g_transport = NULL;
     }
-    g_transport = new Transport( g_state.abcFileName, g_state.fps );
+    g_transport = new Transport( g_state.abcFileName, g_state.fps,
+                                 g_state.numThreads );
 }
 
 //-*****************************************************************************
@@ -509,6 +514,40 @@ bool optionExists(char** begin, char** end, const std::string& option)
 
 //-*****************************************************************************
 //-*****************************************************************************
+//-*****************************************************************************
+static double wallSeconds()
+{
+#ifndef _WIN32
+    timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec + t.tv_usec * 1e-6;
+#else
+    return ( ( double ) clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+//-*****************************************************************************
+// Steps through iNumFrames frames without opening a window, to time how long
+// reading the samples and computing the bounds takes.
+int benchScene( const std::string &iAbcFileName, chrono_t iFps,
+                size_t iNumThreads, int iNumFrames )
+{
+    Transport transport( iAbcFileName, iFps, iNumThreads );
+
+    double start = wallSeconds();
+    for ( int i = 0; i < iNumFrames; ++i )
+    {
+        transport.tickForward();
+    }
+    double elapsed = wallSeconds() - start;
+
+    std::cout << "Set the time of " << iNumFrames << " frames with "
+              << transport.getNumThreads() << " threads: "
+              << elapsed / std::max( iNumFrames, 1 ) * 1000.0
+              << " ms per frame" << std::endl;
+    return 0;
+}
+
 //-*****************************************************************************
 int SimpleViewScene( int argc, char *argv[] )
 {
@@ -520,9 +559,13 @@ int SimpleViewScene( int argc, char *argv[] )
     "  -h [ --help ]         prints this help message\n"
     "  -f [ --file ] arg     abc file name\n"
     "  --fps arg             frames per second for playback (default=24.0)\n"
+    "  --threads arg         threads reading samples (default=one per core)\n"
+    "  --bench arg           time arg frames without opening a window\n"
     "  -P [ --riPlugin ] arg full path to AlembicRiPlugin.so\n"
     "  --rndrScript arg      full path to Render Script" );
     float fps = 24.0f;
+    size_t numThreads = 0;
+    int benchFrames = -1;
 
     // help
     if ( argc < 2 ||
@@ -570,13 +613,29 @@ int SimpleViewScene( int argc, char *argv[] )
                 getOption( argv, argv + argc, "--rndrScript" ) 
                 );
 
+    if ( optionExists( argv, argv + argc, "--threads" ) )
+        numThreads = std::atoi( string( 
+                    getOption( argv, argv + argc, "--threads" ) ).c_str() 
+                );
+
+    if ( optionExists( argv, argv + argc, "--bench" ) )
+        benchFrames = std::atoi( string( 
+                    getOption( argv, argv + argc, "--bench" ) ).c_str() 
+                );
+
 #ifndef DEBUG
     try
 #endif
     {
+        if ( benchFrames >= 0 )
+        {
+            return benchScene( abcFileName, fps, numThreads, benchFrames );
+        }
+
         // Set up the state.
         g_state.abcFileName = abcFileName;
         g_state.fps = fps;
+        g_state.numThreads = numThreads;
         g_state.playback = kStopped;
         g_state.AlembicRiPluginDsoPath = AlembicRiPluginDsoPath;
         g_state.RenderScript = RenderScript;
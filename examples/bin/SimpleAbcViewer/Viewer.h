@@ -66,6 +66,7 @@ struct State
     int mods;
     std::string abcFileName;
     chrono_t fps;
+    size_t numThreads;
 
     PlaybackState playback;
 
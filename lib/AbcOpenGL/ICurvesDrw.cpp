@@ -82,9 +82,9 @@ bool ICurvesDrw::valid()
 }
 
 //-*****************************************************************************
-void ICurvesDrw::setTime( chrono_t iSeconds )
+void ICurvesDrw::updateSample( chrono_t iSeconds )
 {
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
 
     // Use nearest for now.
     ISampleSelector ss( iSeconds, ISampleSelector::kNearIndex );
@@ -105,6 +105,13 @@ void ICurvesDrw::setTime( chrono_t iSeconds )
 }
 
 
+//-*****************************************************************************
+void ICurvesDrw::updateBounds()
+{
+    // The bounds come from this drawable's own sample alone, and were
+    // already computed by updateSample.
+}
+
 //-*****************************************************************************
 void ICurvesDrw::draw( const DrawContext &iCtx )
 {
@@ -88,9 +88,9 @@ bool INuPatchDrw::valid()
 }
 
 //-*****************************************************************************
-void INuPatchDrw::setTime( chrono_t iSeconds )
+void INuPatchDrw::updateSample( chrono_t iSeconds )
 {
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
 
     // Use nearest for now.
     ISampleSelector ss( iSeconds, ISampleSelector::kNearIndex );
@@ -127,6 +127,13 @@ void INuPatchDrw::setTime( chrono_t iSeconds )
 }
 
 
+//-*****************************************************************************
+void INuPatchDrw::updateBounds()
+{
+    // The bounds come from this drawable's own sample alone, and were
+    // already computed by updateSample.
+}
+
 //-*****************************************************************************
 void INuPatchDrw::draw( const DrawContext &iCtx )
 {
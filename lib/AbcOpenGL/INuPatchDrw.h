@@ -54,7 +54,9 @@ public:
 
     virtual bool valid();
 
-    virtual void setTime( chrono_t iSeconds );
+    virtual void updateSample( chrono_t iSeconds );
+
+    virtual void updateBounds();
 
     virtual void draw( const DrawContext & iCtx );
 
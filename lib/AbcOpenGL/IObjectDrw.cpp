@@ -43,6 +43,8 @@
 #include "INuPatchDrw.h"
 #include "Scene.h"
 
+#include <Alembic/Util/Tasks.h>
+
 namespace AbcOpenGL {
 namespace ABCOPENGL_VERSION_NS {
 
@@ -190,14 +192,108 @@ bool IObjectDrw::valid()
     return m_object.valid();
 }
 
+//-*****************************************************************************
+// Updates one drawable per task; runTasks() hands them out one at a time so a
+// few heavy meshes don't leave the other threads idle.
+class UpdateTasks : public Alembic::Util::Tasks
+{
+public:
+    UpdateTasks( std::vector<IObjectDrw *> &iDrawables, chrono_t iSeconds )
+      : m_drawables( iDrawables )
+      , m_seconds( iSeconds )
+    {}
+
+    virtual void run( size_t iIndex )
+    {
+        m_drawables[iIndex]->updateSample( m_seconds );
+    }
+
+private:
+    std::vector<IObjectDrw *> &m_drawables;
+    chrono_t m_seconds;
+};
+
 //-*****************************************************************************
 void IObjectDrw::setTime( chrono_t iTime )
+{
+    setTime( iTime, 1 );
+}
+
+//-*****************************************************************************
+void IObjectDrw::setTime( chrono_t iTime, size_t iNumThreads )
 {
     if ( !m_object ) { return; }
 
+    if ( m_drawables.empty() )
+    {
+        gatherDrawables();
+    }
+
+    // Drawables which aren't ours update their whole hierarchy themselves.
+    for ( DrawablePtrVec::iterator iter = m_otherDrawables.begin();
+          iter != m_otherDrawables.end(); ++iter )
+    {
+        (*iter)->setTime( iTime );
+    }
+
+    UpdateTasks tasks( m_drawables, iTime );
+    Alembic::Util::runTasks( tasks, m_drawables.size(), iNumThreads );
+
+    // Children come after their parents, so merging the bounds back to
+    // front has each drawable see its children's bounds for this time.
+    for ( std::vector<IObjectDrw *>::reverse_iterator iter =
+              m_drawables.rbegin(); iter != m_drawables.rend(); ++iter )
+    {
+        (*iter)->updateBounds();
+    }
+}
+
+//-*****************************************************************************
+void IObjectDrw::gatherDrawables()
+{
+    m_drawables.clear();
+    m_otherDrawables.clear();
+
+    std::vector<IObjectDrw *> stack( 1, this );
+    while ( !stack.empty() )
+    {
+        IObjectDrw *drw = stack.back();
+        stack.pop_back();
+
+        if ( !drw->m_object ) { continue; }
+
+        m_drawables.push_back( drw );
+
+        // Pushed in reverse so the children are visited in order.
+        for ( DrawablePtrVec::reverse_iterator iter =
+                  drw->m_children.rbegin();
+              iter != drw->m_children.rend(); ++iter )
+        {
+            if ( !(*iter) ) { continue; }
+
+            IObjectDrw *child = dynamic_cast<IObjectDrw *>( iter->get() );
+            if ( child )
+            {
+                stack.push_back( child );
+            }
+            else
+            {
+                m_otherDrawables.push_back( *iter );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+void IObjectDrw::updateSample( chrono_t iTime )
+{
     // store the current time on the drawable for easy access later
     m_currentTime = iTime;
+}
 
+//-*****************************************************************************
+void IObjectDrw::updateBounds()
+{
     // Object itself has no properties to worry about.
     m_bounds.makeEmpty();
     for ( DrawablePtrVec::iterator iter = m_children.begin();
@@ -206,7 +302,6 @@ void IObjectDrw::setTime( chrono_t iTime )
         DrawablePtr dptr = (*iter);
         if ( dptr )
         {
-            dptr->setTime( iTime );
             m_bounds.extendBy( dptr->getBounds() );
         }
     }
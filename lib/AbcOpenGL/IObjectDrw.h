@@ -60,8 +60,25 @@ public:
 
     virtual bool valid();
 
+    //! Sets the time of this drawable and all of its children, on this
+    //! thread only.
     virtual void setTime( chrono_t iSeconds );
 
+    //! Sets the time of this drawable and all of its children, reading
+    //! the samples of up to iNumThreads drawables at once. The bounds are
+    //! merged bottom-up on this thread after every sample has been read.
+    //! The archive should have at least iNumThreads streams.
+    void setTime( chrono_t iSeconds, size_t iNumThreads );
+
+    //! Reads the samples of this drawable alone at iSeconds, without
+    //! touching its children or its bounds. setTime calls this on many
+    //! drawables at once, so it may only change this drawable's state.
+    virtual void updateSample( chrono_t iSeconds );
+
+    //! Recomputes the bounds from the children and from this drawable's
+    //! own samples. setTime calls this after the children's.
+    virtual void updateBounds();
+
     virtual Box3d getBounds();
 
     virtual void draw( const DrawContext & iCtx );
@@ -76,6 +93,14 @@ protected:
     DrawablePtrVec m_children;
 
     Box3d m_bounds;
+
+private:
+    void gatherDrawables();
+
+    // Everything at and below this drawable in depth first order, gathered
+    // on the first setTime since the hierarchy doesn't change.
+    std::vector<IObjectDrw *> m_drawables;
+    DrawablePtrVec m_otherDrawables;
 };
 
 } // End namespace ABCOPENGL_VERSION_NS
@@ -95,9 +95,9 @@ bool IPointsDrw::valid()
 }
 
 //-*****************************************************************************
-void IPointsDrw::setTime( chrono_t iSeconds )
+void IPointsDrw::updateSample( chrono_t iSeconds )
 {
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
     if ( !valid() )
     {
         return;
@@ -132,6 +132,13 @@ void IPointsDrw::setTime( chrono_t iSeconds )
     }
 }
 
+//-*****************************************************************************
+void IPointsDrw::updateBounds()
+{
+    // The bounds come from this drawable's own sample alone, and were
+    // already computed by updateSample.
+}
+
 //-*****************************************************************************
 void IPointsDrw::draw( const DrawContext &iCtx )
 {
@@ -88,9 +88,9 @@ bool IPolyMeshDrw::valid()
 }
 
 //-*****************************************************************************
-void IPolyMeshDrw::setTime( chrono_t iSeconds )
+void IPolyMeshDrw::updateSample( chrono_t iSeconds )
 {
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
     if ( !valid() )
     {
         m_drwHelper.makeInvalid();
@@ -101,13 +101,23 @@ void IPolyMeshDrw::setTime( chrono_t iSeconds )
     ISampleSelector ss( iSeconds, ISampleSelector::kNearIndex );
     IPolyMeshSchema::Sample psamp;
 
-    if ( m_polyMesh.getSchema().isConstant() )
+    IPolyMeshSchema &schema = m_polyMesh.getSchema();
+    bool topologyChanged = false;
+
+    if ( schema.isConstant() )
     {
         psamp = m_samp;
     }
-    else if ( m_polyMesh.getSchema().getNumSamples() > 0 )
+    else if ( schema.getNumSamples() > 0 )
     {
-        m_polyMesh.getSchema().get( psamp, ss );
+        // Only reread what changed since the last time.
+        int changed = schema.getChanged( m_samp, m_sampSelector, ss );
+        m_sampSelector = ss;
+        psamp = m_samp;
+
+        topologyChanged = ( changed &
+            ( IPolyMeshSchema::kFaceIndicesChanged |
+              IPolyMeshSchema::kFaceCountsChanged ) ) != 0;
     }
 
     // Get the stuff.
@@ -123,13 +133,36 @@ void IPolyMeshDrw::setTime( chrono_t iSeconds )
         bounds = m_boundsProp.getValue( ss );
     }
 
+    // Unchanged topology keeps its sample pointers, which the helper
+    // notices by itself. Otherwise the keys stored with the samples tell
+    // it whether the new topology is really different.
+    AbcA::ArraySampleKey indicesKey;
+    AbcA::ArraySampleKey countsKey;
+
     // Update the mesh hoo-ha.
-    m_drwHelper.update( P, V3fArraySamplePtr(),
-                        indices, counts, bounds );
+    if ( topologyChanged &&
+         schema.getFaceIndicesProperty().getKey( indicesKey, ss ) &&
+         schema.getFaceCountsProperty().getKey( countsKey, ss ) )
+    {
+        m_drwHelper.update( P, V3fArraySamplePtr(),
+                            indices, counts, indicesKey, countsKey, bounds );
+    }
+    else
+    {
+        m_drwHelper.update( P, V3fArraySamplePtr(),
+                            indices, counts, bounds );
+    }
+
+}
+
+//-*****************************************************************************
+void IPolyMeshDrw::updateBounds()
+{
+    IObjectDrw::updateBounds();
 
     // The Object update computed child bounds.
     // Extend them by this.
-    if ( !m_drwHelper.getBounds().isEmpty() )
+    if ( valid() && !m_drwHelper.getBounds().isEmpty() )
     {
         m_bounds.extendBy( m_drwHelper.getBounds() );
     }
@@ -55,13 +55,16 @@ public:
 
     virtual bool valid();
 
-    virtual void setTime( chrono_t iSeconds );
+    virtual void updateSample( chrono_t iSeconds );
+
+    virtual void updateBounds();
 
     virtual void draw( const DrawContext & iCtx );
 
 protected:
     IPolyMesh m_polyMesh;
     IPolyMeshSchema::Sample m_samp;
+    ISampleSelector m_sampSelector;
     IBox3dProperty m_boundsProp;
     MeshDrwHelper m_drwHelper;
 };
@@ -88,9 +88,9 @@ bool ISubDDrw::valid()
 }
 
 //-*****************************************************************************
-void ISubDDrw::setTime( chrono_t iSeconds )
+void ISubDDrw::updateSample( chrono_t iSeconds )
 {
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
     if ( !valid() )
     {
         m_drwHelper.makeInvalid();
@@ -121,9 +121,24 @@ void ISubDDrw::setTime( chrono_t iSeconds )
     if ( m_boundsProp && m_boundsProp.getNumSamples() > 0 )
     { bounds = m_boundsProp.getValue( ss ); }
 
+    // The keys stored with the samples tell us whether the topology
+    // changed without looking at it.
+    AbcA::ArraySampleKey indicesKey;
+    AbcA::ArraySampleKey countsKey;
+    ISubDSchema &schema = m_subD.getSchema();
+
     // Update the mesh hoo-ha.
-    m_drwHelper.update( P, V3fArraySamplePtr(),
-                        indices, counts, bounds );
+    if ( schema.getFaceIndicesProperty().getKey( indicesKey, ss ) &&
+         schema.getFaceCountsProperty().getKey( countsKey, ss ) )
+    {
+        m_drwHelper.update( P, V3fArraySamplePtr(),
+                            indices, counts, indicesKey, countsKey, bounds );
+    }
+    else
+    {
+        m_drwHelper.update( P, V3fArraySamplePtr(),
+                            indices, counts, bounds );
+    }
 
     if ( !m_drwHelper.valid() )
     {
@@ -131,9 +146,16 @@ void ISubDDrw::setTime( chrono_t iSeconds )
         return;
     }
 
+}
+
+//-*****************************************************************************
+void ISubDDrw::updateBounds()
+{
+    IObjectDrw::updateBounds();
+
     // The Object update computed child bounds.
     // Extend them by this.
-    if ( !m_drwHelper.getBounds().isEmpty() )
+    if ( valid() && !m_drwHelper.getBounds().isEmpty() )
     {
         m_bounds.extendBy( m_drwHelper.getBounds() );
     }
@@ -89,10 +89,9 @@ bool IXformDrw::valid()
 }
 
 //-*****************************************************************************
-void IXformDrw::setTime( chrono_t iSeconds )
+void IXformDrw::updateSample( chrono_t iSeconds )
 {
-    // Let the object set the time of all the children
-    IObjectDrw::setTime( iSeconds );
+    IObjectDrw::updateSample( iSeconds );
     if ( !valid() )
     {
         m_localToParent.makeIdentity();
@@ -111,6 +110,16 @@ void IXformDrw::setTime( chrono_t iSeconds )
     {
         m_localToParent = m_xform.getSchema().getValue( ss ).getMatrix();
     }
+}
+
+//-*****************************************************************************
+void IXformDrw::updateBounds()
+{
+    if ( !valid() )
+    {
+        IObjectDrw::updateBounds();
+        return;
+    }
 
     // Okay, now we need to recalculate the bounds.
     m_bounds.makeEmpty();
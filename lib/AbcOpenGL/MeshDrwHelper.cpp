@@ -72,7 +72,46 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         }
         else
         {
-            update( iP, iN );
+            update( iP, iN, iBounds );
+        }
+        return;
+    }
+
+    AbcA::ArraySampleKey indicesKey;
+    AbcA::ArraySampleKey countsKey;
+    if ( iIndices && iCounts )
+    {
+        indicesKey = iIndices->getKey();
+        countsKey = iCounts->getKey();
+    }
+
+    update( iP, iN, iIndices, iCounts, indicesKey, countsKey, iBounds );
+}
+
+//-*****************************************************************************
+void MeshDrwHelper::update( P3fArraySamplePtr iP,
+                            V3fArraySamplePtr iN,
+                            Int32ArraySamplePtr iIndices,
+                            Int32ArraySamplePtr iCounts,
+                            const AbcA::ArraySampleKey &iIndicesKey,
+                            const AbcA::ArraySampleKey &iCountsKey,
+                            Abc::Box3d iBounds )
+{
+    // Same topology as last time, even if it was reread.
+    if ( m_valid && m_topology && m_meshP && iP && iIndices && iCounts &&
+         m_topology->getNumPoints() == iP->size() &&
+         m_indicesKey == iIndicesKey &&
+         m_countsKey == iCountsKey )
+    {
+        m_meshIndices = iIndices;
+        m_meshCounts = iCounts;
+        if ( m_meshP == iP )
+        {
+            updateNormals( iN );
+        }
+        else
+        {
+            update( iP, iN, iBounds );
         }
         return;
     }
@@ -83,7 +122,7 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
     m_meshP = iP;
     m_meshIndices = iIndices;
     m_meshCounts = iCounts;
-    m_triangles.clear ();
+    m_topology.reset();
 
     // Check stuff.
     if ( !m_meshP ||
@@ -115,67 +154,10 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
     }
 
     // Make triangles.
-    size_t faceIndexBegin = 0;
-    size_t faceIndexEnd = 0;
-    for ( size_t face = 0; face < numFaces; ++face )
-    {
-        faceIndexBegin = faceIndexEnd;
-        size_t count = (*m_meshCounts)[face];
-        faceIndexEnd = faceIndexBegin + count;
-
-        // Check this face is valid
-        if ( faceIndexEnd > numIndices ||
-             faceIndexEnd < faceIndexBegin )
-        {
-            std::cerr << "Mesh update quitting on face: "
-                      << face
-                      << " because of wonky numbers"
-                      << ", faceIndexBegin = " << faceIndexBegin
-                      << ", faceIndexEnd = " << faceIndexEnd
-                      << ", numIndices = " << numIndices
-                      << ", count = " << count
-                      << std::endl;
-
-            // Just get out, make no more triangles.
-            break;
-        }
-
-        // Checking indices are valid.
-        bool goodFace = true;
-        for ( size_t fidx = faceIndexBegin;
-              fidx < faceIndexEnd; ++fidx )
-        {
-            if ( ( size_t ) ( (*m_meshIndices)[fidx] ) >= numPoints )
-            {
-                std::cout << "Mesh update quitting on face: "
-                          << face
-                          << " because of bad indices"
-                          << ", indexIndex = " << fidx
-                          << ", vertexIndex = " << (*m_meshIndices)[fidx]
-                          << ", numPoints = " << numPoints
-                          << std::endl;
-                goodFace = false;
-                break;
-            }
-        }
-
-        // Make triangles to fill this face.
-        if ( goodFace && count > 2 )
-        {
-            m_triangles.push_back(
-                Tri( ( unsigned int )(*m_meshIndices)[faceIndexBegin+0],
-                     ( unsigned int )(*m_meshIndices)[faceIndexBegin+1],
-                     ( unsigned int )(*m_meshIndices)[faceIndexBegin+2] ) );
-            for ( size_t c = 3; c < count; ++c )
-            {
-                m_triangles.push_back(
-                    Tri( ( unsigned int )(*m_meshIndices)[faceIndexBegin+0],
-                         ( unsigned int )(*m_meshIndices)[faceIndexBegin+c-1],
-                         ( unsigned int )(*m_meshIndices)[faceIndexBegin+c]
-                         ) );
-            }
-        }
-    }
+    m_topology.reset( new MeshTopology( *m_meshIndices, *m_meshCounts,
+                                        numPoints ) );
+    m_indicesKey = iIndicesKey;
+    m_countsKey = iCountsKey;
 
     // Cool, we made triangles.
     // Pretend the mesh is made...
@@ -193,6 +175,9 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         m_bounds = iBounds;
     }
 
+    // The normals we have were for the old topology.
+    m_meshN.reset();
+    m_customN.clear();
     updateNormals( iN );
 
     // And that's it.
@@ -211,6 +196,12 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         return;
     }
 
+    // New positions need new normals, unless they're given.
+    if ( iP != m_meshP )
+    {
+        m_customN.clear();
+    }
+
     // Set meshP
     m_meshP = iP;
 
@@ -253,33 +244,7 @@ void MeshDrwHelper::updateNormals( V3fArraySamplePtr iN )
         // Make some custom normals.
         m_meshN.reset();
         m_customN.resize( numPoints );
-        std::fill( m_customN.begin(), m_customN.end(), V3f( 0.0f ) );
-
-        //std::cout << "Recalcing normals for object: "
-        //          << m_host.name() << std::endl;
-
-        for ( size_t tidx = 0; tidx < m_triangles.size(); ++tidx )
-        {
-            const Tri &tri = m_triangles[tidx];
-
-            const V3f &A = (*m_meshP)[tri[0]];
-            const V3f &B = (*m_meshP)[tri[1]];
-            const V3f &C = (*m_meshP)[tri[2]];
-
-            V3f AB = B - A;
-            V3f AC = C - A;
-
-            V3f wN = AB.cross( AC );
-            m_customN[tri[0]] += wN;
-            m_customN[tri[1]] += wN;
-            m_customN[tri[2]] += wN;
-        }
-
-        // Normalize normals.
-        for ( size_t nidx = 0; nidx < numPoints; ++nidx )
-        {
-            m_customN[nidx].normalize();
-        }
+        m_topology->computeNormals( m_meshP->get(), &m_customN.front() );
     }
 }
 
@@ -355,11 +320,14 @@ void drawBoundingBox( const Box3d bounds, const int mode )
 void MeshDrwHelper::draw( const DrawContext & iCtx ) const
 {
     // Bail if invalid.
-    if ( !m_valid || m_triangles.size() < 1 || !m_meshP )
+    if ( !m_valid || !m_topology || m_topology->getTriangles().empty() ||
+         !m_meshP )
     {
         return;
     }
 
+    const TriArray &triangles = m_topology->getTriangles();
+
     const V3f *points = m_meshP->get();
     const V3f *normals = NULL;
     if ( m_meshN  && ( m_meshN->size() == m_meshP->size() ) )
@@ -386,9 +354,9 @@ void MeshDrwHelper::draw( const DrawContext & iCtx ) const
                                    ( const GLvoid * )points ) );
 
         GL_NOISY( glDrawElements( GL_TRIANGLES,
-                                  ( GLsizei )m_triangles.size() * 3,
+                                  ( GLsizei )triangles.size() * 3,
                                   GL_UNSIGNED_INT,
-                                  ( const GLvoid * )&(m_triangles[0]) ) );
+                                  ( const GLvoid * )&(triangles[0]) ) );
 
         if ( normals )
         {
@@ -399,9 +367,9 @@ void MeshDrwHelper::draw( const DrawContext & iCtx ) const
 #else
     glBegin( GL_TRIANGLES );
 
-    for ( size_t i = 0; i < m_triangles.size(); ++i )
+    for ( size_t i = 0; i < triangles.size(); ++i )
     {
-        const Tri &tri = m_triangles[i];
+        const Tri &tri = triangles[i];
         const V3f &vertA = points[tri[0]];
         const V3f &vertB = points[tri[1]];
         const V3f &vertC = points[tri[2]];
@@ -455,7 +423,7 @@ void MeshDrwHelper::makeInvalid()
     m_customN.clear();
     m_valid = false;
     m_bounds.makeEmpty();
-    m_triangles.clear();
+    m_topology.reset();
 }
 
 //-*****************************************************************************
@@ -39,6 +39,7 @@
 
 #include "Foundation.h"
 #include "DrawContext.h"
+#include "MeshTopology.h"
 
 namespace AbcOpenGL {
 namespace ABCOPENGL_VERSION_NS {
@@ -66,6 +67,18 @@ public:
                  Int32ArraySamplePtr iCounts,
                  Abc::Box3d iBounds = Abc::Box3d() );
 
+    // A "full update" where the topology is identified by the keys of
+    // the index and count samples, usually as stored in the file. The
+    // triangles are only rebuilt when one of the keys changes, so
+    // constant topology reread every frame is triangulated once.
+    void update( P3fArraySamplePtr iP,
+                 V3fArraySamplePtr iN,
+                 Int32ArraySamplePtr iIndices,
+                 Int32ArraySamplePtr iCounts,
+                 const AbcA::ArraySampleKey &iIndicesKey,
+                 const AbcA::ArraySampleKey &iCountsKey,
+                 Abc::Box3d iBounds = Abc::Box3d() );
+
     // Update just positions and possibly normals
     void update( P3fArraySamplePtr iP,
                  V3fArraySamplePtr iN,
@@ -92,8 +105,8 @@ public:
 protected:
     void computeBounds();
 
-    typedef Imath::Vec3<unsigned int> Tri;
-    typedef std::vector<Tri> TriArray;
+    typedef MeshTopology::Tri Tri;
+    typedef MeshTopology::TriArray TriArray;
 
     P3fArraySamplePtr m_meshP;
     V3fArraySamplePtr m_meshN;
@@ -106,7 +119,9 @@ protected:
 
     Box3d m_bounds;
 
-    TriArray m_triangles;
+    MeshTopologyPtr m_topology;
+    AbcA::ArraySampleKey m_indicesKey;
+    AbcA::ArraySampleKey m_countsKey;
 };
 
 } // End namespace ABCOPENGL_VERSION_NS
@@ -0,0 +1,277 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include "MeshTopology.h"
+
+#include <Alembic/Util/Tasks.h>
+
+#include <iostream>
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+using Imath::V3f;
+
+//-*****************************************************************************
+MeshTopology::MeshTopology( const Alembic::AbcGeom::Int32ArraySample &iIndices,
+                            const Alembic::AbcGeom::Int32ArraySample &iCounts,
+                            size_t iNumPoints )
+  : m_numPoints( iNumPoints )
+{
+    size_t numFaces = iCounts.size();
+    size_t numIndices = iIndices.size();
+    const Alembic::Util::int32_t *indices = iIndices.get();
+    const Alembic::Util::int32_t *counts = iCounts.get();
+
+    // Size the triangles up front rather than growing them face by face.
+    size_t numTriangles = 0;
+    for ( size_t face = 0; face < numFaces; ++face )
+    {
+        if ( counts[face] > 2 )
+        {
+            numTriangles += counts[face] - 2;
+        }
+    }
+    m_triangles.reserve( numTriangles );
+
+    size_t faceIndexBegin = 0;
+    size_t faceIndexEnd = 0;
+    for ( size_t face = 0; face < numFaces; ++face )
+    {
+        faceIndexBegin = faceIndexEnd;
+        size_t count = counts[face];
+        faceIndexEnd = faceIndexBegin + count;
+
+        // Check this face is valid
+        if ( faceIndexEnd > numIndices ||
+             faceIndexEnd < faceIndexBegin )
+        {
+            std::cerr << "Mesh update quitting on face: "
+                      << face
+                      << " because of wonky numbers"
+                      << ", faceIndexBegin = " << faceIndexBegin
+                      << ", faceIndexEnd = " << faceIndexEnd
+                      << ", numIndices = " << numIndices
+                      << ", count = " << count
+                      << std::endl;
+
+            // Just get out, make no more triangles.
+            break;
+        }
+
+        // Checking indices are valid.
+        bool goodFace = true;
+        for ( size_t fidx = faceIndexBegin;
+              fidx < faceIndexEnd; ++fidx )
+        {
+            if ( ( size_t ) ( indices[fidx] ) >= iNumPoints )
+            {
+                std::cout << "Mesh update quitting on face: "
+                          << face
+                          << " because of bad indices"
+                          << ", indexIndex = " << fidx
+                          << ", vertexIndex = " << indices[fidx]
+                          << ", numPoints = " << iNumPoints
+                          << std::endl;
+                goodFace = false;
+                break;
+            }
+        }
+
+        // Make triangles to fill this face.
+        if ( goodFace && count > 2 )
+        {
+            const Alembic::Util::int32_t *f = indices + faceIndexBegin;
+            for ( size_t c = 2; c < count; ++c )
+            {
+                m_triangles.push_back( Tri( ( unsigned int ) f[0],
+                                            ( unsigned int ) f[c-1],
+                                            ( unsigned int ) f[c] ) );
+            }
+        }
+    }
+
+    // Count the triangles around each point, then turn the counts into
+    // offsets and fill them in.
+    m_pointTriangleStarts.assign( iNumPoints + 1, 0 );
+    for ( size_t tidx = 0; tidx < m_triangles.size(); ++tidx )
+    {
+        const Tri &tri = m_triangles[tidx];
+        ++m_pointTriangleStarts[tri[0] + 1];
+        ++m_pointTriangleStarts[tri[1] + 1];
+        ++m_pointTriangleStarts[tri[2] + 1];
+    }
+
+    for ( size_t p = 0; p < iNumPoints; ++p )
+    {
+        m_pointTriangleStarts[p + 1] += m_pointTriangleStarts[p];
+    }
+
+    m_pointTriangles.resize( m_pointTriangleStarts[iNumPoints] );
+    std::vector<unsigned int> next( m_pointTriangleStarts.begin(),
+                                    m_pointTriangleStarts.end() - 1 );
+    for ( size_t tidx = 0; tidx < m_triangles.size(); ++tidx )
+    {
+        const Tri &tri = m_triangles[tidx];
+        m_pointTriangles[next[tri[0]]++] = tidx;
+        m_pointTriangles[next[tri[1]]++] = tidx;
+        m_pointTriangles[next[tri[2]]++] = tidx;
+    }
+}
+
+//-*****************************************************************************
+// The data shared by both passes of computeNormals. Each task writes its own
+// range of the triangle normals, then once they've all finished, its own
+// range of the point normals, so nothing is ever written by two threads.
+struct NormalsData
+{
+    const MeshTopology::Tri *triangles;
+    const unsigned int *pointTriangleStarts;
+    const unsigned int *pointTriangles;
+    const V3f *P;
+    V3f *triangleNormals;
+    V3f *normals;
+};
+
+//-*****************************************************************************
+class TriangleNormalsTasks : public Alembic::Util::Tasks
+{
+public:
+    TriangleNormalsTasks( const NormalsData &iData, size_t iNumTriangles,
+                          size_t iNumTasks )
+      : m_data( iData )
+      , m_numTriangles( iNumTriangles )
+      , m_numTasks( iNumTasks )
+    {}
+
+    virtual void run( size_t iIndex )
+    {
+        const MeshTopology::Tri *triangles = m_data.triangles;
+        const V3f *P = m_data.P;
+        V3f *triangleNormals = m_data.triangleNormals;
+
+        size_t begin = ( m_numTriangles * iIndex ) / m_numTasks;
+        size_t end = ( m_numTriangles * ( iIndex + 1 ) ) / m_numTasks;
+
+        // Unnormalized, so each is weighted by the area of its triangle.
+        for ( size_t tidx = begin; tidx < end; ++tidx )
+        {
+            const V3f &A = P[triangles[tidx][0]];
+            const V3f &B = P[triangles[tidx][1]];
+            const V3f &C = P[triangles[tidx][2]];
+
+            triangleNormals[tidx] = ( B - A ).cross( C - A );
+        }
+    }
+
+private:
+    const NormalsData &m_data;
+    size_t m_numTriangles;
+    size_t m_numTasks;
+};
+
+//-*****************************************************************************
+class PointNormalsTasks : public Alembic::Util::Tasks
+{
+public:
+    PointNormalsTasks( const NormalsData &iData, size_t iNumPoints,
+                       size_t iNumTasks )
+      : m_data( iData )
+      , m_numPoints( iNumPoints )
+      , m_numTasks( iNumTasks )
+    {}
+
+    virtual void run( size_t iIndex )
+    {
+        const unsigned int *starts = m_data.pointTriangleStarts;
+        const unsigned int *pointTriangles = m_data.pointTriangles;
+        const V3f *triangleNormals = m_data.triangleNormals;
+
+        size_t begin = ( m_numPoints * iIndex ) / m_numTasks;
+        size_t end = ( m_numPoints * ( iIndex + 1 ) ) / m_numTasks;
+
+        for ( size_t p = begin; p < end; ++p )
+        {
+            V3f n( 0.0f );
+            for ( unsigned int i = starts[p]; i < starts[p + 1]; ++i )
+            {
+                n += triangleNormals[pointTriangles[i]];
+            }
+            m_data.normals[p] = n.normalize();
+        }
+    }
+
+private:
+    const NormalsData &m_data;
+    size_t m_numPoints;
+    size_t m_numTasks;
+};
+
+//-*****************************************************************************
+void MeshTopology::computeNormals( const V3f *iP, V3f *oNormals,
+                                   size_t iNumThreads ) const
+{
+    if ( m_numPoints == 0 )
+    {
+        return;
+    }
+
+    std::vector<V3f> triangleNormals( m_triangles.size() );
+
+    NormalsData data;
+    data.triangles = m_triangles.empty() ? NULL : &m_triangles.front();
+    data.pointTriangleStarts = &m_pointTriangleStarts.front();
+    data.pointTriangles =
+        m_pointTriangles.empty() ? NULL : &m_pointTriangles.front();
+    data.P = iP;
+    data.triangleNormals =
+        triangleNormals.empty() ? NULL : &triangleNormals.front();
+    data.normals = oNormals;
+
+    // One task per thread. When this is called from a drawable already
+    // being updated by runTasks the tasks just run on that thread.
+    size_t numTasks =
+        std::max( std::min( iNumThreads, m_numPoints ), ( size_t ) 1 );
+
+    TriangleNormalsTasks triangleTasks( data, m_triangles.size(), numTasks );
+    Alembic::Util::runTasks( triangleTasks, numTasks, numTasks );
+
+    PointNormalsTasks pointTasks( data, m_numPoints, numTasks );
+    Alembic::Util::runTasks( pointTasks, numTasks, numTasks );
+}
+
+} // End namespace ABCOPENGL_VERSION_NS
+} // End namespace AbcOpenGL
@@ -0,0 +1,106 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _AbcOpenGL_MeshTopology_h_
+#define _AbcOpenGL_MeshTopology_h_
+
+// No GL in here, so tools without a window can triangulate and compute
+// normals the same way the viewer does.
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/Util/All.h>
+
+#include <ImathVec.h>
+
+#include <vector>
+
+#ifndef ABCOPENGL_VERSION_NS
+#define ABCOPENGL_VERSION_NS v1
+#endif
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+//-*****************************************************************************
+//! \brief The triangles of a polygonal mesh, along with which triangles
+//! touch each point. Both only depend on the face indices and counts, so
+//! one MeshTopology serves every frame of a mesh whose topology doesn't
+//! change.
+class MeshTopology : private Alembic::Util::noncopyable
+{
+public:
+    typedef Imath::Vec3<unsigned int> Tri;
+    typedef std::vector<Tri> TriArray;
+
+    //! Fans each face into triangles. Faces which run past the end of
+    //! iIndices stop the triangulation, faces referring to points past
+    //! iNumPoints are skipped.
+    MeshTopology( const Alembic::AbcGeom::Int32ArraySample &iIndices,
+                  const Alembic::AbcGeom::Int32ArraySample &iCounts,
+                  size_t iNumPoints );
+
+    size_t getNumPoints() const { return m_numPoints; }
+
+    const TriArray &getTriangles() const { return m_triangles; }
+
+    //! Computes area weighted, normalized point normals into oNormals,
+    //! which must hold getNumPoints() normals. Splits the work across
+    //! iNumThreads threads with Alembic::Util::runTasks, or runs on the
+    //! calling thread if that is already one of its tasks.
+    void computeNormals( const Imath::V3f *iP, Imath::V3f *oNormals,
+                         size_t iNumThreads = 1 ) const;
+
+private:
+    size_t m_numPoints;
+
+    TriArray m_triangles;
+
+    // The triangles touching point p are
+    // m_pointTriangles[m_pointTriangleStarts[p]] up to
+    // m_pointTriangles[m_pointTriangleStarts[p+1]], in triangle order.
+    std::vector<unsigned int> m_pointTriangleStarts;
+    std::vector<unsigned int> m_pointTriangles;
+};
+
+//-*****************************************************************************
+typedef Alembic::Util::shared_ptr<MeshTopology> MeshTopologyPtr;
+
+} // End namespace ABCOPENGL_VERSION_NS
+
+using namespace ABCOPENGL_VERSION_NS;
+
+} // End namespace AbcOpenGL
+
+#endif
@@ -39,6 +39,10 @@
 #include "IObjectDrw.h"
 #include "MeshDrwHelper.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace AbcOpenGL {
 namespace ABCOPENGL_VERSION_NS {
     
@@ -90,15 +94,36 @@ void setMaterials( float o, bool negMatrix = false )
 //-*****************************************************************************
 // SCENE CLASS
 //-*****************************************************************************
-Scene::Scene( const std::string &fileName, bool verbose )
+Scene::Scene( const std::string &fileName, bool verbose,
+              size_t iNumThreads )
   : m_fileName( fileName )
   , m_minTime( ( chrono_t )FLT_MAX )
   , m_maxTime( ( chrono_t )-FLT_MAX )
+  , m_numThreads( iNumThreads )
 {
     Timer playbackTimer;
 
+    if ( m_numThreads == 0 )
+    {
+#ifndef _WIN32
+        long numProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+        m_numThreads = numProcessors > 0 ? ( size_t ) numProcessors : 1;
+#else
+        m_numThreads = 1;
+#endif
+    }
+
+    // Each thread reads through a stream of its own.
     Alembic::AbcCoreFactory::IFactory factory;
-    m_archive = factory.getArchive( fileName );
+    Alembic::AbcCoreFactory::IFactory::CoreType coreType;
+    factory.setOgawaNumStreams( m_numThreads );
+    m_archive = factory.getArchive( fileName, coreType );
+
+    // HDF5 can't be read from more than one thread at a time.
+    if ( coreType != Alembic::AbcCoreFactory::IFactory::kOgawa )
+    {
+        m_numThreads = 1;
+    }
 
     m_topObject = IObject( m_archive, kTop );
 
@@ -121,14 +146,14 @@ Scene::Scene( const std::string &fileName, bool verbose )
             std::cout << "\nMin Time: " << m_minTime << " seconds " << std::endl
                       << "Max Time: " << m_maxTime << " seconds " << std::endl
                       << "\nLoading min time." << std::endl;
-        m_drawable->setTime( m_minTime );
+        m_drawable->setTime( m_minTime, m_numThreads );
     }
     else {
         if ( verbose )
             std::cout << "\nConstant Time." << std::endl
                       << "\nLoading constant sample." << std::endl;
         m_minTime = m_maxTime = 0.0;
-        m_drawable->setTime( 0.0 );
+        m_drawable->setTime( 0.0, m_numThreads );
     }
 
     ABCA_ASSERT( m_drawable->valid(),
@@ -155,7 +180,7 @@ void Scene::setTime( chrono_t iSeconds )
 
     if ( m_minTime <= m_maxTime )
     {
-        m_drawable->setTime( iSeconds );
+        m_drawable->setTime( iSeconds, m_numThreads );
         ABCA_ASSERT( m_drawable->valid(),
                      "Invalid drawable after setting time to: "
                      << iSeconds );
@@ -39,7 +39,7 @@
 
 #include "Foundation.h"
 #include "GLCamera.h"
-#include "Drawable.h"
+#include "IObjectDrw.h"
 #include <ctime>
 
 namespace AbcOpenGL {
@@ -79,12 +79,19 @@ class Scene
 public:
     //! Load a scene from the alembic archive given by the filename.
     //! ...
-    Scene( const std::string &abcFileName, bool verbose = true );
+    //! iNumThreads drawables read their samples at once when setting the
+    //! time, 0 uses one per processor. HDF5 archives always use one.
+    Scene( const std::string &abcFileName, bool verbose = true,
+           size_t iNumThreads = 0 );
 
     //! Return the filename of the archive
     //! ...
     const std::string &getFileName() const { return m_fileName; }
 
+    //! Return how many drawables read their samples at once.
+    //! ...
+    size_t getNumThreads() const { return m_numThreads; }
+
     //! Return the min time, in seconds.
     //! ...
     chrono_t getMinTime() const { return m_minTime; }
@@ -125,7 +132,8 @@ protected:
     chrono_t m_maxTime;
     Box3d m_bounds;
 
-    DrawablePtr m_drawable;
+    size_t m_numThreads;
+    Alembic::Util::shared_ptr<IObjectDrw> m_drawable;
 };
 
 } // End namespace ABCOPENGL_VERSION_NS
@@ -41,6 +41,8 @@
 #include <Alembic/Abc/ErrorHandler.h>
 #include <Alembic/Abc/Foundation.h>
 
+#include <Alembic/Abc/ArchiveDiff.h>
+#include <Alembic/Abc/ArchiveRepack.h>
 #include <Alembic/Abc/ArchiveInfo.h>
 #include <Alembic/Abc/Argument.h>
 #include <Alembic/Abc/IArchive.h>
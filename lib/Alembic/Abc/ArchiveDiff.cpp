@@ -0,0 +1,445 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Abc/ArchiveDiff.h>
+#include <Alembic/Abc/IArrayProperty.h>
+#include <Alembic/Abc/ICompoundProperty.h>
+#include <Alembic/Abc/IScalarProperty.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace Abc {
+namespace ALEMBIC_VERSION_NS {
+
+namespace { // anonymous
+
+//-*****************************************************************************
+// Ogawa archives written before hashes were stored, and leaf objects, hand
+// back an all zero digest, which can't be trusted to mean "identical".
+static inline bool getUsableHash( bool iFound, const Util::Digest &iDigest )
+{
+    return iFound && ( iDigest.words[0] != 0 || iDigest.words[1] != 0 );
+}
+
+//-*****************************************************************************
+// Sample keys are only comparable between archives written by the same core,
+// HDF5 stores MD5 digests and Ogawa SpookyHash ones. The archive version
+// tells them apart (negative for HDF5, from 0 up for Ogawa), including
+// through readers that wrap a core, such as AbcCoreConcat.
+static inline bool sameCore( AbcA::ObjectReaderPtr iA,
+                             AbcA::ObjectReaderPtr iB )
+{
+    AbcA::ArchiveReaderPtr a = iA->getArchive();
+    AbcA::ArchiveReaderPtr b = iB->getArchive();
+    return a && b &&
+        ( a->getArchiveVersion() < 0 ) == ( b->getArchiveVersion() < 0 );
+}
+
+//-*****************************************************************************
+template <class T>
+bool scalarsEqual( IScalarProperty &iA, IScalarProperty &iB,
+                   size_t iNumValues, index_t iIndex )
+{
+    std::vector<T> a( iNumValues );
+    std::vector<T> b( iNumValues );
+    iA.get( &a.front(), iIndex );
+    iB.get( &b.front(), iIndex );
+    return a == b;
+}
+
+//-*****************************************************************************
+class ArchiveDiffer
+{
+public:
+    ArchiveDiffer( ArchiveDifferences &oDifferences,
+                   const ArchiveDiffOptions &iOptions,
+                   ArchiveDiffStats &oStats,
+                   bool iKeysComparable )
+      : m_differences( oDifferences )
+      , m_options( iOptions )
+      , m_stats( oStats )
+      , m_keysComparable( iKeysComparable )
+      , m_numFound( 0 ) {}
+
+    size_t getNumFound() const { return m_numFound; }
+
+    void diffObjects( IObject &iA, IObject &iB );
+
+private:
+    bool done() const
+    {
+        return m_options.maxDifferences > 0 &&
+            m_numFound >= m_options.maxDifferences;
+    }
+
+    void add( ArchiveDifference::Type iType, const std::string &iPath,
+              index_t iSampleIndex = -1 )
+    {
+        if ( !done() )
+        {
+            m_differences.push_back(
+                ArchiveDifference( iType, iPath, iSampleIndex ) );
+            ++m_numFound;
+        }
+    }
+
+    void diffCompounds( ICompoundProperty iA, ICompoundProperty iB,
+                        const std::string &iPath );
+
+    void diffArrays( IArrayProperty iA, IArrayProperty iB,
+                     const std::string &iPath );
+
+    void diffScalars( IScalarProperty iA, IScalarProperty iB,
+                      const std::string &iPath );
+
+    ArchiveDifferences &m_differences;
+    const ArchiveDiffOptions &m_options;
+    ArchiveDiffStats &m_stats;
+    bool m_keysComparable;
+    size_t m_numFound;
+};
+
+//-*****************************************************************************
+void ArchiveDiffer::diffObjects( IObject &iA, IObject &iB )
+{
+    ++m_stats.numObjects;
+
+    Util::Digest a, b;
+    if ( m_options.useHashes &&
+         getUsableHash( iA.getPropertiesHash( a ), a ) &&
+         getUsableHash( iB.getPropertiesHash( b ), b ) && a == b )
+    {
+        ++m_stats.numPropertiesSkipped;
+    }
+    else
+    {
+        diffCompounds( iA.getProperties(), iB.getProperties(),
+                       iA.getFullName() + ":" );
+    }
+
+    // The children hash covers the name, metadata, properties and
+    // descendants of every child, so a match ends the walk here.
+    if ( m_options.useHashes &&
+         getUsableHash( iA.getChildrenHash( a ), a ) &&
+         getUsableHash( iB.getChildrenHash( b ), b ) && a == b )
+    {
+        ++m_stats.numChildrenSkipped;
+        return;
+    }
+
+    size_t numChildren = iA.getNumChildren();
+    for ( size_t i = 0; i < numChildren && !done(); ++i )
+    {
+        const AbcA::ObjectHeader &header = iA.getChildHeader( i );
+        const AbcA::ObjectHeader *other =
+            iB.getChildHeader( header.getName() );
+
+        if ( !other )
+        {
+            add( ArchiveDifference::kObjectRemoved, header.getFullName() );
+            continue;
+        }
+
+        if ( header.getMetaData().serialize() !=
+             other->getMetaData().serialize() )
+        {
+            add( ArchiveDifference::kObjectHeaderChanged,
+                 header.getFullName() );
+        }
+
+        IObject childA( iA, header.getName() );
+        IObject childB( iB, header.getName() );
+        diffObjects( childA, childB );
+    }
+
+    numChildren = iB.getNumChildren();
+    for ( size_t i = 0; i < numChildren && !done(); ++i )
+    {
+        const AbcA::ObjectHeader &header = iB.getChildHeader( i );
+        if ( !iA.getChildHeader( header.getName() ) )
+        {
+            add( ArchiveDifference::kObjectAdded, header.getFullName() );
+        }
+    }
+}
+
+//-*****************************************************************************
+void ArchiveDiffer::diffCompounds( ICompoundProperty iA,
+                                   ICompoundProperty iB,
+                                   const std::string &iPath )
+{
+    size_t numProps = iA.getNumProperties();
+    for ( size_t i = 0; i < numProps && !done(); ++i )
+    {
+        const AbcA::PropertyHeader &header = iA.getPropertyHeader( i );
+        const std::string &name = header.getName();
+        const AbcA::PropertyHeader *other = iB.getPropertyHeader( name );
+        std::string path = iPath + name;
+
+        if ( !other )
+        {
+            add( ArchiveDifference::kPropertyRemoved, path );
+            continue;
+        }
+
+        if ( header.getPropertyType() != other->getPropertyType() ||
+             header.getMetaData().serialize() !=
+             other->getMetaData().serialize() )
+        {
+            add( ArchiveDifference::kPropertyHeaderChanged, path );
+
+            // nothing else can sensibly be compared
+            if ( header.getPropertyType() != other->getPropertyType() )
+            {
+                continue;
+            }
+        }
+
+        if ( header.isCompound() )
+        {
+            diffCompounds( ICompoundProperty( iA, name ),
+                           ICompoundProperty( iB, name ), path + "/" );
+            continue;
+        }
+
+        if ( header.getDataType() != other->getDataType() ||
+             !( *header.getTimeSampling() == *other->getTimeSampling() ) )
+        {
+            add( ArchiveDifference::kPropertyHeaderChanged, path );
+
+            if ( header.getDataType() != other->getDataType() )
+            {
+                continue;
+            }
+        }
+
+        if ( header.isArray() )
+        {
+            diffArrays( IArrayProperty( iA, name ),
+                        IArrayProperty( iB, name ), path );
+        }
+        else
+        {
+            diffScalars( IScalarProperty( iA, name ),
+                         IScalarProperty( iB, name ), path );
+        }
+    }
+
+    numProps = iB.getNumProperties();
+    for ( size_t i = 0; i < numProps && !done(); ++i )
+    {
+        const AbcA::PropertyHeader &header = iB.getPropertyHeader( i );
+        if ( !iA.getPropertyHeader( header.getName() ) )
+        {
+            add( ArchiveDifference::kPropertyAdded,
+                 iPath + header.getName() );
+        }
+    }
+}
+
+//-*****************************************************************************
+void ArchiveDiffer::diffArrays( IArrayProperty iA, IArrayProperty iB,
+                                const std::string &iPath )
+{
+    size_t numSamplesA = iA.getNumSamples();
+    size_t numSamplesB = iB.getNumSamples();
+
+    if ( numSamplesA != numSamplesB )
+    {
+        add( ArchiveDifference::kNumSamplesChanged, iPath );
+    }
+
+    if ( !m_options.compareSamples )
+    {
+        return;
+    }
+
+    // if both sides repeat a single sample, the first one decides
+    size_t numSamples = std::min( numSamplesA, numSamplesB );
+    if ( numSamples > 1 && iA.isConstant() && iB.isConstant() )
+    {
+        numSamples = 1;
+    }
+
+    for ( size_t i = 0; i < numSamples && !done(); ++i )
+    {
+        index_t index = ( index_t ) i;
+
+        // the key only covers the bytes, the same values reshaped have the
+        // same key
+        AbcA::ArraySampleKey keyA, keyB;
+        if ( m_keysComparable && iA.getKey( keyA, index ) &&
+             iB.getKey( keyB, index ) )
+        {
+            ++m_stats.numSamplesComparedByKey;
+            Util::Dimensions dimsA, dimsB;
+            iA.getDimensions( dimsA, index );
+            iB.getDimensions( dimsB, index );
+            if ( !( keyA == keyB ) || !( dimsA == dimsB ) )
+            {
+                add( ArchiveDifference::kSampleChanged, iPath, index );
+            }
+            continue;
+        }
+
+        ++m_stats.numSamplesComparedByContent;
+
+        AbcA::ArraySamplePtr sampA, sampB;
+        iA.get( sampA, index );
+        iB.get( sampB, index );
+
+        if ( !( sampA->getDimensions() == sampB->getDimensions() ) ||
+             !( sampA->getKey() == sampB->getKey() ) )
+        {
+            add( ArchiveDifference::kSampleChanged, iPath, index );
+        }
+    }
+}
+
+//-*****************************************************************************
+void ArchiveDiffer::diffScalars( IScalarProperty iA, IScalarProperty iB,
+                                 const std::string &iPath )
+{
+    size_t numSamplesA = iA.getNumSamples();
+    size_t numSamplesB = iB.getNumSamples();
+
+    if ( numSamplesA != numSamplesB )
+    {
+        add( ArchiveDifference::kNumSamplesChanged, iPath );
+    }
+
+    if ( !m_options.compareSamples )
+    {
+        return;
+    }
+
+    size_t numSamples = std::min( numSamplesA, numSamplesB );
+    if ( numSamples > 1 && iA.isConstant() && iB.isConstant() )
+    {
+        numSamples = 1;
+    }
+
+    // scalar samples have no stored keys, but they are small
+    const AbcA::DataType &dataType = iA.getDataType();
+    size_t extent = dataType.getExtent();
+
+    for ( size_t i = 0; i < numSamples && !done(); ++i )
+    {
+        index_t index = ( index_t ) i;
+        bool equal = false;
+
+        ++m_stats.numSamplesComparedByContent;
+
+        if ( dataType.getPod() == Util::kStringPOD )
+        {
+            equal = scalarsEqual<std::string>( iA, iB, extent, index );
+        }
+        else if ( dataType.getPod() == Util::kWstringPOD )
+        {
+            equal = scalarsEqual<std::wstring>( iA, iB, extent, index );
+        }
+        else
+        {
+            equal = scalarsEqual<Util::uint8_t>( iA, iB,
+                                                 dataType.getNumBytes(),
+                                                 index );
+        }
+
+        if ( !equal )
+        {
+            add( ArchiveDifference::kSampleChanged, iPath, index );
+        }
+    }
+}
+
+} // End namespace anonymous
+
+//-*****************************************************************************
+const char * GetArchiveDifferenceTypeName( ArchiveDifference::Type iType )
+{
+    switch ( iType )
+    {
+    case ArchiveDifference::kObjectAdded: return "object added";
+    case ArchiveDifference::kObjectRemoved: return "object removed";
+    case ArchiveDifference::kObjectHeaderChanged:
+        return "object header changed";
+    case ArchiveDifference::kPropertyAdded: return "property added";
+    case ArchiveDifference::kPropertyRemoved: return "property removed";
+    case ArchiveDifference::kPropertyHeaderChanged:
+        return "property header changed";
+    case ArchiveDifference::kNumSamplesChanged:
+        return "number of samples changed";
+    case ArchiveDifference::kSampleChanged: return "sample changed";
+    }
+
+    return "unknown";
+}
+
+//-*****************************************************************************
+bool DiffArchives( IArchive &iA,
+                   IArchive &iB,
+                   ArchiveDifferences &oDifferences,
+                   const ArchiveDiffOptions &iOptions,
+                   ArchiveDiffStats *oStats )
+{
+    IObject topA = iA.getTop();
+    IObject topB = iB.getTop();
+    return DiffObjects( topA, topB, oDifferences, iOptions, oStats );
+}
+
+//-*****************************************************************************
+bool DiffObjects( IObject &iA,
+                  IObject &iB,
+                  ArchiveDifferences &oDifferences,
+                  const ArchiveDiffOptions &iOptions,
+                  ArchiveDiffStats *oStats )
+{
+    ABCA_ASSERT( iA.valid() && iB.valid(),
+                 "Invalid object passed to DiffObjects" );
+
+    ArchiveDiffStats stats;
+    ArchiveDiffer differ( oDifferences, iOptions, oStats ? *oStats : stats,
+                          sameCore( iA.getPtr(), iB.getPtr() ) );
+
+    differ.diffObjects( iA, iB );
+
+    return differ.getNumFound() == 0;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Abc
+} // End namespace Alembic
@@ -0,0 +1,165 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_Abc_ArchiveDiff_h_
+#define _Alembic_Abc_ArchiveDiff_h_
+
+#include <Alembic/Abc/Foundation.h>
+#include <Alembic/Abc/IArchive.h>
+#include <Alembic/Abc/IObject.h>
+
+namespace Alembic {
+namespace Abc {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Archive comparison:
+// Walks two archives (or two object subtrees) top-down and reports where
+// they differ. Whenever the core stores digests (Ogawa does, HDF5 does not)
+// identical properties and subtrees are recognized from their hashes and
+// skipped, and array samples are compared by their stored keys, so
+// unchanged data is never read. Sample contents are only compared when no
+// usable key is available.
+
+//-*****************************************************************************
+//! A single difference found by DiffArchives or DiffObjects.
+struct ArchiveDifference
+{
+    enum Type
+    {
+        kObjectAdded,
+        kObjectRemoved,
+        kObjectHeaderChanged,
+        kPropertyAdded,
+        kPropertyRemoved,
+        kPropertyHeaderChanged,
+        kNumSamplesChanged,
+        kSampleChanged
+    };
+
+    ArchiveDifference( Type iType, const std::string &iPath,
+                       index_t iSampleIndex = -1 )
+      : type( iType ), path( iPath ), sampleIndex( iSampleIndex ) {}
+
+    Type type;
+
+    //! The full name of the object, followed by ':' and the '/' separated
+    //! property path for property and sample differences,
+    //! e.g. "/pCube1/pCubeShape1:.geom/P"
+    std::string path;
+
+    //! The sample index for kSampleChanged, -1 otherwise.
+    index_t sampleIndex;
+};
+
+typedef std::vector<ArchiveDifference> ArchiveDifferences;
+
+//-*****************************************************************************
+//! Returns a short human readable name for iType, e.g. "sample changed".
+const char * GetArchiveDifferenceTypeName( ArchiveDifference::Type iType );
+
+//-*****************************************************************************
+struct ArchiveDiffOptions
+{
+    ArchiveDiffOptions()
+      : useHashes( true )
+      , compareSamples( true )
+      , maxDifferences( 0 ) {}
+
+    //! Skip identical properties and subtrees using the digests stored by
+    //! the core. Turning this off forces a full walk.
+    bool useHashes;
+
+    //! Compare individual samples. When false only the hierarchy,
+    //! the headers and the sample counts are compared.
+    bool compareSamples;
+
+    //! Stop once this many differences have been found, 0 means no limit.
+    size_t maxDifferences;
+};
+
+//-*****************************************************************************
+//! Counters describing how much work a comparison did.
+struct ArchiveDiffStats
+{
+    ArchiveDiffStats()
+      : numObjects( 0 )
+      , numPropertiesSkipped( 0 )
+      , numChildrenSkipped( 0 )
+      , numSamplesComparedByKey( 0 )
+      , numSamplesComparedByContent( 0 ) {}
+
+    //! Number of object pairs visited.
+    size_t numObjects;
+
+    //! Number of objects whose properties were skipped by hash.
+    size_t numPropertiesSkipped;
+
+    //! Number of objects whose children weren't walked because the
+    //! children hash matched.
+    size_t numChildrenSkipped;
+
+    size_t numSamplesComparedByKey;
+    size_t numSamplesComparedByContent;
+};
+
+//-*****************************************************************************
+//! Compares iA and iB, appending any differences to oDifferences.
+//! Returns true if no differences were found.
+bool DiffArchives( IArchive &iA,
+                   IArchive &iB,
+                   ArchiveDifferences &oDifferences,
+                   const ArchiveDiffOptions &iOptions = ArchiveDiffOptions(),
+                   ArchiveDiffStats *oStats = NULL );
+
+//-*****************************************************************************
+//! Compares the subtrees rooted at iA and iB. The names of iA and iB
+//! themselves are not compared, which allows diffing objects at different
+//! locations. Returns true if no differences were found.
+bool DiffObjects( IObject &iA,
+                  IObject &iB,
+                  ArchiveDifferences &oDifferences,
+                  const ArchiveDiffOptions &iOptions = ArchiveDiffOptions(),
+                  ArchiveDiffStats *oStats = NULL );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace Abc
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,296 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Abc/ArchiveRepack.h>
+
+#include <functional>
+#include <queue>
+
+namespace Alembic {
+namespace Abc {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+PropertyCopier::PropertyCopier( ICompoundProperty &iIn,
+                                OCompoundProperty &iOut,
+                                const AbcA::PropertyHeader &iHeader )
+  : m_timeSampling( iHeader.getTimeSampling() )
+  , m_numSamples( 0 )
+{
+    const std::string &name = iHeader.getName();
+    const AbcA::DataType &dataType = iHeader.getDataType();
+
+    if ( iHeader.isArray() )
+    {
+        m_inArray = IArrayProperty( iIn, name );
+        m_outArray = OArrayProperty( iOut, name, dataType,
+            iHeader.getMetaData(), iHeader.getTimeSampling() );
+        m_numSamples = m_inArray.getNumSamples();
+        return;
+    }
+
+    ABCA_ASSERT( iHeader.isScalar(),
+                 "PropertyCopier: " << name << " is a compound property" );
+
+    m_inScalar = IScalarProperty( iIn, name );
+    m_outScalar = OScalarProperty( iOut, name, dataType,
+        iHeader.getMetaData(), iHeader.getTimeSampling() );
+    m_numSamples = m_inScalar.getNumSamples();
+
+    if ( dataType.getPod() == Util::kStringPOD )
+    {
+        m_strings.resize( dataType.getExtent() );
+    }
+    else if ( dataType.getPod() == Util::kWstringPOD )
+    {
+        m_wstrings.resize( dataType.getExtent() );
+    }
+    else
+    {
+        m_buffer.resize( dataType.getNumBytes() );
+    }
+}
+
+//-*****************************************************************************
+void PropertyCopier::copySample( size_t iIndex )
+{
+    ISampleSelector sel( ( index_t ) iIndex );
+
+    if ( m_inArray )
+    {
+        AbcA::ArraySamplePtr samp;
+        m_inArray.get( samp, sel );
+        m_outArray.set( *samp );
+    }
+    else if ( !m_strings.empty() )
+    {
+        m_inScalar.get( &m_strings.front(), sel );
+        m_outScalar.set( &m_strings.front() );
+    }
+    else if ( !m_wstrings.empty() )
+    {
+        m_inScalar.get( &m_wstrings.front(), sel );
+        m_outScalar.set( &m_wstrings.front() );
+    }
+    else
+    {
+        m_inScalar.get( &m_buffer.front(), sel );
+        m_outScalar.set( &m_buffer.front() );
+    }
+}
+
+//-*****************************************************************************
+void CopyProperties( ICompoundProperty &iIn, OCompoundProperty &iOut )
+{
+    size_t numProps = iIn.getNumProperties();
+    for ( size_t i = 0; i < numProps; ++i )
+    {
+        const AbcA::PropertyHeader &header = iIn.getPropertyHeader( i );
+
+        if ( header.isCompound() )
+        {
+            ICompoundProperty inProp( iIn, header.getName() );
+            OCompoundProperty outProp( iOut, header.getName(),
+                                       header.getMetaData() );
+            CopyProperties( inProp, outProp );
+            continue;
+        }
+
+        PropertyCopier copier( iIn, iOut, header );
+        for ( size_t j = 0; j < copier.getNumSamples(); ++j )
+        {
+            copier.copySample( j );
+        }
+    }
+}
+
+//-*****************************************************************************
+void CopyObject( IObject &iIn, OObject &iOut )
+{
+    ICompoundProperty inProps = iIn.getProperties();
+    OCompoundProperty outProps = iOut.getProperties();
+    CopyProperties( inProps, outProps );
+
+    size_t numChildren = iIn.getNumChildren();
+    for ( size_t i = 0; i < numChildren; ++i )
+    {
+        IObject childIn( iIn.getChild( i ) );
+        OObject childOut( iOut, childIn.getName(), childIn.getMetaData() );
+        CopyObject( childIn, childOut );
+    }
+}
+
+namespace { // anonymous
+
+//-*****************************************************************************
+// A property's copy and the next sample still to be written.
+struct PropertyCopy
+{
+    PropertyCopy( ICompoundProperty &iIn,
+                  OCompoundProperty &iOut,
+                  const AbcA::PropertyHeader &iHeader )
+      : copier( iIn, iOut, iHeader )
+      , nextSample( 0 )
+    {}
+
+    PropertyCopier copier;
+    size_t nextSample;
+};
+
+typedef Util::shared_ptr<PropertyCopy> PropertyCopyPtr;
+
+//-*****************************************************************************
+// Everything which has to stay open until the last sample is written.
+struct RepackContext
+{
+    std::vector<OObject> objects;
+    std::vector<OCompoundProperty> compounds;
+    std::vector<PropertyCopyPtr> properties;
+};
+
+//-*****************************************************************************
+void createProperties( ICompoundProperty &iIn,
+                       OCompoundProperty &iOut,
+                       RepackContext &ioContext )
+{
+    size_t numProps = iIn.getNumProperties();
+    for ( size_t i = 0; i < numProps; ++i )
+    {
+        const AbcA::PropertyHeader &header = iIn.getPropertyHeader( i );
+        const std::string &name = header.getName();
+
+        if ( header.isCompound() )
+        {
+            ICompoundProperty inProp( iIn, name );
+            OCompoundProperty outProp( iOut, name, header.getMetaData() );
+            ioContext.compounds.push_back( outProp );
+            createProperties( inProp, outProp, ioContext );
+            continue;
+        }
+
+        ioContext.properties.push_back(
+            PropertyCopyPtr( new PropertyCopy( iIn, iOut, header ) ) );
+    }
+}
+
+//-*****************************************************************************
+void createObjects( IObject &iIn, OObject &iOut, RepackContext &ioContext )
+{
+    ICompoundProperty inProps = iIn.getProperties();
+    OCompoundProperty outProps = iOut.getProperties();
+    createProperties( inProps, outProps, ioContext );
+
+    size_t numChildren = iIn.getNumChildren();
+    for ( size_t i = 0; i < numChildren; ++i )
+    {
+        IObject childIn( iIn.getChild( i ) );
+        OObject childOut( iOut, childIn.getName(), childIn.getMetaData() );
+        ioContext.objects.push_back( childOut );
+        createObjects( childIn, childOut, ioContext );
+    }
+}
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+void RepackArchive( IArchive &iIn,
+                    OArchive &iOut,
+                    ArchiveRepackStats *oStats )
+{
+    // start at 1, the default time sampling is always there
+    for ( Util::uint32_t i = 1; i < iIn.getNumTimeSamplings(); ++i )
+    {
+        iOut.addTimeSampling( *iIn.getTimeSampling( i ) );
+    }
+
+    RepackContext context;
+    IObject inTop = iIn.getTop();
+    OObject outTop = iOut.getTop();
+    createObjects( inTop, outTop, context );
+
+    // (time of the next sample, property index), smallest first so that
+    // ties are written in hierarchy order
+    typedef std::pair<chrono_t, size_t> NextSample;
+    std::priority_queue< NextSample, std::vector<NextSample>,
+                         std::greater<NextSample> > queue;
+
+    for ( size_t i = 0; i < context.properties.size(); ++i )
+    {
+        PropertyCopy &prop = *context.properties[i];
+        if ( prop.copier.getNumSamples() > 0 )
+        {
+            queue.push( NextSample(
+                prop.copier.getTimeSampling()->getSampleTime( 0 ), i ) );
+        }
+    }
+
+    size_t numSamples = 0;
+    size_t numTimes = 0;
+    chrono_t lastTime = 0.0;
+    while ( !queue.empty() )
+    {
+        NextSample next = queue.top();
+        queue.pop();
+
+        if ( numSamples == 0 || next.first != lastTime )
+        {
+            lastTime = next.first;
+            ++numTimes;
+        }
+
+        PropertyCopy &prop = *context.properties[next.second];
+        prop.copier.copySample( prop.nextSample++ );
+        ++numSamples;
+
+        if ( prop.nextSample < prop.copier.getNumSamples() )
+        {
+            queue.push( NextSample( prop.copier.getTimeSampling()->
+                getSampleTime( ( index_t ) prop.nextSample ), next.second ) );
+        }
+    }
+
+    if ( oStats )
+    {
+        oStats->numObjects = context.objects.size();
+        oStats->numProperties = context.properties.size();
+        oStats->numSamples = numSamples;
+        oStats->numTimes = numTimes;
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Abc
+} // End namespace Alembic
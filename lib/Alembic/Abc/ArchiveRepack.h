@@ -0,0 +1,147 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_Abc_ArchiveRepack_h_
+#define _Alembic_Abc_ArchiveRepack_h_
+
+#include <Alembic/Abc/Foundation.h>
+#include <Alembic/Abc/IArchive.h>
+#include <Alembic/Abc/IArrayProperty.h>
+#include <Alembic/Abc/ICompoundProperty.h>
+#include <Alembic/Abc/IScalarProperty.h>
+#include <Alembic/Abc/OArchive.h>
+#include <Alembic/Abc/OArrayProperty.h>
+#include <Alembic/Abc/OCompoundProperty.h>
+#include <Alembic/Abc/OScalarProperty.h>
+
+namespace Alembic {
+namespace Abc {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Archive repacking:
+// Copies an archive like a plain hierarchy walk would, but writes the
+// samples time-major. The whole hierarchy and every property is created
+// first, then the samples of all properties are written in order of their
+// sample times, with ties kept in hierarchy order. Cores which lay data out
+// in write order (Ogawa) thereby keep everything needed for one frame close
+// together, and a sample shared between properties or frames is written
+// where it is first used.
+
+//-*****************************************************************************
+//! Copies the samples of one scalar or array property into a new property
+//! of the same name, type, metadata and time sampling. Scalar samples are
+//! read into a buffer kept for the whole copy, strings and wide strings
+//! included.
+class PropertyCopier
+{
+public:
+    //! Creates the copy of the property of iIn described by iHeader in iOut.
+    //! iHeader must not be a compound property.
+    PropertyCopier( ICompoundProperty &iIn,
+                    OCompoundProperty &iOut,
+                    const AbcA::PropertyHeader &iHeader );
+
+    size_t getNumSamples() const { return m_numSamples; }
+
+    AbcA::TimeSamplingPtr getTimeSampling() const { return m_timeSampling; }
+
+    //! Reads sample iIndex of the input property and sets it as the next
+    //! sample of the copy.
+    void copySample( size_t iIndex );
+
+private:
+    IArrayProperty m_inArray;
+    OArrayProperty m_outArray;
+    IScalarProperty m_inScalar;
+    OScalarProperty m_outScalar;
+
+    AbcA::TimeSamplingPtr m_timeSampling;
+    size_t m_numSamples;
+
+    std::vector<char> m_buffer;
+    std::vector<std::string> m_strings;
+    std::vector<std::wstring> m_wstrings;
+};
+
+//-*****************************************************************************
+//! Copies the properties of iIn into iOut, each with all of its samples,
+//! and the compound properties recursively.
+void CopyProperties( ICompoundProperty &iIn, OCompoundProperty &iOut );
+
+//! Copies the properties and the children of iIn into iOut, recursively,
+//! one property at a time. Unlike RepackArchive the samples end up grouped
+//! by property.
+void CopyObject( IObject &iIn, OObject &iOut );
+
+//-*****************************************************************************
+//! Counters describing what RepackArchive copied.
+struct ArchiveRepackStats
+{
+    ArchiveRepackStats()
+      : numObjects( 0 )
+      , numProperties( 0 )
+      , numSamples( 0 )
+      , numTimes( 0 ) {}
+
+    //! Number of objects copied, not counting the top object.
+    size_t numObjects;
+
+    //! Number of scalar and array properties copied.
+    size_t numProperties;
+
+    //! Number of samples written.
+    size_t numSamples;
+
+    //! Number of distinct sample times the samples were grouped by.
+    size_t numTimes;
+};
+
+//-*****************************************************************************
+//! Copies iIn into the empty archive iOut with the samples grouped by time.
+//! Time samplings are added to iOut first so they keep their indices.
+void RepackArchive( IArchive &iIn,
+                    OArchive &iOut,
+                    ArchiveRepackStats *oStats = NULL );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace Abc
+} // End namespace Alembic
+
+#endif
@@ -47,6 +47,15 @@ IArchive::~IArchive()
     // Nothing - just here as a support entry point for debugging
 }
 
+//-*****************************************************************************
+void IArchive::initInstanceCache()
+{
+    if ( m_archive )
+    {
+        m_instanceCache = IObject::makeInstanceCache();
+    }
+}
+
 //-*****************************************************************************
 std::string IArchive::getName() const
 {
@@ -67,7 +76,13 @@ IObject IArchive::getTop()
 {
     ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::getTop()" );
 
-    return IObject( m_archive->getTop(), kWrapExisting );
+    // wrapped by hand, so it shares our cache instead of making its own
+    IObject top;
+    top.m_object = m_archive->getTop();
+    top.m_instanceCache = m_instanceCache;
+    top.initInstance();
+
+    return top;
 
     ALEMBIC_ABC_SAFE_CALL_END();
 
@@ -152,6 +167,30 @@ void IArchive::setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr )
     ALEMBIC_ABC_SAFE_CALL_END();
 }
 
+//-*****************************************************************************
+AbcA::ArraySampleAllocatorPtr IArchive::getArraySampleAllocatorPtr()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::getArraySampleAllocatorPtr" );
+
+    return m_archive->getArraySampleAllocatorPtr();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw,
+    // so return a NO-OP value.
+    return AbcA::ArraySampleAllocatorPtr();
+}
+
+//-*****************************************************************************
+void IArchive::setArraySampleAllocatorPtr( AbcA::ArraySampleAllocatorPtr iPtr )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::setArraySampleAllocatorPtr" );
+
+    m_archive->setArraySampleAllocatorPtr( iPtr );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Abc
 } // End namespace Alembic
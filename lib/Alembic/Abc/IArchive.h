@@ -47,6 +47,10 @@ namespace ALEMBIC_VERSION_NS {
 
 class IObject;
 
+//! Resolves instance sources for the IObjects of an archive, see IObject.cpp
+class InstanceCache;
+typedef Alembic::Util::shared_ptr< InstanceCache > InstanceCachePtr;
+
 //-*****************************************************************************
 class IArchive : public Base
 {
@@ -100,6 +104,8 @@ public:
     {
         // Set the error handling policy.
         getErrorHandler().setPolicy( iPolicy );
+
+        initInstanceCache();
     }
 
     //! Destructor
@@ -131,6 +137,15 @@ public:
     //! will be disabled if a NULL cache is passed here.
     void setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr );
 
+    //! Get the allocator array samples are read into. It may be a NULL
+    //! pointer, in which case samples come from the heap.
+    AbcA::ArraySampleAllocatorPtr getArraySampleAllocatorPtr();
+
+    //! Set the allocator array samples are read into, for instance an
+    //! AbcA::ArraySampleArena that is reset between frames. A NULL
+    //! pointer restores the default heap allocation.
+    void setArraySampleAllocatorPtr( AbcA::ArraySampleAllocatorPtr iPtr );
+
     //-*************************************************************************
     // ABC BASE MECHANISMS
     // These functions are used by Abc to deal with errors, rewrapping,
@@ -144,7 +159,12 @@ public:
 
     //! Reset returns this function et to an empty, default
     //! state.
-    void reset() { m_archive.reset(); Base::reset(); }
+    void reset()
+    {
+        m_archive.reset();
+        m_instanceCache.reset();
+        Base::reset();
+    }
 
     //! Returns the TimeSampling at a given index.
     AbcA::TimeSamplingPtr getTimeSampling( uint32_t iIndex );
@@ -175,7 +195,16 @@ public:
     ALEMBIC_OPERATOR_BOOL( valid() );
 
 private:
+    friend class IObject;
+
+    // Set up on construction, so getTop never has to fill it in.
+    void initInstanceCache();
+
     AbcA::ArchiveReaderPtr m_archive;
+
+    // Shared with every IObject reached from getTop, so instance sources
+    // are only resolved once per archive.
+    InstanceCachePtr m_instanceCache;
 };
 
 //-*****************************************************************************
@@ -201,6 +230,8 @@ IArchive::IArchive( ARCHIVE_CTOR iCtor,
 
     ALEMBIC_ABC_SAFE_CALL_END_RESET();
 
+    initInstanceCache();
+
 }
 
 } // End namespace ALEMBIC_VERSION_NS
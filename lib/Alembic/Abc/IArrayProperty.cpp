@@ -161,6 +161,24 @@ bool IArrayProperty::getKey( AbcA::ArraySampleKey& oKey,
     return false;
 }
 
+//-*****************************************************************************
+bool IArrayProperty::isChangedSince( const ISampleSelector &iPrevSS,
+                                     const ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArrayProperty::isChangedSince()" );
+
+    AbcA::TimeSamplingPtr ts = m_property->getTimeSampling();
+    size_t numSamples = m_property->getNumSamples();
+
+    return m_property->isChangedSince( iPrevSS.getIndex( ts, numSamples ),
+                                       iSS.getIndex( ts, numSamples ) );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // for error handler that don't throw
+    return true;
+}
+
 //-*****************************************************************************
 void IArrayProperty::getDimensions( Util::Dimensions & oDim,
                                     const ISampleSelector &iSS ) const
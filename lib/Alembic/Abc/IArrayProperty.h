@@ -143,6 +143,12 @@ public:
     bool getKey( AbcA::ArraySampleKey& oKey,
                  const ISampleSelector &iSS = ISampleSelector() ) const;
 
+    //! Returns whether the sample selected by iSS may differ from the one
+    //! selected by iPrevSS, so that frame to frame readers can skip
+    //! rereading and reprocessing data which didn't change.
+    bool isChangedSince( const ISampleSelector &iPrevSS,
+                         const ISampleSelector &iSS = ISampleSelector() ) const;
+
     //! Get the dimensions of the datum.
     void getDimensions( Util::Dimensions & oDim,
                         const ISampleSelector &iSS = ISampleSelector() ) const;
@@ -39,218 +39,328 @@
 #include <Alembic/Abc/ICompoundProperty.h>
 #include <Alembic/Abc/ITypedScalarProperty.h>
 
+#include <map>
+
 namespace Alembic {
 namespace Abc {
 namespace ALEMBIC_VERSION_NS {
 
-//-*****************************************************************************
-// Nothing at the moment, this is just here as a debug entry point for
-// tracking down problems with reference counting.
-IObject::~IObject()
+namespace { // anonymous
+
+static inline
+std::string readInstanceSource( AbcA::CompoundPropertyReaderPtr iProp )
 {
-    // Nothing for now.
-    // Mostly here in case we need to add reference-counting debug code.
-    //std::cout << "IObject::~IObject() name: "
-    //          << m_object->getName()
-    //          << std::endl
-    //          << "\tUse count of writer ptr: "
-    //          << m_object.use_count() << std::endl;
+    if ( !iProp || !iProp->getPropertyHeader(".instanceSource") )
+    {
+        return std::string();
+    }
+
+    IStringProperty instanceSourceProp( iProp, ".instanceSource" );
+    if ( !instanceSourceProp )
+        return std::string();
+
+    return instanceSourceProp.getValue();
 }
 
+}  // end anonymous namespace
 
 //-*****************************************************************************
-const AbcA::ObjectHeader &IObject::getHeader() const
+//! Maps instance objects, and the source paths they point at, to the object
+//! they stand in for. Reading ".instanceSource" and walking the source path
+//! happen once per instance object, no matter how often it is visited.
+class InstanceCache : private Alembic::Util::noncopyable
 {
-    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getHeader()" );
+public:
+    InstanceCache() {}
 
-    if ( m_object )
-    {
-        return m_object->getHeader();
-    }
+    //! Returns the object iInstance points at, or NULL if it can't be found.
+    AbcA::ObjectReaderPtr resolve( AbcA::ObjectReaderPtr iInstance );
 
-    ALEMBIC_ABC_SAFE_CALL_END();
+private:
+    AbcA::ObjectReaderPtr find( const std::string & iPath,
+                                const std::map< std::string,
+                                    AbcA::ObjectReaderPtr > & iMap );
 
-    // Not all error handlers throw, so have a default behavior.
-    static const AbcA::ObjectHeader ohd;
-    return ohd;
+    AbcA::ObjectReaderPtr resolveSource( AbcA::ObjectReaderPtr iObj,
+                                         const std::string & iSource );
+
+    Alembic::Util::mutex m_lock;
+
+    // keyed by the full name of the instance object
+    std::map< std::string, AbcA::ObjectReaderPtr > m_instances;
+
+    // keyed by the instance source path
+    std::map< std::string, AbcA::ObjectReaderPtr > m_sources;
 };
 
 //-*****************************************************************************
-const std::string &IObject::getName() const
+AbcA::ObjectReaderPtr
+InstanceCache::find( const std::string & iPath,
+                     const std::map< std::string,
+                         AbcA::ObjectReaderPtr > & iMap )
 {
-    // Get the name of the original object
-    if ( m_instanceObject )
+    Alembic::Util::scoped_lock l( m_lock );
+
+    std::map< std::string, AbcA::ObjectReaderPtr >::const_iterator it =
+        iMap.find( iPath );
+
+    if ( it != iMap.end() )
     {
-        return m_instanceObject->getHeader().getName();
+        return it->second;
     }
 
-    return m_object->getHeader().getName();
+    return AbcA::ObjectReaderPtr();
 }
 
 //-*****************************************************************************
-const std::string &IObject::getFullName() const
+AbcA::ObjectReaderPtr
+InstanceCache::resolve( AbcA::ObjectReaderPtr iInstance )
 {
-    if ( !m_instancedFullName.empty() )
+    const std::string & instanceName = iInstance->getFullName();
+    AbcA::ObjectReaderPtr target = find( instanceName, m_instances );
+
+    if ( target )
     {
-        return m_instancedFullName;
+        return target;
     }
 
-    return getHeader().getFullName();
+    // The lock isn't held while resolving, since the source path may pass
+    // through other instances. Two threads may both resolve the same
+    // instance, and will come up with the same answer.
+    std::string source = readInstanceSource( iInstance->getProperties() );
+    target = resolveSource( iInstance, source );
+
+    if ( target )
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        m_instances[instanceName] = target;
+    }
+
+    return target;
 }
 
 //-*****************************************************************************
-IArchive IObject::getArchive() const
+AbcA::ObjectReaderPtr
+InstanceCache::resolveSource( AbcA::ObjectReaderPtr iObj,
+                              const std::string & iSource )
 {
+    if ( iSource.empty() || ! iObj )
+    {
+        return AbcA::ObjectReaderPtr();
+    }
 
-    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getArchive()" );
+    AbcA::ObjectReaderPtr obj = find( iSource, m_sources );
+    if ( obj )
+    {
+        return obj;
+    }
 
-    // proxies and targets are currently required to be in the
-    // same archive. Just use the m_object archive.
-    if ( m_object )
+    std::size_t curPos = 0;
+    if ( iSource[0] == '/' )
     {
-        return IArchive( m_object->getArchive(),
-                         kWrapExisting,
-                         getErrorHandlerPolicy() );
+        curPos = 1;
     }
 
-    ALEMBIC_ABC_SAFE_CALL_END();
+    obj = iObj->getArchive()->getTop();
 
-    // Not all error handlers throw. Have a default.
-    return IArchive();
-}
+    std::string childName;
+    while ( obj )
+    {
+        std::size_t nextSlash = iSource.find( '/', curPos );
+        if ( nextSlash == std::string::npos )
+        {
+            childName.assign( iSource, curPos, std::string::npos );
+        }
+        else
+        {
+            childName.assign( iSource, curPos, nextSlash - curPos );
+        }
 
-namespace { // anonymous
+        obj = obj->getChild( childName );
 
-static inline
-std::string readInstanceSource( AbcA::CompoundPropertyReaderPtr iProp )
-{
-    if ( !iProp || !iProp->getPropertyHeader(".instanceSource") )
-    {
-        return std::string();
+        // child not found, or we are on our last child
+        if ( !obj || nextSlash == std::string::npos )
+        {
+            break;
+        }
+
+        // we hit an instance so we have to evaluate down to the correct spot
+        if ( obj->getMetaData().get("isInstance") == "1" )
+        {
+            obj = resolve( obj );
+        }
+
+        curPos = nextSlash + 1;
     }
 
-    IStringProperty instanceSourceProp( iProp, ".instanceSource" );
-    if ( !instanceSourceProp )
-        return std::string();
+    if ( obj )
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        m_sources[iSource] = obj;
+    }
 
-    return instanceSourceProp.getValue();
+    return obj;
 }
 
-static inline
-AbcA::ObjectReaderPtr objectReaderByName( AbcA::ObjectReaderPtr iObj,
-                                          const std::string & iInstanceSource );
+//-*****************************************************************************
+struct IObject::InstancedPath : private Alembic::Util::noncopyable
+{
+    InstancedPath( InstancedPathPtr iParent, AbcA::ObjectReaderPtr iObject )
+      : parent( iParent ), object( iObject ) {}
 
-static inline
-AbcA::ObjectReaderPtr recurse( AbcA::ObjectReaderPtr iObj,
-                               const std::string & iInstanceSource,
-                               std::size_t iCurPos )
+    //! Built the first time it is asked for, which may happen on several
+    //! threads at once for IObjects sharing this link.
+    const std::string &getFullName();
+
+    InstancedPathPtr parent;
+
+    // the original object, not the instance source
+    AbcA::ObjectReaderPtr object;
+
+private:
+    Alembic::Util::mutex m_lock;
+    std::string m_fullName;
+};
+
+//-*****************************************************************************
+const std::string &IObject::InstancedPath::getFullName()
 {
-    std::size_t nextSlash = iInstanceSource.find( '/', iCurPos );
-    std::string childName;
-    if ( nextSlash == std::string::npos )
+    if ( !parent )
     {
-        childName = iInstanceSource.substr( iCurPos );
-    }
-    else
-    {
-        childName = iInstanceSource.substr( iCurPos, nextSlash - iCurPos );
+        return object->getFullName();
     }
 
-    AbcA::ObjectReaderPtr child = iObj->getChild( childName );
+    Alembic::Util::scoped_lock l( m_lock );
 
-    if ( child && nextSlash != std::string::npos )
+    if ( m_fullName.empty() )
     {
-        // we hit an instance so we have to evaluate down to the correct spot
-        if ( child->getMetaData().get("isInstance") == "1" )
+        // gather the names from the instance root down to us
+        std::vector< const std::string * > names;
+        size_t numChars = 0;
+        for ( InstancedPath * path = this; path; path = path->parent.get() )
         {
-            // get and recursively walk down this other path
-            AbcA::CompoundPropertyReaderPtr prop = child->getProperties();
-            std::string instanceSource = readInstanceSource( prop );
-            child = objectReaderByName( child, instanceSource);
+            const std::string & name = path->parent ?
+                path->object->getName() : path->object->getFullName();
+            names.push_back( &name );
+            numChars += name.size() + 1;
+        }
+
+        m_fullName.reserve( numChars );
+        m_fullName = *names.back();
+        for ( size_t i = names.size() - 1; i > 0; --i )
+        {
+            m_fullName += '/';
+            m_fullName += *names[i - 1];
         }
-        return recurse( child, iInstanceSource, nextSlash + 1 );
     }
 
-    // child not found, or we are on our last child
-    return child;
+    // never changed once built, so it is safe to hand out after unlocking
+    return m_fullName;
 }
 
 //-*****************************************************************************
-static inline
-AbcA::ObjectReaderPtr objectReaderByName( AbcA::ObjectReaderPtr iObj,
-                                          const std::string & iInstanceSource )
+// Nothing at the moment, this is just here as a debug entry point for
+// tracking down problems with reference counting.
+IObject::~IObject()
 {
-    if ( iInstanceSource.empty() || ! iObj )
-        return AbcA::ObjectReaderPtr();
+    // Nothing for now.
+    // Mostly here in case we need to add reference-counting debug code.
+    //std::cout << "IObject::~IObject() name: "
+    //          << m_object->getName()
+    //          << std::endl
+    //          << "\tUse count of writer ptr: "
+    //          << m_object.use_count() << std::endl;
+}
 
-    std::size_t curPos = 0;
-    if ( iInstanceSource[0] == '/' )
+
+//-*****************************************************************************
+const AbcA::ObjectHeader &IObject::getHeader() const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getHeader()" );
+
+    if ( m_object )
     {
-        curPos = 1;
+        return m_object->getHeader();
     }
 
-    AbcA::ObjectReaderPtr obj = iObj->getArchive()->getTop();
-    return recurse( obj, iInstanceSource, curPos );
-}
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so have a default behavior.
+    static const AbcA::ObjectHeader ohd;
+    return ohd;
+};
 
 //-*****************************************************************************
-static inline
-std::string getParentFullName( const std::string& iChildFullName )
+const std::string &IObject::getName() const
 {
-    size_t pos = iChildFullName.rfind('/');
-
-    if ( pos == std::string::npos || pos == 0 )
+    // Get the name of the original object
+    if ( m_instanceObject )
     {
-        return std::string();
+        return m_instanceObject->getHeader().getName();
     }
 
-    return iChildFullName.substr(0, pos);
+    return m_object->getHeader().getName();
 }
 
-}  // end anonymous namespace
+//-*****************************************************************************
+const std::string &IObject::getFullName() const
+{
+    if ( m_instancedPath )
+    {
+        return m_instancedPath->getFullName();
+    }
+    else if ( m_instanceObject )
+    {
+        return m_instanceObject->getFullName();
+    }
+
+    return getHeader().getFullName();
+}
 
 //-*****************************************************************************
-IObject IObject::getParent() const
+IArchive IObject::getArchive() const
 {
 
-    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getParent()" );
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getArchive()" );
 
-    if ( !m_instancedFullName.empty() )
+    // proxies and targets are currently required to be in the
+    // same archive. Just use the m_object archive.
+    if ( m_object )
     {
-        std::string parentFullName = getParentFullName( m_instancedFullName );
-
-        AbcA::ObjectReaderPtr parentPtr = m_object->getParent();
-        bool setFullName = false;
+        IArchive archive;
+        archive.getErrorHandler().setPolicy( getErrorHandlerPolicy() );
+        archive.m_archive = m_object->getArchive();
+        archive.m_instanceCache = m_instanceCache;
+        return archive;
+    }
 
-        // if the instanced full name doesn't match the parents full name
-        // then we have an instanced situation where we need to carefully
-        // walk the hierarchy to make sure we end up with the correct parent
+    ALEMBIC_ABC_SAFE_CALL_END();
 
-        // If the names do match, then the parent isn't a part of the instance
-        // and so we don't need to set that full name
-        if ( parentPtr && !parentFullName.empty() &&
-             parentFullName != parentPtr->getFullName() )
-        {
-            parentPtr = objectReaderByName( parentPtr, parentFullName );
-            setFullName = true;
-        }
+    // Not all error handlers throw. Have a default.
+    return IArchive();
+}
 
-        IObject obj( parentPtr,
-                     kWrapExisting,
-                     getErrorHandlerPolicy() );
+//-*****************************************************************************
+IObject IObject::getParent() const
+{
 
-        if ( setFullName )
-        {
-            obj.setInstancedFullName( parentFullName );
-        }
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::getParent()" );
 
+    // Walking back up through an instance, the parent is the object we came
+    // down from rather than the parent of the instance source.
+    if ( m_instancedPath && m_instancedPath->parent )
+    {
+        IObject obj = wrapObject( m_instancedPath->parent->object );
+        obj.m_instancedPath = m_instancedPath->parent;
         return obj;
     }
+    else if ( m_instanceObject )
+    {
+        return wrapObject( m_instanceObject->getParent() );
+    }
     else if ( m_object )
     {
-        return IObject( m_object->getParent(),
-                        kWrapExisting,
-                        getErrorHandlerPolicy() );
+        return wrapObject( m_object->getParent() );
     }
 
     ALEMBIC_ABC_SAFE_CALL_END();
@@ -320,14 +430,12 @@ IObject IObject::getChild( size_t iChildIndex ) const
 
     if ( m_object )
     {
-        IObject obj( m_object->getChild( iChildIndex ),
-                     kWrapExisting,
-                     getErrorHandlerPolicy() );
+        IObject obj = wrapObject( m_object->getChild( iChildIndex ) );
 
-        if ( !m_instancedFullName.empty() )
+        if ( m_instancedPath && obj.m_object )
         {
-            obj.setInstancedFullName(
-                m_instancedFullName + std::string("/") + obj.getName() );
+            obj.m_instancedPath.reset( new InstancedPath( m_instancedPath,
+                obj.m_instanceObject ? obj.m_instanceObject : obj.m_object ) );
         }
 
         return obj;
@@ -347,14 +455,12 @@ IObject IObject::getChild( const std::string &iChildName ) const
 
     if ( m_object )
     {
-        IObject obj( m_object->getChild( iChildName ),
-                     kWrapExisting,
-                     getErrorHandlerPolicy() );
+        IObject obj = wrapObject( m_object->getChild( iChildName ) );
 
-        if ( !m_instancedFullName.empty() )
+        if ( m_instancedPath && obj.m_object )
         {
-            obj.setInstancedFullName(
-                m_instancedFullName + std::string("/") + obj.getName() );
+            obj.m_instancedPath.reset( new InstancedPath( m_instancedPath,
+                obj.m_instanceObject ? obj.m_instanceObject : obj.m_object ) );
         }
 
         return obj;
@@ -370,7 +476,8 @@ IObject IObject::getChild( const std::string &iChildName ) const
 void IObject::reset()
 {
     m_instanceObject.reset();
-    m_instancedFullName.clear();
+    m_instancedPath.reset();
+    m_instanceCache.reset();
 
     m_object.reset();
     Base::reset();
@@ -446,7 +553,7 @@ bool IObject::isInstanceDescendant() const
 {
     ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::isInstanceDescendant()" );
 
-    if ( !m_instancedFullName.empty() )
+    if ( m_instancedPath || m_instanceObject )
     {
         return true;
     }
@@ -475,9 +582,20 @@ std::string IObject::instanceSourcePath()
 }
 
 //-*****************************************************************************
-void IObject::setInstancedFullName( const std::string& parentPath ) const
+IObject IObject::wrapObject( AbcA::ObjectReaderPtr iObject ) const
+{
+    IObject obj;
+    obj.getErrorHandler().setPolicy( getErrorHandlerPolicy() );
+    obj.m_object = iObject;
+    obj.m_instanceCache = m_instanceCache;
+    obj.initInstance();
+    return obj;
+}
+
+//-*****************************************************************************
+InstanceCachePtr IObject::makeInstanceCache()
 {
-    m_instancedFullName = parentPath;
+    return InstanceCachePtr( new InstanceCache() );
 }
 
 //-*****************************************************************************
@@ -533,6 +651,11 @@ void IObject::init( AbcA::ObjectReaderPtr iParent,
 //-*****************************************************************************
 void IObject::initInstance()
 {
+    // objects we wrap ourselves are handed the cache they share
+    if ( !m_instanceCache )
+    {
+        m_instanceCache = makeInstanceCache();
+    }
 
     // not an instance so m_instanceObject will stay empty
     if ( !m_object || m_object->getMetaData().get("isInstance") != "1")
@@ -540,19 +663,14 @@ void IObject::initInstance()
         return;
     }
 
-    AbcA::CompoundPropertyReaderPtr propsPtr = m_object->getProperties();
-    std::string instanceSource = readInstanceSource( propsPtr );
-    AbcA::ObjectReaderPtr targetObject =
-        objectReaderByName( m_object, instanceSource );
+    AbcA::ObjectReaderPtr targetObject = m_instanceCache->resolve( m_object );
 
     m_instanceObject = m_object;
     m_object = targetObject;
 
-    // initialize the full name to the instance full name
-    if ( m_instanceObject != 0 )
-    {
-        m_instancedFullName = m_instanceObject->getFullName();
-    }
+    // an instance root starts the chain its children hang off of
+    m_instancedPath.reset(
+        new InstancedPath( InstancedPathPtr(), m_instanceObject ) );
 }
 
 } // End namespace ALEMBIC_VERSION_NS
@@ -40,12 +40,12 @@
 #include <Alembic/Abc/Foundation.h>
 #include <Alembic/Abc/Base.h>
 #include <Alembic/Abc/Argument.h>
+#include <Alembic/Abc/IArchive.h>
 
 namespace Alembic {
 namespace Abc {
 namespace ALEMBIC_VERSION_NS {
 
-class IArchive;
 class ICompoundProperty;
 
 //-*****************************************************************************
@@ -106,6 +106,7 @@ public:
         ALEMBIC_ABC_SAFE_CALL_BEGIN( "IObject::IObject( top )" );
 
         m_object = GetArchiveReaderPtr( iPtr )->getTop();
+        initInstance();
 
         ALEMBIC_ABC_SAFE_CALL_END_RESET();
     }
@@ -259,15 +260,29 @@ private:
                const std::string &iName,
                ErrorHandler::Policy iPolicy );
 
+    friend class IArchive;
+
     void initInstance();
 
-    void setInstancedFullName(const std::string& parentPath) const;
+    // Wraps an object of the same archive, sharing our instance cache.
+    IObject wrapObject( AbcA::ObjectReaderPtr iObject ) const;
+
+    static InstanceCachePtr makeInstanceCache();
+
+    // One link in the chain of objects walked from an instance root; the
+    // root has no parent and is named by its full name.
+    struct InstancedPath;
+    typedef Alembic::Util::shared_ptr< InstancedPath > InstancedPathPtr;
 
     // This is the "original" object when it is an instance (not the source)
     AbcA::ObjectReaderPtr m_instanceObject;
 
-    // All IObject ancestors of an instance object have these set.
-    mutable std::string m_instancedFullName;
+    // Set on instance roots and the objects reached by walking down from
+    // them.
+    InstancedPathPtr m_instancedPath;
+
+    // Set on construction, so const functions never have to fill it in.
+    InstanceCachePtr m_instanceCache;
 };
 
 typedef Alembic::Util::shared_ptr< IObject > IObjectPtr;
@@ -0,0 +1,258 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <sstream>
+
+namespace Abc = Alembic::Abc;
+using namespace Abc;
+
+//-*****************************************************************************
+// iVariant 0 writes the reference archive, iVariant 1 the same archive with
+// a handful of known edits.
+void writeArchive( const std::string &iName, bool iUseOgawa, int iVariant )
+{
+    OArchive archive;
+    if ( iUseOgawa )
+    {
+        archive = OArchive( Alembic::AbcCoreOgawa::WriteArchive(),
+                            iName, ErrorHandler::kThrowPolicy );
+    }
+    else
+    {
+        archive = OArchive( Alembic::AbcCoreHDF5::WriteArchive(),
+                            iName, ErrorHandler::kThrowPolicy );
+    }
+
+    OObject top = archive.getTop();
+
+    // a subtree that never changes
+    OObject still( top, "still" );
+    for ( int i = 0; i < 10; ++i )
+    {
+        std::ostringstream name;
+        name << "child" << i;
+        OObject child( still, name.str() );
+        OInt32ArrayProperty ints( child.getProperties(), "ints" );
+        std::vector<Alembic::Util::int32_t> vals( 100, i );
+        for ( int s = 0; s < 3; ++s )
+        {
+            ints.set( vals );
+        }
+
+        OStringProperty label( child.getProperties(), "label" );
+        label.set( name.str() );
+    }
+
+    OObject moving( top, "moving" );
+    OObject leaf( moving, "leaf" );
+    OFloatArrayProperty floats( leaf.getProperties(), "floats" );
+    for ( int s = 0; s < 4; ++s )
+    {
+        std::vector<float> vals( 10, ( float ) s );
+        if ( iVariant == 1 && s == 2 )
+        {
+            vals[5] = -1.0f;
+        }
+        floats.set( vals );
+    }
+
+    // the same values, but 2x3 in one archive and 3x2 in the other
+    OInt32ArrayProperty shape( leaf.getProperties(), "shape" );
+    std::vector<Alembic::Util::int32_t> shapeVals( 6, 7 );
+    Alembic::Util::Dimensions dims;
+    dims.setRank( 2 );
+    dims[0] = iVariant == 1 ? 3 : 2;
+    dims[1] = iVariant == 1 ? 2 : 3;
+    shape.set( Int32ArraySample( &shapeVals.front(), dims ) );
+
+    OInt32Property count( leaf.getProperties(), "count" );
+    count.set( 1 );
+    count.set( iVariant == 1 ? 3 : 2 );
+
+    if ( iVariant == 0 )
+    {
+        OStringProperty removed( leaf.getProperties(), "removed" );
+        removed.set( "gone" );
+    }
+    else
+    {
+        OObject added( moving, "added" );
+    }
+}
+
+//-*****************************************************************************
+bool hasDifference( const ArchiveDifferences &iDiffs,
+                    ArchiveDifference::Type iType,
+                    const std::string &iPath,
+                    index_t iSampleIndex = -1 )
+{
+    for ( size_t i = 0; i < iDiffs.size(); ++i )
+    {
+        if ( iDiffs[i].type == iType && iDiffs[i].path == iPath &&
+             iDiffs[i].sampleIndex == iSampleIndex )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-*****************************************************************************
+IArchive openArchive( const std::string &iName, bool iUseOgawa )
+{
+    if ( iUseOgawa )
+    {
+        return IArchive( Alembic::AbcCoreOgawa::ReadArchive(), iName );
+    }
+
+    return IArchive( Alembic::AbcCoreHDF5::ReadArchive(), iName );
+}
+
+//-*****************************************************************************
+void diffTest( bool iUseOgawa )
+{
+    std::string nameA = iUseOgawa ? "diffA.abc" : "diffA_hdf5.abc";
+    std::string nameB = iUseOgawa ? "diffB.abc" : "diffB_hdf5.abc";
+    std::string nameC = iUseOgawa ? "diffC.abc" : "diffC_hdf5.abc";
+
+    writeArchive( nameA, iUseOgawa, 0 );
+    writeArchive( nameB, iUseOgawa, 1 );
+    writeArchive( nameC, iUseOgawa, 0 );
+
+    IArchive a = openArchive( nameA, iUseOgawa );
+    IArchive b = openArchive( nameB, iUseOgawa );
+    IArchive c = openArchive( nameC, iUseOgawa );
+
+    // identical archives
+    {
+        ArchiveDifferences diffs;
+        ArchiveDiffStats stats;
+        TESTING_ASSERT( DiffArchives( a, c, diffs, ArchiveDiffOptions(),
+                                      &stats ) );
+        TESTING_ASSERT( diffs.empty() );
+
+        if ( iUseOgawa )
+        {
+            // everything below the top is recognized by hash
+            TESTING_ASSERT( stats.numObjects == 1 );
+            TESTING_ASSERT( stats.numChildrenSkipped == 1 );
+            TESTING_ASSERT( stats.numSamplesComparedByContent == 0 );
+        }
+        else
+        {
+            TESTING_ASSERT( stats.numPropertiesSkipped == 0 );
+            TESTING_ASSERT( stats.numSamplesComparedByKey +
+                            stats.numSamplesComparedByContent > 0 );
+        }
+    }
+
+    // the known edits
+    {
+        ArchiveDifferences diffs;
+        ArchiveDiffStats stats;
+        TESTING_ASSERT( !DiffArchives( a, b, diffs, ArchiveDiffOptions(),
+                                       &stats ) );
+
+        TESTING_ASSERT( diffs.size() == 5 );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kSampleChanged, "/moving/leaf:floats", 2 ) );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kSampleChanged, "/moving/leaf:shape", 0 ) );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kSampleChanged, "/moving/leaf:count", 1 ) );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kPropertyRemoved, "/moving/leaf:removed" ) );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kObjectAdded, "/moving/added" ) );
+
+        if ( iUseOgawa )
+        {
+            // the untouched "still" subtree isn't walked, only the floats
+            // and the shape are compared by key and the scalar by content
+            TESTING_ASSERT( stats.numChildrenSkipped == 1 );
+            TESTING_ASSERT( stats.numObjects == 4 );
+            TESTING_ASSERT( stats.numSamplesComparedByKey == 5 );
+            TESTING_ASSERT( stats.numSamplesComparedByContent == 2 );
+        }
+    }
+
+    // the limit stops the walk early
+    {
+        ArchiveDifferences diffs;
+        ArchiveDiffOptions options;
+        options.maxDifferences = 1;
+        TESTING_ASSERT( !DiffArchives( a, b, diffs, options ) );
+        TESTING_ASSERT( diffs.size() == 1 );
+    }
+
+    // without hashes or samples
+    {
+        ArchiveDifferences diffs;
+        ArchiveDiffOptions options;
+        options.useHashes = false;
+        options.compareSamples = false;
+        TESTING_ASSERT( !DiffArchives( a, b, diffs, options ) );
+        TESTING_ASSERT( diffs.size() == 2 );
+    }
+
+    // subtrees at different locations
+    {
+        ArchiveDifferences diffs;
+        IObject stillA( a.getTop(), "still" );
+        IObject childA( stillA, "child3" );
+        IObject stillB( b.getTop(), "still" );
+        IObject childB( stillB, "child3" );
+        TESTING_ASSERT( DiffObjects( childA, childB, diffs ) );
+
+        IObject otherB( stillB, "child4" );
+        TESTING_ASSERT( !DiffObjects( childA, otherB, diffs ) );
+        TESTING_ASSERT( hasDifference( diffs,
+            ArchiveDifference::kSampleChanged, "/still/child3:ints", 0 ) );
+    }
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    diffTest( true );
+    diffTest( false );
+    return 0;
+}
@@ -0,0 +1,252 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Abc = Alembic::Abc;
+using namespace Abc;
+
+static const size_t g_numObjects = 20;
+static const size_t g_numFrames = 10;
+
+//-*****************************************************************************
+// A file buffer which remembers every read, to see which bytes reading a
+// frame touches.
+class RecordingBuf : public std::streambuf
+{
+public:
+    RecordingBuf( const std::string &iName ) : m_pos( 0 )
+    {
+        m_file.open( iName.c_str(), std::ios::in | std::ios::binary );
+    }
+
+    typedef std::pair<Alembic::Util::uint64_t, Alembic::Util::uint64_t> Read;
+    std::vector<Read> reads;
+
+protected:
+    virtual pos_type seekoff( off_type iOff, std::ios_base::seekdir iDir,
+                              std::ios_base::openmode iMode )
+    {
+        pos_type pos = m_file.pubseekoff( iOff, iDir, iMode );
+        if ( pos != pos_type( off_type( -1 ) ) )
+        {
+            m_pos = pos;
+        }
+        return pos;
+    }
+
+    virtual pos_type seekpos( pos_type iPos, std::ios_base::openmode iMode )
+    {
+        return seekoff( off_type( iPos ), std::ios_base::beg, iMode );
+    }
+
+    virtual std::streamsize xsgetn( char *oBuf, std::streamsize iSize )
+    {
+        std::streamsize numRead = m_file.sgetn( oBuf, iSize );
+        reads.push_back( Read( m_pos, numRead ) );
+        m_pos += numRead;
+        return numRead;
+    }
+
+private:
+    std::filebuf m_file;
+    Alembic::Util::uint64_t m_pos;
+};
+
+//-*****************************************************************************
+// Writes the archive object by object, the way most exporters do.
+void writeObjectMajor( const std::string &iName )
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName,
+                      ErrorHandler::kThrowPolicy );
+    Alembic::Util::uint32_t tsIdx = archive.addTimeSampling(
+        AbcA::TimeSampling( 1.0 / 24.0, 0.0 ) );
+
+    OObject top = archive.getTop();
+    for ( size_t i = 0; i < g_numObjects; ++i )
+    {
+        std::ostringstream name;
+        name << "obj" << i;
+        OObject obj( top, name.str() );
+
+        OInt32ArrayProperty vals( obj.getProperties(), "vals", tsIdx );
+        OFloatProperty weight( obj.getProperties(), "weight", tsIdx );
+        OStringProperty label( obj.getProperties(), "label", tsIdx );
+        OCompoundProperty extra( obj.getProperties(), "extra" );
+        OInt32ArrayProperty rest( extra, "rest" );
+
+        // constant data, the same for every object
+        rest.set( std::vector<Alembic::Util::int32_t>( 500, 7 ) );
+
+        for ( size_t f = 0; f < g_numFrames; ++f )
+        {
+            vals.set( std::vector<Alembic::Util::int32_t>(
+                1000, ( Alembic::Util::int32_t )( i * 100 + f ) ) );
+            weight.set( ( float ) f );
+
+            std::ostringstream str;
+            str << name.str() << " frame " << f;
+            label.set( str.str() );
+        }
+    }
+}
+
+//-*****************************************************************************
+void readFrame( ICompoundProperty iProps, const ISampleSelector &iSel )
+{
+    for ( size_t i = 0; i < iProps.getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader &header = iProps.getPropertyHeader( i );
+        if ( header.isCompound() )
+        {
+            readFrame( ICompoundProperty( iProps, header.getName() ), iSel );
+        }
+        else if ( header.isArray() )
+        {
+            AbcA::ArraySamplePtr samp;
+            IArrayProperty( iProps, header.getName() ).get( samp, iSel );
+        }
+        else if ( header.getDataType().getPod() == Alembic::Util::kStringPOD )
+        {
+            std::string str;
+            IScalarProperty( iProps, header.getName() ).get( &str, iSel );
+        }
+        else
+        {
+            char buf[64];
+            IScalarProperty( iProps, header.getName() ).get( buf, iSel );
+        }
+    }
+}
+
+//-*****************************************************************************
+// Returns the number of separate regions of the file read for one frame,
+// treating reads less than 4k apart as one region.
+size_t countFrameRegions( const std::string &iName, size_t iFrame,
+                          Alembic::Util::uint64_t &oSpan )
+{
+    RecordingBuf buf( iName );
+    std::istream stream( &buf );
+    std::vector<std::istream *> streams( 1, &stream );
+
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive( streams ), iName );
+    ISampleSelector sel( ( chrono_t ) iFrame / 24.0 );
+
+    // headers and child tables are read before the frame is
+    IObject top = archive.getTop();
+    for ( size_t i = 0; i < top.getNumChildren(); ++i )
+    {
+        readFrame( top.getChild( i ).getProperties(), ISampleSelector() );
+    }
+    buf.reads.clear();
+
+    for ( size_t i = 0; i < top.getNumChildren(); ++i )
+    {
+        readFrame( top.getChild( i ).getProperties(), sel );
+    }
+
+    std::vector<RecordingBuf::Read> reads = buf.reads;
+    TESTING_ASSERT( !reads.empty() );
+    std::sort( reads.begin(), reads.end() );
+
+    size_t numRegions = 1;
+    Alembic::Util::uint64_t end = reads[0].first + reads[0].second;
+    for ( size_t i = 1; i < reads.size(); ++i )
+    {
+        if ( reads[i].first > end + 4096 )
+        {
+            ++numRegions;
+        }
+        end = std::max( end, reads[i].first + reads[i].second );
+    }
+
+    oSpan = end - reads[0].first;
+    return numRegions;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    writeObjectMajor( "repackIn.abc" );
+
+    ArchiveRepackStats stats;
+    {
+        IArchive in( Alembic::AbcCoreOgawa::ReadArchive(), "repackIn.abc" );
+        OArchive out( Alembic::AbcCoreOgawa::WriteArchive( 0, true ),
+                      "repackOut.abc", in.getTop().getMetaData(),
+                      ErrorHandler::kThrowPolicy );
+        RepackArchive( in, out, &stats );
+    }
+
+    TESTING_ASSERT( stats.numObjects == g_numObjects );
+    TESTING_ASSERT( stats.numProperties == g_numObjects * 4 );
+    TESTING_ASSERT( stats.numSamples ==
+                    g_numObjects * ( 3 * g_numFrames + 1 ) );
+    TESTING_ASSERT( stats.numTimes == g_numFrames );
+
+    // same archive, sample for sample
+    IArchive in( Alembic::AbcCoreOgawa::ReadArchive(), "repackIn.abc" );
+    IArchive out( Alembic::AbcCoreOgawa::ReadArchive(), "repackOut.abc" );
+    TESTING_ASSERT( out.getNumTimeSamplings() == in.getNumTimeSamplings() );
+
+    ArchiveDifferences diffs;
+    TESTING_ASSERT( DiffArchives( in, out, diffs ) );
+
+    Alembic::Util::uint64_t inSpan = 0;
+    Alembic::Util::uint64_t outSpan = 0;
+    size_t inRegions = countFrameRegions( "repackIn.abc", 5, inSpan );
+    size_t outRegions = countFrameRegions( "repackOut.abc", 5, outSpan );
+
+    std::cout << "Reading frame 5 of " << g_numObjects << " objects"
+              << std::endl
+              << "  object-major: " << inRegions << " regions over "
+              << inSpan << " bytes" << std::endl
+              << "  time-major:   " << outRegions << " regions over "
+              << outSpan << " bytes" << std::endl;
+
+    // the frame itself plus the constant data written with frame 0
+    TESTING_ASSERT( outRegions <= 2 );
+    TESTING_ASSERT( inRegions >= g_numObjects );
+
+    return 0;
+}
@@ -41,6 +41,10 @@
 #include <Alembic/AbcCoreAbstract/All.h>
 #include <Alembic/AbcCoreAbstract/Tests/Assert.h>
 
+#include <Alembic/Util/Tasks.h>
+
+#include <sstream>
+
 namespace Abc = Alembic::Abc;
 using namespace Abc;
 
@@ -404,6 +408,174 @@ void diabolicalInstance( const std::string& iArchiveName, bool useOgawa )
 
 }
 
+//-*****************************************************************************
+size_t countObjects( IObject iObj )
+{
+    size_t count = 1;
+    for ( size_t i = 0; i < iObj.getNumChildren(); ++i )
+    {
+        count += countObjects( iObj.getChild( i ) );
+    }
+    return count;
+}
+
+//-*****************************************************************************
+// Every thread asks the same instanced IObjects for their names, which are
+// built on first use. The objects are all reached up front, since the
+// object readers themselves aren't made to be created from several threads.
+// Every task walks all of the shared objects
+class SharedWalk : public Alembic::Util::Tasks
+{
+public:
+    virtual void run( size_t iIndex )
+    {
+        size_t wrong = 0;
+
+        for ( size_t i = 0; i < geos.size(); ++i )
+        {
+            std::ostringstream name;
+            name << "/scene/g" << i << "/inst/geo";
+
+            const IObject & geo = geos[i];
+            if ( geo.getFullName() != name.str() ||
+                 leaves[i].getFullName() != name.str() + "/leaf" ||
+                 geo.getChild( "leaf" ).getFullName() !=
+                 name.str() + "/leaf" )
+            {
+                ++wrong;
+            }
+        }
+
+        Alembic::Util::scoped_lock l( lock );
+        numWrong += wrong;
+    }
+
+    std::vector< IObject > geos;
+    std::vector< IObject > leaves;
+    size_t numWrong;
+    Alembic::Util::mutex lock;
+};
+
+//-*****************************************************************************
+void manyInstances( const std::string& iArchiveName )
+{
+    /*
+        protos
+           |
+          p0 - p3
+           |    \
+          geo   nested (p0 only, points to /protos/p1/geo)
+           |
+          leaf
+
+        scene
+           |
+          g0 - gN
+           |
+          inst (points to /protos/p[i % 4])
+    */
+
+    const size_t numProtos = 4;
+    const size_t numInstances = 2000;
+
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iArchiveName );
+    OObject protos( archive.getTop(), "protos" );
+
+    std::vector< OObject > geos;
+    for ( size_t i = 0; i < numProtos; ++i )
+    {
+        std::ostringstream name;
+        name << "p" << i;
+        OObject p( protos, name.str() );
+        OObject geo( p, "geo" );
+        OObject leaf( geo, "leaf" );
+        geos.push_back( geo );
+    }
+
+    OObject p0 = protos.getChild( "p0" );
+    TESTING_ASSERT( p0.addChildInstance( geos[1], "nested" ) );
+
+    OObject scene( archive.getTop(), "scene" );
+    for ( size_t i = 0; i < numInstances; ++i )
+    {
+        std::ostringstream name;
+        name << "g" << i;
+        OObject g( scene, name.str() );
+        TESTING_ASSERT( g.addChildInstance(
+            protos.getChild( i % numProtos ), "inst" ) );
+    }
+}
+
+{
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(), iArchiveName );
+    IObject scene = archive.getTop().getChild( "scene" );
+
+    for ( size_t i = 0; i < numInstances; ++i )
+    {
+        std::ostringstream name;
+        name << "/scene/g" << i << "/inst";
+
+        IObject inst = scene.getChild( i ).getChild( "inst" );
+        TESTING_ASSERT( inst.isInstanceRoot() );
+        TESTING_ASSERT( inst.getFullName() == name.str() );
+
+        std::ostringstream source;
+        source << "/protos/p" << i % numProtos;
+        TESTING_ASSERT( inst.instanceSourcePath() == source.str() );
+        TESTING_ASSERT( inst.getPtr()->getFullName() == source.str() );
+
+        IObject leaf = inst.getChild( "geo" ).getChild( "leaf" );
+        TESTING_ASSERT( leaf.isInstanceDescendant() );
+        TESTING_ASSERT( leaf.getFullName() == name.str() + "/geo/leaf" );
+        TESTING_ASSERT( leaf.getParent().getParent().getFullName() ==
+                        name.str() );
+        TESTING_ASSERT( leaf.getParent().getParent().isInstanceRoot() );
+        TESTING_ASSERT( !leaf.getParent().getParent().getParent().
+                        isInstanceDescendant() );
+
+        if ( i % numProtos == 0 )
+        {
+            // an instance inside an instance
+            IObject nestedLeaf = inst.getChild( "nested" ).getChild( 0 );
+            TESTING_ASSERT( nestedLeaf.getFullName() ==
+                            name.str() + "/nested/leaf" );
+            TESTING_ASSERT( nestedLeaf.getPtr()->getFullName() ==
+                            "/protos/p1/geo/leaf" );
+            TESTING_ASSERT( nestedLeaf.getParent().getParent().getName() ==
+                            "inst" );
+        }
+    }
+
+    {
+        IArchive shared( Alembic::AbcCoreOgawa::ReadArchive(),
+                         iArchiveName );
+        IObject sharedScene = shared.getTop().getChild( "scene" );
+
+        SharedWalk walk;
+        walk.numWrong = 0;
+        for ( size_t i = 0; i < numInstances; ++i )
+        {
+            IObject geo = sharedScene.getChild( i ).getChild( "inst" ).
+                getChild( "geo" );
+            walk.geos.push_back( geo );
+            walk.leaves.push_back( geo.getChild( "leaf" ) );
+        }
+
+        Alembic::Util::runTasks( walk, 4, 4 );
+
+        TESTING_ASSERT( walk.numWrong == 0 );
+    }
+
+    // the instance cache follows the archive back out of an object
+    IObject top = scene.getArchive().getTop();
+    TESTING_ASSERT( countObjects( top ) ==
+        1 + 1 + numProtos * 3 + 2 + 1 + numInstances * ( 2 + 2 ) +
+        ( numInstances / numProtos ) * 2 );
+}
+
+}
+
 //-*****************************************************************************
 int main( int argc, char* argv[] )
 {
@@ -423,5 +595,7 @@ int main( int argc, char* argv[] )
     simpleTestIn( harkhive );
     diabolicalInstance( harkhive2, useOgawa );
 
+    manyInstances( "manyinstances_ogawa.abc" );
+
     return 0;
 }
@@ -0,0 +1,337 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCollection/CollectionIndex.h>
+
+#include <Alembic/Util/Tasks.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace AbcCollection {
+namespace ALEMBIC_VERSION_NS {
+
+const size_t CollectionIndex::kNotFound;
+
+namespace {
+
+class ReadCollectionTasks : public Alembic::Util::Tasks
+{
+public:
+    ReadCollectionTasks( CollectionIndex &iIndex ) : m_index( iIndex ) {}
+
+    virtual void run( size_t iIndex )
+    {
+        m_index.readCollection( iIndex );
+    }
+
+private:
+    CollectionIndex &m_index;
+};
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+CollectionIndex::CollectionIndex( ICollectionsSchema iSchema,
+                                  const Abc::ISampleSelector &iSS )
+{
+    update( iSchema, iSS );
+}
+
+//-*****************************************************************************
+bool CollectionIndex::update( ICollectionsSchema iSchema,
+                              const Abc::ISampleSelector &iSS )
+{
+    return update( iSchema, iSS, 1 );
+}
+
+//-*****************************************************************************
+bool CollectionIndex::update( ICollectionsSchema iSchema,
+                              const Abc::ISampleSelector &iSS,
+                              size_t iNumThreads )
+{
+    size_t numCollections = beginUpdate( iSchema, iSS );
+
+    size_t numDirty = 0;
+    for ( size_t i = 0; i < numCollections; ++i )
+    {
+        numDirty += m_collections[i].dirty ? 1 : 0;
+    }
+
+    if ( iNumThreads <= 1 || numDirty <= 1 )
+    {
+        for ( size_t i = 0; i < numCollections; ++i )
+        {
+            readCollection( i );
+        }
+    }
+    else
+    {
+        ReadCollectionTasks tasks( *this );
+
+        try
+        {
+            Alembic::Util::runTasks( tasks, numCollections,
+                                     std::min( iNumThreads, numDirty ) );
+        }
+        catch ( std::exception &exc )
+        {
+            // forget the keys, so the next update reads every collection
+            // again instead of trusting ones that were only partly read
+            for ( size_t i = 0; i < numCollections; ++i )
+            {
+                m_collections[i].keyValid = false;
+            }
+
+            ABCA_THROW( "CollectionIndex::update (): " << exc.what() );
+        }
+    }
+
+    return endUpdate();
+}
+
+//-*****************************************************************************
+size_t CollectionIndex::beginUpdate( ICollectionsSchema iSchema,
+                                     const Abc::ISampleSelector &iSS )
+{
+    size_t numCollections = iSchema.getNumCollections();
+
+    // start over if the collections themselves aren't the same
+    bool sameCollections = ( numCollections == m_collections.size() );
+    for ( size_t i = 0; sameCollections && i < numCollections; ++i )
+    {
+        sameCollections = ( m_collections[i].name ==
+                            iSchema.getCollectionName( i ) );
+    }
+
+    if ( !sameCollections )
+    {
+        m_collections.clear();
+        m_collections.resize( numCollections );
+        m_pathToCollections.clear();
+    }
+
+    for ( size_t i = 0; i < numCollections; ++i )
+    {
+        Collection &col = m_collections[i];
+
+        col.prop = iSchema.getCollection( i );
+        col.name = col.prop.getName();
+        col.sampleIndex = iSS.getIndex( col.prop.getTimeSampling(),
+                                        col.prop.getNumSamples() );
+
+        AbcCoreAbstract::ArraySampleKey key;
+        bool keyValid = col.prop.getKey( key,
+            Abc::ISampleSelector( col.sampleIndex ) );
+
+        // without a key we can't tell whether the sample changed
+        col.dirty = !sameCollections || !keyValid || !col.keyValid ||
+            !( key == col.key );
+
+        col.key = key;
+        col.keyValid = keyValid;
+    }
+
+    return numCollections;
+}
+
+//-*****************************************************************************
+void CollectionIndex::readCollection( size_t iIndex )
+{
+    Collection &col = m_collections[iIndex];
+
+    if ( !col.dirty )
+    {
+        return;
+    }
+
+    col.paths.clear();
+
+    Abc::StringArraySamplePtr samp =
+        col.prop.getValue( Abc::ISampleSelector( col.sampleIndex ) );
+
+    if ( samp )
+    {
+        col.paths.assign( samp->get(), samp->get() + samp->size() );
+    }
+
+    std::sort( col.paths.begin(), col.paths.end() );
+    col.paths.erase( std::unique( col.paths.begin(), col.paths.end() ),
+                     col.paths.end() );
+}
+
+//-*****************************************************************************
+bool CollectionIndex::endUpdate()
+{
+    bool changed = false;
+    for ( size_t i = 0; i < m_collections.size(); ++i )
+    {
+        changed = changed || m_collections[i].dirty;
+        m_collections[i].dirty = false;
+    }
+
+    if ( !changed )
+    {
+        return false;
+    }
+
+    m_pathToCollections.clear();
+    for ( size_t i = 0; i < m_collections.size(); ++i )
+    {
+        const Paths &paths = m_collections[i].paths;
+        for ( Paths::const_iterator p = paths.begin(); p != paths.end(); ++p )
+        {
+            m_pathToCollections[*p].push_back( i );
+        }
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+size_t CollectionIndex::getCollectionIndex( const std::string &iName ) const
+{
+    for ( size_t i = 0; i < m_collections.size(); ++i )
+    {
+        if ( m_collections[i].name == iName )
+        {
+            return i;
+        }
+    }
+
+    return kNotFound;
+}
+
+//-*****************************************************************************
+const CollectionIndex::CollectionIndices &
+CollectionIndex::getCollections( const std::string &iPath ) const
+{
+    PathMap::const_iterator it = m_pathToCollections.find( iPath );
+    if ( it != m_pathToCollections.end() )
+    {
+        return it->second;
+    }
+
+    static const CollectionIndices empty;
+    return empty;
+}
+
+//-*****************************************************************************
+void CollectionIndex::getCollectionsIncludingAncestors(
+    const std::string &iPath, CollectionIndices &oIndices ) const
+{
+    oIndices.clear();
+
+    std::string path = iPath;
+    while ( !path.empty() )
+    {
+        const CollectionIndices &indices = getCollections( path );
+        oIndices.insert( oIndices.end(), indices.begin(), indices.end() );
+
+        size_t pos = path.rfind( '/' );
+        if ( pos == std::string::npos || path == "/" )
+        {
+            break;
+        }
+
+        // the parent of "/a" is "/"
+        path.resize( pos == 0 ? 1 : pos );
+    }
+
+    std::sort( oIndices.begin(), oIndices.end() );
+    oIndices.erase( std::unique( oIndices.begin(), oIndices.end() ),
+                    oIndices.end() );
+}
+
+//-*****************************************************************************
+bool CollectionIndex::contains( size_t iIndex, const std::string &iPath ) const
+{
+    const Paths &paths = m_collections[iIndex].paths;
+    return std::binary_search( paths.begin(), paths.end(), iPath );
+}
+
+//-*****************************************************************************
+void CollectionIndex::getSubtreeRange( size_t iIndex,
+                                       const std::string &iPath,
+                                       Range &oExact, Range &oBelow ) const
+{
+    const Paths &paths = m_collections[iIndex].paths;
+
+    oExact = std::equal_range( paths.begin(), paths.end(), iPath );
+
+    // Everything below the root sorts after "/" itself and before "0", '0'
+    // being the character after '/'. Appending a '/' to the root would
+    // look for paths starting with "//" instead.
+    if ( iPath == "/" )
+    {
+        oBelow.first = oExact.second;
+        oBelow.second = std::lower_bound( oBelow.first, paths.end(),
+                                          std::string( "0" ) );
+        return;
+    }
+
+    // Everything below iPath sorts between iPath + "/" and iPath + "0".
+    std::string below = iPath + '/';
+    std::string end = iPath + '0';
+
+    oBelow.first = std::lower_bound( paths.begin(), paths.end(), below );
+    oBelow.second = std::lower_bound( oBelow.first, paths.end(), end );
+}
+
+//-*****************************************************************************
+void CollectionIndex::getPathsUnder( size_t iIndex, const std::string &iPath,
+                                     Paths &oPaths ) const
+{
+    Range exact, below;
+    getSubtreeRange( iIndex, iPath, exact, below );
+
+    oPaths.assign( exact.first, exact.second );
+    oPaths.insert( oPaths.end(), below.first, below.second );
+}
+
+//-*****************************************************************************
+bool CollectionIndex::hasPathsUnder( size_t iIndex,
+                                     const std::string &iPath ) const
+{
+    Range exact, below;
+    getSubtreeRange( iIndex, iPath, exact, below );
+
+    return exact.first != exact.second || below.first != below.second;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCollection
+} // End namespace Alembic
@@ -0,0 +1,164 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCollections_CollectionIndex_h_
+#define _Alembic_AbcCollections_CollectionIndex_h_
+
+#include <Alembic/AbcCollection/ICollections.h>
+
+namespace Alembic {
+namespace AbcCollection {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! A lookup structure built from one sample of an ICollectionsSchema, for
+//! answering which collections contain a path, or which paths of a
+//! collection lie under a given object, without scanning every collection.
+//!
+//! update() only re-reads collections whose ArraySampleKey changed, so the
+//! index can be kept around and updated every frame. Reading the
+//! collections is the bulk of the work, so update can spread it over
+//! several threads, or it can be done in stages, with readCollection
+//! called for different collections on the caller's own threads between
+//! beginUpdate and endUpdate.
+class CollectionIndex
+{
+public:
+    typedef std::vector<size_t> CollectionIndices;
+    typedef std::vector<std::string> Paths;
+
+    static const size_t kNotFound = ~size_t( 0 );
+
+    CollectionIndex() {}
+
+    //! Builds the index for the collections of iSchema at iSS.
+    explicit CollectionIndex( ICollectionsSchema iSchema,
+        const Abc::ISampleSelector &iSS = Abc::ISampleSelector() );
+
+    //! Brings the index up to date with the collections of iSchema at iSS.
+    //! Returns true if any collection changed.
+    bool update( ICollectionsSchema iSchema,
+        const Abc::ISampleSelector &iSS = Abc::ISampleSelector() );
+
+    //! As above, but the changed collections are read on up to
+    //! iNumThreads threads (the calling thread included), which needs an
+    //! archive reader that allows concurrent reads (Ogawa does, HDF5
+    //! doesn't). The reads are spread out with Alembic::Util::runTasks.
+    bool update( ICollectionsSchema iSchema,
+                 const Abc::ISampleSelector &iSS,
+                 size_t iNumThreads );
+
+    //! Reads the sample keys of the collections at iSS and returns the
+    //! number of collections. readCollection must then be called for each
+    //! of them, followed by endUpdate.
+    size_t beginUpdate( ICollectionsSchema iSchema,
+                        const Abc::ISampleSelector &iSS );
+
+    //! Reads and sorts collection iIndex if its sample changed. Different
+    //! indices can be read at the same time, as long as the archive reader
+    //! allows concurrent reads (Ogawa does, HDF5 doesn't).
+    void readCollection( size_t iIndex );
+
+    //! Rebuilds the path lookup if any collection changed, which it
+    //! returns.
+    bool endUpdate();
+
+    size_t getNumCollections() const { return m_collections.size(); }
+
+    const std::string &getCollectionName( size_t iIndex ) const
+    { return m_collections[iIndex].name; }
+
+    //! Returns the index of the named collection, or kNotFound.
+    size_t getCollectionIndex( const std::string &iName ) const;
+
+    //! The paths in collection iIndex, sorted and without duplicates.
+    const Paths &getPaths( size_t iIndex ) const
+    { return m_collections[iIndex].paths; }
+
+    //! The indices of the collections containing iPath, in increasing
+    //! order. Empty if no collection contains it.
+    const CollectionIndices &getCollections( const std::string &iPath ) const;
+
+    //! Fills oIndices with the collections containing iPath or any of its
+    //! ancestors, in increasing order.
+    void getCollectionsIncludingAncestors( const std::string &iPath,
+                                           CollectionIndices &oIndices ) const;
+
+    //! Returns whether collection iIndex contains iPath.
+    bool contains( size_t iIndex, const std::string &iPath ) const;
+
+    //! Fills oPaths with the paths of collection iIndex that are iPath or
+    //! lie below it, in sorted order. Everything lies below "/".
+    void getPathsUnder( size_t iIndex, const std::string &iPath,
+                        Paths &oPaths ) const;
+
+    //! Returns whether collection iIndex contains iPath or anything below it.
+    bool hasPathsUnder( size_t iIndex, const std::string &iPath ) const;
+
+private:
+    typedef std::pair< Paths::const_iterator, Paths::const_iterator > Range;
+
+    void getSubtreeRange( size_t iIndex, const std::string &iPath,
+                          Range &oExact, Range &oBelow ) const;
+
+    struct Collection
+    {
+        Collection() : keyValid( false ), dirty( false ) {}
+
+        std::string name;
+        Abc::IStringArrayProperty prop;
+        AbcCoreAbstract::index_t sampleIndex;
+        AbcCoreAbstract::ArraySampleKey key;
+        bool keyValid;
+        bool dirty;
+        Paths paths;
+    };
+
+    std::vector<Collection> m_collections;
+
+    typedef Alembic::Util::unordered_map< std::string, CollectionIndices >
+        PathMap;
+    PathMap m_pathToCollections;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCollection
+} // End namespace Alembic
+
+#endif
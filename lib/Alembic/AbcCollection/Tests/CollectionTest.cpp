@@ -36,10 +36,13 @@
 
 #include <Alembic/Abc/All.h>
 #include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
 #include <Alembic/AbcCollection/All.h>
 
 #include <Alembic/AbcCoreAbstract/Tests/Assert.h>
 
+#include <sstream>
+
 
 namespace Abc =  Alembic::Abc;
 namespace AbcCol = Alembic::AbcCollection;
@@ -124,10 +127,181 @@ void read()
     TESTING_ASSERT((*samp)[2] == "/a/b/c/3");
 }
 
+void indexTest()
+{
+    {
+        Abc::OArchive archive(Alembic::AbcCoreHDF5::WriteArchive(),
+            "CollectionIndex.abc");
+        Abc::OObject root(archive, Abc::kTop);
+
+        AbcA::TimeSamplingPtr ts(new AbcA::TimeSampling(1/24.0, 0.0));
+        AbcCol::OCollections group(root, "layers");
+
+        std::vector< std::string > strVec;
+        strVec.push_back("/z");
+        strVec.push_back("/a/b/c");
+        strVec.push_back("/a/bx");
+        strVec.push_back("/a/b");
+        strVec.push_back("/a/b/c");
+        group.getSchema().createCollection("lights").set(
+            Abc::StringArraySample(strVec));
+
+        Abc::OStringArrayProperty geo =
+            group.getSchema().createCollection("geo", AbcA::MetaData(), ts);
+
+        strVec.clear();
+        strVec.push_back("/q");
+        strVec.push_back("/a/b/c");
+        geo.set(Abc::StringArraySample(strVec));
+        geo.set(Abc::StringArraySample(strVec));
+
+        strVec.push_back("/a/bx/y");
+        geo.set(Abc::StringArraySample(strVec));
+    }
+
+    Abc::IArchive archive(Alembic::AbcCoreHDF5::ReadArchive(),
+        "CollectionIndex.abc");
+    AbcCol::ICollections group(archive.getTop(), "layers");
+
+    AbcCol::CollectionIndex index(group.getSchema(), Abc::ISampleSelector(
+        (AbcA::index_t) 0));
+    TESTING_ASSERT(index.getNumCollections() == 2);
+
+    size_t lights = index.getCollectionIndex("lights");
+    size_t geo = index.getCollectionIndex("geo");
+    TESTING_ASSERT(lights != AbcCol::CollectionIndex::kNotFound);
+    TESTING_ASSERT(geo != AbcCol::CollectionIndex::kNotFound);
+    TESTING_ASSERT(index.getCollectionIndex("potato") ==
+        AbcCol::CollectionIndex::kNotFound);
+
+    // sorted and without duplicates
+    TESTING_ASSERT(index.getPaths(lights).size() == 4);
+    TESTING_ASSERT(index.getPaths(lights)[0] == "/a/b");
+    TESTING_ASSERT(index.getPaths(lights)[3] == "/z");
+
+    TESTING_ASSERT(index.getCollections("/a/b/c").size() == 2);
+    TESTING_ASSERT(index.getCollections("/z").size() == 1);
+    TESTING_ASSERT(index.getCollections("/z")[0] == lights);
+    TESTING_ASSERT(index.getCollections("/nope").empty());
+
+    TESTING_ASSERT(index.contains(geo, "/q"));
+    TESTING_ASSERT(!index.contains(geo, "/z"));
+
+    AbcCol::CollectionIndex::CollectionIndices indices;
+    index.getCollectionsIncludingAncestors("/q/r/s", indices);
+    TESTING_ASSERT(indices.size() == 1 && indices[0] == geo);
+    index.getCollectionsIncludingAncestors("/a/b/c/d", indices);
+    TESTING_ASSERT(indices.size() == 2);
+    index.getCollectionsIncludingAncestors("/a/bx", indices);
+    TESTING_ASSERT(indices.size() == 1 && indices[0] == lights);
+
+    // "/a/bx" sorts between "/a/b" and "/a/b/c" but isn't below "/a/b"
+    AbcCol::CollectionIndex::Paths paths;
+    index.getPathsUnder(lights, "/a/b", paths);
+    TESTING_ASSERT(paths.size() == 2);
+    TESTING_ASSERT(paths[0] == "/a/b" && paths[1] == "/a/b/c");
+    index.getPathsUnder(lights, "/", paths);
+    TESTING_ASSERT(paths.size() == 4);
+    index.getPathsUnder(lights, "/a/b/c/d", paths);
+    TESTING_ASSERT(paths.empty());
+
+    TESTING_ASSERT(index.hasPathsUnder(geo, "/a"));
+    TESTING_ASSERT(!index.hasPathsUnder(geo, "/a/bx"));
+
+    // the second sample is identical to the first
+    TESTING_ASSERT(!index.update(group.getSchema(),
+        Abc::ISampleSelector((AbcA::index_t) 1)));
+
+    TESTING_ASSERT(index.update(group.getSchema(),
+        Abc::ISampleSelector((AbcA::index_t) 2)));
+    TESTING_ASSERT(index.hasPathsUnder(geo, "/a/bx"));
+    TESTING_ASSERT(index.getCollections("/a/bx/y").size() == 1);
+
+    // staged, as it would be done with one collection per thread
+    AbcCol::CollectionIndex staged;
+    size_t numCollections = staged.beginUpdate(group.getSchema(),
+        Abc::ISampleSelector((AbcA::index_t) 2));
+    for (size_t i = numCollections; i > 0; --i)
+    {
+        staged.readCollection(i - 1);
+    }
+    TESTING_ASSERT(staged.endUpdate());
+    TESTING_ASSERT(staged.getPaths(geo) == index.getPaths(geo));
+    TESTING_ASSERT(staged.getPaths(lights) == index.getPaths(lights));
+}
+
+void threadedIndexTest()
+{
+    const size_t numCollections = 12;
+    {
+        Abc::OArchive archive(Alembic::AbcCoreOgawa::WriteArchive(),
+            "CollectionIndexThreaded.abc");
+        Abc::OObject root(archive, Abc::kTop);
+        AbcCol::OCollections group(root, "layers");
+
+        AbcA::TimeSamplingPtr ts(new AbcA::TimeSampling(1/24.0, 0.0));
+
+        for (size_t i = 0; i < numCollections; ++i)
+        {
+            std::ostringstream name;
+            name << "col" << i;
+            Abc::OStringArrayProperty prop =
+                group.getSchema().createCollection(name.str(),
+                    AbcA::MetaData(), ts);
+
+            for (size_t s = 0; s < 2; ++s)
+            {
+                std::vector<std::string> strVec;
+                strVec.push_back("/");
+                for (size_t j = 0; j < 50 + i + s; ++j)
+                {
+                    std::ostringstream path;
+                    path << "/obj" << j % 7 << "/child" << j;
+                    strVec.push_back(path.str());
+                }
+                prop.set(Abc::StringArraySample(strVec));
+            }
+        }
+    }
+
+    Abc::IArchive archive(Alembic::AbcCoreOgawa::ReadArchive(),
+        "CollectionIndexThreaded.abc");
+    AbcCol::ICollections group(archive.getTop(), "layers");
+
+    for (AbcA::index_t s = 0; s < 2; ++s)
+    {
+        AbcCol::CollectionIndex serial(group.getSchema(),
+            Abc::ISampleSelector(s));
+
+        AbcCol::CollectionIndex threaded;
+        TESTING_ASSERT(threaded.update(group.getSchema(),
+            Abc::ISampleSelector(s), 4));
+        TESTING_ASSERT(threaded.getNumCollections() == numCollections);
+
+        for (size_t i = 0; i < numCollections; ++i)
+        {
+            TESTING_ASSERT(threaded.getPaths(i) == serial.getPaths(i));
+            TESTING_ASSERT(threaded.getPaths(i).size() == 51 + i + s);
+
+            // the root is listed once, followed by everything below it
+            AbcCol::CollectionIndex::Paths paths;
+            threaded.getPathsUnder(i, "/", paths);
+            TESTING_ASSERT(paths == threaded.getPaths(i));
+            TESTING_ASSERT(paths[0] == "/" && paths[1] != "/");
+        }
+
+        TESTING_ASSERT(threaded.getCollections("/").size() == numCollections);
+        TESTING_ASSERT(!threaded.update(group.getSchema(),
+            Abc::ISampleSelector(s), 4));
+    }
+}
+
 int main(int argc, char *argv[])
 {
     write();
     read();
+    indexTest();
+    threadedIndexTest();
     return 0;
 }
 
@@ -46,6 +46,18 @@ ArchiveReader::~ArchiveReader()
     // Nothing
 }
 
+//-*****************************************************************************
+ArraySampleAllocatorPtr ArchiveReader::getArraySampleAllocatorPtr()
+{
+    return ArraySampleAllocatorPtr();
+}
+
+//-*****************************************************************************
+void ArchiveReader::setArraySampleAllocatorPtr( ArraySampleAllocatorPtr iPtr )
+{
+    // Nothing
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
@@ -40,6 +40,7 @@
 #include <Alembic/AbcCoreAbstract/Foundation.h>
 #include <Alembic/AbcCoreAbstract/ForwardDeclarations.h>
 #include <Alembic/AbcCoreAbstract/ReadArraySampleCache.h>
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
 
 namespace Alembic {
 namespace AbcCoreAbstract {
@@ -105,6 +106,16 @@ public:
     //! will be disabled if a NULL cache is passed here.
     virtual void setReadArraySampleCachePtr( ReadArraySampleCachePtr iPtr ) = 0;
 
+    //! Get the allocator that array samples are read into. A NULL pointer
+    //! means the default heap allocation is used, which is all the default
+    //! implementation supports.
+    virtual ArraySampleAllocatorPtr getArraySampleAllocatorPtr();
+
+    //! Set the allocator that array samples are read into, or NULL for the
+    //! default heap allocation. Implementations are free to ignore it, as
+    //! the default implementation does.
+    virtual void setArraySampleAllocatorPtr( ArraySampleAllocatorPtr iPtr );
+
     //! Returns the TimeSampling at a given index.
     virtual TimeSamplingPtr getTimeSampling( uint32_t iIndex ) = 0;
 
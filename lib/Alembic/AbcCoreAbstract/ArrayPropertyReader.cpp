@@ -46,6 +46,25 @@ ArrayPropertyReader::~ArrayPropertyReader()
     // Nothing
 }
 
+//-*****************************************************************************
+bool ArrayPropertyReader::isChangedSince( index_t iPrevSampleIndex,
+                                          index_t iSampleIndex )
+{
+    if ( iPrevSampleIndex == iSampleIndex || isConstant() )
+    {
+        return false;
+    }
+
+    ArraySampleKey prevKey;
+    ArraySampleKey key;
+    if ( !getKey( iPrevSampleIndex, prevKey ) || !getKey( iSampleIndex, key ) )
+    {
+        return true;
+    }
+
+    return !( prevKey == key );
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
@@ -110,6 +110,14 @@ public:
     //! Expose the key for apps that use their own custom cache management.
     virtual bool getKey( index_t iSampleIndex, ArraySampleKey & oKey ) = 0;
 
+    //! Returns whether the sample at iSampleIndex may differ from the one
+    //! at iPrevSampleIndex, so readers stepping through the samples can
+    //! skip rereading data which didn't change. The default compares the
+    //! keys; implementations which know the first and last changed
+    //! indices can often answer without reading anything.
+    virtual bool isChangedSince( index_t iPrevSampleIndex,
+                                 index_t iSampleIndex );
+
     //! The ArraySample may have incorrect dimensions, (even though the packed
     //! data will be correct) expose the correct dimensions here for those
     //! clients that need it.
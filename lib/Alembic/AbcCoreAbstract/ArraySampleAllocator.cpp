@@ -0,0 +1,393 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
+
+#include <algorithm>
+#include <new>
+
+// The tr1 shared_ptr can't allocate its control block through an allocator
+#if defined( _MSC_VER ) || defined( __GXX_EXPERIMENTAL_CXX0X ) || \
+    __cplusplus >= 201103L
+#define ALEMBIC_SHARED_PTR_ALLOCATOR 1
+#endif
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+ArraySampleAllocator::~ArraySampleAllocator()
+{
+    // Nothing
+}
+
+namespace { // anonymous
+
+//-*****************************************************************************
+// The sample data starts after the ArraySample, keeping its alignment.
+static const size_t kSampleHeaderSize =
+    ( sizeof( ArraySample ) + 15 ) & ~( size_t )15;
+
+//-*****************************************************************************
+// Only the string PODs need their elements constructed and destroyed.
+template <class T>
+struct NeedsConstruction { static const bool value = false; };
+
+template <>
+struct NeedsConstruction<string> { static const bool value = true; };
+
+template <>
+struct NeedsConstruction<wstring> { static const bool value = true; };
+
+//-*****************************************************************************
+// Hands shared_ptr control blocks out of an ArraySampleAllocator.
+template <class T>
+class AllocatorAdaptor
+{
+public:
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind { typedef AllocatorAdaptor<U> other; };
+
+    explicit AllocatorAdaptor( ArraySampleAllocatorPtr iAllocator )
+      : m_allocator( iAllocator ) {}
+
+    template <class U>
+    AllocatorAdaptor( const AllocatorAdaptor<U> &iCopy )
+      : m_allocator( iCopy.getAllocator() ) {}
+
+    T *allocate( size_t iNum, const void * = 0 )
+    {
+        return static_cast<T *>( m_allocator->allocate( iNum * sizeof( T ) ) );
+    }
+
+    void deallocate( T *iPtr, size_t iNum )
+    {
+        m_allocator->deallocate( iPtr, iNum * sizeof( T ) );
+    }
+
+    void construct( T *iPtr, const T &iVal ) { new ( iPtr ) T( iVal ); }
+
+    void destroy( T *iPtr ) { iPtr->~T(); }
+
+    size_t max_size() const { return ~size_t( 0 ) / sizeof( T ); }
+
+    ArraySampleAllocatorPtr getAllocator() const { return m_allocator; }
+
+    template <class U>
+    bool operator==( const AllocatorAdaptor<U> &iRhs ) const
+    { return m_allocator == iRhs.getAllocator(); }
+
+    template <class U>
+    bool operator!=( const AllocatorAdaptor<U> &iRhs ) const
+    { return m_allocator != iRhs.getAllocator(); }
+
+private:
+    ArraySampleAllocatorPtr m_allocator;
+};
+
+//-*****************************************************************************
+template <class T>
+struct TAllocatorDeleter
+{
+    TAllocatorDeleter( ArraySampleAllocatorPtr iAllocator,
+                       size_t iNumPODs, size_t iNumBytes )
+      : allocator( iAllocator ), numPODs( iNumPODs ), numBytes( iNumBytes )
+    {}
+
+    void operator()( ArraySample *iSample ) const
+    {
+        if ( NeedsConstruction<T>::value )
+        {
+            T *data = reinterpret_cast<T*>(
+                const_cast<void*>( iSample->getData() ) );
+
+            for ( size_t i = 0; i < numPODs; ++i )
+            {
+                data[i].~T();
+            }
+        }
+
+        iSample->~ArraySample();
+        allocator->deallocate( iSample, numBytes );
+    }
+
+    ArraySampleAllocatorPtr allocator;
+    size_t numPODs;
+    size_t numBytes;
+};
+
+//-*****************************************************************************
+template <class T>
+ArraySamplePtr TAllocateArraySample( size_t iDataTypeExtent,
+                                     const Dimensions &iDims,
+                                     ArraySampleAllocatorPtr iAllocator )
+{
+    DataType dtype( PODTraitsFromType<T>::pod_enum, iDataTypeExtent );
+    size_t numPODs = iDims.numPoints() * iDataTypeExtent;
+    size_t numBytes = kSampleHeaderSize + numPODs * sizeof( T );
+
+    char *memory = static_cast<char *>( iAllocator->allocate( numBytes ) );
+    ABCA_ASSERT( memory, "ArraySampleAllocator failed to allocate "
+                 << numBytes << " bytes" );
+
+    T *data = NULL;
+    if ( numPODs > 0 )
+    {
+        data = reinterpret_cast<T *>( memory + kSampleHeaderSize );
+
+        // left uninitialized, like new T[], unless T is a string
+        if ( NeedsConstruction<T>::value )
+        {
+            for ( size_t i = 0; i < numPODs; ++i )
+            {
+                new ( data + i ) T;
+            }
+        }
+    }
+
+    ArraySample *sample = new ( memory ) ArraySample(
+        reinterpret_cast<const void *>( data ), dtype, iDims );
+
+    TAllocatorDeleter<T> deleter( iAllocator, numPODs, numBytes );
+
+#ifdef ALEMBIC_SHARED_PTR_ALLOCATOR
+    return ArraySamplePtr( sample, deleter,
+                           AllocatorAdaptor<char>( iAllocator ) );
+#else
+    return ArraySamplePtr( sample, deleter );
+#endif
+}
+
+} // End namespace anonymous
+
+//-*****************************************************************************
+ArraySamplePtr AllocateArraySample( const DataType &iDtype,
+                                    const Dimensions &iDims,
+                                    ArraySampleAllocatorPtr iAllocator )
+{
+    if ( !iAllocator )
+    {
+        return AllocateArraySample( iDtype, iDims );
+    }
+
+    size_t extent = iDtype.getExtent();
+
+    switch ( iDtype.getPod() )
+    {
+    case kBooleanPOD:
+        return TAllocateArraySample<bool_t>( extent, iDims, iAllocator );
+
+    case kUint8POD:
+        return TAllocateArraySample<uint8_t>( extent, iDims, iAllocator );
+    case kInt8POD:
+        return TAllocateArraySample<int8_t>( extent, iDims, iAllocator );
+
+    case kUint16POD:
+        return TAllocateArraySample<uint16_t>( extent, iDims, iAllocator );
+    case kInt16POD:
+        return TAllocateArraySample<int16_t>( extent, iDims, iAllocator );
+
+    case kUint32POD:
+        return TAllocateArraySample<uint32_t>( extent, iDims, iAllocator );
+    case kInt32POD:
+        return TAllocateArraySample<int32_t>( extent, iDims, iAllocator );
+
+    case kUint64POD:
+        return TAllocateArraySample<uint64_t>( extent, iDims, iAllocator );
+    case kInt64POD:
+        return TAllocateArraySample<int64_t>( extent, iDims, iAllocator );
+
+    case kFloat16POD:
+        return TAllocateArraySample<float16_t>( extent, iDims, iAllocator );
+    case kFloat32POD:
+        return TAllocateArraySample<float32_t>( extent, iDims, iAllocator );
+    case kFloat64POD:
+        return TAllocateArraySample<float64_t>( extent, iDims, iAllocator );
+
+    case kStringPOD:
+        return TAllocateArraySample<string>( extent, iDims, iAllocator );
+    case kWstringPOD:
+        return TAllocateArraySample<wstring>( extent, iDims, iAllocator );
+
+    default:
+        return ArraySamplePtr();
+    }
+}
+
+//-*****************************************************************************
+ArraySampleArena::ArraySampleArena( size_t iBlockSize )
+  : m_blockSize( iBlockSize )
+  , m_current( 0 )
+  , m_used( 0 )
+  , m_numLive( 0 )
+{
+    ABCA_ASSERT( iBlockSize > 0, "ArraySampleArena needs a block size" );
+}
+
+//-*****************************************************************************
+ArraySampleArena::~ArraySampleArena()
+{
+    // Every sample keeps its allocator alive, so nothing can be live here.
+    for ( size_t i = 0; i < m_blocks.size(); ++i )
+    {
+        freeBlock( m_blocks[i].memory, m_blocks[i].size );
+    }
+}
+
+//-*****************************************************************************
+void *ArraySampleArena::allocate( size_t iNumBytes )
+{
+    size_t numBytes = ( iNumBytes + 15 ) & ~( size_t )15;
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    // look for room in the current block and the ones after it, which
+    // after a reset are left over from the previous frame
+    while ( m_current < m_blocks.size() &&
+            m_blocks[m_current].size - m_used < numBytes )
+    {
+        ++m_current;
+        m_used = 0;
+    }
+
+    if ( m_current == m_blocks.size() )
+    {
+        Block block;
+        block.size = std::max( m_blockSize, numBytes );
+        block.memory = static_cast<char *>( allocateBlock( block.size ) );
+        ABCA_ASSERT( block.memory, "ArraySampleArena failed to allocate "
+                     << block.size << " bytes" );
+
+        m_blocks.push_back( block );
+        m_used = 0;
+    }
+
+    void *ret = m_blocks[m_current].memory + m_used;
+    m_used += numBytes;
+    ++m_numLive;
+    return ret;
+}
+
+//-*****************************************************************************
+void ArraySampleArena::deallocate( void *iMemory, size_t iNumBytes )
+{
+    if ( iMemory )
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        --m_numLive;
+    }
+}
+
+//-*****************************************************************************
+bool ArraySampleArena::reset()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    if ( m_numLive > 0 )
+    {
+        return false;
+    }
+
+    m_current = 0;
+    m_used = 0;
+    return true;
+}
+
+//-*****************************************************************************
+bool ArraySampleArena::release()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    if ( m_numLive > 0 )
+    {
+        return false;
+    }
+
+    for ( size_t i = 0; i < m_blocks.size(); ++i )
+    {
+        freeBlock( m_blocks[i].memory, m_blocks[i].size );
+    }
+
+    m_blocks.clear();
+    m_current = 0;
+    m_used = 0;
+    return true;
+}
+
+//-*****************************************************************************
+size_t ArraySampleArena::getNumLiveAllocations() const
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return m_numLive;
+}
+
+//-*****************************************************************************
+size_t ArraySampleArena::getNumBytesReserved() const
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    size_t total = 0;
+    for ( size_t i = 0; i < m_blocks.size(); ++i )
+    {
+        total += m_blocks[i].size;
+    }
+    return total;
+}
+
+//-*****************************************************************************
+void *ArraySampleArena::allocateBlock( size_t iNumBytes )
+{
+    return malloc( iNumBytes );
+}
+
+//-*****************************************************************************
+void ArraySampleArena::freeBlock( void *iMemory, size_t iNumBytes )
+{
+    free( iMemory );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
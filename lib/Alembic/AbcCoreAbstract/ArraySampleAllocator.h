@@ -0,0 +1,145 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreAbstract_ArraySampleAllocator_h_
+#define _Alembic_AbcCoreAbstract_ArraySampleAllocator_h_
+
+#include <Alembic/AbcCoreAbstract/Foundation.h>
+#include <Alembic/AbcCoreAbstract/ArraySample.h>
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! An ArraySampleAllocator provides the memory for the array samples read
+//! from an archive. It can be set on an ArchiveReader so that, for
+//! instance, all the samples of a frame come out of an arena that is
+//! recycled once the frame is done with, rather than from the global heap.
+//! A single block is requested per sample, holding the ArraySample and its
+//! data, and the shared_ptr bookkeeping is allocated from it as well where
+//! the shared_ptr implementation supports allocators.
+//! Allocators must be safe to call from several threads at once.
+class ArraySampleAllocator : private Alembic::Util::noncopyable
+{
+public:
+    virtual ~ArraySampleAllocator();
+
+    //! Returns iNumBytes of memory aligned to at least 16 bytes.
+    virtual void *allocate( size_t iNumBytes ) = 0;
+
+    //! Gives back memory obtained from allocate, iNumBytes is the size
+    //! that was asked for.
+    virtual void deallocate( void *iMemory, size_t iNumBytes ) = 0;
+};
+
+typedef Alembic::Util::shared_ptr<ArraySampleAllocator>
+    ArraySampleAllocatorPtr;
+
+//-*****************************************************************************
+//! Same as AllocateArraySample above, but the memory comes from
+//! iAllocator, which is kept alive until the returned sample is freed.
+//! A NULL allocator uses the default allocation.
+ArraySamplePtr AllocateArraySample( const DataType &iDtype,
+                                    const Dimensions &iDims,
+                                    ArraySampleAllocatorPtr iAllocator );
+
+//-*****************************************************************************
+//! A per-frame arena. Memory is handed out from large blocks by bumping a
+//! pointer and deallocate only keeps count, so reading a frame costs a
+//! handful of block allocations at most. Once every sample from the arena
+//! has been released, reset() recycles the blocks for the next frame.
+//! Derived classes can override allocateBlock and freeBlock to back the
+//! arena with huge pages or NUMA local memory, in which case their
+//! destructor should call release().
+class ArraySampleArena : public ArraySampleAllocator
+{
+public:
+    //! iBlockSize is the size of the blocks requested from allocateBlock,
+    //! larger requests get a block of their own.
+    explicit ArraySampleArena( size_t iBlockSize = 4 * 1024 * 1024 );
+
+    virtual ~ArraySampleArena();
+
+    virtual void *allocate( size_t iNumBytes );
+
+    virtual void deallocate( void *iMemory, size_t iNumBytes );
+
+    //! Makes all the memory available again. This only happens if no
+    //! allocation is outstanding, otherwise false is returned and nothing
+    //! changes.
+    bool reset();
+
+    //! Releases all blocks, with the same condition as reset.
+    bool release();
+
+    //! The number of allocations that haven't been given back.
+    size_t getNumLiveAllocations() const;
+
+    //! The total size of the blocks held by the arena.
+    size_t getNumBytesReserved() const;
+
+protected:
+    virtual void *allocateBlock( size_t iNumBytes );
+
+    virtual void freeBlock( void *iMemory, size_t iNumBytes );
+
+private:
+    struct Block
+    {
+        char *memory;
+        size_t size;
+    };
+
+    size_t m_blockSize;
+
+    //! Blocks before m_current are full, m_current is being filled.
+    std::vector<Block> m_blocks;
+    size_t m_current;
+    size_t m_used;
+
+    size_t m_numLive;
+    mutable Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
+
+#endif
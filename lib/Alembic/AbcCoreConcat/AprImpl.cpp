@@ -0,0 +1,262 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/AprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+AprImpl::AprImpl( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader )
+  : m_data( iParent, iHeader )
+  , m_constantKnown( false )
+  , m_constant( false )
+  , m_scalarLikeKnown( false )
+  , m_scalarLike( false )
+{
+    if ( iHeader.getPropertyType() != AbcA::kArrayProperty )
+    {
+        ABCA_THROW( "Attempted to create a ArrayPropertyReader from a "
+                    "non-array property type" );
+    }
+}
+
+//-*****************************************************************************
+const AbcA::PropertyHeader & AprImpl::getHeader() const
+{
+    return m_data.getHeader();
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr AprImpl::getObject()
+{
+    return m_data.getParent()->getObject();
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr AprImpl::getParent()
+{
+    return m_data.getParent();
+}
+
+//-*****************************************************************************
+AbcA::ArrayPropertyReaderPtr AprImpl::asArrayPtr()
+{
+    return shared_from_this();
+}
+
+//-*****************************************************************************
+size_t AprImpl::getNumSamples()
+{
+    return m_data.getNumSamples();
+}
+
+//-*****************************************************************************
+bool AprImpl::isConstant()
+{
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        if ( m_constantKnown )
+        {
+            return m_constant;
+        }
+    }
+
+    // a first chunk which changes settles it without opening the others
+    bool constant = m_data.getFirst()->asArrayPtr()->isConstant() &&
+        computeIsConstant();
+
+    Alembic::Util::scoped_lock l( m_lock );
+    m_constant = constant;
+    m_constantKnown = true;
+    return constant;
+}
+
+//-*****************************************************************************
+bool AprImpl::computeIsConstant()
+{
+    AbcA::ArraySampleKey firstKey;
+    size_t numStarts = m_data.getNumChunkStarts();
+    for ( size_t i = 0; i < numStarts; ++i )
+    {
+        index_t start = 0;
+        AbcA::ArrayPropertyReaderPtr chunk =
+            m_data.getChunkStart( i, start )->asArrayPtr();
+        if ( !chunk->isConstant() )
+        {
+            return false;
+        }
+
+        // every chunk is constant, so compare the first sample of each
+        AbcA::ArraySampleKey key;
+        if ( !chunk->getKey( start, key ) )
+        {
+            return false;
+        }
+
+        if ( i == 0 )
+        {
+            firstKey = key;
+        }
+        else if ( !( key == firstKey ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+void AprImpl::getSample( index_t iSampleIndex, AbcA::ArraySamplePtr &oSample )
+{
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+    chunk->asArrayPtr()->getSample( index, oSample );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> AprImpl::getFloorIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getFloorIndex( iTime,
+        getNumSamples() );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> AprImpl::getCeilIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getCeilIndex( iTime,
+        getNumSamples() );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> AprImpl::getNearIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getNearIndex( iTime,
+        getNumSamples() );
+}
+
+//-*****************************************************************************
+bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey )
+{
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+    return chunk->asArrayPtr()->getKey( index, oKey );
+}
+
+//-*****************************************************************************
+bool AprImpl::isChangedSince( index_t iPrevSampleIndex, index_t iSampleIndex )
+{
+    index_t prevIndex = 0;
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr prevChunk =
+        m_data.getSample( iPrevSampleIndex, prevIndex );
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+
+    // the chunk may know without reading anything
+    if ( prevChunk == chunk )
+    {
+        return chunk->asArrayPtr()->isChangedSince( prevIndex, index );
+    }
+
+    AbcA::ArraySampleKey prevKey;
+    AbcA::ArraySampleKey key;
+    if ( !prevChunk->asArrayPtr()->getKey( prevIndex, prevKey ) ||
+         !chunk->asArrayPtr()->getKey( index, key ) )
+    {
+        return true;
+    }
+
+    return !( prevKey == key );
+}
+
+//-*****************************************************************************
+void AprImpl::getDimensions( index_t iSampleIndex,
+                             Alembic::Util::Dimensions & oDim )
+{
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+    chunk->asArrayPtr()->getDimensions( index, oDim );
+}
+
+//-*****************************************************************************
+bool AprImpl::isScalarLike()
+{
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        if ( m_scalarLikeKnown )
+        {
+            return m_scalarLike;
+        }
+    }
+
+    bool scalarLike = m_data.getFirst()->asArrayPtr()->isScalarLike() &&
+        computeIsScalarLike();
+
+    Alembic::Util::scoped_lock l( m_lock );
+    m_scalarLike = scalarLike;
+    m_scalarLikeKnown = true;
+    return scalarLike;
+}
+
+//-*****************************************************************************
+bool AprImpl::computeIsScalarLike()
+{
+    size_t numStarts = m_data.getNumChunkStarts();
+    for ( size_t i = 0; i < numStarts; ++i )
+    {
+        index_t start = 0;
+        if ( !m_data.getChunkStart( i, start )->asArrayPtr()->isScalarLike() )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-*****************************************************************************
+void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
+                     Alembic::Util::PlainOldDataType iPod )
+{
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+    chunk->asArrayPtr()->getAs( index, iIntoLocation, iPod );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
@@ -0,0 +1,115 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_AprImpl_h_
+#define _Alembic_AbcCoreConcat_AprImpl_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+#include <Alembic/AbcCoreConcat/PrData.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Reads each sample, key and dimensions from the chunk it is in.
+class AprImpl
+    : public AbcA::ArrayPropertyReader
+    , public Alembic::Util::enable_shared_from_this<AprImpl>
+{
+public:
+
+    AprImpl( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader );
+
+    // BasePropertyReader overrides
+    virtual const AbcA::PropertyHeader & getHeader() const;
+
+    virtual AbcA::ObjectReaderPtr getObject();
+
+    virtual AbcA::CompoundPropertyReaderPtr getParent();
+
+    virtual AbcA::ArrayPropertyReaderPtr asArrayPtr();
+
+    // ArrayPropertyReader overrides
+    virtual size_t getNumSamples();
+
+    virtual bool isConstant();
+
+    virtual void getSample( index_t iSampleIndex,
+                            AbcA::ArraySamplePtr &oSample );
+
+    virtual std::pair<index_t, chrono_t> getFloorIndex( chrono_t iTime );
+
+    virtual std::pair<index_t, chrono_t> getCeilIndex( chrono_t iTime );
+
+    virtual std::pair<index_t, chrono_t> getNearIndex( chrono_t iTime );
+
+    virtual bool getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey );
+
+    virtual bool isChangedSince( index_t iPrevSampleIndex,
+                                 index_t iSampleIndex );
+
+    virtual void getDimensions( index_t iSampleIndex,
+                                Alembic::Util::Dimensions & oDim );
+
+    virtual bool isScalarLike();
+
+    virtual void getAs( index_t iSample, void *iIntoLocation,
+                        Alembic::Util::PlainOldDataType iPod );
+
+private:
+    bool computeIsConstant();
+
+    bool computeIsScalarLike();
+
+    PrData m_data;
+
+    // these need every chunk, so they are only worked out once
+    bool m_constantKnown;
+    bool m_constant;
+    bool m_scalarLikeKnown;
+    bool m_scalarLike;
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,509 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/ArImpl.h>
+#include <Alembic/AbcCoreConcat/OrImpl.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+// m_maxSamples entries which haven't been worked out yet
+static const AbcA::index_t MAX_SAMPLES_UNSET = -1;
+
+//-*****************************************************************************
+ArImpl::ArImpl( const std::vector< std::string > &iFileNames,
+                size_t iNumStreams,
+                AbcA::ReadArraySampleCachePtr iCache )
+  : m_chunkNames( iFileNames )
+  , m_chunks( iFileNames.size() )
+  , m_numStreams( iNumStreams )
+  , m_cache( iCache )
+  , m_sequence( false )
+  , m_maxOpenFiles( 0 )
+  , m_numOpens( 0 )
+{
+    init();
+}
+
+//-*****************************************************************************
+ArImpl::ArImpl( const std::vector< std::string > &iFileNames,
+                size_t iNumStreams,
+                AbcA::ReadArraySampleCachePtr iCache,
+                const AbcA::TimeSampling &iSequence,
+                size_t iMaxOpenFiles )
+  : m_chunkNames( iFileNames )
+  , m_chunks( iFileNames.size() )
+  , m_numStreams( iNumStreams )
+  , m_cache( iCache )
+  , m_sequence( true )
+  , m_maxOpenFiles( iMaxOpenFiles )
+  , m_numOpens( 0 )
+{
+    ABCA_ASSERT( !iSequence.getTimeSamplingType().isAcyclic() ||
+                 iSequence.getNumStoredTimes() >= iFileNames.size(),
+                 "The sequence TimeSampling has "
+                 << iSequence.getNumStoredTimes() << " times for "
+                 << iFileNames.size() << " files." );
+
+    init();
+
+    // the other samplings only describe the first file, which is all we
+    // know without opening the rest
+    AbcA::ArchiveReaderPtr first = m_chunks[0];
+    for ( size_t i = 0; i < m_maxSamples.size(); ++i )
+    {
+        m_maxSamples[i] =
+            first->getMaxNumSamplesForTimeSamplingIndex( i );
+    }
+
+    m_timeSamples.push_back(
+        AbcA::TimeSamplingPtr( new AbcA::TimeSampling( iSequence ) ) );
+    m_maxSamples.push_back( m_chunks.size() );
+}
+
+//-*****************************************************************************
+ArImpl::ArImpl( const std::vector< AbcA::ArchiveReaderPtr > &iChunks )
+  : m_chunks( iChunks )
+  , m_numStreams( 1 )
+  , m_sequence( false )
+  , m_maxOpenFiles( 0 )
+  , m_numOpens( 0 )
+{
+    m_chunkNames.resize( m_chunks.size() );
+    for ( size_t i = 0; i < m_chunks.size(); ++i )
+    {
+        ABCA_ASSERT( m_chunks[i], "Invalid chunk archive: " << i );
+        m_chunkNames[i] = m_chunks[i]->getName();
+        validateChunk( i, m_chunks[i],
+                       i > 0 ? m_chunks[i - 1] : AbcA::ArchiveReaderPtr() );
+    }
+
+    init();
+}
+
+//-*****************************************************************************
+void ArImpl::init()
+{
+    ABCA_ASSERT( !m_chunks.empty(), "No chunk archives to concatenate." );
+
+    AbcA::ArchiveReaderPtr first = getChunk( 0 );
+
+    bool hasAcyclic = false;
+    m_timeSamples.resize( first->getNumTimeSamplings() );
+    for ( size_t i = 0; i < m_timeSamples.size(); ++i )
+    {
+        m_timeSamples[i] = first->getTimeSampling( i );
+        hasAcyclic = hasAcyclic ||
+            m_timeSamples[i]->getTimeSamplingType().isAcyclic();
+    }
+
+    m_maxSamples.resize( m_timeSamples.size(), MAX_SAMPLES_UNSET );
+
+    // uniform and cyclic samplings just carry on into the later chunks, but
+    // acyclic ones need all of their times, which means opening every chunk.
+    // Sequence files each hold one frame, so there is nothing to merge.
+    if ( !hasAcyclic || m_sequence )
+    {
+        return;
+    }
+
+    for ( size_t i = 0; i < m_timeSamples.size(); ++i )
+    {
+        if ( !m_timeSamples[i]->getTimeSamplingType().isAcyclic() )
+        {
+            continue;
+        }
+
+        std::vector< chrono_t > times = m_timeSamples[i]->getStoredTimes();
+        for ( size_t c = 1; c < m_chunks.size(); ++c )
+        {
+            const std::vector< chrono_t > & chunkTimes =
+                getChunk( c )->getTimeSampling( i )->getStoredTimes();
+
+            for ( size_t j = 0; j < chunkTimes.size(); ++j )
+            {
+                if ( times.empty() ||
+                     chunkTimes[j] > times.back() + kCHRONO_TOLERANCE )
+                {
+                    times.push_back( chunkTimes[j] );
+                }
+            }
+        }
+
+        m_timeSamples[i].reset( new AbcA::TimeSampling(
+            AbcA::TimeSamplingType( AbcA::TimeSamplingType::kAcyclic ),
+            times ) );
+    }
+}
+
+//-*****************************************************************************
+void ArImpl::validateChunk( size_t iIndex, AbcA::ArchiveReaderPtr iChunk,
+                            AbcA::ArchiveReaderPtr iPrev )
+{
+    ABCA_ASSERT( iChunk, "Could not open chunk: " << m_chunkNames[iIndex] );
+
+    if ( iIndex == 0 )
+    {
+        return;
+    }
+
+    AbcA::ArchiveReaderPtr first = m_chunks[0];
+    ABCA_ASSERT( iChunk->getNumTimeSamplings() ==
+                 first->getNumTimeSamplings(),
+                 "Chunk " << m_chunkNames[iIndex] << " has "
+                 << iChunk->getNumTimeSamplings() << " TimeSamplings, but "
+                 << m_chunkNames[0] << " has "
+                 << first->getNumTimeSamplings() );
+
+    // the samplings carry on from one chunk into the next, so they have to
+    // be of the same kind
+    for ( Util::uint32_t i = 0; i < first->getNumTimeSamplings(); ++i )
+    {
+        const AbcA::TimeSamplingType & type =
+            iChunk->getTimeSampling( i )->getTimeSamplingType();
+        const AbcA::TimeSamplingType & firstType =
+            first->getTimeSampling( i )->getTimeSamplingType();
+
+        ABCA_ASSERT( type.getNumSamplesPerCycle() ==
+                     firstType.getNumSamplesPerCycle(),
+                     "Chunk " << m_chunkNames[iIndex] << " TimeSampling "
+                     << i << " has " << type.getNumSamplesPerCycle()
+                     << " samples per cycle, but " << m_chunkNames[0]
+                     << " has " << firstType.getNumSamplesPerCycle() );
+
+        ABCA_ASSERT( type.getTimePerCycle() == firstType.getTimePerCycle(),
+                     "Chunk " << m_chunkNames[iIndex] << " TimeSampling "
+                     << i << " has a time per cycle of "
+                     << type.getTimePerCycle() << ", but "
+                     << m_chunkNames[0] << " has "
+                     << firstType.getTimePerCycle() );
+    }
+
+    // catch chunks which were given out of frame order when we can
+    if ( iPrev && !m_sequence && iChunk->getNumTimeSamplings() > 1 )
+    {
+        ABCA_ASSERT( iChunk->getTimeSampling( 1 )->getSampleTime( 0 ) >=
+                     iPrev->getTimeSampling( 1 )->getSampleTime( 0 ),
+                     "Chunk " << m_chunkNames[iIndex]
+                     << " starts before " << m_chunkNames[iIndex - 1] );
+    }
+}
+
+//-*****************************************************************************
+ArImpl::~ArImpl()
+{
+}
+
+//-*****************************************************************************
+const std::string &ArImpl::getName() const
+{
+    return m_chunkNames[0];
+}
+
+//-*****************************************************************************
+const AbcA::MetaData &ArImpl::getMetaData() const
+{
+    return m_chunks[0]->getMetaData();
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr ArImpl::getTop()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::ObjectReaderPtr ret = m_top.lock();
+    if ( ! ret )
+    {
+        ret.reset( new OrImpl( shared_from_this(),
+                               m_chunks[0]->getTop() ) );
+        m_top = ret;
+    }
+    return ret;
+}
+
+//-*****************************************************************************
+AbcA::TimeSamplingPtr ArImpl::getTimeSampling( Util::uint32_t iIndex )
+{
+    ABCA_ASSERT( iIndex < m_timeSamples.size(),
+                 "Invalid index provided to getTimeSampling." );
+
+    return m_timeSamples[iIndex];
+}
+
+//-*****************************************************************************
+AbcA::TimeSamplingPtr ArImpl::getTimeSampling( AbcA::TimeSamplingPtr iFirst )
+{
+    if ( !iFirst )
+    {
+        return iFirst;
+    }
+
+    AbcA::ArchiveReaderPtr first = m_chunks[0];
+    for ( Util::uint32_t i = 0; i < m_timeSamples.size(); ++i )
+    {
+        if ( first->getTimeSampling( i ) == iFirst )
+        {
+            return m_timeSamples[i];
+        }
+    }
+
+    for ( Util::uint32_t i = 0; i < m_timeSamples.size(); ++i )
+    {
+        if ( *( first->getTimeSampling( i ) ) == *iFirst )
+        {
+            return m_timeSamples[i];
+        }
+    }
+
+    return iFirst;
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr ArImpl::asArchivePtr()
+{
+    return shared_from_this();
+}
+
+//-*****************************************************************************
+AbcA::ReadArraySampleCachePtr ArImpl::getReadArraySampleCachePtr()
+{
+    return m_cache;
+}
+
+//-*****************************************************************************
+void ArImpl::setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_cache = iPtr;
+    for ( size_t i = 0; i < m_chunks.size(); ++i )
+    {
+        if ( m_chunks[i] )
+        {
+            m_chunks[i]->setReadArraySampleCachePtr( iPtr );
+        }
+    }
+}
+
+//-*****************************************************************************
+AbcA::ArraySampleAllocatorPtr ArImpl::getArraySampleAllocatorPtr()
+{
+    return m_allocator;
+}
+
+//-*****************************************************************************
+void ArImpl::setArraySampleAllocatorPtr( AbcA::ArraySampleAllocatorPtr iPtr )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_allocator = iPtr;
+    for ( size_t i = 0; i < m_chunks.size(); ++i )
+    {
+        if ( m_chunks[i] )
+        {
+            m_chunks[i]->setArraySampleAllocatorPtr( iPtr );
+        }
+    }
+}
+
+//-*****************************************************************************
+AbcA::index_t
+ArImpl::getMaxNumSamplesForTimeSamplingIndex( Util::uint32_t iIndex )
+{
+    if ( iIndex >= m_maxSamples.size() )
+    {
+        return INDEX_UNKNOWN;
+    }
+
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        if ( m_maxSamples[iIndex] != MAX_SAMPLES_UNSET )
+        {
+            return m_maxSamples[iIndex];
+        }
+    }
+
+    // the latest sample time of any chunk, as an index of our TimeSampling
+    bool hasSamples = false;
+    chrono_t lastTime = 0.0;
+    for ( size_t i = 0; i < m_chunks.size(); ++i )
+    {
+        AbcA::ArchiveReaderPtr chunk = getChunk( i );
+        AbcA::index_t numSamples =
+            chunk->getMaxNumSamplesForTimeSamplingIndex( iIndex );
+
+        if ( numSamples == INDEX_UNKNOWN )
+        {
+            return INDEX_UNKNOWN;
+        }
+
+        if ( numSamples > 0 )
+        {
+            chrono_t chunkTime =
+                chunk->getTimeSampling( iIndex )->getSampleTime(
+                    numSamples - 1 );
+            if ( !hasSamples || chunkTime > lastTime )
+            {
+                lastTime = chunkTime;
+            }
+            hasSamples = true;
+        }
+    }
+
+    AbcA::index_t maxSamples = 0;
+    if ( hasSamples )
+    {
+        AbcA::TimeSamplingPtr ts = m_timeSamples[iIndex];
+        AbcA::index_t bound = AbcA::index_t( 1 ) << 48;
+        if ( ts->getTimeSamplingType().isAcyclic() )
+        {
+            bound = ts->getNumStoredTimes();
+        }
+        maxSamples = ts->getFloorIndex( lastTime, bound ).first + 1;
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    m_maxSamples[iIndex] = maxSamples;
+    return maxSamples;
+}
+
+//-*****************************************************************************
+Util::int32_t ArImpl::getArchiveVersion()
+{
+    return m_chunks[0]->getArchiveVersion();
+}
+
+//-*****************************************************************************
+const std::string & ArImpl::getChunkName( size_t iIndex ) const
+{
+    return m_chunkNames[iIndex];
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr ArImpl::getChunk( size_t iIndex )
+{
+    ABCA_ASSERT( iIndex < m_chunks.size(),
+                 "Invalid chunk index: " << iIndex );
+
+    AbcA::ArchiveReaderPtr chunk;
+    AbcA::ArchiveReaderPtr prev;
+    AbcA::ReadArraySampleCachePtr cache;
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        chunk = m_chunks[iIndex];
+        if ( iIndex > 0 )
+        {
+            prev = m_chunks[iIndex - 1];
+        }
+        cache = m_cache;
+    }
+
+    // opening a file is slow, so other chunks stay available meanwhile
+    if ( !chunk )
+    {
+        AbcCoreOgawa::ReadArchive reader( m_numStreams );
+        chunk = reader( m_chunkNames[iIndex], cache );
+        validateChunk( iIndex, chunk, prev );
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    // another thread may have opened it at the same time, keep theirs
+    if ( m_chunks[iIndex] )
+    {
+        chunk = m_chunks[iIndex];
+    }
+    else
+    {
+        if ( cache != m_cache )
+        {
+            chunk->setReadArraySampleCachePtr( m_cache );
+        }
+        chunk->setArraySampleAllocatorPtr( m_allocator );
+        m_chunks[iIndex] = chunk;
+        ++m_numOpens;
+    }
+
+    // the first file holds the hierarchy so it always stays open, the least
+    // recently used of the rest are closed once there are too many of them.
+    // A file is only really closed when the last reader using it lets go.
+    if ( m_sequence && iIndex > 0 )
+    {
+        m_openFiles.remove( iIndex );
+        m_openFiles.push_front( iIndex );
+        while ( m_openFiles.size() > m_maxOpenFiles &&
+                m_openFiles.size() > 1 )
+        {
+            m_chunks[m_openFiles.back()].reset();
+            m_openFiles.pop_back();
+        }
+    }
+
+    return chunk;
+}
+
+//-*****************************************************************************
+size_t ArImpl::getNumOpenChunks()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    size_t numOpen = 0;
+    for ( size_t i = 0; i < m_chunks.size(); ++i )
+    {
+        numOpen += m_chunks[i] ? 1 : 0;
+    }
+    return numOpen;
+}
+
+//-*****************************************************************************
+size_t ArImpl::getNumChunkOpens()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return m_numOpens;
+}
+
+//-*****************************************************************************
+AbcA::TimeSamplingPtr ArImpl::getSequenceTimeSampling() const
+{
+    if ( !m_sequence )
+    {
+        return AbcA::TimeSamplingPtr();
+    }
+    return m_timeSamples.back();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
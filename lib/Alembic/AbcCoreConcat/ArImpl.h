@@ -0,0 +1,174 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_ArImpl_h_
+#define _Alembic_AbcCoreConcat_ArImpl_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+
+#include <list>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+class ArImpl
+    : public AbcA::ArchiveReader
+    , public Alembic::Util::enable_shared_from_this<ArImpl>
+{
+private:
+    friend class ReadArchive;
+    friend class ReadSequence;
+
+    ArImpl( const std::vector< std::string > &iFileNames,
+            size_t iNumStreams,
+            AbcA::ReadArraySampleCachePtr iCache );
+
+    // one file per sample of iSequence, at most iMaxOpenFiles of them are
+    // kept open besides the first
+    ArImpl( const std::vector< std::string > &iFileNames,
+            size_t iNumStreams,
+            AbcA::ReadArraySampleCachePtr iCache,
+            const AbcA::TimeSampling &iSequence,
+            size_t iMaxOpenFiles );
+
+    ArImpl( const std::vector< AbcA::ArchiveReaderPtr > &iChunks );
+
+public:
+
+    virtual ~ArImpl();
+
+    //-*************************************************************************
+    // ABSTRACT FUNCTIONS
+    //-*************************************************************************
+    virtual const std::string &getName() const;
+
+    virtual const AbcA::MetaData &getMetaData() const;
+
+    virtual AbcA::ObjectReaderPtr getTop();
+
+    virtual AbcA::TimeSamplingPtr getTimeSampling( Util::uint32_t iIndex );
+
+    virtual AbcA::ArchiveReaderPtr asArchivePtr();
+
+    virtual AbcA::ReadArraySampleCachePtr getReadArraySampleCachePtr();
+
+    virtual void
+    setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr );
+
+    virtual AbcA::ArraySampleAllocatorPtr getArraySampleAllocatorPtr();
+
+    //! THIS METHOD IS NOT MULTITHREAD SAFE
+    virtual void
+    setArraySampleAllocatorPtr( AbcA::ArraySampleAllocatorPtr iPtr );
+
+    virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
+        Util::uint32_t iIndex );
+
+    virtual Util::uint32_t getNumTimeSamplings()
+    {
+        return m_timeSamples.size();
+    }
+
+    virtual Util::int32_t getArchiveVersion();
+
+    //-*************************************************************************
+    // CHUNKS
+    //-*************************************************************************
+    size_t getNumChunks() const { return m_chunks.size(); }
+
+    const std::string & getChunkName( size_t iIndex ) const;
+
+    //! Opens the chunk the first time it is asked for, or again if it has
+    //! been closed since
+    AbcA::ArchiveReaderPtr getChunk( size_t iIndex );
+
+    //! How many of the chunks are open right now
+    size_t getNumOpenChunks();
+
+    //! How many times any chunk has been opened
+    size_t getNumChunkOpens();
+
+    //! Whether each chunk is one sample of every property instead of a
+    //! range of them.  Objects and properties of a sequence only hold on to
+    //! the first file's readers, the rest are looked up by name as needed
+    //! so that closed files stay closed.
+    bool isSequence() const { return m_sequence; }
+
+    //! The TimeSampling of every scalar and array property of a sequence
+    AbcA::TimeSamplingPtr getSequenceTimeSampling() const;
+
+    //! Our TimeSampling for one of the first chunk's
+    AbcA::TimeSamplingPtr getTimeSampling( AbcA::TimeSamplingPtr iFirst );
+
+private:
+    void init();
+
+    // iPrev is the chunk before iIndex, if it is open
+    void validateChunk( size_t iIndex, AbcA::ArchiveReaderPtr iChunk,
+                        AbcA::ArchiveReaderPtr iPrev );
+
+    std::vector< std::string > m_chunkNames;
+    std::vector< AbcA::ArchiveReaderPtr > m_chunks;
+    size_t m_numStreams;
+
+    AbcA::ReadArraySampleCachePtr m_cache;
+    AbcA::ArraySampleAllocatorPtr m_allocator;
+
+    Alembic::Util::weak_ptr< AbcA::ObjectReader > m_top;
+
+    std::vector< AbcA::TimeSamplingPtr > m_timeSamples;
+    std::vector< AbcA::index_t > m_maxSamples;
+
+    bool m_sequence;
+    size_t m_maxOpenFiles;
+    size_t m_numOpens;
+
+    // the open sequence files besides the first, most recently used first
+    std::list< size_t > m_openFiles;
+
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,286 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/CprImpl.h>
+#include <Alembic/AbcCoreConcat/AprImpl.h>
+#include <Alembic/AbcCoreConcat/SprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+CprImpl::CprImpl( OrImplPtr iObject, AbcA::CompoundPropertyReaderPtr iFirst )
+  : m_object( iObject )
+{
+    ABCA_ASSERT( m_object, "Invalid object" );
+    ABCA_ASSERT( iFirst, "Invalid compound property" );
+
+    m_chunks.resize( m_object->getArchiveImpl()->getNumChunks() );
+    m_chunks[0] = iFirst;
+    init();
+}
+
+//-*****************************************************************************
+CprImpl::CprImpl( CprImplPtr iParent, AbcA::CompoundPropertyReaderPtr iFirst )
+  : m_parent( iParent )
+{
+    ABCA_ASSERT( m_parent, "Invalid parent" );
+    ABCA_ASSERT( iFirst, "Invalid compound property" );
+
+    m_object = m_parent->getObjectImpl();
+    m_chunks.resize( m_object->getArchiveImpl()->getNumChunks() );
+    m_chunks[0] = iFirst;
+    init();
+}
+
+//-*****************************************************************************
+void CprImpl::init()
+{
+    ArImplPtr archive = m_object->getArchiveImpl();
+    AbcA::CompoundPropertyReaderPtr first = m_chunks[0];
+
+    m_header = first->getHeader();
+
+    size_t numProperties = first->getNumProperties();
+    m_propertyHeaders.resize( numProperties );
+    m_made.resize( numProperties );
+    for ( size_t i = 0; i < numProperties; ++i )
+    {
+        m_propertyHeaders[i] = first->getPropertyHeader( i );
+        if ( archive->isSequence() && !m_propertyHeaders[i].isCompound() )
+        {
+            m_propertyHeaders[i].setTimeSampling(
+                archive->getSequenceTimeSampling() );
+        }
+        else
+        {
+            m_propertyHeaders[i].setTimeSampling( archive->getTimeSampling(
+                m_propertyHeaders[i].getTimeSampling() ) );
+        }
+        m_propertyIndices[m_propertyHeaders[i].getName()] = i;
+    }
+}
+
+//-*****************************************************************************
+CprImpl::~CprImpl()
+{
+}
+
+//-*****************************************************************************
+const AbcA::PropertyHeader & CprImpl::getHeader() const
+{
+    return m_header;
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr CprImpl::getObject()
+{
+    return m_object;
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr CprImpl::getParent()
+{
+    return m_parent;
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr CprImpl::asCompoundPtr()
+{
+    return shared_from_this();
+}
+
+//-*****************************************************************************
+size_t CprImpl::getNumProperties()
+{
+    return m_propertyHeaders.size();
+}
+
+//-*****************************************************************************
+const AbcA::PropertyHeader & CprImpl::getPropertyHeader( size_t i )
+{
+    ABCA_ASSERT( i < m_propertyHeaders.size(),
+        "Out of range index in getPropertyHeader: " << i );
+
+    return m_propertyHeaders[i];
+}
+
+//-*****************************************************************************
+const AbcA::PropertyHeader *
+CprImpl::getPropertyHeader( const std::string &iName )
+{
+    std::map< std::string, size_t >::iterator it =
+        m_propertyIndices.find( iName );
+    if ( it == m_propertyIndices.end() )
+    {
+        return NULL;
+    }
+    return &( m_propertyHeaders[it->second] );
+}
+
+//-*****************************************************************************
+bool CprImpl::findProperty( const std::string &iName,
+                            AbcA::PropertyType iType, size_t & oIndex )
+{
+    std::map< std::string, size_t >::iterator it =
+        m_propertyIndices.find( iName );
+    if ( it == m_propertyIndices.end() )
+    {
+        return false;
+    }
+
+    const AbcA::PropertyHeader & header = m_propertyHeaders[it->second];
+    if ( header.getPropertyType() != iType )
+    {
+        ABCA_THROW( "Tried to read a property of type " << iType
+                    << " from one of type " << header.getPropertyType()
+                    << ": " << iName );
+    }
+
+    oIndex = it->second;
+    return true;
+}
+
+//-*****************************************************************************
+AbcA::ScalarPropertyReaderPtr
+CprImpl::getScalarProperty( const std::string &iName )
+{
+    size_t index = 0;
+    if ( !findProperty( iName, AbcA::kScalarProperty, index ) )
+    {
+        return AbcA::ScalarPropertyReaderPtr();
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::BasePropertyReaderPtr bptr = m_made[index].lock();
+    if ( ! bptr )
+    {
+        bptr.reset( new SprImpl( shared_from_this(),
+                                 m_propertyHeaders[index] ) );
+        m_made[index] = bptr;
+    }
+    return bptr->asScalarPtr();
+}
+
+//-*****************************************************************************
+AbcA::ArrayPropertyReaderPtr
+CprImpl::getArrayProperty( const std::string &iName )
+{
+    size_t index = 0;
+    if ( !findProperty( iName, AbcA::kArrayProperty, index ) )
+    {
+        return AbcA::ArrayPropertyReaderPtr();
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::BasePropertyReaderPtr bptr = m_made[index].lock();
+    if ( ! bptr )
+    {
+        bptr.reset( new AprImpl( shared_from_this(),
+                                 m_propertyHeaders[index] ) );
+        m_made[index] = bptr;
+    }
+    return bptr->asArrayPtr();
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr
+CprImpl::getCompoundProperty( const std::string &iName )
+{
+    size_t index = 0;
+    if ( !findProperty( iName, AbcA::kCompoundProperty, index ) )
+    {
+        return AbcA::CompoundPropertyReaderPtr();
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::BasePropertyReaderPtr bptr = m_made[index].lock();
+    if ( ! bptr )
+    {
+        bptr.reset( new CprImpl( shared_from_this(),
+                                 m_chunks[0]->getCompoundProperty( iName ) ) );
+        m_made[index] = bptr;
+    }
+    return bptr->asCompoundPtr();
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr CprImpl::getChunk( size_t iIndex )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::CompoundPropertyReaderPtr ret = m_chunks[iIndex];
+    if ( !ret )
+    {
+        if ( m_parent )
+        {
+            ret = m_parent->getChunk( iIndex )->getCompoundProperty(
+                getName() );
+        }
+        else
+        {
+            ret = m_object->getChunk( iIndex )->getProperties();
+        }
+
+        ABCA_ASSERT( ret, "Chunk "
+                     << getArchiveImpl()->getChunkName( iIndex )
+                     << " is missing compound property: " << getName()
+                     << " of " << m_object->getFullName() );
+
+        // holding on to it would keep a sequence file open
+        if ( !getArchiveImpl()->isSequence() )
+        {
+            m_chunks[iIndex] = ret;
+        }
+    }
+
+    return ret;
+}
+
+//-*****************************************************************************
+AbcA::BasePropertyReaderPtr
+CprImpl::getFirstProperty( const std::string &iName )
+{
+    return m_chunks[0]->getProperty( iName );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
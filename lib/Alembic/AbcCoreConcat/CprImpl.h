@@ -0,0 +1,136 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_CprImpl_h_
+#define _Alembic_AbcCoreConcat_CprImpl_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+#include <Alembic/AbcCoreConcat/OrImpl.h>
+
+#include <map>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+class CprImpl
+    : public AbcA::CompoundPropertyReader
+    , public Alembic::Util::enable_shared_from_this<CprImpl>
+{
+public:
+
+    // the top compound of an object
+    CprImpl( OrImplPtr iObject, AbcA::CompoundPropertyReaderPtr iFirst );
+
+    CprImpl( CprImplPtr iParent, AbcA::CompoundPropertyReaderPtr iFirst );
+
+    virtual ~CprImpl();
+
+    //-*************************************************************************
+    // FROM ABSTRACT
+    //-*************************************************************************
+    virtual const AbcA::PropertyHeader & getHeader() const;
+
+    virtual AbcA::ObjectReaderPtr getObject();
+
+    virtual AbcA::CompoundPropertyReaderPtr getParent();
+
+    virtual AbcA::CompoundPropertyReaderPtr asCompoundPtr();
+
+    virtual size_t getNumProperties();
+
+    virtual const AbcA::PropertyHeader & getPropertyHeader( size_t i );
+
+    virtual const AbcA::PropertyHeader *
+    getPropertyHeader( const std::string &iName );
+
+    virtual AbcA::ScalarPropertyReaderPtr
+    getScalarProperty( const std::string &iName );
+
+    virtual AbcA::ArrayPropertyReaderPtr
+    getArrayProperty( const std::string &iName );
+
+    virtual AbcA::CompoundPropertyReaderPtr
+    getCompoundProperty( const std::string &iName );
+
+    //-*************************************************************************
+    // CHUNKS
+    //-*************************************************************************
+    ArImplPtr getArchiveImpl() const { return m_object->getArchiveImpl(); }
+
+    OrImplPtr getObjectImpl() const { return m_object; }
+
+    //! This compound in the given chunk, looked up by name under our parent
+    AbcA::CompoundPropertyReaderPtr getChunk( size_t iIndex );
+
+    //! The first chunk's reader for one of our properties
+    AbcA::BasePropertyReaderPtr getFirstProperty( const std::string &iName );
+
+private:
+
+    void init();
+
+    // returns the index of iName, throwing if it isn't of type iType
+    bool findProperty( const std::string &iName, AbcA::PropertyType iType,
+                       size_t & oIndex );
+
+    OrImplPtr m_object;
+
+    CprImplPtr m_parent;
+
+    AbcA::PropertyHeader m_header;
+
+    // with our TimeSamplings instead of the first chunk's
+    std::vector< AbcA::PropertyHeader > m_propertyHeaders;
+    std::map< std::string, size_t > m_propertyIndices;
+
+    std::vector< Alembic::Util::weak_ptr< AbcA::BasePropertyReader > >
+        m_made;
+
+    std::vector< AbcA::CompoundPropertyReaderPtr > m_chunks;
+
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,220 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/OrImpl.h>
+#include <Alembic/AbcCoreConcat/CprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+OrImpl::OrImpl( ArImplPtr iArchive, AbcA::ObjectReaderPtr iFirst )
+  : m_archive( iArchive )
+{
+    ABCA_ASSERT( m_archive, "Invalid archive" );
+    ABCA_ASSERT( iFirst, "Invalid object" );
+
+    m_chunks.resize( m_archive->getNumChunks() );
+    m_chunks[0] = iFirst;
+    m_children.resize( iFirst->getNumChildren() );
+}
+
+//-*****************************************************************************
+OrImpl::OrImpl( OrImplPtr iParent, AbcA::ObjectReaderPtr iFirst )
+  : m_parent( iParent )
+{
+    ABCA_ASSERT( m_parent, "Invalid parent" );
+    ABCA_ASSERT( iFirst, "Invalid object" );
+
+    m_archive = m_parent->getArchiveImpl();
+    m_chunks.resize( m_archive->getNumChunks() );
+    m_chunks[0] = iFirst;
+    m_children.resize( iFirst->getNumChildren() );
+}
+
+//-*****************************************************************************
+OrImpl::~OrImpl()
+{
+}
+
+//-*****************************************************************************
+const AbcA::ObjectHeader & OrImpl::getHeader() const
+{
+    return m_chunks[0]->getHeader();
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr OrImpl::getArchive()
+{
+    return m_archive;
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr OrImpl::getParent()
+{
+    return m_parent;
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr OrImpl::getProperties()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::CompoundPropertyReaderPtr ret = m_top.lock();
+    if ( ! ret )
+    {
+        ret.reset( new CprImpl( shared_from_this(),
+                                m_chunks[0]->getProperties() ) );
+        m_top = ret;
+    }
+    return ret;
+}
+
+//-*****************************************************************************
+size_t OrImpl::getNumChildren()
+{
+    return m_children.size();
+}
+
+//-*****************************************************************************
+const AbcA::ObjectHeader & OrImpl::getChildHeader( size_t i )
+{
+    return m_chunks[0]->getChildHeader( i );
+}
+
+//-*****************************************************************************
+const AbcA::ObjectHeader * OrImpl::getChildHeader( const std::string &iName )
+{
+    return m_chunks[0]->getChildHeader( iName );
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr OrImpl::getChild( const std::string &iName )
+{
+    size_t index = 0;
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        if ( m_childIndices.empty() )
+        {
+            for ( size_t i = 0; i < m_children.size(); ++i )
+            {
+                m_childIndices[m_chunks[0]->getChildHeader( i ).getName()] =
+                    i;
+            }
+        }
+
+        std::map< std::string, size_t >::iterator it =
+            m_childIndices.find( iName );
+        if ( it == m_childIndices.end() )
+        {
+            return AbcA::ObjectReaderPtr();
+        }
+        index = it->second;
+    }
+
+    return getChild( index );
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr OrImpl::getChild( size_t i )
+{
+    ABCA_ASSERT( i < m_children.size(),
+        "Out of range index in OrImpl::getChild: " << i );
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::ObjectReaderPtr ret = m_children[i].lock();
+    if ( ! ret )
+    {
+        ret.reset( new OrImpl( shared_from_this(),
+                               m_chunks[0]->getChild( i ) ) );
+        m_children[i] = ret;
+    }
+    return ret;
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr OrImpl::asObjectPtr()
+{
+    return shared_from_this();
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr OrImpl::getChunk( size_t iIndex )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    AbcA::ObjectReaderPtr ret = m_chunks[iIndex];
+    if ( !ret )
+    {
+        if ( m_parent )
+        {
+            ret = m_parent->getChunk( iIndex )->getChild( getName() );
+        }
+        else
+        {
+            ret = m_archive->getChunk( iIndex )->getTop();
+        }
+
+        ABCA_ASSERT( ret, "Chunk "
+                     << m_archive->getChunkName( iIndex )
+                     << " is missing object: " << getFullName() );
+
+        // holding on to it would keep a sequence file open.  The object
+        // and property hashes of a sequence file include its samples, so they
+        // can't tell us whether its hierarchy matches, just check the child
+        // count of every object as we get to it.
+        if ( !m_archive->isSequence() )
+        {
+            m_chunks[iIndex] = ret;
+        }
+        else
+        {
+            ABCA_ASSERT( ret->getNumChildren() == m_chunks[0]->getNumChildren(),
+                         "Chunk " << m_archive->getChunkName( iIndex )
+                         << " has " << ret->getNumChildren()
+                         << " children under " << getFullName()
+                         << ", expected " << m_chunks[0]->getNumChildren() );
+        }
+    }
+
+    return ret;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
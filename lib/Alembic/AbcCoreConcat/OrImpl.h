@@ -0,0 +1,120 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_OrImpl_h_
+#define _Alembic_AbcCoreConcat_OrImpl_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+#include <Alembic/AbcCoreConcat/ArImpl.h>
+
+#include <map>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+class OrImpl
+    : public AbcA::ObjectReader
+    , public Alembic::Util::enable_shared_from_this<OrImpl>
+{
+
+public:
+
+    // the top object
+    OrImpl( ArImplPtr iArchive, AbcA::ObjectReaderPtr iFirst );
+
+    OrImpl( OrImplPtr iParent, AbcA::ObjectReaderPtr iFirst );
+
+    virtual ~OrImpl();
+
+    //-*************************************************************************
+    // ABSTRACT
+    //-*************************************************************************
+    virtual const AbcA::ObjectHeader & getHeader() const;
+
+    virtual AbcA::ArchiveReaderPtr getArchive();
+
+    virtual AbcA::ObjectReaderPtr getParent();
+
+    virtual AbcA::CompoundPropertyReaderPtr getProperties();
+
+    virtual size_t getNumChildren();
+
+    virtual const AbcA::ObjectHeader & getChildHeader( size_t i );
+
+    virtual const AbcA::ObjectHeader * getChildHeader
+    ( const std::string &iName );
+
+    virtual AbcA::ObjectReaderPtr getChild( const std::string &iName );
+
+    virtual AbcA::ObjectReaderPtr getChild( size_t i );
+
+    virtual AbcA::ObjectReaderPtr asObjectPtr();
+
+    //-*************************************************************************
+    // CHUNKS
+    //-*************************************************************************
+    ArImplPtr getArchiveImpl() const { return m_archive; }
+
+    //! This object in the given chunk, looked up by name under our parent
+    AbcA::ObjectReaderPtr getChunk( size_t iIndex );
+
+private:
+
+    OrImplPtr m_parent;
+
+    ArImplPtr m_archive;
+
+    // everything about the hierarchy comes from the first chunk
+    std::vector< AbcA::ObjectReaderPtr > m_chunks;
+
+    std::vector< Alembic::Util::weak_ptr< AbcA::ObjectReader > > m_children;
+    std::map< std::string, size_t > m_childIndices;
+
+    Alembic::Util::weak_ptr< AbcA::CompoundPropertyReader > m_top;
+
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,228 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/PrData.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+static index_t getNumChunkSamples( AbcA::BasePropertyReaderPtr iReader )
+{
+    if ( iReader->isScalar() )
+    {
+        return iReader->asScalarPtr()->getNumSamples();
+    }
+    return iReader->asArrayPtr()->getNumSamples();
+}
+
+//-*****************************************************************************
+PrData::PrData( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader )
+  : m_parent( iParent )
+  , m_header( iHeader )
+  , m_built( false )
+  , m_numSamples( 0 )
+{
+    ABCA_ASSERT( m_parent, "Invalid parent" );
+
+    m_first = m_parent->getFirstProperty( m_header.getName() );
+    ABCA_ASSERT( m_first, "Invalid property: " << m_header.getName() );
+    m_firstNumSamples = getNumChunkSamples( m_first );
+    m_sequence = m_parent->getArchiveImpl()->isSequence();
+}
+
+//-*****************************************************************************
+AbcA::BasePropertyReaderPtr PrData::getChunkProperty( size_t iIndex )
+{
+    if ( iIndex == 0 )
+    {
+        return m_first;
+    }
+
+    AbcA::BasePropertyReaderPtr reader =
+        m_parent->getChunk( iIndex )->getProperty( m_header.getName() );
+
+    ABCA_ASSERT( reader &&
+        reader->getPropertyType() == m_header.getPropertyType() &&
+        reader->getDataType() == m_header.getDataType(),
+        "Chunk " << m_parent->getArchiveImpl()->getChunkName( iIndex )
+        << " is missing property: " << m_header.getName()
+        << " of " << m_parent->getObject()->getFullName()
+        << ", or it has a different type" );
+
+    return reader;
+}
+
+//-*****************************************************************************
+void PrData::buildRanges()
+{
+    if ( m_built )
+    {
+        return;
+    }
+
+    ArImplPtr archive = m_parent->getArchiveImpl();
+    m_numSamples = 0;
+
+    bool hasSamples = false;
+    chrono_t lastTime = 0.0;
+    for ( size_t i = 0; i < archive->getNumChunks(); ++i )
+    {
+        AbcA::BasePropertyReaderPtr reader = getChunkProperty( i );
+        index_t numSamples = getNumChunkSamples( reader );
+        AbcA::TimeSamplingPtr ts = reader->getTimeSampling();
+
+        index_t start = 0;
+        while ( hasSamples && start < numSamples &&
+                ts->getSampleTime( start ) <= lastTime + kCHRONO_TOLERANCE )
+        {
+            ++start;
+        }
+
+        if ( start < numSamples )
+        {
+            Range range;
+            range.first = m_numSamples;
+            range.reader = reader;
+            range.start = start;
+            m_ranges.push_back( range );
+
+            m_numSamples += numSamples - start;
+            lastTime = ts->getSampleTime( numSamples - 1 );
+            hasSamples = true;
+        }
+    }
+
+    m_built = true;
+}
+
+//-*****************************************************************************
+size_t PrData::getNumSamples()
+{
+    if ( m_sequence )
+    {
+        return m_firstNumSamples > 0 ?
+            m_parent->getArchiveImpl()->getNumChunks() : 0;
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    buildRanges();
+    return m_numSamples;
+}
+
+//-*****************************************************************************
+AbcA::BasePropertyReaderPtr PrData::getSample( index_t iIndex,
+                                               index_t & oChunkIndex )
+{
+    // the first chunk always starts at the beginning
+    if ( iIndex >= 0 && iIndex < m_firstNumSamples )
+    {
+        oChunkIndex = iIndex;
+        return m_first;
+    }
+
+    // which is only ever sample 0 of a sequence file, the others are looked
+    // up every time so that they can be closed
+    if ( m_sequence )
+    {
+        index_t numSamples = getNumSamples();
+        ABCA_ASSERT( iIndex >= 0 && iIndex < numSamples,
+                     "Invalid sample index: " << iIndex
+                     << ", should be between 0 and " << numSamples - 1 );
+
+        AbcA::BasePropertyReaderPtr reader = getChunkProperty( iIndex );
+        ABCA_ASSERT( getNumChunkSamples( reader ) > 0,
+                     "Chunk " << m_parent->getArchiveImpl()->getChunkName(
+                         iIndex ) << " has no samples for: "
+                     << m_header.getName() );
+
+        oChunkIndex = 0;
+        return reader;
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    buildRanges();
+
+    ABCA_ASSERT( iIndex >= 0 && iIndex < m_numSamples,
+                 "Invalid sample index: " << iIndex
+                 << ", should be between 0 and " << m_numSamples - 1 );
+
+    size_t r = m_ranges.size() - 1;
+    while ( m_ranges[r].first > iIndex )
+    {
+        --r;
+    }
+
+    oChunkIndex = m_ranges[r].start + ( iIndex - m_ranges[r].first );
+    return m_ranges[r].reader;
+}
+
+//-*****************************************************************************
+size_t PrData::getNumChunkStarts()
+{
+    if ( m_sequence )
+    {
+        return getNumSamples();
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    buildRanges();
+    return m_ranges.size();
+}
+
+//-*****************************************************************************
+AbcA::BasePropertyReaderPtr PrData::getChunkStart( size_t iIndex,
+                                                   index_t & oChunkIndex )
+{
+    if ( m_sequence )
+    {
+        return getSample( iIndex, oChunkIndex );
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    buildRanges();
+
+    ABCA_ASSERT( iIndex < m_ranges.size(),
+                 "Invalid chunk start index: " << iIndex );
+
+    oChunkIndex = m_ranges[iIndex].start;
+    return m_ranges[iIndex].reader;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
@@ -0,0 +1,115 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_PrData_h_
+#define _Alembic_AbcCoreConcat_PrData_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+#include <Alembic/AbcCoreConcat/CprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Works out which chunk each sample of a scalar or array property is in.
+// Every chunk adds the samples which come after the last one taken from the
+// chunks before it, so the first sample of a chunk which overlaps the
+// previous one by a frame is skipped.  Samples of the first chunk are found
+// without opening any of the others.  In a file sequence sample i is the
+// first sample of file i instead, and only the first file's property is
+// held on to.
+class PrData
+{
+public:
+    PrData( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader );
+
+    const AbcA::PropertyHeader & getHeader() const { return m_header; }
+
+    CprImplPtr getParent() const { return m_parent; }
+
+    //! The first chunk's property, which never needs any other chunk
+    AbcA::BasePropertyReaderPtr getFirst() const { return m_first; }
+
+    size_t getNumSamples();
+
+    //! The chunk's property sample iIndex is in, and its index in there
+    AbcA::BasePropertyReaderPtr getSample( index_t iIndex,
+                                           index_t & oChunkIndex );
+
+    //! How many chunk properties have samples
+    size_t getNumChunkStarts();
+
+    //! The iIndex'th chunk property which has samples, and the first one we
+    //! use from it
+    AbcA::BasePropertyReaderPtr getChunkStart( size_t iIndex,
+                                               index_t & oChunkIndex );
+
+private:
+    void buildRanges();
+
+    AbcA::BasePropertyReaderPtr getChunkProperty( size_t iIndex );
+
+    struct Range
+    {
+        // our index of its first sample
+        index_t first;
+        AbcA::BasePropertyReaderPtr reader;
+        index_t start;
+    };
+
+    CprImplPtr m_parent;
+    AbcA::PropertyHeader m_header;
+
+    AbcA::BasePropertyReaderPtr m_first;
+    index_t m_firstNumSamples;
+    bool m_sequence;
+
+    bool m_built;
+    std::vector< Range > m_ranges;
+    index_t m_numSamples;
+
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,110 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/ReadArchive.h>
+#include <Alembic/AbcCoreConcat/ArImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+ReadArchive::ReadArchive()
+{
+    m_numStreams = 1;
+}
+
+//-*****************************************************************************
+ReadArchive::ReadArchive( size_t iNumStreams )
+{
+    m_numStreams = iNumStreams;
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr
+ReadArchive::operator()( const std::vector< std::string > &iFileNames ) const
+{
+    return AbcA::ArchiveReaderPtr( new ArImpl( iFileNames, m_numStreams,
+        AbcA::ReadArraySampleCachePtr() ) );
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr
+ReadArchive::operator()( const std::vector< std::string > &iFileNames,
+                         AbcA::ReadArraySampleCachePtr iCache ) const
+{
+    return AbcA::ArchiveReaderPtr( new ArImpl( iFileNames, m_numStreams,
+                                               iCache ) );
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr
+ReadArchive::operator()(
+    const std::vector< AbcA::ArchiveReaderPtr > &iChunks ) const
+{
+    return AbcA::ArchiveReaderPtr( new ArImpl( iChunks ) );
+}
+
+//-*****************************************************************************
+ReadSequence::ReadSequence( const AbcA::TimeSampling &iSequence,
+                            size_t iMaxOpenFiles,
+                            size_t iNumStreams )
+  : m_sequence( iSequence )
+  , m_maxOpenFiles( iMaxOpenFiles )
+  , m_numStreams( iNumStreams )
+{
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr
+ReadSequence::operator()( const std::vector< std::string > &iFileNames ) const
+{
+    return AbcA::ArchiveReaderPtr( new ArImpl( iFileNames, m_numStreams,
+        AbcA::ReadArraySampleCachePtr(), m_sequence, m_maxOpenFiles ) );
+}
+
+//-*****************************************************************************
+AbcA::ArchiveReaderPtr
+ReadSequence::operator()( const std::vector< std::string > &iFileNames,
+                          AbcA::ReadArraySampleCachePtr iCache ) const
+{
+    return AbcA::ArchiveReaderPtr( new ArImpl( iFileNames, m_numStreams,
+        iCache, m_sequence, m_maxOpenFiles ) );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
@@ -0,0 +1,124 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_ReadArchive_h_
+#define _Alembic_AbcCoreConcat_ReadArchive_h_
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! Presents archives written in frame range chunks, with the same hierarchy
+//! in each, as one read only archive, which is what AbcStitcher would have
+//! written without the copy.
+//!
+//! The hierarchy, headers and meta data all come from the first chunk.  The
+//! others are only opened once a property needs them, as the samples of a
+//! property are spread over every chunk.  Samples of a later chunk which
+//! don't come after the ones already seen are skipped, so chunks may overlap
+//! by a frame.  TimeSamplings come from the first chunk, acyclic ones have
+//! the times of all of the chunks.
+class ReadArchive
+{
+public:
+    ReadArchive();
+
+    //! Open each Ogawa chunk with iNumStreams streams
+    ReadArchive( size_t iNumStreams );
+
+    //! The chunk files have to be in frame order.  They are opened with
+    //! AbcCoreOgawa when needed, except the first which is opened right away.
+    ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
+    operator()( const std::vector< std::string > &iFileNames ) const;
+
+    //! Samples are read through iCache when it is set.
+    ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
+    operator()( const std::vector< std::string > &iFileNames,
+                ::Alembic::AbcCoreAbstract::ReadArraySampleCachePtr iCache
+              ) const;
+
+    //! Concatenates chunks which are already open, from any core, in frame
+    //! order.
+    ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
+    operator()( const std::vector<
+                ::Alembic::AbcCoreAbstract::ArchiveReaderPtr > &iChunks ) const;
+
+private:
+    size_t m_numStreams;
+};
+
+//-*****************************************************************************
+//! Reads a sequence of per-frame files, all with the same hierarchy, as one
+//! animated archive.  The hierarchy comes from the first file, and every
+//! scalar and array property gets one sample from each file, at the times
+//! of iSequence.  The other files are opened as their samples are read and
+//! are checked against the first one as they are, at most iMaxOpenFiles of
+//! them are kept open at once.
+class ReadSequence
+{
+public:
+    ReadSequence( const ::Alembic::AbcCoreAbstract::TimeSampling &iSequence,
+                  size_t iMaxOpenFiles = 16,
+                  size_t iNumStreams = 1 );
+
+    //! The files have to be in frame order, they are opened with
+    //! AbcCoreOgawa.
+    ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
+    operator()( const std::vector< std::string > &iFileNames ) const;
+
+    //! Samples are read through iCache when it is set.
+    ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
+    operator()( const std::vector< std::string > &iFileNames,
+                ::Alembic::AbcCoreAbstract::ReadArraySampleCachePtr iCache
+              ) const;
+
+private:
+    ::Alembic::AbcCoreAbstract::TimeSampling m_sequence;
+    size_t m_maxOpenFiles;
+    size_t m_numStreams;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,209 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/SprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+template < class T >
+static bool sameSamples( AbcA::ScalarPropertyReaderPtr iA, index_t iIndexA,
+                         AbcA::ScalarPropertyReaderPtr iB, index_t iIndexB,
+                         size_t iSize )
+{
+    std::vector< T > a( iSize );
+    std::vector< T > b( iSize );
+    iA->getSample( iIndexA, &a.front() );
+    iB->getSample( iIndexB, &b.front() );
+    return a == b;
+}
+
+//-*****************************************************************************
+SprImpl::SprImpl( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader )
+  : m_data( iParent, iHeader )
+  , m_constantKnown( false )
+  , m_constant( false )
+{
+    if ( iHeader.getPropertyType() != AbcA::kScalarProperty )
+    {
+        ABCA_THROW( "Attempted to create a ScalarPropertyReader from a "
+                    "non-scalar property type" );
+    }
+}
+
+//-*****************************************************************************
+const AbcA::PropertyHeader & SprImpl::getHeader() const
+{
+    return m_data.getHeader();
+}
+
+//-*****************************************************************************
+AbcA::ObjectReaderPtr SprImpl::getObject()
+{
+    return m_data.getParent()->getObject();
+}
+
+//-*****************************************************************************
+AbcA::CompoundPropertyReaderPtr SprImpl::getParent()
+{
+    return m_data.getParent();
+}
+
+//-*****************************************************************************
+AbcA::ScalarPropertyReaderPtr SprImpl::asScalarPtr()
+{
+    return shared_from_this();
+}
+
+//-*****************************************************************************
+size_t SprImpl::getNumSamples()
+{
+    return m_data.getNumSamples();
+}
+
+//-*****************************************************************************
+bool SprImpl::isConstant()
+{
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        if ( m_constantKnown )
+        {
+            return m_constant;
+        }
+    }
+
+    // a first chunk which changes settles it without opening the others
+    bool constant = m_data.getFirst()->asScalarPtr()->isConstant() &&
+        computeIsConstant();
+
+    Alembic::Util::scoped_lock l( m_lock );
+    m_constant = constant;
+    m_constantKnown = true;
+    return constant;
+}
+
+//-*****************************************************************************
+bool SprImpl::computeIsConstant()
+{
+    size_t numStarts = m_data.getNumChunkStarts();
+    if ( numStarts == 0 )
+    {
+        return true;
+    }
+
+    index_t aStart = 0;
+    AbcA::ScalarPropertyReaderPtr a =
+        m_data.getChunkStart( 0, aStart )->asScalarPtr();
+
+    // every chunk has to be constant, and the first sample of each the same.
+    // Only one other chunk is held at a time, for file sequences.
+    const AbcA::DataType & dataType = getHeader().getDataType();
+    for ( size_t i = 0; i < numStarts; ++i )
+    {
+        index_t bStart = 0;
+        AbcA::ScalarPropertyReaderPtr b =
+            m_data.getChunkStart( i, bStart )->asScalarPtr();
+
+        if ( !b->isConstant() )
+        {
+            return false;
+        }
+
+        if ( i == 0 )
+        {
+            continue;
+        }
+
+        bool same = false;
+        if ( dataType.getPod() == Util::kStringPOD )
+        {
+            same = sameSamples< std::string >( a, aStart,
+                b, bStart, dataType.getExtent() );
+        }
+        else if ( dataType.getPod() == Util::kWstringPOD )
+        {
+            same = sameSamples< std::wstring >( a, aStart,
+                b, bStart, dataType.getExtent() );
+        }
+        else
+        {
+            same = sameSamples< char >( a, aStart,
+                b, bStart, dataType.getNumBytes() );
+        }
+
+        if ( !same )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+void SprImpl::getSample( index_t iSampleIndex, void * iIntoLocation )
+{
+    index_t index = 0;
+    AbcA::BasePropertyReaderPtr chunk = m_data.getSample( iSampleIndex, index );
+    chunk->asScalarPtr()->getSample( index, iIntoLocation );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> SprImpl::getFloorIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getFloorIndex( iTime,
+        getNumSamples() );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> SprImpl::getCeilIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getCeilIndex( iTime,
+        getNumSamples() );
+}
+
+//-*****************************************************************************
+std::pair<index_t, chrono_t> SprImpl::getNearIndex( chrono_t iTime )
+{
+    return getHeader().getTimeSampling()->getNearIndex( iTime,
+        getNumSamples() );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
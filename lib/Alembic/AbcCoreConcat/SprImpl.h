@@ -0,0 +1,98 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreConcat_SprImpl_h_
+#define _Alembic_AbcCoreConcat_SprImpl_h_
+
+#include <Alembic/AbcCoreConcat/Foundation.h>
+#include <Alembic/AbcCoreConcat/PrData.h>
+
+namespace Alembic {
+namespace AbcCoreConcat {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Reads each sample from the chunk it is in.
+class SprImpl
+    : public AbcA::ScalarPropertyReader
+    , public Alembic::Util::enable_shared_from_this<SprImpl>
+{
+public:
+
+    SprImpl( CprImplPtr iParent, const AbcA::PropertyHeader &iHeader );
+
+    // BasePropertyReader overrides
+    virtual const AbcA::PropertyHeader & getHeader() const;
+
+    virtual AbcA::ObjectReaderPtr getObject();
+
+    virtual AbcA::CompoundPropertyReaderPtr getParent();
+
+    virtual AbcA::ScalarPropertyReaderPtr asScalarPtr();
+
+    // ScalarPropertyReader overrides
+    virtual size_t getNumSamples();
+
+    virtual bool isConstant();
+
+    virtual void getSample( index_t iSampleIndex,
+                            void * iIntoLocation );
+
+    virtual std::pair<index_t, chrono_t> getFloorIndex( chrono_t iTime );
+
+    virtual std::pair<index_t, chrono_t> getCeilIndex( chrono_t iTime );
+
+    virtual std::pair<index_t, chrono_t> getNearIndex( chrono_t iTime );
+
+private:
+    bool computeIsConstant();
+
+    PrData m_data;
+
+    // this needs every chunk, so it is only worked out once
+    bool m_constantKnown;
+    bool m_constant;
+    Alembic::Util::mutex m_lock;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreConcat
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,287 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+
+namespace Abc = Alembic::Abc;
+namespace AbcA = Alembic::AbcCoreAbstract;
+
+static const double g_dt = 1.0 / 24.0;
+
+//-*****************************************************************************
+// A chunk of a simulation, frames iFirst to iLast.  iIrregularTimes are the
+// times of an extra acyclic property, if there are any.
+void writeChunk( const std::string & iName, int iFirst, int iLast,
+                 const std::vector< double > & iIrregularTimes,
+                 double iDt = g_dt )
+{
+    Abc::OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+
+    Abc::TimeSampling ts( iDt, iFirst * iDt );
+    Alembic::Util::uint32_t tsIndex = archive.addTimeSampling( ts );
+
+    Abc::OObject sim( Abc::OObject( archive, Abc::kTop ), "sim" );
+    Abc::OObject particles( sim, "particles" );
+    Abc::OCompoundProperty props = particles.getProperties();
+
+    Abc::ODoubleProperty frame( props, "frame", tsIndex );
+    Abc::OV3fArrayProperty points( props, "P", tsIndex );
+    Abc::OStringProperty label( props, "label", tsIndex );
+    Abc::OInt32Property still( props, "still" );
+    still.set( 7 );
+
+    for ( int f = iFirst; f <= iLast; ++f )
+    {
+        frame.set( f );
+        std::vector< Imath::V3f > p( f % 3 + 1, Imath::V3f( f, 0, 0 ) );
+        points.set( p );
+        label.set( "particles" );
+    }
+
+    if ( !iIrregularTimes.empty() )
+    {
+        Abc::TimeSampling irregular( Abc::TimeSamplingType(
+            Abc::TimeSamplingType::kAcyclic ), iIrregularTimes );
+        Abc::ODoubleProperty prop( props, "irregular",
+                                   archive.addTimeSampling( irregular ) );
+        for ( size_t i = 0; i < iIrregularTimes.size(); ++i )
+        {
+            prop.set( iIrregularTimes[i] );
+        }
+    }
+}
+
+//-*****************************************************************************
+Abc::ICompoundProperty getProps( Abc::IArchive & iArchive )
+{
+    Abc::IObject sim( iArchive.getTop(), "sim" );
+    return Abc::IObject( sim, "particles" ).getProperties();
+}
+
+//-*****************************************************************************
+void readConcatenated( AbcA::ArchiveReaderPtr iReader )
+{
+    Abc::IArchive archive( iReader, Abc::kWrapExisting );
+    TESTING_ASSERT( archive.getName() == "chunk1.abc" );
+    TESTING_ASSERT( archive.getNumTimeSamplings() == 3 );
+    TESTING_ASSERT( archive.getMaxNumSamplesForTimeSamplingIndex( 1 ) == 30 );
+    TESTING_ASSERT( archive.getMaxNumSamplesForTimeSamplingIndex( 2 ) == 4 );
+
+    Abc::ICompoundProperty props = getProps( archive );
+    TESTING_ASSERT( props.getNumProperties() == 5 );
+
+    // frame 10 is in the first two chunks, but only once here
+    Abc::IDoubleProperty frame( props, "frame" );
+    TESTING_ASSERT( frame.getNumSamples() == 30 );
+    TESTING_ASSERT( !frame.isConstant() );
+    for ( size_t i = 0; i < 30; ++i )
+    {
+        TESTING_ASSERT( frame.getValue( i ) == i + 1 );
+        TESTING_ASSERT( Imath::equalWithAbsError(
+            frame.getTimeSampling()->getSampleTime( i ), ( i + 1 ) * g_dt,
+            1e-9 ) );
+    }
+
+    Abc::ISampleSelector frame25( 25 * g_dt );
+    TESTING_ASSERT( frame.getValue( frame25 ) == 25 );
+
+    Abc::IV3fArrayProperty points( props, "P" );
+    TESTING_ASSERT( points.getNumSamples() == 30 );
+    TESTING_ASSERT( !points.isConstant() );
+    for ( size_t i = 0; i < 30; ++i )
+    {
+        Abc::V3fArraySamplePtr samp = points.getValue( i );
+        TESTING_ASSERT( samp->size() == ( i + 1 ) % 3 + 1 );
+        TESTING_ASSERT( ( *samp )[0].x == i + 1 );
+
+        Alembic::Util::Dimensions dims;
+        points.getDimensions( dims, i );
+        TESTING_ASSERT( dims.numPoints() == samp->size() );
+    }
+
+    Abc::IStringProperty label( props, "label" );
+    TESTING_ASSERT( label.getNumSamples() == 30 );
+    TESTING_ASSERT( label.isConstant() );
+    TESTING_ASSERT( label.getValue( 29 ) == "particles" );
+
+    // static properties don't pick up a sample from each chunk
+    Abc::IInt32Property still( props, "still" );
+    TESTING_ASSERT( still.getNumSamples() == 1 );
+    TESTING_ASSERT( still.isConstant() );
+    TESTING_ASSERT( still.getValue() == 7 );
+
+    // acyclic times are merged, overlaps and all
+    Abc::IDoubleProperty irregular( props, "irregular" );
+    TESTING_ASSERT( irregular.getTimeSampling() ==
+                    archive.getTimeSampling( 2 ) );
+    TESTING_ASSERT( irregular.getTimeSampling()->getNumStoredTimes() == 4 );
+    TESTING_ASSERT( irregular.getNumSamples() == 4 );
+    const double expected[4] = { 0.1, 0.2, 0.35, 0.5 };
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        TESTING_ASSERT( irregular.getValue( i ) == expected[i] );
+        TESTING_ASSERT( irregular.getTimeSampling()->getSampleTime( i ) ==
+                        expected[i] );
+    }
+}
+
+//-*****************************************************************************
+void lazyTest()
+{
+    std::vector< double > noTimes;
+    writeChunk( "lazy1.abc", 1, 10, noTimes );
+    writeChunk( "lazy2.abc", 11, 20, noTimes );
+
+    std::vector< std::string > names;
+    names.push_back( "lazy1.abc" );
+    names.push_back( "lazy2.abc" );
+    names.push_back( "lazyMissing.abc" );
+
+    Abc::IArchive archive( Alembic::AbcCoreConcat::ReadArchive()( names ),
+                           Abc::kWrapExisting );
+
+    // the hierarchy and the first chunk's samples don't need the others,
+    // though Abc asks for the number of samples before reading any
+    Abc::ICompoundProperty props = getProps( archive );
+    TESTING_ASSERT( props.getNumProperties() == 4 );
+    Abc::IDoubleProperty frame( props, "frame" );
+
+    double value = 0.0;
+    frame.getPtr()->asScalarPtr()->getSample( 9, &value );
+    TESTING_ASSERT( value == 10 );
+
+    bool threw = false;
+    try
+    {
+        frame.getValue( 10 );
+    }
+    catch ( std::exception & e )
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+}
+
+//-*****************************************************************************
+void orderTest()
+{
+    AbcA::ArchiveReaderPtr first =
+        Alembic::AbcCoreOgawa::ReadArchive()( "chunk1.abc" );
+    AbcA::ArchiveReaderPtr second =
+        Alembic::AbcCoreOgawa::ReadArchive()( "chunk2.abc" );
+
+    std::vector< AbcA::ArchiveReaderPtr > chunks;
+    chunks.push_back( second );
+    chunks.push_back( first );
+
+    bool threw = false;
+    try
+    {
+        Alembic::AbcCoreConcat::ReadArchive()( chunks );
+    }
+    catch ( std::exception & e )
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+}
+
+//-*****************************************************************************
+void samplingTypeTest()
+{
+    // the same frames, but at 30 instead of 24 frames per second
+    std::vector< double > times( 1, 0.5 );
+    writeChunk( "rate.abc", 11, 20, times, 1.0 / 30.0 );
+
+    std::vector< AbcA::ArchiveReaderPtr > chunks;
+    chunks.push_back( Alembic::AbcCoreOgawa::ReadArchive()( "chunk1.abc" ) );
+    chunks.push_back( Alembic::AbcCoreOgawa::ReadArchive()( "rate.abc" ) );
+
+    bool threw = false;
+    try
+    {
+        Alembic::AbcCoreConcat::ReadArchive()( chunks );
+    }
+    catch ( std::exception & e )
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::vector< double > times;
+    times.push_back( 0.1 );
+    times.push_back( 0.2 );
+    writeChunk( "chunk1.abc", 1, 10, times );
+
+    times[0] = 0.2;
+    times[1] = 0.35;
+    writeChunk( "chunk2.abc", 10, 20, times );
+
+    times.resize( 1 );
+    times[0] = 0.5;
+    writeChunk( "chunk3.abc", 21, 30, times );
+
+    std::vector< std::string > names;
+    names.push_back( "chunk1.abc" );
+    names.push_back( "chunk2.abc" );
+    names.push_back( "chunk3.abc" );
+    readConcatenated( Alembic::AbcCoreConcat::ReadArchive()( names ) );
+
+    std::vector< AbcA::ArchiveReaderPtr > chunks;
+    for ( size_t i = 0; i < names.size(); ++i )
+    {
+        chunks.push_back( Alembic::AbcCoreOgawa::ReadArchive()( names[i] ) );
+    }
+    readConcatenated( Alembic::AbcCoreConcat::ReadArchive()( chunks ) );
+
+    lazyTest();
+    orderTest();
+    samplingTypeTest();
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreConcat/All.h>
+#include <Alembic/AbcCoreConcat/ArImpl.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <sstream>
+
+namespace Abc = Alembic::Abc;
+namespace AbcA = Alembic::AbcCoreAbstract;
+namespace AC = Alembic::AbcCoreConcat;
+
+static const double g_dt = 1.0 / 24.0;
+static const size_t g_numFrames = 30;
+static const size_t g_maxOpen = 4;
+
+//-*****************************************************************************
+// One frame of a per-frame export, everything in it is static.  iNumChildren
+// of the mesh lets a file with a different hierarchy be written.
+std::string writeFrame( int iFrame, size_t iNumChildren = 1 )
+{
+    std::ostringstream name;
+    name << "seq." << iFrame << ".abc";
+
+    Abc::OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(),
+                           name.str() );
+
+    Abc::OObject geo( Abc::OObject( archive, Abc::kTop ), "geo" );
+    Abc::OObject mesh( geo, "mesh" );
+    for ( size_t i = 0; i < iNumChildren; ++i )
+    {
+        std::ostringstream child;
+        child << "child" << i;
+        Abc::OObject( mesh, child.str() );
+    }
+
+    Abc::OCompoundProperty props = mesh.getProperties();
+    Abc::ODoubleProperty( props, "frame" ).set( iFrame );
+    Abc::OInt32Property( props, "still" ).set( 7 );
+
+    std::vector< Imath::V3f > p( iFrame % 3 + 1, Imath::V3f( iFrame, 0, 0 ) );
+    Abc::OV3fArrayProperty( props, "P" ).set( p );
+
+    return name.str();
+}
+
+//-*****************************************************************************
+Abc::ICompoundProperty getProps( Abc::IArchive & iArchive )
+{
+    Abc::IObject geo( iArchive.getTop(), "geo" );
+    return Abc::IObject( geo, "mesh" ).getProperties();
+}
+
+//-*****************************************************************************
+void sequenceTest( const std::vector< std::string > & iNames )
+{
+    Abc::TimeSampling ts( g_dt, g_dt );
+    AbcA::ArchiveReaderPtr reader =
+        AC::ReadSequence( ts, g_maxOpen )( iNames );
+    AC::ArImplPtr impl = Alembic::Util::dynamic_pointer_cast<
+        AC::ArImpl, AbcA::ArchiveReader >( reader );
+
+    // only the first file is needed for the hierarchy
+    Abc::IArchive archive( reader, Abc::kWrapExisting );
+    Abc::ICompoundProperty props = getProps( archive );
+    TESTING_ASSERT( props.getNumProperties() == 3 );
+    TESTING_ASSERT( impl->getNumOpenChunks() == 1 );
+
+    TESTING_ASSERT( archive.getNumTimeSamplings() == 2 );
+    TESTING_ASSERT( *( archive.getTimeSampling( 1 ) ) == ts );
+    TESTING_ASSERT( archive.getMaxNumSamplesForTimeSamplingIndex( 1 ) ==
+                    ( AbcA::index_t ) g_numFrames );
+
+    Abc::IDoubleProperty frame( props, "frame" );
+    Abc::IV3fArrayProperty points( props, "P" );
+    TESTING_ASSERT( frame.getTimeSampling() == archive.getTimeSampling( 1 ) );
+    TESTING_ASSERT( frame.getNumSamples() == g_numFrames );
+    TESTING_ASSERT( points.getNumSamples() == g_numFrames );
+
+    // scrubbing forward opens every file once, however many properties are
+    // read from it, and never has more than the limit open
+    for ( size_t i = 0; i < g_numFrames; ++i )
+    {
+        Abc::ISampleSelector sel( ( i + 1 ) * g_dt );
+        TESTING_ASSERT( frame.getValue( sel ) == i + 1 );
+
+        Abc::V3fArraySamplePtr samp = points.getValue( sel );
+        TESTING_ASSERT( samp->size() == ( i + 1 ) % 3 + 1 );
+        TESTING_ASSERT( ( *samp )[0].x == i + 1 );
+
+        TESTING_ASSERT( impl->getNumOpenChunks() <= g_maxOpen + 1 );
+    }
+    TESTING_ASSERT( impl->getNumChunkOpens() == g_numFrames );
+
+    // the last few frames are still open
+    for ( size_t i = g_numFrames - g_maxOpen; i < g_numFrames; ++i )
+    {
+        TESTING_ASSERT( frame.getValue( i ) == i + 1 );
+    }
+    TESTING_ASSERT( impl->getNumChunkOpens() == g_numFrames );
+
+    TESTING_ASSERT( frame.getValue( 1 ) == 2 );
+    TESTING_ASSERT( impl->getNumChunkOpens() == g_numFrames + 1 );
+
+    // looking at every file for these still keeps to the limit
+    Abc::IInt32Property still( props, "still" );
+    TESTING_ASSERT( still.getNumSamples() == g_numFrames );
+    TESTING_ASSERT( still.isConstant() );
+    TESTING_ASSERT( !frame.isConstant() );
+    TESTING_ASSERT( !points.isConstant() );
+    TESTING_ASSERT( !points.getPtr()->isScalarLike() );
+    TESTING_ASSERT( impl->getNumOpenChunks() <= g_maxOpen + 1 );
+
+    // and only the first time
+    size_t numOpens = impl->getNumChunkOpens();
+    TESTING_ASSERT( still.isConstant() );
+    TESTING_ASSERT( !frame.isConstant() );
+    TESTING_ASSERT( !points.isConstant() );
+    TESTING_ASSERT( !points.getPtr()->isScalarLike() );
+    TESTING_ASSERT( impl->getNumChunkOpens() == numOpens );
+
+    // the rest of the hierarchy is the first file's
+    Abc::IObject mesh = getProps( archive ).getObject();
+    TESTING_ASSERT( mesh.getNumChildren() == 1 );
+    TESTING_ASSERT( mesh.getChild( 0 ).getName() == "child0" );
+}
+
+//-*****************************************************************************
+void mismatchTest( const std::vector< std::string > & iNames )
+{
+    // a file in the middle with an extra child is only found when a sample
+    // is read from it
+    std::vector< std::string > names = iNames;
+    names[5] = writeFrame( 100, 2 );
+
+    Abc::IArchive archive( AC::ReadSequence( Abc::TimeSampling( 1.0, 0.0 ) )(
+        names ), Abc::kWrapExisting );
+    Abc::IDoubleProperty frame( getProps( archive ), "frame" );
+    TESTING_ASSERT( frame.getValue( 4 ) == 5 );
+
+    bool threw = false;
+    try
+    {
+        frame.getValue( 5 );
+    }
+    catch ( std::exception & e )
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+
+    // acyclic sequences need a time for every file
+    threw = false;
+    std::vector< double > times( 2, 0.0 );
+    times[1] = 1.0;
+    try
+    {
+        AC::ReadSequence( Abc::TimeSampling( Abc::TimeSamplingType(
+            Abc::TimeSamplingType::kAcyclic ), times ) )( names );
+    }
+    catch ( std::exception & e )
+    {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::vector< std::string > names;
+    for ( size_t i = 1; i <= g_numFrames; ++i )
+    {
+        names.push_back( writeFrame( i ) );
+    }
+
+    sequenceTest( names );
+    mismatchTest( names );
+    return 0;
+}
@@ -34,18 +34,46 @@
 //
 //-*****************************************************************************
 
+#include <Alembic/AbcCoreConcat/All.h>
 #include <Alembic/AbcCoreHDF5/All.h>
 #include <Alembic/AbcCoreOgawa/All.h>
 #include <Alembic/AbcCoreFactory/IFactory.h>
 
+#include <limits.h>
+#include <stdlib.h>
+
 namespace Alembic {
 namespace AbcCoreFactory {
 namespace ALEMBIC_VERSION_NS {
 
+namespace {
+
+// the same file reached by different paths shares blocks in the cache
+std::string normalizePath( const std::string & iFileName )
+{
+#if defined _WIN32 || defined _WIN64
+    char * path = _fullpath( NULL, iFileName.c_str(), 0 );
+#else
+    char * path = realpath( iFileName.c_str(), NULL );
+#endif
+
+    if ( !path )
+    {
+        return iFileName;
+    }
+
+    std::string normalized( path );
+    free( path );
+    return normalized;
+}
+
+} // End anonymous namespace
+
 IFactory::IFactory()
 {
     m_cacheHierarchy = true;
     m_numStreams = 1;
+    m_maxOpenFiles = 16;
     m_policy = Alembic::Abc::ErrorHandler::kThrowPolicy;
 }
 
@@ -58,14 +86,33 @@ Alembic::Abc::IArchive IFactory::getArchive( const std::string & iFileName,
 {
 
     // try Ogawa first, use kQuietNoop at first in case we fail
-    Alembic::AbcCoreOgawa::ReadArchive ogawa( m_numStreams );
-    Alembic::Abc::IArchive archive( ogawa, iFileName,
-        Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+    Alembic::Abc::IArchive archive;
+    if ( m_blockCache )
+    {
+        Alembic::Util::shared_ptr< Alembic::Ogawa::FileStreamReader > file(
+            new Alembic::Ogawa::FileStreamReader( iFileName ) );
+        if ( file->isValid() )
+        {
+            Alembic::Ogawa::IStreamReaderPtr reader(
+                new Alembic::Ogawa::CachedStreamReader( file,
+                    normalizePath( iFileName ), m_blockCache ) );
+            Alembic::AbcCoreOgawa::ReadArchive ogawa( reader, m_numStreams );
+            archive = Alembic::Abc::IArchive( ogawa, iFileName,
+                Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+        }
+    }
+    else
+    {
+        Alembic::AbcCoreOgawa::ReadArchive ogawa( m_numStreams );
+        archive = Alembic::Abc::IArchive( ogawa, iFileName,
+            Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+    }
 
     if ( archive.valid() )
     {
         oType = kOgawa;
         archive.getErrorHandler().setPolicy( m_policy );
+        archive.setArraySampleAllocatorPtr( m_allocatorPtr );
         return archive;
     }
 
@@ -76,6 +123,7 @@ Alembic::Abc::IArchive IFactory::getArchive( const std::string & iFileName,
     {
         oType = kHDF5;
         archive.getErrorHandler().setPolicy( m_policy );
+        archive.setArraySampleAllocatorPtr( m_allocatorPtr );
         return archive;
     }
 
@@ -98,6 +146,57 @@ Alembic::Abc::IArchive IFactory::getArchive(
     if ( archive.valid() )
     {
         oType = kOgawa;
+        archive.setArraySampleAllocatorPtr( m_allocatorPtr );
+        return archive;
+    }
+
+    oType = kUnknown;
+    return Alembic::Abc::IArchive();
+}
+
+Alembic::Abc::IArchive IFactory::getArchive(
+    Alembic::Ogawa::IStreamReaderPtr iReader, CoreType & oType)
+{
+    Alembic::AbcCoreOgawa::ReadArchive ogawa( iReader, m_numStreams );
+    Alembic::Abc::IArchive archive( ogawa, "", m_policy, m_cachePtr );
+    if ( archive.valid() )
+    {
+        oType = kOgawa;
+        archive.setArraySampleAllocatorPtr( m_allocatorPtr );
+        return archive;
+    }
+
+    oType = kUnknown;
+    return Alembic::Abc::IArchive();
+}
+
+Alembic::Abc::IArchive IFactory::getArchiveSequence(
+    const std::vector< std::string > & iFileNames,
+    const Alembic::AbcCoreAbstract::TimeSampling & iSequence,
+    CoreType & oType )
+{
+    // only the first file is opened here, so it is all we can check
+    Alembic::AbcCoreAbstract::ArchiveReaderPtr reader;
+    try
+    {
+        Alembic::AbcCoreConcat::ReadSequence sequence( iSequence,
+            m_maxOpenFiles, m_numStreams );
+        reader = sequence( iFileNames, m_cachePtr );
+    }
+    catch ( std::exception & )
+    {
+        if ( m_policy == Alembic::Abc::ErrorHandler::kThrowPolicy )
+        {
+            throw;
+        }
+    }
+
+    if ( reader )
+    {
+        oType = kOgawa;
+        Alembic::Abc::IArchive archive( reader, Alembic::Abc::kWrapExisting,
+                                        m_policy );
+        archive.setArraySampleAllocatorPtr( m_allocatorPtr );
         return archive;
     }
 
@@ -37,8 +37,11 @@
 #ifndef _Alembic_AbcCoreFactory_IFactory_h_
 #define _Alembic_AbcCoreFactory_IFactory_h_
 
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
 #include <Alembic/AbcCoreAbstract/ReadArraySampleCache.h>
 #include <Alembic/Abc/IArchive.h>
+#include <Alembic/Ogawa/BlockCache.h>
+#include <Alembic/Ogawa/IStreamReader.h>
 
 namespace Alembic {
 namespace AbcCoreFactory {
@@ -73,6 +76,21 @@ public:
     Alembic::Abc::IArchive getArchive(
         const std::vector< std::istream * > & iStreams, CoreType & oType );
 
+    //! Read through the given reader instead of a file or streams, see
+    //! Alembic::Ogawa::IStreamReader.  This is also only valid for Ogawa,
+    //! and the reader is called from up to getOgawaNumStreams threads at once.
+    Alembic::Abc::IArchive getArchive(
+        Alembic::Ogawa::IStreamReaderPtr iReader, CoreType & oType );
+
+    //! Open a sequence of per-frame Ogawa files which all have the same
+    //! hierarchy, like foo.0001.abc, foo.0002.abc..., as one animated
+    //! archive.  Every property gets one sample from each file, at the times
+    //! of iSequence, only the first file's hierarchy is read up front.
+    Alembic::Abc::IArchive getArchiveSequence(
+        const std::vector< std::string > & iFileNames,
+        const Alembic::AbcCoreAbstract::TimeSampling & iSequence,
+        CoreType & oType );
+
     //! If opening an HDF5 file, sets whether to use the cached hierarchy
     //! if it exists, the default value is true
     void setHDF5CacheHierarchy( bool iCacheHierarchy )
@@ -96,6 +114,20 @@ public:
         return m_cachePtr;
     }
 
+    //! Set the allocator array samples are read into, only Ogawa uses this
+    void setSampleAllocator(
+        Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr iAllocatorPtr )
+    {
+        m_allocatorPtr = iAllocatorPtr;
+    }
+
+    //! Get the array sample allocator
+    Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr
+    getSampleAllocator() const
+    {
+        return m_allocatorPtr;
+    }
+
     //! Gets the number of streams that will be opened when opening an Ogawa
     //! file
     size_t getOgawaNumStreams() const { return m_numStreams; }
@@ -107,6 +139,31 @@ public:
         m_numStreams = iNumStreams;
     }
 
+    //! Sets the block cache Ogawa files are read through, pass
+    //! Alembic::Ogawa::BlockCache::getShared() to share one with everything
+    //! else in the process.  Files are read directly by default.
+    void setOgawaBlockCache( Alembic::Ogawa::BlockCachePtr iBlockCache )
+    {
+        m_blockCache = iBlockCache;
+    }
+
+    //! Gets the Ogawa block cache
+    Alembic::Ogawa::BlockCachePtr getOgawaBlockCache() const
+    {
+        return m_blockCache;
+    }
+
+    //! Gets how many files of a sequence, besides the first, are kept open
+    size_t getSequenceMaxOpenFiles() const { return m_maxOpenFiles; }
+
+    //! Sets how many files of a sequence, besides the first, are kept open
+    //! at once, the least recently read is closed to make room for the next
+    //! one.  The default is 16.
+    void setSequenceMaxOpenFiles( size_t iMaxOpenFiles )
+    {
+        m_maxOpenFiles = iMaxOpenFiles;
+    }
+
     //! Gets the error handler policy
     Alembic::Abc::ErrorHandler::Policy getPolicy() { return m_policy; }
 
@@ -119,7 +176,10 @@ public:
 private:
     bool m_cacheHierarchy;
     size_t m_numStreams;
+    size_t m_maxOpenFiles;
     Alembic::AbcCoreAbstract::ReadArraySampleCachePtr m_cachePtr;
+    Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr m_allocatorPtr;
+    Alembic::Ogawa::BlockCachePtr m_blockCache;
     Alembic::Abc::ErrorHandler::Policy m_policy;
 
 };
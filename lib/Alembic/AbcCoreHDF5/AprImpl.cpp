@@ -147,6 +147,21 @@ void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
     }
 }
 
+//-*****************************************************************************
+bool AprImpl::isChangedSince( index_t iPrevSampleIndex, index_t iSampleIndex )
+{
+    // Samples before the first change and after the last one are read
+    // from the same place.
+    if ( verifySampleIndex( iPrevSampleIndex ) ==
+         verifySampleIndex( iSampleIndex ) )
+    {
+        return false;
+    }
+
+    return AbcA::ArrayPropertyReader::isChangedSince( iPrevSampleIndex,
+                                                      iSampleIndex );
+}
+
 //-*****************************************************************************
 void AprImpl::readSample( hid_t iGroup,
                           const std::string &iSampleName,
@@ -62,6 +62,8 @@ public:
     virtual void getDimensions( index_t iSampleIndex, Dimensions & oDim );
     virtual void getAs( index_t iSample, void *iIntoLocation,
                         PlainOldDataType iPod );
+    virtual bool isChangedSince( index_t iPrevSampleIndex,
+                                 index_t iSampleIndex );
 protected:
     friend class SimplePrImpl<AbcA::ArrayPropertyReader, AprImpl,
                               AbcA::ArraySamplePtr&>;
@@ -87,6 +87,11 @@ public:
         m_readArraySampleCache = iPtr;
     }
 
+    // Samples read from HDF5 may be held on to by the
+    // ReadArraySampleCache, so they always come from the heap and the
+    // ArchiveReader defaults for the ArraySampleAllocator, which ignore
+    // it, are kept.
+
     virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
         uint32_t iIndex );
 
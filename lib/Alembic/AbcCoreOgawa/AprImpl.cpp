@@ -104,14 +104,18 @@ void AprImpl::getSample( index_t iSampleIndex, AbcA::ArraySamplePtr &oSample )
 {
     size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
+    Alembic::Util::shared_ptr< ArImpl > archive =
+        Alembic::Util::dynamic_pointer_cast< ArImpl, AbcA::ArchiveReader > (
+            getObject()->getArchive() );
+
+    StreamIDPtr streamId = archive->getStreamID();
 
     std::size_t id = streamId->getID();
     Ogawa::IDataPtr dims = m_group->getData(index + 1, id);
     Ogawa::IDataPtr data = m_group->getData(index, id);
 
-    ReadArraySample( dims, data, id, m_header->header.getDataType(), oSample );
+    ReadArraySample( dims, data, id, m_header->header.getDataType(),
+                     archive->getArraySampleAllocatorPtr(), oSample );
 }
 
 //-*****************************************************************************
@@ -165,6 +169,21 @@ bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey )
     return false;
 }
 
+//-*****************************************************************************
+bool AprImpl::isChangedSince( index_t iPrevSampleIndex, index_t iSampleIndex )
+{
+    // Samples before the first change and after the last one share the
+    // same stored sample.
+    if ( m_header->verifyIndex( iPrevSampleIndex ) ==
+         m_header->verifyIndex( iSampleIndex ) )
+    {
+        return false;
+    }
+
+    return AbcA::ArrayPropertyReader::isChangedSince( iPrevSampleIndex,
+                                                      iSampleIndex );
+}
+
 //-*****************************************************************************
 bool AprImpl::isScalarLike()
 {
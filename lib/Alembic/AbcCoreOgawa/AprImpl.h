@@ -68,6 +68,9 @@ public:
     virtual std::pair<index_t, chrono_t> getCeilIndex( chrono_t iTime );
     virtual std::pair<index_t, chrono_t> getNearIndex( chrono_t iTime );
     virtual bool getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey );
+
+    virtual bool isChangedSince( index_t iPrevSampleIndex,
+                                 index_t iSampleIndex );
     virtual void getDimensions( index_t iSampleIndex,
                                 Alembic::Util::Dimensions & oDim );
     virtual bool isScalarLike();
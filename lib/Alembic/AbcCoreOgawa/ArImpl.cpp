@@ -75,6 +75,26 @@ ArImpl::ArImpl( const std::vector< std::istream * > & iStreams )
     init();
 }
 
+//-*****************************************************************************
+ArImpl::ArImpl( Ogawa::IStreamReaderPtr iReader,
+                const std::string &iFileName,
+                std::size_t iNumStreams )
+  : m_fileName( iFileName )
+  , m_archive( iReader )
+  , m_header( new AbcA::ObjectHeader() )
+  , m_manager( iNumStreams )
+{
+    ABCA_ASSERT( m_archive.isValid(),
+                 "Could not open as Ogawa file from provided reader: "
+                 << m_fileName );
+
+    ABCA_ASSERT( m_archive.isFrozen(),
+        "Ogawa reader data not cleanly closed while being written: "
+        << m_fileName );
+
+    init();
+}
+
 //-*****************************************************************************
 void ArImpl::init()
 {
@@ -119,7 +139,7 @@ void ArImpl::init()
     ReadTimeSamplesAndMax( group->getData( 4, 0 ),
                            m_timeSamples, m_maxSamples );
 
-    ReadIndexedMetaData( group->getData( 5, 0 ), m_indexMetaData );
+    ReadIndexedMetaData( group->getData( 5, 0 ), version, m_indexMetaData );
 
     m_data.reset( new OrData( group->getGroup( 2, false, 0 ), "", 0, *this,
                               m_indexMetaData ) );
@@ -60,6 +60,9 @@ private:
 
     ArImpl( const std::vector< std::istream * > & iStreams );
 
+    ArImpl( Ogawa::IStreamReaderPtr iReader, const std::string &iFileName,
+            std::size_t iNumStreams );
+
 public:
 
     virtual ~ArImpl();
@@ -87,6 +90,18 @@ public:
     {
     }
 
+    virtual AbcA::ArraySampleAllocatorPtr getArraySampleAllocatorPtr()
+    {
+        return m_allocator;
+    }
+
+    //! THIS METHOD IS NOT MULTITHREAD SAFE
+    virtual void
+    setArraySampleAllocatorPtr( AbcA::ArraySampleAllocatorPtr iPtr )
+    {
+        m_allocator = iPtr;
+    }
+
     virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
         Util::uint32_t iIndex );
 
@@ -125,6 +140,8 @@ private:
     StreamManager m_manager;
 
     std::vector< AbcA::MetaData > m_indexMetaData;
+
+    AbcA::ArraySampleAllocatorPtr m_allocator;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
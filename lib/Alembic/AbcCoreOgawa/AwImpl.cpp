@@ -45,11 +45,14 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 AwImpl::AwImpl( const std::string &iFileName,
-                const AbcA::MetaData &iMetaData )
+                const AbcA::MetaData &iMetaData,
+                Util::int32_t iFileVersion,
+                bool iContiguousHierarchy )
   : m_fileName( iFileName )
   , m_metaData( iMetaData )
-  , m_archive( iFileName )
-  , m_metaDataMap( new MetaDataMap() )
+  , m_fileVersion( iFileVersion )
+  , m_archive( iFileName, iContiguousHierarchy )
+  , m_metaDataMap( new MetaDataMap( iFileVersion >= 1 ) )
 {
 
     // add default time sampling
@@ -67,10 +70,13 @@ AwImpl::AwImpl( const std::string &iFileName,
 
 //-*****************************************************************************
 AwImpl::AwImpl( std::ostream * iStream,
-                const AbcA::MetaData &iMetaData )
+                const AbcA::MetaData &iMetaData,
+                Util::int32_t iFileVersion,
+                bool iContiguousHierarchy )
   : m_metaData( iMetaData )
-  , m_archive( iStream )
-  , m_metaDataMap( new MetaDataMap() )
+  , m_fileVersion( iFileVersion )
+  , m_archive( iStream, iContiguousHierarchy )
+  , m_metaDataMap( new MetaDataMap( iFileVersion >= 1 ) )
 {
     // add default time sampling
     AbcA::TimeSamplingPtr ts( new AbcA::TimeSampling() );
@@ -91,8 +97,7 @@ void AwImpl::init()
     // set the version using Ogawa native calls
     // This expresses the AbcCoreOgawa version - how properties,
     // are stored within Ogawa, etc.
-    Util::int32_t version = ALEMBIC_OGAWA_FILE_VERSION;
-    m_archive.getGroup()->addData( 4, &version );
+    m_archive.getGroup()->addData( 4, &m_fileVersion );
 
     // This is the Alembic library version XXYYZZ
     // Where XX is the major version, YY is the minor version
@@ -235,7 +240,8 @@ AwImpl::~AwImpl()
         // meta data can be kinda big and is very specialized don't worry
         // about putting it into the meta data map
         std::string metaData = m_metaData.serialize();
-        m_archive.getGroup()->addData( metaData.size(), metaData.c_str() );
+        m_archive.getGroup()->addHierarchyData( metaData.size(),
+                                                metaData.c_str() );
 
         std::vector< Util::uint8_t > data;
         Util::uint32_t numSamplings = getNumTimeSamplings();
@@ -246,7 +252,8 @@ AwImpl::~AwImpl()
             WriteTimeSampling( data, maxSample, *timePtr );
         }
 
-        m_archive.getGroup()->addData( data.size(), &( data.front() ) );
+        m_archive.getGroup()->addHierarchyData( data.size(),
+                                                &( data.front() ) );
         m_metaDataMap->write( m_archive.getGroup() );
     }
 
@@ -57,10 +57,14 @@ private:
     friend struct WriteArchive;
 
     AwImpl( const std::string &iFileName,
-            const AbcA::MetaData &iMetaData );
+            const AbcA::MetaData &iMetaData,
+            Util::int32_t iFileVersion,
+            bool iContiguousHierarchy );
 
     AwImpl( std::ostream * iStream,
-            const AbcA::MetaData & iMetaData );
+            const AbcA::MetaData & iMetaData,
+            Util::int32_t iFileVersion,
+            bool iContiguousHierarchy );
 
 public:
     virtual ~AwImpl();
@@ -106,6 +110,7 @@ private:
     void init();
     std::string m_fileName;
     AbcA::MetaData m_metaData;
+    Util::int32_t m_fileVersion;
     Alembic::Ogawa::OArchive m_archive;
 
     Alembic::Util::weak_ptr< AbcA::ObjectWriter > m_top;
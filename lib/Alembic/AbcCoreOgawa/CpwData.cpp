@@ -234,7 +234,7 @@ void CpwData::writePropertyHeaders( MetaDataMapPtr iMetaDataMap )
 
     if ( !data.empty() )
     {
-        m_group->addData( data.size(), &( data.front() ) );
+        m_group->addHierarchyData( data.size(), &( data.front() ) );
     }
 }
 
@@ -54,7 +54,12 @@
 #include <assert.h>
 #include <string.h>
 
-#define ALEMBIC_OGAWA_FILE_VERSION 0
+// The newest file version this library can read and write.  Version 1 has
+// a metadata table without the 254 entry and 256 byte limits, see
+// MetaDataMap.  Version 0 is still written by default so that older
+// libraries can read the files.
+#define ALEMBIC_OGAWA_FILE_VERSION 1
+#define ALEMBIC_OGAWA_DEFAULT_FILE_VERSION 0
 
 //-*****************************************************************************
 
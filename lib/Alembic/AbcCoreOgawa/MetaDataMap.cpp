@@ -35,6 +35,7 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreOgawa/MetaDataMap.h>
+#include <Alembic/AbcCoreOgawa/WriteUtil.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -47,6 +48,20 @@ Util::uint32_t MetaDataMap::getIndex( const std::string & iStr )
     {
         return 0;
     }
+    else if ( m_wideIndices )
+    {
+        std::map< std::string, Util::uint32_t >::iterator it =
+            m_map.find( iStr );
+
+        if ( it != m_map.end() )
+        {
+            return it->second + 1;
+        }
+
+        Util::uint32_t index = m_map.size();
+        m_map[iStr] = index;
+        return index + 1;
+    }
     // we only want small meta data strings in our map since they are the
     // most likely to be repeated over and over
     else if ( iStr.size() < 256 )
@@ -98,13 +113,20 @@ void MetaDataMap::write( Ogawa::OGroupPtr iParent )
     for ( jt = mdVec.begin(), jtEnd = mdVec.end(); jt != jtEnd; ++jt )
     {
 
-        // all these strings are less than 256 chars so just push back size
-        // as 1 byte
-        buf.push_back( jt->size() );
+        // without wide indices all these strings are less than 256 chars
+        // so just push back size as 1 byte
+        if ( m_wideIndices )
+        {
+            pushVarUint32( buf, jt->size() );
+        }
+        else
+        {
+            buf.push_back( jt->size() );
+        }
         buf.insert( buf.end(), jt->begin(), jt->end() );
     }
 
-    iParent->addData( buf.size(), ( const void * )&buf.front() );
+    iParent->addHierarchyData( buf.size(), ( const void * )&buf.front() );
 }
 
 } // End namespace ALEMBIC_VERSION_NS
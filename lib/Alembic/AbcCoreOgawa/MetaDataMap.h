@@ -45,19 +45,25 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 // convenience class which is meant to map serialized meta data to an index
-// It will only hold 254 strings, and won't hold any that are over 256 bytes
+// By default it will only hold 254 strings, and won't hold any that are over
+// 256 bytes.  With wide indices (file version 1 and up) it holds every string,
+// indices past 254 are written as varints after the header which uses them.
 class MetaDataMap
 {
 public:
-    MetaDataMap() {};
+    MetaDataMap( bool iWideIndices = false ) : m_wideIndices( iWideIndices ) {};
     ~MetaDataMap() {};
 
-    // will return 0xff if iStr is too long, or we've run out of indices
+    // will return 0xff if iStr is too long, or we've run out of indices,
+    // which can't happen with wide indices where 0xff is a valid index
     // 0 will be returned if iStr is empty
     Util::uint32_t getIndex( const std::string & iStr );
     void write( Ogawa::OGroupPtr iParent );
+
+    bool hasWideIndices() const { return m_wideIndices; }
 private:
     std::map< std::string, Util::uint32_t > m_map;
+    bool m_wideIndices;
 };
 
 typedef Alembic::Util::shared_ptr<MetaDataMap> MetaDataMapPtr;
@@ -88,6 +88,7 @@ OrData::~OrData()
 AbcA::CompoundPropertyReaderPtr
 OrData::getProperties( AbcA::ObjectReaderPtr iParent )
 {
+    Alembic::Util::scoped_lock l( m_lock );
     AbcA::CompoundPropertyReaderPtr ret = m_top.lock();
     if ( ! ret )
     {
@@ -149,6 +150,7 @@ OrData::getChild( AbcA::ObjectReaderPtr iParent, size_t i )
     ABCA_ASSERT( i < m_children.size(),
         "Out of range index in OrData::getChild: " << i );
 
+    Alembic::Util::scoped_lock l( m_lock );
     AbcA::ObjectReaderPtr optr = m_children[i].made.lock();
     if ( ! optr )
     {
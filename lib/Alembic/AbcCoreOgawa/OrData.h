@@ -100,6 +100,10 @@ private:
     // Our "top" property.
     Alembic::Util::weak_ptr< AbcA::CompoundPropertyReader > m_top;
     Alembic::Util::shared_ptr < CprData > m_data;
+
+    // guards the children and the properties made on demand, since several
+    // threads can walk the same object
+    Alembic::Util::mutex m_lock;
 };
 
 typedef Alembic::Util::shared_ptr<OrData> OrDataPtr;
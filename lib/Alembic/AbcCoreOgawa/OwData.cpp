@@ -216,7 +216,7 @@ void OwData::writeHeaders( MetaDataMapPtr iMetaDataMap,
 
     if ( !data.empty() )
     {
-        m_group->addData( data.size(), &( data.front() ) );
+        m_group->addHierarchyData( data.size(), &( data.front() ) );
     }
 
     m_data->writePropertyHeaders( iMetaDataMap );
@@ -69,14 +69,9 @@ ReadDimensions( Ogawa::IDataPtr iDims,
         // we write them as uint64_t so / 8
         std::size_t numRanks = iDims->getSize() / 8;
 
+        // Dimensions are uint64_t too, so read straight into them
         oDim.setRank( numRanks );
-
-        std::vector< Util::uint64_t > dims( numRanks );
-        iDims->read( numRanks * 8, &( dims.front() ), 0, iThreadId );
-        for ( std::size_t i = 0; i < numRanks; ++i )
-        {
-            oDim[i] = dims[i];
-        }
+        iDims->read( numRanks * 8, oDim.rootPtr(), 0, iThreadId );
     }
 }
 
@@ -1416,13 +1411,14 @@ ReadArraySample( Ogawa::IDataPtr iDims,
                  Ogawa::IDataPtr iData,
                  size_t iThreadId,
                  const AbcA::DataType &iDataType,
+                 AbcA::ArraySampleAllocatorPtr iAllocator,
                  AbcA::ArraySamplePtr &oSample )
 {
     // get our dimensions
     Util::Dimensions dims;
     ReadDimensions( iDims, iData, iThreadId, iDataType, dims );
 
-    oSample = AbcA::AllocateArraySample( iDataType, dims );
+    oSample = AbcA::AllocateArraySample( iDataType, dims, iAllocator );
 
     ReadData( const_cast<void*>( oSample->getData() ), iData,
         iThreadId, iDataType, iDataType.getPod() );
@@ -1472,6 +1468,26 @@ ReadTimeSamplesAndMax( Ogawa::IDataPtr iData,
     }
 }
 
+//-*****************************************************************************
+Util::uint32_t GetVarUint32( const std::vector< char > & iBuf,
+                             std::size_t & ioPos )
+{
+    Util::uint32_t retVal = 0;
+    Util::uint32_t shift = 0;
+    Util::uint8_t byte = 0x80;
+
+    while ( byte & 0x80 )
+    {
+        ABCA_ASSERT( ioPos < iBuf.size() && shift < 32,
+            "Invalid variable length integer" );
+
+        byte = ( Util::uint8_t ) iBuf[ioPos++];
+        retVal |= ( Util::uint32_t )( byte & 0x7f ) << shift;
+        shift += 7;
+    }
+    return retVal;
+}
+
 //-*****************************************************************************
 void
 ReadObjectHeaders( Ogawa::IGroupPtr iGroup,
@@ -1501,13 +1517,22 @@ ReadObjectHeaders( Ogawa::IGroupPtr iGroup,
         std::string name( &buf[pos], nameSize );
         pos += nameSize;
 
-        Util::uint8_t metaDataIndex = buf[pos++];
+        Util::uint32_t metaDataIndex = ( Util::uint8_t ) buf[pos++];
 
         ObjectHeaderPtr objPtr( new AbcA::ObjectHeader() );
         objPtr->setName( name );
         objPtr->setFullName( iParentName + "/" + name );
 
-        if ( metaDataIndex == 0xff )
+        // a table this large can only come from wide indices, the real
+        // index follows
+        if ( metaDataIndex == 0xff && iMetaDataVec.size() > 0xff )
+        {
+            metaDataIndex = GetVarUint32( buf, pos );
+            ABCA_ASSERT( metaDataIndex < iMetaDataVec.size(),
+                "Invalid meta data index: " << metaDataIndex );
+            objPtr->getMetaData() = iMetaDataVec[metaDataIndex];
+        }
+        else if ( metaDataIndex == 0xff )
         {
             Util::uint32_t metaDataSize = *( (Util::uint32_t *)( &buf[pos] ) );
             pos += 4;
@@ -1696,7 +1721,16 @@ ReadPropertyHeaders( Ogawa::IGroupPtr iGroup,
 
         Util::uint32_t metaDataIndex = ( info & metaDataIndexMask ) >> 20;
 
-        if ( metaDataIndex == 0xff )
+        // a table this large can only come from wide indices, the real
+        // index follows the name
+        if ( metaDataIndex == 0xff && iMetaDataVec.size() > 0xff )
+        {
+            metaDataIndex = GetVarUint32( buf, pos );
+            ABCA_ASSERT( metaDataIndex < iMetaDataVec.size(),
+                "Invalid meta data index: " << metaDataIndex );
+            header->header.setMetaData( iMetaDataVec[metaDataIndex] );
+        }
+        else if ( metaDataIndex == 0xff )
         {
             Util::uint32_t metaDataSize =
                 GetUint32WithHint( buf, sizeHint, pos );
@@ -1718,8 +1752,10 @@ ReadPropertyHeaders( Ogawa::IGroupPtr iGroup,
     }
 }
 
+//-*****************************************************************************
 void
 ReadIndexedMetaData( Ogawa::IDataPtr iData,
+                     Util::int32_t iFileVersion,
                      std::vector< AbcA::MetaData > & oMetaDataVec )
 {
     // add the default empty meta data
@@ -1732,8 +1768,21 @@ ReadIndexedMetaData( Ogawa::IDataPtr iData,
     std::size_t pos = 0;
     while ( pos < buf.size() )
     {
-        // these are all small (less than 256 byte) meta data strings
-        Util::uint8_t metaDataSize = buf[pos++];
+        // before version 1 these are all small (less than 256 byte) meta
+        // data strings
+        Util::uint32_t metaDataSize = 0;
+        if ( iFileVersion >= 1 )
+        {
+            metaDataSize = GetVarUint32( buf, pos );
+        }
+        else
+        {
+            metaDataSize = ( Util::uint8_t ) buf[pos++];
+        }
+
+        ABCA_ASSERT( pos + metaDataSize <= buf.size(),
+            "Invalid indexed meta data size: " << metaDataSize );
+
         std::string metaData( &buf[pos], metaDataSize );
         pos += metaDataSize;
         AbcA::MetaData md;
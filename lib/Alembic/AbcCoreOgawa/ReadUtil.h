@@ -70,6 +70,7 @@ ReadArraySample( Ogawa::IDataPtr iDims,
                  Ogawa::IDataPtr iData,
                  size_t iThreadId,
                  const AbcA::DataType &iDataType,
+                 AbcA::ArraySampleAllocatorPtr iAllocator,
                  AbcA::ArraySamplePtr &oSample );
 
 //-*****************************************************************************
@@ -99,6 +100,7 @@ ReadPropertyHeaders( Ogawa::IGroupPtr iGroup,
 //-*****************************************************************************
 void
 ReadIndexedMetaData( Ogawa::IDataPtr iData,
+                     Util::int32_t iFileVersion,
                      std::vector< AbcA::MetaData > & oMetaDataVec );
 
 } // End namespace ALEMBIC_VERSION_NS
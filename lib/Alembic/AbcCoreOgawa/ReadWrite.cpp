@@ -45,15 +45,40 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 WriteArchive::WriteArchive()
+    : m_fileVersion( ALEMBIC_OGAWA_DEFAULT_FILE_VERSION )
+    , m_contiguousHierarchy( false )
 {
 }
 
+//-*****************************************************************************
+WriteArchive::WriteArchive( Util::int32_t iFileVersion )
+    : m_fileVersion( iFileVersion )
+    , m_contiguousHierarchy( false )
+{
+    ABCA_ASSERT( iFileVersion >= 0 &&
+                 iFileVersion <= ALEMBIC_OGAWA_FILE_VERSION,
+                 "Unsupported file version requested: " << iFileVersion );
+}
+
+//-*****************************************************************************
+WriteArchive::WriteArchive( Util::int32_t iFileVersion,
+                            bool iContiguousHierarchy )
+    : m_fileVersion( iFileVersion )
+    , m_contiguousHierarchy( iContiguousHierarchy )
+{
+    ABCA_ASSERT( iFileVersion >= 0 &&
+                 iFileVersion <= ALEMBIC_OGAWA_FILE_VERSION,
+                 "Unsupported file version requested: " << iFileVersion );
+}
+
 //-*****************************************************************************
 AbcA::ArchiveWriterPtr
 WriteArchive::operator()( const std::string &iFileName,
                           const AbcA::MetaData &iMetaData ) const
 {
-    AbcA::ArchiveWriterPtr archivePtr( new AwImpl( iFileName, iMetaData ) );
+    AbcA::ArchiveWriterPtr archivePtr( new AwImpl( iFileName, iMetaData,
+                                                   m_fileVersion,
+                                                   m_contiguousHierarchy ) );
     return archivePtr;
 }
 
@@ -62,7 +87,9 @@ AbcA::ArchiveWriterPtr
 WriteArchive::operator()( std::ostream * iStream,
                           const AbcA::MetaData &iMetaData ) const
 {
-    AbcA::ArchiveWriterPtr archivePtr( new AwImpl( iStream, iMetaData ) );
+    AbcA::ArchiveWriterPtr archivePtr( new AwImpl( iStream, iMetaData,
+                                                   m_fileVersion,
+                                                   m_contiguousHierarchy ) );
     return archivePtr;
 }
 
@@ -84,13 +111,25 @@ ReadArchive::ReadArchive( const std::vector< std::istream * > & iStreams )
 {
 }
 
+//-*****************************************************************************
+ReadArchive::ReadArchive( Alembic::Ogawa::IStreamReaderPtr iReader,
+                          size_t iNumStreams )
+    : m_numStreams( iNumStreams ), m_reader( iReader )
+{
+}
+
 //-*****************************************************************************
 AbcA::ArchiveReaderPtr
 ReadArchive::operator()( const std::string &iFileName ) const
 {
     AbcA::ArchiveReaderPtr archivePtr;
 
-    if ( m_streams.empty() )
+    if ( m_reader )
+    {
+        archivePtr = AbcA::ArchiveReaderPtr(
+            new ArImpl( m_reader, iFileName, m_numStreams ) );
+    }
+    else if ( m_streams.empty() )
     {
         archivePtr =
             AbcA::ArchiveReaderPtr( new ArImpl( iFileName, m_numStreams ) );
@@ -111,7 +150,12 @@ ReadArchive::operator()( const std::string &iFileName,
 {
     AbcA::ArchiveReaderPtr archivePtr;
 
-    if ( m_streams.empty() )
+    if ( m_reader )
+    {
+        archivePtr = AbcA::ArchiveReaderPtr(
+            new ArImpl( m_reader, iFileName, m_numStreams ) );
+    }
+    else if ( m_streams.empty() )
     {
         archivePtr =
             AbcA::ArchiveReaderPtr( new ArImpl( iFileName, m_numStreams ) );
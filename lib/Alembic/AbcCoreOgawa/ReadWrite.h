@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreOgawa_ReadWrite_h_
 
 #include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/Ogawa/IStreamReader.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -50,6 +51,18 @@ class WriteArchive
 public:
     WriteArchive();
 
+    // Write the given file version, which is ALEMBIC_OGAWA_DEFAULT_FILE_VERSION
+    // by default.  Version 1 lifts the limits on indexed meta data so that
+    // richly tagged hierarchies don't inline it in every header, but can't be
+    // read by libraries older than this one.
+    explicit WriteArchive( Util::int32_t iFileVersion );
+
+    // iContiguousHierarchy holds the hierarchy, headers, time samplings and
+    // indexed meta data in memory and writes them together at the end of the
+    // file, so that opening and traversing the archive is one sequential
+    // read instead of many small scattered ones.  Any reader can read it.
+    WriteArchive( Util::int32_t iFileVersion, bool iContiguousHierarchy );
+
     ::Alembic::AbcCoreAbstract::ArchiveWriterPtr
     operator()( const std::string &iFileName,
                 const ::Alembic::AbcCoreAbstract::MetaData &iMetaData ) const;
@@ -57,6 +70,10 @@ public:
     ::Alembic::AbcCoreAbstract::ArchiveWriterPtr
     operator()( std::ostream * iStream,
                 const ::Alembic::AbcCoreAbstract::MetaData &iMetaData ) const;
+
+private:
+    Util::int32_t m_fileVersion;
+    bool m_contiguousHierarchy;
 };
 
 //-*****************************************************************************
@@ -75,6 +92,12 @@ public:
     // delete them
     ReadArchive( const std::vector< std::istream * > & iStreams );
 
+    // Read through the provided reader, which has to be safe to call from
+    // iNumStreams threads at once, no locks are held around it.  The file
+    // name given to operator() is only used for error messages.
+    ReadArchive( Alembic::Ogawa::IStreamReaderPtr iReader,
+                 size_t iNumStreams = 1 );
+
     // open the file
     ::Alembic::AbcCoreAbstract::ArchiveReaderPtr
     operator()( const std::string &iFileName ) const;
@@ -88,6 +111,7 @@ public:
 private:
     size_t m_numStreams;
     std::vector< std::istream * > m_streams;
+    Alembic::Ogawa::IStreamReaderPtr m_reader;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
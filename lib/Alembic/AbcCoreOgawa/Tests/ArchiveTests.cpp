@@ -267,11 +267,12 @@ void testReadWriteMaxNumSamplesArchive()
     }
 }
 
-void writeArchive( const std::string & iName, std::ostream * iStream )
+void writeArchive( const std::string & iName, std::ostream * iStream,
+                   bool iContiguousHierarchy = false )
 {
     ABCA::MetaData m;
     ABCA::ObjectHeader header("a", m);
-    AO::WriteArchive w;
+    AO::WriteArchive w(0, iContiguousHierarchy);
     ABCA::ArchiveWriterPtr a;
     if (iStream)
     {
@@ -326,7 +327,9 @@ void writeArchive( const std::string & iName, std::ostream * iStream )
     }
 }
 
-void readArchive( const std::string & iName, std::istream * iStream )
+void readArchive( const std::string & iName, std::istream * iStream,
+                  Alembic::Ogawa::IStreamReaderPtr iReader =
+                      Alembic::Ogawa::IStreamReaderPtr() )
 {
     std::vector< std::istream * > streamVec;
     if (iStream)
@@ -334,6 +337,10 @@ void readArchive( const std::string & iName, std::istream * iStream )
         streamVec.push_back(iStream);
     }
     Alembic::AbcCoreOgawa::ReadArchive r(streamVec);
+    if ( iReader )
+    {
+        r = Alembic::AbcCoreOgawa::ReadArchive( iReader, 4 );
+    }
     ABCA::ArchiveReaderPtr a = r( iName );
     std::vector< ABCA::ObjectReaderPtr > objs;
     objs.push_back( a->getTop() );
@@ -391,11 +398,25 @@ int main ( int argc, char *argv[] )
     writeArchive("test.abc", NULL);
     readArchive("test.abc", NULL);
 
+    Alembic::Ogawa::IStreamReaderPtr reader(
+        new Alembic::Ogawa::FileStreamReader( "test.abc" ) );
+    readArchive("test.abc", NULL, reader);
+
     std::stringstream strStream;
     writeArchive("", &strStream);
     strStream.seekg(0, strStream.beg);
     readArchive("", &strStream);
 
+    // the same archive with all of the hierarchy at the end of the file
+    writeArchive("testContiguous.abc", NULL, true);
+    readArchive("testContiguous.abc", NULL);
+
+    std::stringstream contiguousStream;
+    contiguousStream << "prefix";
+    writeArchive("", &contiguousStream, true);
+    contiguousStream.seekg(6, contiguousStream.beg);
+    readArchive("", &contiguousStream);
+
     writeVeryEmptyArchive("testEmpty.abc");
     readVeryEmptyArchive("testEmpty.abc");
 
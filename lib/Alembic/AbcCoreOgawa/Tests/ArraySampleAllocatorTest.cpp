@@ -0,0 +1,273 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <vector>
+
+//-*****************************************************************************
+// Counts calls to operator new to show how much heap traffic reading a
+// frame generates with and without an ArraySampleArena.
+//-*****************************************************************************
+static size_t g_numAllocs = 0;
+
+void * operator new( size_t iSize )
+{
+    ++g_numAllocs;
+    void * ptr = malloc( iSize ? iSize : 1 );
+    if ( !ptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void * operator new[]( size_t iSize )
+{
+    return operator new( iSize );
+}
+
+void operator delete( void * iPtr ) throw()
+{
+    free( iPtr );
+}
+
+void operator delete[]( void * iPtr ) throw()
+{
+    free( iPtr );
+}
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+using namespace Alembic::Util;
+
+static const size_t g_numProps = 200;
+static const size_t g_numPoints = 5000;
+
+//-*****************************************************************************
+double now()
+{
+    timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//-*****************************************************************************
+void writeHeavyFrame( const std::string &iName )
+{
+    AO::WriteArchive w;
+    ABCA::ArchiveWriterPtr a = w( iName, ABCA::MetaData() );
+    ABCA::CompoundPropertyWriterPtr parent = a->getTop()->getProperties();
+
+    ABCA::DataType v3f( kFloat32POD, 3 );
+    std::vector<float> vals( g_numPoints * 3 );
+    for ( size_t i = 0; i < g_numProps; ++i )
+    {
+        std::ostringstream name;
+        name << "P" << i;
+        ABCA::ArrayPropertyWriterPtr awp =
+            parent->createArrayProperty( name.str(), ABCA::MetaData(),
+                                         v3f, 0 );
+        vals[0] = ( float ) i;
+        awp->setSample( ABCA::ArraySample( &( vals.front() ), v3f,
+                                           Dimensions( g_numPoints ) ) );
+    }
+
+    ABCA::DataType strType( kStringPOD, 1 );
+    ABCA::ArrayPropertyWriterPtr swp =
+        parent->createArrayProperty( "names", ABCA::MetaData(), strType, 0 );
+    std::vector<std::string> strs( 3 );
+    strs[0] = "a";
+    strs[1] = "a much longer string that won't fit in any small buffer";
+    strs[2] = "";
+    swp->setSample( ABCA::ArraySample( &( strs.front() ), strType,
+                                       Dimensions( 3 ) ) );
+}
+
+//-*****************************************************************************
+void readFrame( ABCA::CompoundPropertyReaderPtr iParent,
+                std::vector<ABCA::ArraySamplePtr> &oSamples )
+{
+    oSamples.resize( iParent->getNumProperties() );
+    for ( size_t i = 0; i < oSamples.size(); ++i )
+    {
+        iParent->getArrayProperty( i )->getSample( 0, oSamples[i] );
+    }
+}
+
+//-*****************************************************************************
+void testArena()
+{
+    ABCA::ArraySampleArena * arena = new ABCA::ArraySampleArena( 1024 );
+    ABCA::ArraySampleAllocatorPtr arenaPtr( arena );
+
+    ABCA::ArraySamplePtr floats = ABCA::AllocateArraySample(
+        ABCA::DataType( kFloat32POD, 3 ), Dimensions( 100 ), arenaPtr );
+    ABCA::ArraySamplePtr strings = ABCA::AllocateArraySample(
+        ABCA::DataType( kStringPOD, 1 ), Dimensions( 4 ), arenaPtr );
+    ABCA::ArraySamplePtr empty = ABCA::AllocateArraySample(
+        ABCA::DataType( kInt32POD, 1 ), Dimensions( 0 ), arenaPtr );
+
+    TESTING_ASSERT( floats->getDimensions().numPoints() == 100 );
+    TESTING_ASSERT( ( ( size_t ) floats->getData() ) % 16 == 0 );
+    TESTING_ASSERT( empty->getData() == NULL );
+
+    std::string *strData = ( std::string * )( strings->getData() );
+    TESTING_ASSERT( strData[3].empty() );
+    strData[1] = "a string long enough to need its own heap allocation";
+
+    // the large sample got a block of its own
+    TESTING_ASSERT( arena->getNumBytesReserved() > 1024 );
+    TESTING_ASSERT( arena->getNumLiveAllocations() > 0 );
+    TESTING_ASSERT( !arena->reset() );
+
+    floats.reset();
+    strings.reset();
+    empty.reset();
+
+    TESTING_ASSERT( arena->getNumLiveAllocations() == 0 );
+    size_t reserved = arena->getNumBytesReserved();
+    TESTING_ASSERT( arena->reset() );
+
+    // the same allocations fit in the recycled blocks
+    floats = ABCA::AllocateArraySample(
+        ABCA::DataType( kFloat32POD, 3 ), Dimensions( 100 ), arenaPtr );
+    TESTING_ASSERT( arena->getNumBytesReserved() == reserved );
+
+    // the arena is kept alive by its samples
+    arenaPtr.reset();
+    TESTING_ASSERT( arena->getNumLiveAllocations() > 0 );
+    floats.reset();
+
+    // no allocator falls back to the heap
+    floats = ABCA::AllocateArraySample( ABCA::DataType( kFloat32POD, 3 ),
+                                        Dimensions( 10 ),
+                                        ABCA::ArraySampleAllocatorPtr() );
+    TESTING_ASSERT( floats->getDimensions().numPoints() == 10 );
+}
+
+//-*****************************************************************************
+void benchHeavyFrame()
+{
+    std::string archiveName = "heavyFrame.abc";
+    writeHeavyFrame( archiveName );
+
+    const size_t numFrames = 50;
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    ABCA::CompoundPropertyReaderPtr parent = a->getTop()->getProperties();
+    TESTING_ASSERT( !a->getArraySampleAllocatorPtr() );
+
+    std::vector<ABCA::ArraySamplePtr> samples;
+
+    // warm up the property readers
+    readFrame( parent, samples );
+    samples.clear();
+
+    size_t before = g_numAllocs;
+    double start = now();
+    for ( size_t f = 0; f < numFrames; ++f )
+    {
+        readFrame( parent, samples );
+        samples.clear();
+    }
+    double heapTime = now() - start;
+    size_t heapAllocs = g_numAllocs - before;
+
+    ABCA::ArraySampleArena * arena = new ABCA::ArraySampleArena();
+    a->setArraySampleAllocatorPtr( ABCA::ArraySampleAllocatorPtr( arena ) );
+    TESTING_ASSERT( a->getArraySampleAllocatorPtr().get() == arena );
+
+    before = g_numAllocs;
+    start = now();
+    for ( size_t f = 0; f < numFrames; ++f )
+    {
+        readFrame( parent, samples );
+
+        if ( f == 0 )
+        {
+            const float * p = ( const float * ) samples[7]->getData();
+            TESTING_ASSERT( p[0] == 7.0f );
+
+            ABCA::ArraySamplePtr names;
+            parent->getArrayProperty( "names" )->getSample( 0, names );
+            const std::string * s = ( const std::string * )names->getData();
+            TESTING_ASSERT( s[1] ==
+                "a much longer string that won't fit in any small buffer" );
+        }
+
+        samples.clear();
+        TESTING_ASSERT( arena->reset() );
+    }
+    double arenaTime = now() - start;
+    size_t arenaAllocs = g_numAllocs - before;
+
+    std::cout << "Reading " << numFrames << " frames of " << g_numProps
+              << " x " << g_numPoints << " points" << std::endl
+              << "  heap:  " << heapAllocs / numFrames
+              << " allocations per frame, "
+              << heapTime / numFrames * 1000.0 << " ms per frame"
+              << std::endl
+              << "  arena: " << arenaAllocs / numFrames
+              << " allocations per frame, "
+              << arenaTime / numFrames * 1000.0 << " ms per frame, "
+              << arena->getNumBytesReserved() << " bytes reserved"
+              << std::endl;
+
+    // every sample and its control block come out of the arena
+    TESTING_ASSERT( arenaAllocs + 2 * g_numProps * numFrames <= heapAllocs );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    testArena();
+    benchHeavyFrame();
+    return 0;
+}
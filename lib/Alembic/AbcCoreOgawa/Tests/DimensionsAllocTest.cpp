@@ -0,0 +1,198 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <new>
+#include <stdlib.h>
+#include <vector>
+
+//-*****************************************************************************
+// Counts heap allocations made through operator new, so that the effect of
+// Dimensions (and anything else) on a sample read loop can be measured.
+//-*****************************************************************************
+static size_t g_numAllocs = 0;
+
+void * operator new( size_t iSize )
+{
+    ++g_numAllocs;
+    void * ptr = malloc( iSize ? iSize : 1 );
+    if ( !ptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void * operator new[]( size_t iSize )
+{
+    return operator new( iSize );
+}
+
+void operator delete( void * iPtr ) throw()
+{
+    free( iPtr );
+}
+
+void operator delete[]( void * iPtr ) throw()
+{
+    free( iPtr );
+}
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+using namespace Alembic::Util;
+
+//-*****************************************************************************
+void testDimensionsDontAllocate()
+{
+    size_t before = g_numAllocs;
+
+    for ( size_t i = 0; i < 1000; ++i )
+    {
+        Dimensions a( i );
+        Dimensions b( a );
+        Dimensions c;
+        c = b;
+        c.setRank( 2 );
+        c[1] = 3;
+        BaseDimensions<uint32_t> d( c );
+        TESTING_ASSERT( d.numPoints() == i * 3 );
+        c.setRank( 1 );
+        TESTING_ASSERT( c == a );
+    }
+
+    size_t numAllocs = g_numAllocs - before;
+    std::cout << "Dimensions allocations for low ranks: " << numAllocs
+              << std::endl;
+    TESTING_ASSERT( numAllocs == 0 );
+
+    // high ranks still work, on the heap
+    Dimensions high;
+    high.setRank( 9 );
+    for ( size_t i = 0; i < 9; ++i )
+    {
+        high[i] = 2;
+    }
+    Dimensions highCopy( high );
+    TESTING_ASSERT( highCopy.numPoints() == 512 );
+    TESTING_ASSERT( highCopy == high );
+    highCopy.setRank( 1 );
+    TESTING_ASSERT( highCopy.rank() == 1 && highCopy[0] == 2 );
+    high = highCopy;
+    TESTING_ASSERT( high.rank() == 1 && high.numPoints() == 2 );
+}
+
+//-*****************************************************************************
+void benchSampleReadAllocations()
+{
+    std::string archiveName = "dimensionsAlloc.abc";
+
+    const size_t numSamples = 1000;
+
+    {
+        AO::WriteArchive w;
+        ABCA::ArchiveWriterPtr a = w( archiveName, ABCA::MetaData() );
+        ABCA::ObjectWriterPtr archive = a->getTop();
+
+        ABCA::CompoundPropertyWriterPtr parent = archive->getProperties();
+
+        ABCA::DataType v3f( Alembic::Util::kFloat32POD, 3 );
+        ABCA::ArrayPropertyWriterPtr awp =
+            parent->createArrayProperty( "P", ABCA::MetaData(), v3f, 0 );
+
+        std::vector<float> vals( 30 );
+        for ( size_t i = 0; i < numSamples; ++i )
+        {
+            vals[0] = ( float ) i;
+            awp->setSample( ABCA::ArraySample( &( vals.front() ), v3f,
+                                               Dimensions( 10 ) ) );
+        }
+    }
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    ABCA::ArrayPropertyReaderPtr arp =
+        a->getTop()->getProperties()->getArrayProperty( "P" );
+    TESTING_ASSERT( arp->getNumSamples() == numSamples );
+
+    // dimensions and keys only, the common case for change detection
+    Dimensions dims;
+    ABCA::ArraySampleKey key;
+    size_t before = g_numAllocs;
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        arp->getDimensions( i, dims );
+        arp->getKey( i, key );
+        TESTING_ASSERT( dims.numPoints() == 10 );
+    }
+    size_t keyAllocs = g_numAllocs - before;
+
+    // full sample reads
+    std::vector<float> buffer( 30 );
+    before = g_numAllocs;
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        ABCA::ArraySamplePtr samp;
+        arp->getSample( i, samp );
+        TESTING_ASSERT( samp->getDimensions().numPoints() == 10 );
+
+        arp->getAs( i, &( buffer.front() ), Alembic::Util::kFloat32POD );
+        TESTING_ASSERT( buffer[0] == ( float ) i );
+    }
+    size_t sampleAllocs = g_numAllocs - before;
+
+    std::cout << "Allocations per sample, getDimensions + getKey: "
+              << ( double ) keyAllocs / numSamples << std::endl;
+    std::cout << "Allocations per sample, getSample + getAs: "
+              << ( double ) sampleAllocs / numSamples << std::endl;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    testDimensionsDontAllocate();
+    benchSampleReadAllocations();
+    return 0;
+}
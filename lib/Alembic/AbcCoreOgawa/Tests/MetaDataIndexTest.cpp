@@ -0,0 +1,259 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/Ogawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/time.h>
+#include <vector>
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+using namespace Alembic::Util;
+
+// more distinct tags than fit in a version 0 table, some too long for it
+static const size_t g_numTags = 600;
+static const size_t g_numGroups = 10;
+static const size_t g_numObjects = 300;
+
+//-*****************************************************************************
+double now()
+{
+    timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//-*****************************************************************************
+ABCA::MetaData tagMetaData( size_t iTag )
+{
+    std::ostringstream tag;
+    tag << "tag" << iTag;
+
+    ABCA::MetaData md;
+    md.set( "department", "lighting" );
+    md.set( "tag", tag.str() );
+
+    // every tenth tag is over 256 bytes
+    if ( iTag % 10 == 0 )
+    {
+        md.set( "notes", std::string( 300, 'n' ) );
+    }
+    return md;
+}
+
+//-*****************************************************************************
+void writeTagged( const std::string & iName, int32_t iFileVersion )
+{
+    AO::WriteArchive w( iFileVersion );
+    ABCA::ArchiveWriterPtr a = w( iName, ABCA::MetaData() );
+
+    ABCA::DataType i32( kInt32POD, 1 );
+    int32_t val = 0;
+
+    std::vector< ABCA::ObjectWriterPtr > groups;
+    std::vector< ABCA::ObjectWriterPtr > objects;
+    for ( size_t g = 0; g < g_numGroups; ++g )
+    {
+        std::ostringstream groupName;
+        groupName << "group" << g;
+        groups.push_back( a->getTop()->createChild(
+            ABCA::ObjectHeader( groupName.str(), tagMetaData( g ) ) ) );
+
+        for ( size_t i = 0; i < g_numObjects; ++i )
+        {
+            size_t tag = ( g * g_numObjects + i ) % g_numTags;
+
+            std::ostringstream name;
+            name << "obj" << i;
+            ABCA::ObjectWriterPtr obj = groups.back()->createChild(
+                ABCA::ObjectHeader( name.str(), tagMetaData( tag ) ) );
+
+            ABCA::ScalarPropertyWriterPtr swp =
+                obj->getProperties()->createScalarProperty( "id",
+                    tagMetaData( g_numTags - 1 - tag ), i32, 0 );
+            val = ( int32_t ) tag;
+            swp->setSample( &val );
+
+            objects.push_back( obj );
+        }
+    }
+}
+
+//-*****************************************************************************
+size_t traverse( ABCA::ObjectReaderPtr iObj )
+{
+    size_t numChildren = iObj->getNumChildren();
+    size_t numObjects = numChildren;
+    for ( size_t i = 0; i < numChildren; ++i )
+    {
+        ABCA::ObjectReaderPtr child = iObj->getChild( i );
+        ABCA::CompoundPropertyReaderPtr props = child->getProperties();
+        for ( size_t j = 0; j < props->getNumProperties(); ++j )
+        {
+            TESTING_ASSERT( !props->getPropertyHeader( j ).getMetaData().
+                get( "tag" ).empty() );
+        }
+        numObjects += traverse( child );
+    }
+    return numObjects;
+}
+
+//-*****************************************************************************
+int32_t readFileVersion( const std::string & iName )
+{
+    Alembic::Ogawa::IArchive ia( iName );
+    int32_t version = -1;
+    ia.getGroup()->getData( 0, 0 )->read( 4, &version, 0, 0 );
+    return version;
+}
+
+//-*****************************************************************************
+void checkTagged( const std::string & iName, int32_t iFileVersion )
+{
+    TESTING_ASSERT( readFileVersion( iName ) == iFileVersion );
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( iName );
+
+    TESTING_ASSERT( a->getTop()->getNumChildren() == g_numGroups );
+    for ( size_t g = 0; g < g_numGroups; ++g )
+    {
+        ABCA::ObjectReaderPtr group = a->getTop()->getChild( g );
+        TESTING_ASSERT( group->getMetaData().serialize() ==
+                        tagMetaData( g ).serialize() );
+        TESTING_ASSERT( group->getNumChildren() == g_numObjects );
+
+        for ( size_t i = 0; i < g_numObjects; ++i )
+        {
+            size_t tag = ( g * g_numObjects + i ) % g_numTags;
+
+            ABCA::ObjectReaderPtr obj = group->getChild( i );
+            TESTING_ASSERT( obj->getMetaData().serialize() ==
+                            tagMetaData( tag ).serialize() );
+
+            ABCA::ScalarPropertyReaderPtr srp =
+                obj->getProperties()->getScalarProperty( "id" );
+            TESTING_ASSERT( srp->getMetaData().serialize() ==
+                tagMetaData( g_numTags - 1 - tag ).serialize() );
+
+            int32_t val = -1;
+            srp->getSample( 0, &val );
+            TESTING_ASSERT( val == ( int32_t ) tag );
+        }
+    }
+}
+
+//-*****************************************************************************
+size_t fileSize( const std::string & iName )
+{
+    std::ifstream f( iName.c_str(), std::ios::binary | std::ios::ate );
+    return f.tellg();
+}
+
+//-*****************************************************************************
+double timeOpen( const std::string & iName )
+{
+    const size_t numOpens = 20;
+    double start = now();
+    for ( size_t n = 0; n < numOpens; ++n )
+    {
+        AO::ReadArchive r;
+        ABCA::ArchiveReaderPtr a = r( iName );
+        TESTING_ASSERT( traverse( a->getTop() ) ==
+                        g_numGroups * ( g_numObjects + 1 ) );
+    }
+    return ( now() - start ) / numOpens;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string oldName = "metaDataIndexV0.abc";
+    std::string wideName = "metaDataIndexV1.abc";
+
+    writeTagged( oldName, 0 );
+    writeTagged( wideName, 1 );
+
+    checkTagged( oldName, 0 );
+    checkTagged( wideName, 1 );
+
+    // the default still writes files older libraries can read
+    {
+        AO::WriteArchive w;
+        w( "metaDataIndexDefault.abc", ABCA::MetaData() );
+    }
+    TESTING_ASSERT( readFileVersion( "metaDataIndexDefault.abc" ) == 0 );
+
+    size_t oldSize = fileSize( oldName );
+    size_t wideSize = fileSize( wideName );
+    TESTING_ASSERT( wideSize < oldSize );
+
+    double oldTime = timeOpen( oldName );
+    double wideTime = timeOpen( wideName );
+
+    std::cout << "Opening and traversing " << g_numGroups * g_numObjects
+              << " objects with " << g_numTags << " distinct tags"
+              << std::endl
+              << "  version 0: " << oldSize << " bytes, "
+              << oldTime * 1000.0 << " ms" << std::endl
+              << "  version 1: " << wideSize << " bytes, "
+              << wideTime * 1000.0 << " ms" << std::endl;
+
+    bool threw = false;
+    try
+    {
+        AO::WriteArchive w( ALEMBIC_OGAWA_FILE_VERSION + 1 );
+    }
+    catch ( std::exception & e )
+    {
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+
+    return 0;
+}
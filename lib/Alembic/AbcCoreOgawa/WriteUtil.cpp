@@ -64,6 +64,17 @@ void pushUint32WithHint( std::vector< Util::uint8_t > & ioData,
     }
 }
 
+//-*****************************************************************************
+void pushVarUint32( std::vector< Util::uint8_t > & ioData, Util::uint32_t iVal )
+{
+    while ( iVal >= 0x80 )
+    {
+        ioData.push_back( ( Util::uint8_t )( iVal | 0x80 ) );
+        iVal >>= 7;
+    }
+    ioData.push_back( ( Util::uint8_t ) iVal );
+}
+
 //-*****************************************************************************
 void pushChrono( std::vector< Util::uint8_t > & ioData, chrono_t iVal )
 {
@@ -369,7 +380,12 @@ void WritePropertyInfo( std::vector< Util::uint8_t > & ioData,
 
     Util::uint32_t metaDataIndex = iMap->getIndex( metaData );
 
-    info |= metaDataIndexMask & ( metaDataIndex << 20 );
+    // wide indices past 254 don't fit in the info, 0xff tells the reader
+    // the index follows the name
+    Util::uint32_t infoMetaDataIndex = metaDataIndex < 0xff ?
+        metaDataIndex : 0xff;
+
+    info |= metaDataIndexMask & ( infoMetaDataIndex << 20 );
 
     // compounds are treated differently
     if ( !iHeader.isCompound() )
@@ -449,7 +465,14 @@ void WritePropertyInfo( std::vector< Util::uint8_t > & ioData,
     ioData.insert( ioData.end(), iHeader.getName().begin(),
                    iHeader.getName().end() );
 
-    if ( metaDataIndex == 0xff )
+    if ( iMap->hasWideIndices() )
+    {
+        if ( metaDataIndex >= 0xff )
+        {
+            pushVarUint32( ioData, metaDataIndex );
+        }
+    }
+    else if ( metaDataIndex == 0xff )
     {
         pushUint32WithHint( ioData, metaDataSize, sizeHint );
 
@@ -476,7 +499,15 @@ void WriteObjectHeader( std::vector< Util::uint8_t > & ioData,
 
     Util::uint32_t metaDataIndex = iMap->getIndex( metaData );
 
-    // write 1 byte for the meta data index
+    // write 1 byte for the meta data index, wide indices past 254 follow
+    // as a varint
+    if ( iMap->hasWideIndices() && metaDataIndex >= 0xff )
+    {
+        pushUint32WithHint( ioData, 0xff, 0 );
+        pushVarUint32( ioData, metaDataIndex );
+        return;
+    }
+
     pushUint32WithHint( ioData, metaDataIndex, 0 );
 
     // write the size and meta data IF necessary
@@ -45,6 +45,11 @@ namespace Alembic {
 namespace AbcCoreOgawa {
 namespace ALEMBIC_VERSION_NS {
 
+//-*****************************************************************************
+// Pushes iVal 7 bits at a time, low bits first, with the high bit of each
+// byte set when more bytes follow.
+void pushVarUint32( std::vector< Util::uint8_t > & ioData, Util::uint32_t iVal );
+
 //-*****************************************************************************
 void HashPropertyHeader( const AbcA::PropertyHeader & iHeader,
                          Util::SpookyHash & ioHash );
@@ -81,6 +81,9 @@
 #include <Alembic/AbcGeom/OXform.h>
 #include <Alembic/AbcGeom/IXform.h>
 
+#include <Alembic/AbcGeom/OXformTable.h>
+#include <Alembic/AbcGeom/IXformTable.h>
+
 #include <Alembic/AbcGeom/Visibility.h>
 
 #endif
@@ -87,6 +87,69 @@ public:
         bool m_isIndexed;
     };
 
+    //-*************************************************************************
+    //! A caller-owned destination for expanded values. The storage only ever
+    //! grows, so once it has been sized for the largest sample of a param,
+    //! repeated calls to getExpanded( ExpandedBuffer &, ... ) do not touch
+    //! the heap. The keys of the last samples read are kept so that an
+    //! unchanged sample can be skipped entirely.
+    class ExpandedBuffer
+    {
+    public:
+        typedef ExpandedBuffer this_type;
+
+        ExpandedBuffer()
+          : m_size( 0 )
+          , m_scope( kUnknownScope )
+          , m_isIndexed( false )
+          , m_hasKeys( false )
+          , m_valid( false )
+        {}
+
+        const value_type *get() const
+        { return m_size ? &m_data.front() : NULL; }
+
+        const value_type &operator[]( size_t i ) const
+        { return m_data[i]; }
+
+        size_t size() const { return m_size; }
+        GeometryScope getScope() const { return m_scope; }
+        bool isIndexed() const { return m_isIndexed; }
+
+        //! Forgets the contents and the cached keys, but keeps the storage
+        //! so the next fill does not allocate.
+        void reset()
+        {
+            m_size = 0;
+            m_scope = kUnknownScope;
+            m_isIndexed = false;
+            m_hasKeys = false;
+            m_valid = false;
+        }
+
+        bool valid() const { return m_valid; }
+
+        ALEMBIC_OPERATOR_BOOL( valid() );
+
+    protected:
+        friend class ITypedGeomParam<TRAITS>;
+
+        std::vector<value_type> m_data;
+
+        // scratch space for the unexpanded values and indices
+        std::vector<value_type> m_vals;
+        std::vector<Util::uint32_t> m_indices;
+
+        size_t m_size;
+        GeometryScope m_scope;
+        bool m_isIndexed;
+
+        AbcA::ArraySampleKey m_valsKey;
+        AbcA::ArraySampleKey m_indicesKey;
+        bool m_hasKeys;
+        bool m_valid;
+    };
+
     //-*************************************************************************
     typedef ITypedGeomParam<TRAITS> this_type;
     typedef typename this_type::Sample sample_type;
@@ -138,6 +201,19 @@ public:
     void getExpanded( sample_type &oSamp,
                       const Abc::ISampleSelector &iSS = Abc::ISampleSelector() ) const;
 
+    //! Expands into ioBuf without allocating once ioBuf is large enough.
+    //! If the value and index samples selected by iSS have the same keys as
+    //! the ones ioBuf was last filled from, ioBuf is left untouched and
+    //! false is returned; otherwise ioBuf is refilled and true is returned.
+    bool getExpanded( ExpandedBuffer &ioBuf,
+                      const Abc::ISampleSelector &iSS = Abc::ISampleSelector() ) const;
+
+    //! Returns whether the values or indices selected by iSS may differ
+    //! from the ones selected by iPrevSS.
+    bool isChangedSince( const Abc::ISampleSelector &iPrevSS,
+                         const Abc::ISampleSelector &iSS = \
+                         Abc::ISampleSelector() ) const;
+
     sample_type getIndexedValue( const Abc::ISampleSelector &iSS = \
                                  Abc::ISampleSelector() ) const
     {
@@ -391,6 +467,127 @@ ITypedGeomParam<TRAITS>::getExpanded( typename ITypedGeomParam<TRAITS>::Sample &
 
 }
 
+//-*****************************************************************************
+//! Gathers oVals[i] = iVals[iIndices[i]]. Kept as a flat loop over raw
+//! pointers so the compiler is free to unroll and vectorize it for the
+//! fixed size POD value types.
+template <class T>
+inline void GatherExpandedValues( T * oVals, const T * iVals,
+                                  const Util::uint32_t * iIndices,
+                                  size_t iSize )
+{
+    for ( size_t i = 0 ; i < iSize ; ++i )
+    {
+        oVals[i] = iVals[ iIndices[i] ];
+    }
+}
+
+//-*****************************************************************************
+//! Reads the sample of iProp selected by iSS into oVec, growing oVec only
+//! when it is too small. Returns the number of elements read.
+template <class T>
+size_t ReadArrayInto( AbcA::ArrayPropertyReaderPtr iProp,
+                      std::vector<T> & oVec,
+                      const Abc::ISampleSelector &iSS )
+{
+    AbcA::index_t index = iSS.getIndex( iProp->getTimeSampling(),
+                                        iProp->getNumSamples() );
+
+    const AbcA::DataType &dtype = iProp->getDataType();
+    Util::PlainOldDataType pod = dtype.getPod();
+
+    if ( pod == Util::kStringPOD || pod == Util::kWstringPOD )
+    {
+        // strings can't be read in place by every backend
+        AbcA::ArraySamplePtr samp;
+        iProp->getSample( index, samp );
+
+        size_t size = samp->getDimensions().numPoints();
+        if ( oVec.size() < size ) { oVec.resize( size ); }
+
+        const T * src = static_cast<const T *>( samp->getData() );
+        std::copy( src, src + size, oVec.begin() );
+        return size;
+    }
+
+    Util::Dimensions dims;
+    iProp->getDimensions( index, dims );
+
+    size_t size = dims.numPoints();
+    if ( oVec.size() < size ) { oVec.resize( size ); }
+
+    if ( size > 0 )
+    {
+        iProp->getAs( index, &oVec.front(), pod );
+    }
+
+    return size;
+}
+
+//-*****************************************************************************
+template <class TRAITS>
+bool
+ITypedGeomParam<TRAITS>::getExpanded( typename ITypedGeomParam<TRAITS>::ExpandedBuffer &ioBuf,
+                                      const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "ITypedGeomParam::getExpanded( ExpandedBuffer )" );
+
+    AbcA::ArraySampleKey valsKey;
+    AbcA::ArraySampleKey indicesKey;
+
+    bool hasKeys = m_valProp.getKey( valsKey, iSS );
+    if ( hasKeys && m_indicesProperty )
+    {
+        hasKeys = m_indicesProperty.getKey( indicesKey, iSS );
+    }
+
+    if ( hasKeys && ioBuf.m_hasKeys && ioBuf.m_valsKey == valsKey &&
+         ( ! m_indicesProperty || ioBuf.m_indicesKey == indicesKey ) )
+    {
+        return false;
+    }
+
+    ioBuf.m_scope = this->getScope();
+    ioBuf.m_isIndexed = m_isIndexed;
+
+    if ( ! m_indicesProperty )
+    {
+        ioBuf.m_size = ReadArrayInto( m_valProp.getPtr(), ioBuf.m_data, iSS );
+    }
+    else
+    {
+        size_t numVals = ReadArrayInto( m_valProp.getPtr(), ioBuf.m_vals,
+                                        iSS );
+        size_t size = ReadArrayInto( m_indicesProperty.getPtr(),
+                                     ioBuf.m_indices, iSS );
+
+        if ( ioBuf.m_data.size() < size ) { ioBuf.m_data.resize( size ); }
+
+        if ( size > 0 )
+        {
+            ABCA_ASSERT( numVals > 0, "Indexed GeomParam " << getName()
+                         << " has indices but no values" );
+
+            GatherExpandedValues( &ioBuf.m_data.front(),
+                                  &ioBuf.m_vals.front(),
+                                  &ioBuf.m_indices.front(), size );
+        }
+
+        ioBuf.m_size = size;
+    }
+
+    ioBuf.m_valsKey = valsKey;
+    ioBuf.m_indicesKey = indicesKey;
+    ioBuf.m_hasKeys = hasKeys;
+    ioBuf.m_valid = true;
+
+    return true;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    return false;
+}
+
 //-*****************************************************************************
 template <class TRAITS>
 size_t ITypedGeomParam<TRAITS>::getNumSamples() const
@@ -433,6 +630,26 @@ bool ITypedGeomParam<TRAITS>::isConstant() const
     return false;
 }
 
+//-*****************************************************************************
+template <class TRAITS>
+bool ITypedGeomParam<TRAITS>::isChangedSince(
+    const Abc::ISampleSelector &iPrevSS,
+    const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "ITypedGeomParam::isChangedSince()" );
+
+    if ( m_valProp.isChangedSince( iPrevSS, iSS ) )
+    {
+        return true;
+    }
+
+    return m_isIndexed && m_indicesProperty.isChangedSince( iPrevSS, iSS );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    return true;
+}
+
 //-*****************************************************************************
 template <class TRAITS>
 const std::string &ITypedGeomParam<TRAITS>::getName() const
@@ -67,6 +67,61 @@ MeshTopologyVariance IPolyMeshSchema::getTopologyVariance() const
     return kConstantTopology;
 }
 
+//-*****************************************************************************
+int IPolyMeshSchema::getChanged( Sample &ioSample,
+                                 const Abc::ISampleSelector &iPrevSS,
+                                 const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPolyMeshSchema::getChanged()" );
+
+    bool hasVelocities = m_velocitiesProperty &&
+        m_velocitiesProperty.getNumSamples() > 0;
+
+    if ( !ioSample.valid() )
+    {
+        get( ioSample, iSS );
+        return kPositionsChanged | kFaceIndicesChanged | kFaceCountsChanged |
+            ( hasVelocities ? kVelocitiesChanged : 0 );
+    }
+
+    int changed = 0;
+
+    if ( m_positionsProperty.isChangedSince( iPrevSS, iSS ) )
+    {
+        m_positionsProperty.get( ioSample.m_positions, iSS );
+        changed |= kPositionsChanged;
+    }
+
+    if ( m_indicesProperty.isChangedSince( iPrevSS, iSS ) )
+    {
+        m_indicesProperty.get( ioSample.m_indices, iSS );
+        changed |= kFaceIndicesChanged;
+    }
+
+    if ( m_countsProperty.isChangedSince( iPrevSS, iSS ) )
+    {
+        m_countsProperty.get( ioSample.m_counts, iSS );
+        changed |= kFaceCountsChanged;
+    }
+
+    if ( hasVelocities &&
+         ( !ioSample.m_velocities ||
+           m_velocitiesProperty.isChangedSince( iPrevSS, iSS ) ) )
+    {
+        m_velocitiesProperty.get( ioSample.m_velocities, iSS );
+        changed |= kVelocitiesChanged;
+    }
+
+    m_selfBoundsProperty.get( ioSample.m_selfBounds, iSS );
+
+    return changed;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw
+    return 0;
+}
+
 //-*****************************************************************************
 void IPolyMeshSchema::init( const Abc::Argument &iArg0,
                             const Abc::Argument &iArg1 )
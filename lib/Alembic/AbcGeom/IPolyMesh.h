@@ -210,6 +210,25 @@ public:
         ALEMBIC_ABC_SAFE_CALL_END();
     }
 
+    //! Bits returned by getChanged, one for each array which was reread.
+    enum ChangedArrays
+    {
+        kPositionsChanged = 1,
+        kVelocitiesChanged = 2,
+        kFaceIndicesChanged = 4,
+        kFaceCountsChanged = 8
+    };
+
+    //! Brings ioSample, last filled at iPrevSS, up to iSS by rereading only
+    //! the arrays whose keys changed in between; the self bounds are always
+    //! reread. Returns the ChangedArrays bits of the arrays which were
+    //! reread, so callers can skip reprocessing the rest. An invalid
+    //! ioSample is filled completely.
+    int getChanged( Sample &ioSample,
+                    const Abc::ISampleSelector &iPrevSS,
+                    const Abc::ISampleSelector &iSS = Abc::ISampleSelector()
+                  ) const;
+
     Sample getValue( const Abc::ISampleSelector &iSS = Abc::ISampleSelector() ) const
     {
         Sample smp;
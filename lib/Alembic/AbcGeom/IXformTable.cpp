@@ -0,0 +1,178 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcGeom/IXformTable.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+Abc::M44d IXformTableSchema::Sample::getMatrix( size_t iEntry ) const
+{
+    ABCA_ASSERT( iEntry < getNumEntries(),
+                 "Invalid xform table entry: " << iEntry );
+
+    return ( *m_matrices )[iEntry];
+}
+
+//-*****************************************************************************
+bool IXformTableSchema::Sample::getInheritsXforms( size_t iEntry ) const
+{
+    // no flags, or an empty placeholder sample, means everything inherits
+    if ( !m_inherits || m_inherits->size() <= iEntry )
+    {
+        return true;
+    }
+
+    return ( *m_inherits )[iEntry];
+}
+
+//-*****************************************************************************
+std::string IXformTableSchema::Sample::getName( size_t iEntry ) const
+{
+    if ( !m_names || m_names->size() <= iEntry )
+    {
+        return std::string();
+    }
+
+    return ( *m_names )[iEntry];
+}
+
+//-*****************************************************************************
+void IXformTableSchema::Sample::getXformSample( size_t iEntry,
+                                                XformSample &oSamp ) const
+{
+    oSamp.reset();
+    oSamp.setMatrix( getMatrix( iEntry ) );
+    oSamp.setInheritsXforms( getInheritsXforms( iEntry ) );
+}
+
+//-*****************************************************************************
+void IXformTableSchema::get( Sample &oSample,
+                             const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IXformTableSchema::get()" );
+
+    m_matricesProperty.get( oSample.m_matrices, iSS );
+
+    if ( m_inheritsProperty && m_inheritsProperty.getNumSamples() > 0 )
+    {
+        m_inheritsProperty.get( oSample.m_inherits, iSS );
+    }
+    else
+    {
+        oSample.m_inherits.reset();
+    }
+
+    if ( m_namesProperty && m_namesProperty.getNumSamples() > 0 )
+    {
+        m_namesProperty.get( oSample.m_names, iSS );
+    }
+    else
+    {
+        oSample.m_names.reset();
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IXformTableSchema::getXformSample( size_t iEntry, XformSample &oSamp,
+                                        const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IXformTableSchema::getXformSample()" );
+
+    Sample smp;
+    m_matricesProperty.get( smp.m_matrices, iSS );
+
+    if ( m_inheritsProperty && m_inheritsProperty.getNumSamples() > 0 )
+    {
+        m_inheritsProperty.get( smp.m_inherits, iSS );
+    }
+
+    smp.getXformSample( iEntry, oSamp );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IXformTableSchema::init( const Abc::Argument &iArg0,
+                              const Abc::Argument &iArg1 )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IXformTableSchema::init()" );
+
+    Abc::Arguments args;
+    iArg0.setInto( args );
+    iArg1.setInto( args );
+
+    AbcA::CompoundPropertyReaderPtr _this = this->getPtr();
+
+    m_matricesProperty = Abc::IM44dArrayProperty( _this, ".matrices",
+                                                  iArg0, iArg1 );
+
+    // the rest are optional
+
+    if ( _this->getPropertyHeader( ".inherits" ) != NULL )
+    {
+        m_inheritsProperty = Abc::IBoolArrayProperty( _this, ".inherits",
+                                                      iArg0, iArg1 );
+    }
+
+    if ( _this->getPropertyHeader( ".names" ) != NULL )
+    {
+        m_namesProperty = Abc::IStringArrayProperty( _this, ".names",
+                                                     iArg0, iArg1 );
+    }
+
+    if ( _this->getPropertyHeader( ".arbGeomParams" ) != NULL )
+    {
+        m_arbGeomParams = Abc::ICompoundProperty( _this, ".arbGeomParams",
+            args.getErrorHandlerPolicy() );
+    }
+
+    if ( _this->getPropertyHeader( ".userProperties" ) != NULL )
+    {
+        m_userProperties = Abc::ICompoundProperty( _this, ".userProperties",
+            args.getErrorHandlerPolicy() );
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END_RESET();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcGeom
+} // End namespace Alembic
@@ -0,0 +1,303 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcGeom_IXformTable_h_
+#define _Alembic_AbcGeom_IXformTable_h_
+
+#include <Alembic/AbcGeom/Foundation.h>
+#include <Alembic/AbcGeom/SchemaInfoDeclarations.h>
+
+#include <Alembic/AbcGeom/XformSample.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+class IXformTableSchema : public Abc::ISchema<XformTableSchemaInfo>
+{
+public:
+    class Sample
+    {
+    public:
+        typedef Sample this_type;
+
+        // Users don't ever create this data directly.
+        Sample() { reset(); }
+
+        Abc::M44dArraySamplePtr getMatrices() const { return m_matrices; }
+        Abc::BoolArraySamplePtr getInherits() const { return m_inherits; }
+        Abc::StringArraySamplePtr getNames() const { return m_names; }
+
+        //! Number of transforms held by this sample.
+        size_t getNumEntries() const
+        { return m_matrices ? m_matrices->size() : 0; }
+
+        //! Returns the local matrix of the given entry.
+        Abc::M44d getMatrix( size_t iEntry ) const;
+
+        //! Returns whether the given entry inherits its parents transform,
+        //! entries are assumed to inherit when no flags were written.
+        bool getInheritsXforms( size_t iEntry ) const;
+
+        //! Returns the name of the given entry, or an empty string if the
+        //! entries weren't named.
+        std::string getName( size_t iEntry ) const;
+
+        //! Presents the given entry as a regular IXform sample, holding a
+        //! single matrix op.
+        void getXformSample( size_t iEntry, XformSample &oSamp ) const;
+
+        XformSample getXformSample( size_t iEntry ) const
+        {
+            XformSample ret;
+            getXformSample( iEntry, ret );
+            return ret;
+        }
+
+        bool valid() const
+        {
+            return m_matrices.get() != NULL;
+        }
+
+        void reset()
+        {
+            m_matrices.reset();
+            m_inherits.reset();
+            m_names.reset();
+        }
+
+        ALEMBIC_OPERATOR_BOOL( valid() );
+
+    protected:
+        friend class IXformTableSchema;
+        Abc::M44dArraySamplePtr m_matrices;
+        Abc::BoolArraySamplePtr m_inherits;
+        Abc::StringArraySamplePtr m_names;
+    };
+
+    //-*************************************************************************
+    // XFORM TABLE SCHEMA
+    //-*************************************************************************
+public:
+    //! By convention we always define this_type in AbcGeom classes.
+    //! Used by unspecified-bool-type conversion below
+    typedef Abc::ISchema<XformTableSchemaInfo> super_type;
+    typedef IXformTableSchema this_type;
+    typedef Sample sample_type;
+
+    //-*************************************************************************
+    // CONSTRUCTION, DESTRUCTION, ASSIGNMENT
+    //-*************************************************************************
+
+    //! The default constructor creates an empty IXformTableSchema
+    //! ...
+    IXformTableSchema() {}
+
+    //! This templated, primary constructor creates a new xform table reader.
+    //! The first argument is any Abc (or AbcCoreAbstract) object
+    //! which can intrusively be converted to an CompoundPropertyReaderPtr
+    //! to use as a parent, from which the error handler policy for
+    //! inheritance is also derived.  The remaining optional arguments
+    //! can be used to override the ErrorHandlerPolicy, to specify
+    //! MetaData, and to set TimeSamplingType.
+    template <class CPROP_PTR>
+    IXformTableSchema( CPROP_PTR iParent,
+                       const std::string &iName,
+                       const Abc::Argument &iArg0 = Abc::Argument(),
+                       const Abc::Argument &iArg1 = Abc::Argument() )
+      : Abc::ISchema<XformTableSchemaInfo>( iParent, iName, iArg0, iArg1 )
+    {
+        init( iArg0, iArg1 );
+    }
+
+    //! This constructor is the same as above, but with default
+    //! schema name used.
+    template <class CPROP_PTR>
+    explicit IXformTableSchema( CPROP_PTR iParent,
+                                const Abc::Argument &iArg0 = Abc::Argument(),
+                                const Abc::Argument &iArg1 = Abc::Argument() )
+      : Abc::ISchema<XformTableSchemaInfo>( iParent, iArg0, iArg1 )
+    {
+        init( iArg0, iArg1 );
+    }
+
+    //! Wrap an existing IXformTable object
+    template <class CPROP_PTR>
+    explicit IXformTableSchema( CPROP_PTR iThis,
+                                Abc::WrapExistingFlag iFlag,
+                                const Abc::Argument &iArg0 = Abc::Argument(),
+                                const Abc::Argument &iArg1 = Abc::Argument() )
+      : Abc::ISchema<XformTableSchemaInfo>( iThis, iFlag, iArg0, iArg1 )
+    {
+        init( iArg0, iArg1 );
+    }
+
+    //! Copy constructor.
+    IXformTableSchema(const IXformTableSchema& iCopy)
+        : Abc::ISchema<XformTableSchemaInfo>()
+    {
+        *this = iCopy;
+    }
+
+    //! Default assignment operator used.
+
+    //-*************************************************************************
+    // SCHEMA STUFF
+    //-*************************************************************************
+
+    //! Return the number of samples contained in the property.
+    //! This can be any number, including zero.
+    //! This returns the number of samples that were written, independently
+    //! of whether or not they were constant.
+    size_t getNumSamples() const
+    { return m_matricesProperty.getNumSamples(); }
+
+    //! Ask if we're constant - no change in value amongst samples,
+    //! regardless of the time sampling.
+    bool isConstant() const
+    {
+        return m_matricesProperty.isConstant() &&
+            ( !m_inheritsProperty || m_inheritsProperty.isConstant() ) &&
+            ( !m_namesProperty || m_namesProperty.isConstant() );
+    }
+
+    //! Time sampling Information.
+    //!
+    AbcA::TimeSamplingPtr getTimeSampling() const
+    {
+        if ( m_matricesProperty.valid() )
+        {
+            return m_matricesProperty.getTimeSampling();
+        }
+        return getObject().getArchive().getTimeSampling(0);
+    }
+
+    //-*************************************************************************
+    void get( Sample &oSample,
+              const Abc::ISampleSelector &iSS = Abc::ISampleSelector() ) const;
+
+    Sample getValue( const Abc::ISampleSelector &iSS =
+                     Abc::ISampleSelector() ) const
+    {
+        Sample smp;
+        get( smp, iSS );
+        return smp;
+    }
+
+    //! Lightweight access to a single entry as a regular IXform sample.
+    //! When walking every entry, get() the Sample once and use
+    //! Sample::getXformSample() instead.
+    void getXformSample( size_t iEntry, XformSample &oSamp,
+                         const Abc::ISampleSelector &iSS =
+                         Abc::ISampleSelector() ) const;
+
+    Abc::IM44dArrayProperty getMatricesProperty() const
+    {
+        return m_matricesProperty;
+    }
+
+    Abc::IBoolArrayProperty getInheritsProperty() const
+    {
+        return m_inheritsProperty;
+    }
+
+    Abc::IStringArrayProperty getNamesProperty() const
+    {
+        return m_namesProperty;
+    }
+
+    Abc::ICompoundProperty getArbGeomParams() const { return m_arbGeomParams; }
+
+    Abc::ICompoundProperty getUserProperties() const
+    { return m_userProperties; }
+
+    //-*************************************************************************
+    // ABC BASE MECHANISMS
+    // These functions are used by Abc to deal with errors, rewrapping,
+    // and so on.
+    //-*************************************************************************
+
+    //! Reset returns this function set to an empty, default
+    //! state.
+    void reset()
+    {
+        m_matricesProperty.reset();
+        m_inheritsProperty.reset();
+        m_namesProperty.reset();
+        m_arbGeomParams.reset();
+        m_userProperties.reset();
+
+        super_type::reset();
+    }
+
+    //! Valid returns whether this function set is
+    //! valid.
+    bool valid() const
+    {
+        return ( super_type::valid() &&
+                 m_matricesProperty.valid() );
+    }
+
+    //! unspecified-bool-type operator overload.
+    //! ...
+    ALEMBIC_OVERRIDE_OPERATOR_BOOL( IXformTableSchema::valid() );
+
+protected:
+    void init( const Abc::Argument &iArg0,
+               const Abc::Argument &iArg1 );
+
+    Abc::IM44dArrayProperty m_matricesProperty;
+    Abc::IBoolArrayProperty m_inheritsProperty;
+    Abc::IStringArrayProperty m_namesProperty;
+
+    Abc::ICompoundProperty m_arbGeomParams;
+    Abc::ICompoundProperty m_userProperties;
+};
+
+//-*****************************************************************************
+typedef Abc::ISchemaObject<IXformTableSchema> IXformTable;
+
+typedef Util::shared_ptr< IXformTable > IXformTablePtr;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcGeom
+} // End namespace Alembic
+
+#endif
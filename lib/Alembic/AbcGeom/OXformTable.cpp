@@ -0,0 +1,228 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcGeom/OXformTable.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+void OXformTableSchema::set( const Sample &iSamp )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OXformTableSchema::set()" );
+
+    const size_t numSamps = m_matricesProperty.getNumSamples();
+
+    if ( numSamps == 0 )
+    {
+        // First sample must have the matrices.
+        ABCA_ASSERT( iSamp.getMatrices(),
+                     "Sample 0 must have valid data for the matrices" );
+    }
+
+    // check everything before writing anything, the parts left out repeat
+    // the previous sample so they have to agree with the new ones too.
+    // An empty inherits or names sample always agrees.
+    size_t numMatrices = iSamp.getMatrices() ?
+        iSamp.getMatrices().size() : m_numMatrices;
+    size_t numInherits = iSamp.getInherits() ?
+        iSamp.getInherits().size() : m_numInherits;
+    size_t numNames = iSamp.getNames() ?
+        iSamp.getNames().size() : m_numNames;
+
+    ABCA_ASSERT( numInherits == 0 || numInherits == numMatrices,
+                 "Number of inherits flags: " << numInherits <<
+                 " doesn't match number of matrices: " << numMatrices );
+
+    ABCA_ASSERT( numNames == 0 || numNames == numMatrices,
+                 "Number of names: " << numNames <<
+                 " doesn't match number of matrices: " << numMatrices );
+
+    // do we need to create inherits prop?
+    if ( iSamp.getInherits() && !m_inheritsProperty )
+    {
+        m_inheritsProperty = Abc::OBoolArrayProperty( this->getPtr(),
+            ".inherits", m_matricesProperty.getTimeSampling() );
+
+        // an empty inherits sample means every entry inherits
+        std::vector<Util::bool_t> emptyVec;
+        const Abc::BoolArraySample empty( emptyVec );
+        for ( size_t i = 0 ; i < numSamps ; ++i )
+        {
+            m_inheritsProperty.set( empty );
+        }
+    }
+
+    // do we need to create names prop?
+    if ( iSamp.getNames() && !m_namesProperty )
+    {
+        m_namesProperty = Abc::OStringArrayProperty( this->getPtr(),
+            ".names", m_matricesProperty.getTimeSampling() );
+
+        std::vector<std::string> emptyVec;
+        const Abc::StringArraySample empty( emptyVec );
+        for ( size_t i = 0 ; i < numSamps ; ++i )
+        {
+            m_namesProperty.set( empty );
+        }
+    }
+
+    SetPropUsePrevIfNull( m_matricesProperty, iSamp.getMatrices() );
+    SetPropUsePrevIfNull( m_inheritsProperty, iSamp.getInherits() );
+    SetPropUsePrevIfNull( m_namesProperty, iSamp.getNames() );
+
+    m_numMatrices = numMatrices;
+    m_numInherits = numInherits;
+    m_numNames = numNames;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void OXformTableSchema::setFromPrevious()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OXformTableSchema::setFromPrevious" );
+
+    m_matricesProperty.setFromPrevious();
+
+    if ( m_inheritsProperty )
+    {
+        m_inheritsProperty.setFromPrevious();
+    }
+
+    if ( m_namesProperty )
+    {
+        m_namesProperty.setFromPrevious();
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void OXformTableSchema::setTimeSampling( uint32_t iIndex )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN(
+        "OXformTableSchema::setTimeSampling( uint32_t )" );
+
+    m_matricesProperty.setTimeSampling( iIndex );
+
+    if ( m_inheritsProperty )
+    {
+        m_inheritsProperty.setTimeSampling( iIndex );
+    }
+
+    if ( m_namesProperty )
+    {
+        m_namesProperty.setTimeSampling( iIndex );
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void OXformTableSchema::setTimeSampling( AbcA::TimeSamplingPtr iTime )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN(
+        "OXformTableSchema::setTimeSampling( TimeSamplingPtr )" );
+
+    if (iTime)
+    {
+        uint32_t tsIndex = getObject().getArchive().addTimeSampling( *iTime );
+        setTimeSampling( tsIndex );
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+Abc::OCompoundProperty OXformTableSchema::getArbGeomParams()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OXformTableSchema::getArbGeomParams()" );
+
+    if ( ! m_arbGeomParams )
+    {
+        m_arbGeomParams = Abc::OCompoundProperty( this->getPtr(),
+                                                  ".arbGeomParams" );
+    }
+
+    return m_arbGeomParams;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    Abc::OCompoundProperty ret;
+    return ret;
+}
+
+//-*****************************************************************************
+Abc::OCompoundProperty OXformTableSchema::getUserProperties()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OXformTableSchema::getUserProperties()" );
+
+    if ( ! m_userProperties )
+    {
+        m_userProperties = Abc::OCompoundProperty( this->getPtr(),
+                                                   ".userProperties" );
+    }
+
+    return m_userProperties;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    Abc::OCompoundProperty ret;
+    return ret;
+}
+
+//-*****************************************************************************
+void OXformTableSchema::init( uint32_t iTsIdx )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OXformTableSchema::init()" );
+
+    AbcA::CompoundPropertyWriterPtr _this = this->getPtr();
+
+    m_numMatrices = 0;
+    m_numInherits = 0;
+    m_numNames = 0;
+
+    m_matricesProperty = Abc::OM44dArrayProperty( _this, ".matrices",
+                                                  iTsIdx );
+
+    ALEMBIC_ABC_SAFE_CALL_END_RESET();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcGeom
+} // End namespace Alembic
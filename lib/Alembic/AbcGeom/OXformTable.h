@@ -0,0 +1,303 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcGeom_OXformTable_h_
+#define _Alembic_AbcGeom_OXformTable_h_
+
+#include <Alembic/AbcGeom/Foundation.h>
+#include <Alembic/AbcGeom/SchemaInfoDeclarations.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! The XformTable schema stores the matrices of many transforms (for example
+//! the agents of a crowd, or the placements of instances) as a single
+//! M44d array sample per frame, instead of one OXform object per transform.
+//! Each frame then costs one array write no matter how many entries there
+//! are, rather than an .inherits and a .vals scalar write per OXform.
+//! IXformTableSchema can hand each entry back as a regular XformSample.
+class OXformTableSchema : public Abc::OSchema<XformTableSchemaInfo>
+{
+public:
+    //-*************************************************************************
+    // XFORM TABLE SCHEMA SAMPLE TYPE
+    //-*************************************************************************
+    class Sample
+    {
+    public:
+        //! Creates a default sample with no data in it.
+        //! ...
+        Sample() { reset(); }
+
+        //! Creates a sample with only matrices, the entry names and
+        //! inherits flags are taken from the previous sample, or defaults
+        //! to unnamed entries which all inherit their parents transforms.
+        Sample( const Abc::M44dArraySample &iMatrices,
+                const Abc::BoolArraySample &iInherits =
+                Abc::BoolArraySample() )
+          : m_matrices( iMatrices )
+          , m_inherits( iInherits )
+        {}
+
+        //! Creates a sample with matrices and names for each entry.
+        //! Names only need to be supplied again if they change.
+        Sample( const Abc::M44dArraySample &iMatrices,
+                const Abc::StringArraySample &iNames,
+                const Abc::BoolArraySample &iInherits =
+                Abc::BoolArraySample() )
+          : m_matrices( iMatrices )
+          , m_inherits( iInherits )
+          , m_names( iNames )
+        {}
+
+        // matrices accessor
+        const Abc::M44dArraySample &getMatrices() const { return m_matrices; }
+        void setMatrices( const Abc::M44dArraySample &iSmp )
+        { m_matrices = iSmp; }
+
+        // inherits accessor
+        const Abc::BoolArraySample &getInherits() const { return m_inherits; }
+        void setInherits( const Abc::BoolArraySample &iSmp )
+        { m_inherits = iSmp; }
+
+        // names accessor
+        const Abc::StringArraySample &getNames() const { return m_names; }
+        void setNames( const Abc::StringArraySample &iSmp )
+        { m_names = iSmp; }
+
+        void reset()
+        {
+            m_matrices.reset();
+            m_inherits.reset();
+            m_names.reset();
+        }
+
+    protected:
+        Abc::M44dArraySample m_matrices;
+        Abc::BoolArraySample m_inherits;
+        Abc::StringArraySample m_names;
+    };
+
+    //-*************************************************************************
+    // XFORM TABLE SCHEMA
+    //-*************************************************************************
+public:
+    //! By convention we always define this_type in AbcGeom classes.
+    //! Used by unspecified-bool-type conversion below
+    typedef OXformTableSchema this_type;
+
+    //-*************************************************************************
+    // CONSTRUCTION, DESTRUCTION, ASSIGNMENT
+    //-*************************************************************************
+
+    //! The default constructor creates an empty OXformTableSchema
+    //! ...
+    OXformTableSchema()
+      : m_numMatrices( 0 )
+      , m_numInherits( 0 )
+      , m_numNames( 0 )
+    {}
+
+    //! This templated, primary constructor creates a new xform table writer.
+    //! The first argument is any Abc (or AbcCoreAbstract) object
+    //! which can intrusively be converted to an CompoundPropertyWriterPtr
+    //! to use as a parent, from which the error handler policy for
+    //! inheritance is also derived.  The remaining optional arguments
+    //! can be used to override the ErrorHandlerPolicy, to specify
+    //! MetaData, and to set TimeSampling.
+    template <class CPROP_PTR>
+    OXformTableSchema( CPROP_PTR iParent,
+                       const std::string &iName,
+                       const Abc::Argument &iArg0 = Abc::Argument(),
+                       const Abc::Argument &iArg1 = Abc::Argument(),
+                       const Abc::Argument &iArg2 = Abc::Argument() )
+      : Abc::OSchema<XformTableSchemaInfo>( iParent, iName,
+                                            iArg0, iArg1, iArg2 )
+    {
+        AbcA::TimeSamplingPtr tsPtr =
+            Abc::GetTimeSampling( iArg0, iArg1, iArg2 );
+        uint32_t tsIndex =
+            Abc::GetTimeSamplingIndex( iArg0, iArg1, iArg2 );
+
+        // if we specified a valid TimeSamplingPtr, use it to determine the
+        // index otherwise we'll use the index, which defaults to the intrinsic
+        // 0 index
+        if (tsPtr)
+        {
+            tsIndex = GetCompoundPropertyWriterPtr( iParent )->getObject(
+                )->getArchive()->addTimeSampling(*tsPtr);
+        }
+
+        // Meta data and error handling are eaten up by
+        // the super type, so all that's left is time sampling.
+        init( tsIndex );
+    }
+
+    template <class CPROP_PTR>
+    explicit OXformTableSchema( CPROP_PTR iParent,
+                                const Abc::Argument &iArg0 = Abc::Argument(),
+                                const Abc::Argument &iArg1 = Abc::Argument(),
+                                const Abc::Argument &iArg2 = Abc::Argument() )
+      : Abc::OSchema<XformTableSchemaInfo>( iParent,
+                                            iArg0, iArg1, iArg2 )
+    {
+        AbcA::TimeSamplingPtr tsPtr =
+            Abc::GetTimeSampling( iArg0, iArg1, iArg2 );
+        uint32_t tsIndex =
+            Abc::GetTimeSamplingIndex( iArg0, iArg1, iArg2 );
+
+        // if we specified a valid TimeSamplingPtr, use it to determine the
+        // index otherwise we'll use the index, which defaults to the intrinsic
+        // 0 index
+        if (tsPtr)
+        {
+            tsIndex = GetCompoundPropertyWriterPtr( iParent )->getObject(
+                )->getArchive()->addTimeSampling(*tsPtr);
+        }
+
+        // Meta data and error handling are eaten up by
+        // the super type, so all that's left is time sampling.
+        init( tsIndex );
+    }
+
+    //! Copy constructor.
+    OXformTableSchema(const OXformTableSchema& iCopy)
+        : Abc::OSchema<XformTableSchemaInfo>()
+    {
+        *this = iCopy;
+    }
+
+    //! Default assignment operator used.
+
+    //-*************************************************************************
+    // SCHEMA STUFF
+    //-*************************************************************************
+
+    //! Return the time sampling
+    AbcA::TimeSamplingPtr getTimeSampling() const
+    { return m_matricesProperty.getTimeSampling(); }
+
+    //-*************************************************************************
+    // SAMPLE STUFF
+    //-*************************************************************************
+
+    //! Get number of samples written so far.
+    //! ...
+    size_t getNumSamples() const
+    { return m_matricesProperty.getNumSamples(); }
+
+    //! Set a sample
+    void set( const Sample &iSamp );
+
+    //! Set from previous sample. Will apply to each of matrices,
+    //! inherits, and names
+    void setFromPrevious();
+
+    void setTimeSampling( uint32_t iIndex );
+    void setTimeSampling( AbcA::TimeSamplingPtr iTime );
+
+    Abc::OCompoundProperty getUserProperties();
+    Abc::OCompoundProperty getArbGeomParams();
+
+    //-*************************************************************************
+    // ABC BASE MECHANISMS
+    // These functions are used by Abc to deal with errors, validity,
+    // and so on.
+    //-*************************************************************************
+
+    //! Reset returns this function set to an empty, default
+    //! state.
+    void reset()
+    {
+        m_matricesProperty.reset();
+        m_inheritsProperty.reset();
+        m_namesProperty.reset();
+        m_userProperties.reset();
+        m_arbGeomParams.reset();
+
+        m_numMatrices = 0;
+        m_numInherits = 0;
+        m_numNames = 0;
+
+        Abc::OSchema<XformTableSchemaInfo>::reset();
+    }
+
+    //! Valid returns whether this function set is
+    //! valid.
+    bool valid() const
+    {
+        return ( Abc::OSchema<XformTableSchemaInfo>::valid() &&
+                 m_matricesProperty.valid() );
+    }
+
+    //! unspecified-bool-type operator overload.
+    //! ...
+    ALEMBIC_OVERRIDE_OPERATOR_BOOL( OXformTableSchema::valid() );
+
+protected:
+    void init( uint32_t iTsIdx );
+
+    Abc::OM44dArrayProperty m_matricesProperty;
+    Abc::OBoolArrayProperty m_inheritsProperty;
+    Abc::OStringArrayProperty m_namesProperty;
+
+    Abc::OCompoundProperty m_userProperties;
+    Abc::OCompoundProperty m_arbGeomParams;
+
+    // the sizes of the last samples written, which later samples that leave
+    // some of them out have to agree with
+    size_t m_numMatrices;
+    size_t m_numInherits;
+    size_t m_numNames;
+};
+
+//-*****************************************************************************
+// SCHEMA OBJECT
+//-*****************************************************************************
+typedef Abc::OSchemaObject<OXformTableSchema> OXformTable;
+
+typedef Util::shared_ptr< OXformTable > OXformTablePtr;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcGeom
+} // End namespace Alembic
+
+#endif
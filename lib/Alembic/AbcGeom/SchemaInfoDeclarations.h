@@ -139,6 +139,15 @@ ALEMBIC_ABCGEOM_DECLARE_SCHEMA_INFO( "AbcGeom_Xform_v3",
 
 #define ALEMBIC_ABCGEOM_XFORM_SCHEMA (XformSchemaInfo::title())
 
+//-*****************************************************************************
+// XformTable
+ALEMBIC_ABCGEOM_DECLARE_SCHEMA_INFO( "AbcGeom_XformTable_v1",
+                                     "",
+                                     ".xformTable",
+                                     XformTableSchemaInfo );
+
+#define ALEMBIC_ABCGEOM_XFORMTABLE_SCHEMA (XformTableSchemaInfo::title())
+
 //-*****************************************************************************
 // Camera
 ALEMBIC_ABCGEOM_DECLARE_SCHEMA_INFO( "AbcGeom_Camera_v1",
@@ -35,6 +35,7 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
 #include <Alembic/Abc/All.h>
 #include <Alembic/AbcGeom/Visibility.h>
 #include <Alembic/AbcGeom/ArchiveBounds.h>
@@ -42,6 +43,8 @@
 
 #include <Alembic/AbcCoreAbstract/Tests/Assert.h>
 
+#include <sstream>
+
 namespace Abc = Alembic::Abc;
 
 using namespace Alembic::AbcGeom; // Contains Abc, AbcCoreAbstract
@@ -556,9 +559,181 @@ void readNestedCommpoundWithVis(const std::string &archiveName)
     ABCA_ASSERT( IsAncestorInvisible (child1) == true, "child1 should eval to being not visible");
     ABCA_ASSERT( IsAncestorInvisible (otherChild) == false, "other object should eval to being visible");
 
+    // The resolver should agree with IsAncestorInvisible for every object
+    VisibilityResolver resolver( archiveTop );
+    std::vector<Alembic::Util::uint8_t> visible;
+    resolver.resolve( ISampleSelector(), visible );
+    TESTING_ASSERT( resolver.getNumObjects() == visible.size() );
+    TESTING_ASSERT( resolver.getFullName( 0 ) == "/" );
+    TESTING_ASSERT( resolver.getParentIndex( 0 ) ==
+                    VisibilityResolver::kNoParent );
+    for ( size_t i = 0; i < visible.size(); ++i )
+    {
+        IObject obj = archive.getTop();
+        std::string fullName = resolver.getFullName( i );
+        size_t start = 1;
+        while ( start < fullName.size() )
+        {
+            size_t end = fullName.find( '/', start );
+            if ( end == std::string::npos )
+            {
+                end = fullName.size();
+            }
+            obj = obj.getChild( fullName.substr( start, end - start ) );
+            start = end + 1;
+        }
+        TESTING_ASSERT( obj.valid() );
+        TESTING_ASSERT( ( visible[i] == 0 ) == IsAncestorInvisible( obj ) );
+    }
+
+    // Resolving below a hidden object still honors it
+    VisibilityResolver subResolver( child1SubObject );
+    subResolver.resolve( ISampleSelector(), visible );
+    TESTING_ASSERT( visible.size() == 1 && visible[0] == 0 );
+
     // Done - the archive closes itself
 }
 
+//-*****************************************************************************
+void animatedVisibilityResolver( const std::string &archiveName )
+{
+    {
+        OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
+                          archiveName, ErrorHandler::kThrowPolicy );
+        OObject archiveTop = archive.getTop();
+
+        TimeSampling ts( 1.0 / 24.0, 0.0 );
+        Alembic::Util::uint32_t tsidx = archive.addTimeSampling( ts );
+
+        // group blinks, its child defers, the grandchild is always visible
+        OObject group( archiveTop, "group" );
+        OVisibilityProperty groupVis = CreateVisibilityProperty( group,
+                                                                 tsidx );
+        groupVis.set( kVisibilityVisible );
+        groupVis.set( kVisibilityHidden );
+        groupVis.set( kVisibilityDeferred );
+
+        OObject child( group, "child" );
+        OVisibilityProperty childVis = CreateVisibilityProperty( child,
+                                                                 tsidx );
+        childVis.set( kVisibilityDeferred );
+
+        OObject grandChild( child, "grandChild" );
+        OVisibilityProperty grandChildVis =
+            CreateVisibilityProperty( grandChild, tsidx );
+        grandChildVis.set( kVisibilityVisible );
+
+        OObject sibling( archiveTop, "sibling" );
+    }
+
+    IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(),
+                      archiveName, ErrorHandler::kThrowPolicy );
+    VisibilityResolver resolver( archive.getTop() );
+
+    // top, group, child, grandChild, sibling
+    TESTING_ASSERT( resolver.getNumObjects() == 5 );
+    TESTING_ASSERT( resolver.getNumAnimated() == 1 );
+    TESTING_ASSERT( resolver.getFullName( 3 ) == "/group/child/grandChild" );
+    TESTING_ASSERT( resolver.getParentIndex( 3 ) == 2 );
+    TESTING_ASSERT( resolver.getParentIndex( 4 ) == 0 );
+
+    const int expected[3][5] = { { 1, 1, 1, 1, 1 },
+                                 { 1, 0, 0, 1, 1 },
+                                 { 1, 1, 1, 1, 1 } };
+
+    for ( index_t s = 0; s < 3; ++s )
+    {
+        // the same thing done the way a threaded caller would
+        std::vector<Alembic::Util::int8_t> values =
+            resolver.getConstantValues();
+        resolver.readAnimatedValues( s, 0, resolver.getNumAnimated(),
+                                     values );
+
+        std::vector<Alembic::Util::uint8_t> visible;
+        std::vector<Alembic::Util::uint8_t> propagated;
+        resolver.resolve( s, visible );
+        resolver.propagate( s, values, propagated );
+        TESTING_ASSERT( visible == propagated );
+
+        for ( size_t i = 0; i < 5; ++i )
+        {
+            TESTING_ASSERT( visible[i] == expected[s][i] );
+        }
+    }
+}
+
+void threadedVisibilityResolver( const std::string &archiveName )
+{
+    const size_t numGroups = 10;
+    const size_t numChildren = 12;
+    {
+        OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(),
+                          archiveName, ErrorHandler::kThrowPolicy );
+        OObject archiveTop = archive.getTop();
+
+        TimeSampling ts( 1.0 / 24.0, 0.0 );
+        Alembic::Util::uint32_t tsidx = archive.addTimeSampling( ts );
+
+        // enough animated properties to be split over several threads
+        for ( size_t g = 0; g < numGroups; ++g )
+        {
+            std::ostringstream groupName;
+            groupName << "group" << g;
+            OObject group( archiveTop, groupName.str() );
+            OVisibilityProperty groupVis = CreateVisibilityProperty( group,
+                                                                     tsidx );
+            for ( index_t s = 0; s < 4; ++s )
+            {
+                groupVis.set( ( s + g ) % 3 == 0 ? kVisibilityHidden :
+                              kVisibilityDeferred );
+            }
+
+            for ( size_t c = 0; c < numChildren; ++c )
+            {
+                std::ostringstream childName;
+                childName << "child" << c;
+                OObject child( group, childName.str() );
+                OVisibilityProperty childVis =
+                    CreateVisibilityProperty( child, tsidx );
+                for ( index_t s = 0; s < 4; ++s )
+                {
+                    childVis.set( ( s + c ) % 2 == 0 ? kVisibilityVisible :
+                                  kVisibilityDeferred );
+                }
+            }
+        }
+    }
+
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(),
+                      archiveName, ErrorHandler::kThrowPolicy );
+    VisibilityResolver resolver( archive.getTop() );
+    TESTING_ASSERT( resolver.getNumAnimated() ==
+                    numGroups * ( numChildren + 1 ) );
+
+    for ( index_t s = 0; s < 4; ++s )
+    {
+        std::vector<Alembic::Util::uint8_t> serial;
+        resolver.resolve( s, serial );
+
+        std::vector<Alembic::Util::uint8_t> threaded;
+        resolver.resolve( s, threaded, 4 );
+        TESTING_ASSERT( serial == threaded );
+
+        // the objects are numbered depth first, the top being 0
+        size_t index = 1;
+        for ( size_t g = 0; g < numGroups; ++g )
+        {
+            IObject group = archive.getTop().getChild( g );
+            TESTING_ASSERT( serial[index++] ==
+                            !IsAncestorInvisible( group, s ) );
+            for ( size_t c = 0; c < numChildren; ++c )
+            {
+                TESTING_ASSERT( serial[index++] ==
+                    !IsAncestorInvisible( group.getChild( c ), s ) );
+            }
+        }
+    }
+}
 
 int main( int argc, char *argv[] )
 {
@@ -578,6 +753,9 @@ int main( int argc, char *argv[] )
         std::string archiveName2("simpleHelperProps.abc");
         writeSimpleProperties(archiveName2);
         readSimpleProperties(archiveName2);
+
+        animatedVisibilityResolver("animatedVisibility.abc");
+        threadedVisibilityResolver("threadedVisibility.abc");
     }
     catch (char * str )
     {
@@ -59,6 +59,7 @@
 // Alembic Includes
 #include <Alembic/AbcGeom/All.h>
 #include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
 
 // Other includes
 #include <iostream>
@@ -341,6 +342,225 @@ void optPropTest()
     }
 }
 
+//-*****************************************************************************
+void expandedBufferTest()
+{
+    std::string name = "meshExpandedBufferTest.abc";
+    {
+        OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(), name );
+        OPolyMesh meshyObj( OObject( archive, kTop ), "mesh" );
+        OPolyMeshSchema &mesh = meshyObj.getSchema();
+
+        // 4 unique uvs indexed per face vertex
+        std::vector< V2f > uvs( 4 );
+        uvs[0] = V2f( 0.0f, 0.0f );
+        uvs[1] = V2f( 1.0f, 0.0f );
+        uvs[2] = V2f( 1.0f, 1.0f );
+        uvs[3] = V2f( 0.0f, 1.0f );
+
+        std::vector< Alembic::Util::uint32_t > uvIndices( g_numIndices );
+        for ( size_t i = 0; i < g_numIndices; ++i )
+        {
+            uvIndices[i] = i % 4;
+        }
+
+        OPolyMeshSchema::Sample mesh_samp(
+            V3fArraySample( ( const V3f * )g_verts, g_numVerts ),
+            Int32ArraySample( g_indices, g_numIndices ),
+            Int32ArraySample( g_counts, g_numCounts ) );
+
+        OV2fGeomParam::Sample uvsamp( V2fArraySample( uvs ),
+                                      UInt32ArraySample( uvIndices ),
+                                      kFacevaryingScope );
+
+        // first two samples are identical, the third has new values
+        mesh_samp.setUVs( uvsamp );
+        mesh.set( mesh_samp );
+        mesh.set( mesh_samp );
+
+        uvs[0] = V2f( 0.5f, 0.5f );
+        uvsamp.setVals( V2fArraySample( uvs ) );
+        mesh_samp.setUVs( uvsamp );
+        mesh.set( mesh_samp );
+    }
+
+    {
+        IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), name );
+
+        IPolyMesh meshyObj( IObject( archive, kTop ), "mesh" );
+        IPolyMeshSchema &mesh = meshyObj.getSchema();
+        IV2fGeomParam uv = mesh.getUVsParam();
+        TESTING_ASSERT( uv.isIndexed() );
+        TESTING_ASSERT( 3 == uv.getNumSamples() );
+
+        IV2fGeomParam::ExpandedBuffer buf;
+        TESTING_ASSERT( ! buf.valid() );
+
+        TESTING_ASSERT( uv.getExpanded( buf, ISampleSelector( ( index_t ) 0 ) ) );
+        TESTING_ASSERT( buf.valid() );
+        TESTING_ASSERT( buf.isIndexed() );
+        TESTING_ASSERT( buf.getScope() == kFacevaryingScope );
+        TESTING_ASSERT( buf.size() == g_numIndices );
+
+        const V2f * first = buf.get();
+
+        // same sample keys, nothing should be read
+        TESTING_ASSERT( ! uv.getExpanded( buf, ISampleSelector( ( index_t ) 1 ) ) );
+        TESTING_ASSERT( buf.get() == first );
+
+        // new values, same size, the storage should be reused
+        TESTING_ASSERT( uv.getExpanded( buf, ISampleSelector( ( index_t ) 2 ) ) );
+        TESTING_ASSERT( buf.get() == first );
+
+        IV2fGeomParam::Sample expanded =
+            uv.getExpandedValue( ISampleSelector( ( index_t ) 2 ) );
+        TESTING_ASSERT( expanded.getVals()->size() == buf.size() );
+        for ( size_t i = 0; i < buf.size(); ++i )
+        {
+            TESTING_ASSERT( (*expanded.getVals())[i] == buf[i] );
+        }
+        TESTING_ASSERT( buf[0] == V2f( 0.5f, 0.5f ) );
+        TESTING_ASSERT( buf[1] == V2f( 1.0f, 0.0f ) );
+
+        // reset forgets the keys but keeps the storage
+        buf.reset();
+        TESTING_ASSERT( ! buf.valid() );
+        TESTING_ASSERT( uv.getExpanded( buf, ISampleSelector( ( index_t ) 2 ) ) );
+        TESTING_ASSERT( buf.get() == first );
+    }
+
+    {
+        // non-indexed params are read straight into the buffer
+        IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), "polyMesh1.abc" );
+        IPolyMesh meshyObj( IObject( archive, kTop ), "meshy" );
+        IN3fGeomParam N = meshyObj.getSchema().getNormalsParam();
+        TESTING_ASSERT( ! N.isIndexed() );
+
+        IN3fGeomParam::ExpandedBuffer buf;
+        TESTING_ASSERT( N.getExpanded( buf ) );
+        TESTING_ASSERT( ! N.getExpanded( buf ) );
+
+        N3fArraySamplePtr nsp = N.getExpandedValue().getVals();
+        TESTING_ASSERT( nsp->size() == buf.size() );
+        for ( size_t i = 0; i < buf.size(); ++i )
+        {
+            TESTING_ASSERT( (*nsp)[i] == buf[i] );
+        }
+    }
+}
+
+//-*****************************************************************************
+void changedArraysTest( bool iUseOgawa )
+{
+    std::string name = iUseOgawa ? "meshChangedOgawa.abc" :
+        "meshChangedHDF5.abc";
+    {
+        OArchive archive;
+        if ( iUseOgawa )
+        {
+            archive = OArchive( Alembic::AbcCoreOgawa::WriteArchive(), name );
+        }
+        else
+        {
+            archive = OArchive( Alembic::AbcCoreHDF5::WriteArchive(), name );
+        }
+
+        OPolyMesh meshyObj( OObject( archive, kTop ), "mesh" );
+        OPolyMeshSchema &mesh = meshyObj.getSchema();
+
+        std::vector< V3f > verts( ( const V3f * )g_verts,
+                                  ( const V3f * )g_verts + g_numVerts );
+        std::vector< Alembic::Util::int32_t > indices( g_indices,
+                                                       g_indices + g_numIndices );
+        std::vector< V2f > uvs( g_numIndices, V2f( 0.0f, 0.0f ) );
+
+        OV2fGeomParam::Sample uvsamp( V2fArraySample( uvs ),
+                                      kFacevaryingScope );
+
+        // 0 and 1 are identical, 2 moves the points and the uvs, 3 flips
+        // the winding of the first face
+        for ( size_t i = 0; i < 4; ++i )
+        {
+            if ( i == 2 )
+            {
+                verts[0].x += 1.0f;
+                uvs[0].x = 1.0f;
+            }
+            else if ( i == 3 )
+            {
+                std::swap( indices[0], indices[1] );
+            }
+
+            uvsamp.setVals( V2fArraySample( uvs ) );
+            OPolyMeshSchema::Sample mesh_samp(
+                V3fArraySample( verts ), Int32ArraySample( indices ),
+                Int32ArraySample( g_counts, g_numCounts ), uvsamp );
+            mesh.set( mesh_samp );
+        }
+    }
+
+    IArchive archive;
+    if ( iUseOgawa )
+    {
+        archive = IArchive( Alembic::AbcCoreOgawa::ReadArchive(), name );
+    }
+    else
+    {
+        archive = IArchive( Alembic::AbcCoreHDF5::ReadArchive(), name );
+    }
+
+    IPolyMesh meshyObj( IObject( archive, kTop ), "mesh" );
+    IPolyMeshSchema &mesh = meshyObj.getSchema();
+    TESTING_ASSERT( mesh.getNumSamples() == 4 );
+
+    ISampleSelector ss0( ( index_t ) 0 );
+    ISampleSelector ss1( ( index_t ) 1 );
+    ISampleSelector ss2( ( index_t ) 2 );
+    ISampleSelector ss3( ( index_t ) 3 );
+
+    // the counts never change, so they're stored once
+    TESTING_ASSERT( mesh.getFaceCountsProperty().isConstant() );
+    TESTING_ASSERT( !mesh.getFaceCountsProperty().isChangedSince( ss0, ss3 ) );
+    TESTING_ASSERT( !mesh.getPositionsProperty().isChangedSince( ss0, ss1 ) );
+    TESTING_ASSERT( mesh.getPositionsProperty().isChangedSince( ss1, ss2 ) );
+    TESTING_ASSERT( !mesh.getPositionsProperty().isChangedSince( ss2, ss3 ) );
+
+    IV2fGeomParam uv = mesh.getUVsParam();
+    TESTING_ASSERT( !uv.isChangedSince( ss0, ss1 ) );
+    TESTING_ASSERT( uv.isChangedSince( ss1, ss2 ) );
+    TESTING_ASSERT( !uv.isChangedSince( ss2, ss3 ) );
+
+    // an empty sample is read completely
+    IPolyMeshSchema::Sample samp;
+    TESTING_ASSERT( mesh.getChanged( samp, ss0, ss0 ) ==
+                    ( IPolyMeshSchema::kPositionsChanged |
+                      IPolyMeshSchema::kFaceIndicesChanged |
+                      IPolyMeshSchema::kFaceCountsChanged ) );
+    TESTING_ASSERT( samp.valid() );
+
+    Int32ArraySamplePtr indicesPtr = samp.getFaceIndices();
+    P3fArraySamplePtr positionsPtr = samp.getPositions();
+
+    TESTING_ASSERT( mesh.getChanged( samp, ss0, ss1 ) == 0 );
+    TESTING_ASSERT( samp.getPositions() == positionsPtr );
+
+    TESTING_ASSERT( mesh.getChanged( samp, ss1, ss2 ) ==
+                    IPolyMeshSchema::kPositionsChanged );
+    TESTING_ASSERT( samp.getFaceIndices() == indicesPtr );
+    TESTING_ASSERT( (*samp.getPositions())[0].x == g_verts[0] + 1.0f );
+
+    TESTING_ASSERT( mesh.getChanged( samp, ss2, ss3 ) ==
+                    IPolyMeshSchema::kFaceIndicesChanged );
+    TESTING_ASSERT( (*samp.getFaceIndices())[0] == g_indices[1] );
+
+    // going backwards works the same way
+    TESTING_ASSERT( mesh.getChanged( samp, ss3, ss0 ) ==
+                    ( IPolyMeshSchema::kPositionsChanged |
+                      IPolyMeshSchema::kFaceIndicesChanged ) );
+    TESTING_ASSERT( (*samp.getFaceIndices())[0] == g_indices[0] );
+    TESTING_ASSERT( (*samp.getPositions())[0].x == g_verts[0] );
+}
+
 //-*****************************************************************************
 //-*****************************************************************************
 //-*****************************************************************************
@@ -360,5 +580,10 @@ int main( int argc, char *argv[] )
     meshUnderXformOut( "animatedXformedMesh.abc" );
 
     optPropTest();
+
+    expandedBufferTest();
+
+    changedArraysTest( false );
+    changedArraysTest( true );
     return 0;
 }
@@ -0,0 +1,193 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+using namespace Alembic::AbcGeom;
+
+static const size_t g_numEntries = 100;
+static const size_t g_numSamples = 10;
+
+//-*****************************************************************************
+M44d entryMatrix( size_t iEntry, size_t iSample )
+{
+    M44d mat;
+    mat.setTranslation( V3d( ( double ) iEntry, ( double ) iSample, 1.0 ) );
+    return mat;
+}
+
+//-*****************************************************************************
+void xformTableOut()
+{
+    OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
+                      "xformTable.abc" );
+
+    OXformTable crowd( OObject( archive, kTop ), "crowd" );
+    OXformTableSchema &schema = crowd.getSchema();
+
+    std::vector< std::string > names;
+    std::vector< Alembic::Util::bool_t > inherits;
+    for ( size_t i = 0; i < g_numEntries; ++i )
+    {
+        std::ostringstream strm;
+        strm << "agent" << i;
+        names.push_back( strm.str() );
+
+        // every third agent ignores its parents transform
+        inherits.push_back( i % 3 != 0 );
+    }
+
+    for ( size_t s = 0; s < g_numSamples; ++s )
+    {
+        std::vector< M44d > mats;
+        for ( size_t i = 0; i < g_numEntries; ++i )
+        {
+            mats.push_back( entryMatrix( i, s ) );
+        }
+
+        // names and inherits only need to be written once
+        if ( s == 0 )
+        {
+            schema.set( OXformTableSchema::Sample( M44dArraySample( mats ),
+                StringArraySample( names ), BoolArraySample( inherits ) ) );
+        }
+        else
+        {
+            schema.set( OXformTableSchema::Sample(
+                M44dArraySample( mats ) ) );
+        }
+    }
+
+    // a different number of matrices would leave the names behind
+    std::vector< M44d > fewerMats( 2 );
+    bool threw = false;
+    try
+    {
+        schema.set( OXformTableSchema::Sample(
+            M44dArraySample( fewerMats ) ) );
+    }
+    catch ( std::exception & )
+    {
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+    TESTING_ASSERT( schema.getNumSamples() == g_numSamples );
+
+    // a bad sample doesn't create the names property before failing
+    OXformTable empty( OObject( archive, kTop ), "empty" );
+    std::vector< M44d > noMats;
+    std::vector< std::string > twoNames( 2 );
+    threw = false;
+    try
+    {
+        empty.getSchema().set( OXformTableSchema::Sample(
+            M44dArraySample( noMats ), StringArraySample( twoNames ) ) );
+    }
+    catch ( std::exception & )
+    {
+        threw = true;
+    }
+    TESTING_ASSERT( threw );
+
+    empty.getSchema().set( OXformTableSchema::Sample(
+        M44dArraySample( noMats ) ) );
+}
+
+//-*****************************************************************************
+void xformTableIn()
+{
+    IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), "xformTable.abc" );
+
+    IObject crowdObj( IObject( archive, kTop ), "crowd" );
+    TESTING_ASSERT( IXformTable::matches( crowdObj.getHeader() ) );
+    TESTING_ASSERT( !IXform::matches( crowdObj.getHeader() ) );
+
+    IXformTable crowd( crowdObj, kWrapExisting );
+    IXformTableSchema &schema = crowd.getSchema();
+
+    TESTING_ASSERT( schema.getNumSamples() == g_numSamples );
+    TESTING_ASSERT( !schema.isConstant() );
+    TESTING_ASSERT( schema.getNamesProperty().isConstant() );
+    TESTING_ASSERT( schema.getInheritsProperty().isConstant() );
+
+    for ( size_t s = 0; s < g_numSamples; ++s )
+    {
+        IXformTableSchema::Sample samp;
+        schema.get( samp, s );
+
+        TESTING_ASSERT( samp.getNumEntries() == g_numEntries );
+
+        for ( size_t i = 0; i < g_numEntries; ++i )
+        {
+            std::ostringstream strm;
+            strm << "agent" << i;
+            TESTING_ASSERT( samp.getName( i ) == strm.str() );
+
+            TESTING_ASSERT( samp.getMatrix( i ) == entryMatrix( i, s ) );
+
+            // the entry should look just like a regular xform
+            XformSample xs = samp.getXformSample( i );
+            TESTING_ASSERT( xs.getNumOps() == 1 );
+            TESTING_ASSERT( xs[0].getType() == kMatrixOperation );
+            TESTING_ASSERT( xs.getMatrix() == entryMatrix( i, s ) );
+            TESTING_ASSERT( xs.getInheritsXforms() == ( i % 3 != 0 ) );
+        }
+    }
+
+    XformSample xs;
+    schema.getXformSample( 43, xs, 3 );
+    TESTING_ASSERT( xs.getTranslation() == V3d( 43.0, 3.0, 1.0 ) );
+    TESTING_ASSERT( xs.getInheritsXforms() );
+
+    IXformTable empty( IObject( archive, kTop ), "empty" );
+    TESTING_ASSERT( !empty.getSchema().getNamesProperty() );
+    TESTING_ASSERT( !empty.getSchema().getInheritsProperty() );
+
+    IXformTableSchema::Sample emptySamp = empty.getSchema().getValue();
+    TESTING_ASSERT( emptySamp.valid() );
+    TESTING_ASSERT( emptySamp.getNumEntries() == 0 );
+    TESTING_ASSERT( emptySamp.getInheritsXforms( 0 ) );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    xformTableOut();
+    xformTableIn();
+    return 0;
+}
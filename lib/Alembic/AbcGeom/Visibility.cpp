@@ -36,6 +36,10 @@
 
 #include <Alembic/AbcGeom/Visibility.h>
 
+#include <Alembic/Util/Tasks.h>
+
+#include <algorithm>
+
 
 namespace Alembic {
 namespace AbcGeom {
@@ -147,6 +151,171 @@ bool IsAncestorInvisible( IObject iObject,
     return false;
 }
 
+const size_t VisibilityResolver::kNoParent;
+
+namespace {
+
+// the animated properties are handed out to the threads this many at a time
+const size_t kAnimatedPerTask = 16;
+
+class ReadAnimatedTasks : public Alembic::Util::Tasks
+{
+public:
+    ReadAnimatedTasks( const VisibilityResolver &iResolver,
+                       const Abc::ISampleSelector &iSS,
+                       std::vector<int8_t> &ioValues )
+      : m_resolver( iResolver )
+      , m_ss( iSS )
+      , m_values( ioValues )
+    {}
+
+    // every object appears once, so the ranges write disjoint values
+    virtual void run( size_t iIndex )
+    {
+        size_t numAnimated = m_resolver.getNumAnimated();
+        size_t begin = iIndex * kAnimatedPerTask;
+        m_resolver.readAnimatedValues( m_ss, begin,
+            std::min( begin + kAnimatedPerTask, numAnimated ), m_values );
+    }
+
+private:
+    const VisibilityResolver &m_resolver;
+    const Abc::ISampleSelector &m_ss;
+    std::vector<int8_t> &m_values;
+};
+
+} // End anonymous namespace
+
+VisibilityResolver::VisibilityResolver( IObject iRoot )
+  : m_root( iRoot )
+{
+    ABCA_ASSERT ( iRoot,
+                 "VisibilityResolver (): object passed in isn't valid.");
+
+    // depth first, pushing the children in reverse so they come off the
+    // stack, and get numbered, in their natural order
+    std::vector< std::pair<IObject, size_t> > stack;
+    stack.push_back( std::make_pair( iRoot, kNoParent ) );
+
+    while ( !stack.empty() )
+    {
+        IObject obj = stack.back().first;
+        size_t parent = stack.back().second;
+        stack.pop_back();
+
+        size_t index = m_parents.size();
+        m_parents.push_back( parent );
+        m_fullNames.push_back( obj.getFullName() );
+        m_constantValues.push_back( kVisibilityDeferred );
+
+        IVisibilityProperty visibilityProperty = GetVisibilityProperty( obj );
+        if ( visibilityProperty )
+        {
+            if ( visibilityProperty.isConstant() )
+            {
+                m_constantValues.back() = visibilityProperty.getValue();
+            }
+            else
+            {
+                m_animated.push_back(
+                    std::make_pair( index, visibilityProperty ) );
+            }
+        }
+
+        for ( size_t i = obj.getNumChildren(); i > 0; --i )
+        {
+            stack.push_back( std::make_pair( obj.getChild( i - 1 ), index ) );
+        }
+    }
+}
+
+void VisibilityResolver::readAnimatedValues( const Abc::ISampleSelector &iSS,
+                                             size_t iBegin, size_t iEnd,
+                                             std::vector<int8_t> &ioValues )
+    const
+{
+    ABCA_ASSERT( iBegin <= iEnd && iEnd <= m_animated.size() &&
+                 ioValues.size() == m_parents.size(),
+                 "VisibilityResolver::readAnimatedValues (): invalid range" );
+
+    for ( size_t i = iBegin; i < iEnd; ++i )
+    {
+        ioValues[ m_animated[i].first ] = m_animated[i].second.getValue( iSS );
+    }
+}
+
+void VisibilityResolver::propagate( const Abc::ISampleSelector &iSS,
+                                    const std::vector<int8_t> &iValues,
+                                    std::vector<uint8_t> &oVisible ) const
+{
+    size_t numObjects = m_parents.size();
+    ABCA_ASSERT( iValues.size() == numObjects,
+                 "VisibilityResolver::propagate (): wrong number of values" );
+
+    oVisible.resize( numObjects );
+    if ( numObjects == 0 )
+    {
+        return;
+    }
+
+    // parents always precede their children, so one pass is enough
+    for ( size_t i = 0; i < numObjects; ++i )
+    {
+        if ( iValues[i] == kVisibilityDeferred )
+        {
+            size_t parent = m_parents[i];
+            if ( parent != kNoParent )
+            {
+                oVisible[i] = oVisible[parent];
+            }
+            else
+            {
+                oVisible[i] = !IsAncestorInvisible( m_root, iSS );
+            }
+        }
+        else
+        {
+            oVisible[i] = iValues[i] != kVisibilityHidden;
+        }
+    }
+}
+
+void VisibilityResolver::resolve( const Abc::ISampleSelector &iSS,
+                                  std::vector<uint8_t> &oVisible ) const
+{
+    resolve( iSS, oVisible, 1 );
+}
+
+void VisibilityResolver::resolve( const Abc::ISampleSelector &iSS,
+                                  std::vector<uint8_t> &oVisible,
+                                  size_t iNumThreads ) const
+{
+    std::vector<int8_t> values( m_constantValues );
+
+    size_t numTasks = ( m_animated.size() + kAnimatedPerTask - 1 ) /
+        kAnimatedPerTask;
+
+    if ( iNumThreads <= 1 || numTasks <= 1 )
+    {
+        readAnimatedValues( iSS, 0, m_animated.size(), values );
+    }
+    else
+    {
+        ReadAnimatedTasks tasks( *this, iSS, values );
+
+        try
+        {
+            Alembic::Util::runTasks( tasks, numTasks, iNumThreads );
+        }
+        catch ( std::exception &exc )
+        {
+            ABCA_THROW( "VisibilityResolver::resolve (): " << exc.what() );
+        }
+    }
+
+    propagate( iSS, values, oVisible );
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcGeom
 } // End namespace Alembic
@@ -119,6 +119,78 @@ bool IsAncestorInvisible( IObject schemaObject,
                           const Abc::ISampleSelector &iSS =
                           Abc::ISampleSelector () );
 
+//! Resolves the effective visibility of every object in a subtree at once.
+//! The hierarchy is walked a single time on construction, numbering the
+//! objects depth first (the root is index 0 and every parent comes before
+//! its children) and keeping the visibility properties of the objects
+//! that have one. Constant visibility is read up front, so resolving a
+//! frame only reads the animated properties and then propagates the
+//! values down in one linear pass, instead of walking the ancestors of
+//! every object as IsAncestorInvisible does.
+//! Once constructed the resolver is not modified by any of the read
+//! functions, so resolve can read the animated properties on several
+//! threads and readAnimatedValues may be called by a caller's own threads
+//! on disjoint ranges.
+class VisibilityResolver
+{
+public:
+    static const size_t kNoParent = ~size_t( 0 );
+
+    VisibilityResolver() {}
+
+    explicit VisibilityResolver( IObject iRoot );
+
+    size_t getNumObjects() const { return m_parents.size(); }
+
+    //! The index of the parent of object iIndex, kNoParent for the root.
+    size_t getParentIndex( size_t iIndex ) const
+    { return m_parents[iIndex]; }
+
+    const std::string &getFullName( size_t iIndex ) const
+    { return m_fullNames[iIndex]; }
+
+    //! The explicit ObjectVisibility of every object that doesn't change
+    //! over time, kVisibilityDeferred for those that have no property.
+    const std::vector<int8_t> &getConstantValues() const
+    { return m_constantValues; }
+
+    //! The number of objects with animated visibility.
+    size_t getNumAnimated() const { return m_animated.size(); }
+
+    //! Reads the animated visibility values [iBegin, iEnd) into ioValues,
+    //! which is indexed by object and usually starts as a copy of
+    //! getConstantValues().
+    void readAnimatedValues( const Abc::ISampleSelector &iSS,
+                             size_t iBegin, size_t iEnd,
+                             std::vector<int8_t> &ioValues ) const;
+
+    //! Turns the explicit values into the effective visibility of every
+    //! object, 1 if visible and 0 if hidden, following the rules of
+    //! IsAncestorInvisible. The ancestors of the root are consulted when
+    //! the root defers.
+    void propagate( const Abc::ISampleSelector &iSS,
+                    const std::vector<int8_t> &iValues,
+                    std::vector<uint8_t> &oVisible ) const;
+
+    //! Reads and propagates in one go.
+    void resolve( const Abc::ISampleSelector &iSS,
+                  std::vector<uint8_t> &oVisible ) const;
+
+    //! As above, but the animated properties are read on up to iNumThreads
+    //! threads (the calling thread included) before the values are
+    //! propagated, using Alembic::Util::runTasks.
+    void resolve( const Abc::ISampleSelector &iSS,
+                  std::vector<uint8_t> &oVisible,
+                  size_t iNumThreads ) const;
+
+private:
+    IObject m_root;
+    std::vector<size_t> m_parents;
+    std::vector<std::string> m_fullNames;
+    std::vector<int8_t> m_constantValues;
+    std::vector< std::pair<size_t, IVisibilityProperty> > m_animated;
+};
+
 } // End namespace ALEMBIC_VERSION_NS
 
 using namespace ALEMBIC_VERSION_NS;
@@ -115,6 +115,55 @@ void split_tokens( const std::string & iValue,
     }
 }
 
+
+Abc::IObject findObject( Abc::IObject iTop, const std::string & iPath )
+{
+    Abc::IObject parent = iTop;
+
+    size_t lastPos = 0;
+    bool isDone = false;
+
+    while ( ! isDone )
+    {
+        size_t curPos = iPath.find( '/', lastPos );
+        size_t length = 0;
+
+        if ( curPos == std::string::npos )
+        {
+            isDone = true;
+            length = std::string::npos;
+        }
+        // no other characters between / (starting / or multiple / in a row)
+        else if ( lastPos == curPos )
+        {
+            lastPos = curPos + 1;
+            if ( lastPos == iPath.size() )
+            {
+                isDone = true;
+            }
+            continue;
+        }
+        else
+        {
+            length = curPos - lastPos;
+        }
+
+        std::string childName = iPath.substr( lastPos, length );
+        lastPos = curPos + 1;
+
+        if ( parent.getChildHeader( childName ) )
+        {
+            parent = parent.getChild( childName );
+        }
+        else
+        {
+            return Abc::IObject();
+        }
+    }
+
+    return parent;
+}
+
 } // End namespace Util
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcGeom
@@ -55,6 +55,10 @@ void split_tokens( const std::string & iValue,
                    std::vector<std::string> & oResult,
                    size_t iMaxSplit = 0 );
 
+//! Walks down from iTop to the object at the '/' separated iPath, returning
+//! an invalid object if any part of the path doesn't exist.
+Abc::IObject findObject( Abc::IObject iTop, const std::string & iPath );
+
 }
 }
 }
@@ -36,6 +36,7 @@
 
 #include <Alembic/AbcMaterial/MaterialFlatten.h>
 #include <Alembic/AbcMaterial/MaterialAssignment.h>
+#include "InternalUtil.h"
 
 #include <set>
 
@@ -82,59 +83,18 @@ MaterialFlatten::MaterialFlatten( Abc::IObject iObject,
         //For now, walk from root and then back down
         //eventually, support relative paths
 
-        Abc::IObject parent;
+        Abc::IObject top;
         if ( iAlternateSearchArchive.valid() &&
              iAlternateSearchArchive.getTop().valid() )
         {
-            parent = iAlternateSearchArchive.getTop();
+            top = iAlternateSearchArchive.getTop();
         }
         else
         {
-            parent = iObject.getArchive().getTop();
+            top = iObject.getArchive().getTop();
         }
 
-
-        size_t lastPos = 0;
-        bool isDone = false;
-
-        while ( ! isDone )
-        {
-            size_t curPos = assignedPath.find( '/', lastPos );
-            size_t length = 0;
-
-            if ( curPos == std::string::npos )
-            {
-                isDone = true;
-                length = std::string::npos;
-            }
-            // no other characters between / (starting / or multiple / in a row)
-            else if ( lastPos == curPos )
-            {
-                lastPos = curPos + 1;
-                if ( lastPos == assignedPath.size() )
-                {
-                    isDone = true;
-                }
-                continue;
-            }
-            else
-            {
-                length = curPos - lastPos;
-            }
-
-            std::string childName = assignedPath.substr( lastPos, length );
-            lastPos = curPos + 1;
-
-            if ( parent.getChildHeader( childName ) )
-            {
-                parent = parent.getChild( childName );
-            }
-            else
-            {
-                parent = Abc::IObject();
-                break;
-            }
-        }
+        Abc::IObject parent = Util::findObject( top, assignedPath );
 
         if ( parent.valid() && IMaterial::matches( parent.getHeader() ) )
         {
@@ -151,6 +111,14 @@ void MaterialFlatten::append( IMaterialSchema iMaterialSchema )
 }
 
 
+void MaterialFlatten::append( const MaterialFlatten & iFlatten )
+{
+    m_schemas.insert( m_schemas.end(), iFlatten.m_schemas.begin(),
+                      iFlatten.m_schemas.end() );
+
+    m_networkFlattened = false;
+}
+
 void MaterialFlatten::append( IMaterial iMaterialObject )
 {
     //append the schema objects
@@ -361,7 +329,7 @@ void MaterialFlatten::flattenNetwork()
         {
             const std::string & name = ( *j );
 
-            if ( foundNodes.find( name ) != foundNodes.end() )
+            if ( foundNodes.find( name ) == foundNodes.end() )
             {
                 foundNodes.insert( name );
                 m_nodeNames.push_back( name );
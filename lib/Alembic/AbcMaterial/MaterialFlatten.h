@@ -77,6 +77,9 @@ public:
     
     //! Append the schemas of matching parent material objects
     void append( IMaterial iMaterialObject );
+
+    //! Append the inheritance hierarchy of another flattened material
+    void append( const MaterialFlatten & iFlatten );
     
     
     //! Returns true is there are no schema in the inheritance path
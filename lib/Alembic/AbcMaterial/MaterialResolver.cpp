@@ -0,0 +1,219 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcMaterial/MaterialResolver.h>
+#include <Alembic/AbcMaterial/MaterialAssignment.h>
+#include "InternalUtil.h"
+
+namespace Alembic {
+namespace AbcMaterial {
+namespace ALEMBIC_VERSION_NS {
+
+MaterialResolver::MaterialResolver( Abc::IArchive iSearchArchive )
+: m_archive( iSearchArchive )
+{
+    if ( m_archive.valid() )
+    {
+        m_top = m_archive.getTop();
+    }
+}
+
+bool MaterialResolver::getMaterial( const std::string & iPath,
+                                    IMaterial & oMaterial )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return findMaterial( iPath, oMaterial );
+}
+
+MaterialResolver::MaterialFlattenPtr
+MaterialResolver::getFlattenedMaterial( const std::string & iPath )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return findFlattened( iPath );
+}
+
+MaterialResolver::MaterialFlattenPtr
+MaterialResolver::getFlattenedMaterial( Abc::IObject iObject )
+{
+    IMaterialSchema localMaterial;
+    bool hasLocal = hasMaterial( iObject, localMaterial );
+
+    MaterialFlattenPtr assigned;
+    std::string assignedPath;
+    if ( getMaterialAssignmentPath( iObject, assignedPath ) )
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        assigned = findFlattened( assignedPath );
+    }
+
+    if ( !hasLocal )
+    {
+        return assigned;
+    }
+
+    // a local material comes first, so this one can't be shared
+    MaterialFlattenPtr result( new MaterialFlatten( localMaterial ) );
+
+    if ( assigned )
+    {
+        result->append( *assigned );
+    }
+
+    result->getNumNetworkNodes();
+    return result;
+}
+
+bool MaterialResolver::getShaderParameters( const std::string & iPath,
+    const std::string & iTarget,
+    const std::string & iShaderType,
+    MaterialFlatten::ParameterEntryVector & oResult )
+{
+    oResult.clear();
+
+    std::string key = iPath;
+    key += '\n';
+    key += iTarget;
+    key += '\n';
+    key += iShaderType;
+
+    Alembic::Util::scoped_lock l( m_lock );
+
+    ParameterMap::iterator i = m_parameters.find( key );
+    if ( i != m_parameters.end() )
+    {
+        oResult = ( *i ).second;
+        return true;
+    }
+
+    MaterialFlattenPtr flatten = findFlattened( iPath );
+    if ( !flatten )
+    {
+        return false;
+    }
+
+    flatten->getShaderParameters( iTarget, iShaderType, oResult );
+    m_parameters[key] = oResult;
+    return true;
+}
+
+void MaterialResolver::resolveAssignments( Abc::IObject iRoot,
+                                           AssignmentVector & oResult )
+{
+    if ( !iRoot.valid() )
+    {
+        return;
+    }
+
+    MaterialFlattenPtr material = getFlattenedMaterial( iRoot );
+    if ( material )
+    {
+        Assignment assignment;
+        assignment.object = iRoot;
+        getMaterialAssignmentPath( iRoot, assignment.materialPath );
+        assignment.material = material;
+        oResult.push_back( assignment );
+    }
+
+    for ( size_t i = 0; i < iRoot.getNumChildren(); ++i )
+    {
+        resolveAssignments( iRoot.getChild( i ), oResult );
+    }
+}
+
+void MaterialResolver::clear()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    m_materials.clear();
+    m_flattened.clear();
+    m_parameters.clear();
+}
+
+bool MaterialResolver::findMaterial( const std::string & iPath,
+                                     IMaterial & oMaterial )
+{
+    MaterialMap::iterator i = m_materials.find( iPath );
+    if ( i != m_materials.end() )
+    {
+        oMaterial = ( *i ).second;
+        return oMaterial.valid();
+    }
+
+    Abc::IObject obj;
+    if ( m_top.valid() )
+    {
+        obj = Util::findObject( m_top, iPath );
+    }
+
+    if ( obj.valid() && IMaterial::matches( obj.getHeader() ) )
+    {
+        oMaterial = IMaterial( obj, Abc::kWrapExisting );
+    }
+    else
+    {
+        oMaterial = IMaterial();
+    }
+
+    m_materials[iPath] = oMaterial;
+    return oMaterial.valid();
+}
+
+MaterialResolver::MaterialFlattenPtr
+MaterialResolver::findFlattened( const std::string & iPath )
+{
+    FlattenMap::iterator i = m_flattened.find( iPath );
+    if ( i != m_flattened.end() )
+    {
+        return ( *i ).second;
+    }
+
+    MaterialFlattenPtr result;
+    IMaterial material;
+    if ( findMaterial( iPath, material ) )
+    {
+        result.reset( new MaterialFlatten( material ) );
+
+        // flatten now, so sharing it afterwards only reads from it
+        result->getNumNetworkNodes();
+    }
+
+    m_flattened[iPath] = result;
+    return result;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcMaterial
+} // End namespace Alembic
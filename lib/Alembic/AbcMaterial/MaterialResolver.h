@@ -0,0 +1,134 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcMaterial_MaterialResolver_h_
+#define _Alembic_AbcMaterial_MaterialResolver_h_
+
+#include <Alembic/AbcMaterial/MaterialFlatten.h>
+
+namespace Alembic {
+namespace AbcMaterial {
+namespace ALEMBIC_VERSION_NS {
+
+//! Resolves material assignments against a single archive, caching the
+//! materials found at each assigned path and their flattened inheritance
+//! chains. Objects which share an assignment share one MaterialFlatten, so
+//! thousands of objects using a dozen materials only flatten a dozen times.
+//!
+//! The returned MaterialFlatten objects have already flattened their
+//! networks and are only read from afterwards, so they can be shared by
+//! several threads. The resolver itself locks around its caches.
+class MaterialResolver : private Alembic::Util::noncopyable
+{
+public:
+    typedef Alembic::Util::shared_ptr<MaterialFlatten> MaterialFlattenPtr;
+
+    //! Create with the archive assigned material paths are looked up in.
+    explicit MaterialResolver( Abc::IArchive iSearchArchive );
+
+    //! Returns true and fills oMaterial with the material at iPath, false
+    //! if there is no material there. Either way the answer is cached.
+    bool getMaterial( const std::string & iPath, IMaterial & oMaterial );
+
+    //! Returns the flattened inheritance chain of the material at iPath,
+    //! or NULL if there is no material there.
+    MaterialFlattenPtr getFlattenedMaterial( const std::string & iPath );
+
+    //! Returns what MaterialFlatten( iObject, iSearchArchive ) would build.
+    //! Objects without a local material share the flattening of their
+    //! assigned material. NULL is returned if the object neither has nor is
+    //! assigned a material.
+    MaterialFlattenPtr getFlattenedMaterial( Abc::IObject iObject );
+
+    //! Fills oResult with MaterialFlatten::getShaderParameters for the
+    //! material at iPath, which is only gathered the first time it's asked
+    //! for. Returns false if there is no material at iPath.
+    bool getShaderParameters( const std::string & iPath,
+                              const std::string & iTarget,
+                              const std::string & iShaderType,
+                              MaterialFlatten::ParameterEntryVector & oResult );
+
+    struct Assignment
+    {
+        Abc::IObject object;
+
+        //! The assigned material path, empty with only a local material
+        std::string materialPath;
+
+        MaterialFlattenPtr material;
+    };
+
+    typedef std::vector<Assignment> AssignmentVector;
+
+    //! Appends an Assignment to oResult for iRoot and every descendant of it
+    //! which has or is assigned a material, in depth first order.
+    void resolveAssignments( Abc::IObject iRoot, AssignmentVector & oResult );
+
+    //! Drops everything cached so far.
+    void clear();
+
+private:
+
+    // These expect m_lock to be held.
+    bool findMaterial( const std::string & iPath, IMaterial & oMaterial );
+    MaterialFlattenPtr findFlattened( const std::string & iPath );
+
+    Abc::IArchive m_archive;
+    Abc::IObject m_top;
+
+    Alembic::Util::mutex m_lock;
+
+    // Invalid materials are kept too, so missing paths aren't walked again.
+    typedef std::map<std::string, IMaterial> MaterialMap;
+    MaterialMap m_materials;
+
+    typedef std::map<std::string, MaterialFlattenPtr> FlattenMap;
+    FlattenMap m_flattened;
+
+    // Keyed by the material path, target and shader type.
+    typedef std::map<std::string, MaterialFlatten::ParameterEntryVector>
+        ParameterMap;
+    ParameterMap m_parameters;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcMaterial
+} // End namespace Alembic
+
+#endif
@@ -2,6 +2,7 @@
 #include <Alembic/AbcCoreHDF5/All.h>
 
 #include <Alembic/AbcMaterial/MaterialAssignment.h>
+#include <Alembic/AbcMaterial/MaterialResolver.h>
 #include "PrintMaterial.h"
 #include <Alembic/AbcCoreAbstract/Tests/Assert.h>
 
@@ -133,9 +134,78 @@ void read()
 }
 
 
+void compareFlattened(Mat::MaterialFlatten & iA, Mat::MaterialFlatten & iB)
+{
+    std::string shaderA, shaderB;
+    TESTING_ASSERT(iA.getShader("prman", "surface", shaderA) ==
+        iB.getShader("prman", "surface", shaderB));
+    TESTING_ASSERT(shaderA == shaderB);
+
+    Mat::MaterialFlatten::ParameterEntryVector paramsA, paramsB;
+    iA.getShaderParameters("prman", "surface", paramsA);
+    iB.getShaderParameters("prman", "surface", paramsB);
+    TESTING_ASSERT(paramsA.size() == paramsB.size());
+    for (size_t i = 0; i < paramsA.size(); ++i)
+    {
+        TESTING_ASSERT(paramsA[i].name == paramsB[i].name);
+        TESTING_ASSERT(paramsA[i].parent.getObject().getFullName() ==
+            paramsB[i].parent.getObject().getFullName());
+    }
+}
+
+
+void resolve()
+{
+    Abc::IArchive archive(Alembic::AbcCoreHDF5::ReadArchive(),
+            "MaterialAssignment.abc");
+
+    Mat::MaterialResolver resolver(archive);
+
+    Mat::MaterialResolver::AssignmentVector assignments;
+    resolver.resolveAssignments(archive.getTop(), assignments);
+
+    // geoA, geoB and geoC, materials aren't assigned to themselves
+    TESTING_ASSERT(assignments.size() == 3);
+
+    for (size_t i = 0; i < assignments.size(); ++i)
+    {
+        Mat::MaterialFlatten mafla(assignments[i].object);
+        compareFlattened(mafla, *assignments[i].material);
+    }
+
+    TESTING_ASSERT(assignments[0].object.getName() == "geoA");
+    TESTING_ASSERT(assignments[0].materialPath == "/materials/materialA");
+    TESTING_ASSERT(assignments[0].material ==
+        resolver.getFlattenedMaterial("/materials/materialA"));
+
+    // geoB shares its flattened material, geoC has a local one in front
+    TESTING_ASSERT(assignments[1].material ==
+        resolver.getFlattenedMaterial("/materials/materialA/materialB"));
+    TESTING_ASSERT(assignments[2].material != assignments[1].material);
+
+    Mat::MaterialFlatten::ParameterEntryVector params;
+    TESTING_ASSERT(resolver.getShaderParameters(
+        "/materials/materialA/materialB", "prman", "surface", params));
+    TESTING_ASSERT(params.size() == 2);
+    TESTING_ASSERT(resolver.getShaderParameters(
+        "/materials/materialA/materialB", "prman", "surface", params));
+    TESTING_ASSERT(params.size() == 2);
+
+    Mat::IMaterial material;
+    TESTING_ASSERT(!resolver.getMaterial("/geometry/geoA", material));
+    TESTING_ASSERT(!resolver.getMaterial("/no/such/path", material));
+    TESTING_ASSERT(!resolver.getFlattenedMaterial("/no/such/path"));
+    TESTING_ASSERT(!resolver.getShaderParameters(
+        "/no/such/path", "prman", "surface", params));
+    TESTING_ASSERT(resolver.getMaterial("/materials/materialA", material));
+    TESTING_ASSERT(material.getName() == "materialA");
+}
+
+
 int main( int argc, char *argv[] )
 {
     write();
     read();
+    resolve();
     return 0;
 }
@@ -37,10 +37,12 @@
 #ifndef _Alembic_Ogawa_All_h_
 #define _Alembic_Ogawa_All_h_
 
+#include <Alembic/Ogawa/BlockCache.h>
 #include <Alembic/Ogawa/Foundation.h>
 #include <Alembic/Ogawa/IArchive.h>
 #include <Alembic/Ogawa/IData.h>
 #include <Alembic/Ogawa/IGroup.h>
+#include <Alembic/Ogawa/IStreamReader.h>
 #include <Alembic/Ogawa/IStreams.h>
 #include <Alembic/Ogawa/OArchive.h>
 #include <Alembic/Ogawa/OData.h>
@@ -0,0 +1,391 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Industrial Light & Magic nor the names of
+// its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Ogawa/BlockCache.h>
+#include <algorithm>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string.h>
+
+namespace Alembic {
+namespace Ogawa {
+namespace ALEMBIC_VERSION_NS {
+
+// the most blocks fetched from the source at once, bigger reads are split
+static const Alembic::Util::uint64_t MAX_FETCH_BLOCKS = 16;
+
+static const Alembic::Util::uint64_t NO_BLOCK = ~Alembic::Util::uint64_t(0);
+
+typedef std::pair< std::string, Alembic::Util::uint64_t > BlockKey;
+
+struct CachedBlock
+{
+    BlockKey key;
+    std::vector<char> data;
+};
+
+typedef std::list< CachedBlock > BlockList;
+
+static Alembic::Util::mutex g_sharedLock;
+static BlockCachePtr g_sharedCache;
+
+class BlockCache::PrivateData
+{
+public:
+    PrivateData()
+    {
+        numHits = 0;
+        numMisses = 0;
+        numBytes = 0;
+    }
+
+    Alembic::Util::uint64_t blockSize;
+    Alembic::Util::uint64_t maxBytes;
+    std::size_t readAhead;
+
+    // most recently used at the front
+    BlockList blocks;
+    std::map< BlockKey, BlockList::iterator > index;
+
+    Alembic::Util::uint64_t numHits;
+    Alembic::Util::uint64_t numMisses;
+    Alembic::Util::uint64_t numBytes;
+
+    mutable Alembic::Util::mutex lock;
+};
+
+BlockCache::BlockCache(Alembic::Util::uint64_t iBlockSize,
+                       Alembic::Util::uint64_t iMaxBytes,
+                       std::size_t iReadAheadBlocks) :
+    mData(new BlockCache::PrivateData())
+{
+    mData->blockSize = iBlockSize > 0 ? iBlockSize : 1;
+    mData->maxBytes = iMaxBytes;
+    mData->readAhead = iReadAheadBlocks;
+}
+
+BlockCache::~BlockCache()
+{
+}
+
+Alembic::Util::uint64_t BlockCache::getBlockSize() const
+{
+    return mData->blockSize;
+}
+
+std::size_t BlockCache::getReadAheadBlocks() const
+{
+    return mData->readAhead;
+}
+
+Alembic::Util::uint64_t BlockCache::getMaxBytes() const
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->maxBytes;
+}
+
+void BlockCache::setMaxBytes(Alembic::Util::uint64_t iMaxBytes)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    mData->maxBytes = iMaxBytes;
+    evict();
+}
+
+bool BlockCache::get(const std::string & iKey, Alembic::Util::uint64_t iBlock,
+                     Alembic::Util::uint64_t iOffset,
+                     Alembic::Util::uint64_t iSize, void * oBuf)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    std::map< BlockKey, BlockList::iterator >::iterator it =
+        mData->index.find(BlockKey(iKey, iBlock));
+
+    if (it == mData->index.end() ||
+        iOffset + iSize > it->second->data.size())
+    {
+        mData->numMisses ++;
+        return false;
+    }
+
+    mData->numHits ++;
+    mData->blocks.splice(mData->blocks.begin(), mData->blocks, it->second);
+    if (iSize > 0)
+    {
+        memcpy(oBuf, &(it->second->data[iOffset]), iSize);
+    }
+    return true;
+}
+
+void BlockCache::put(const std::string & iKey, Alembic::Util::uint64_t iBlock,
+                     const char * iData, Alembic::Util::uint64_t iSize)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    BlockKey key(iKey, iBlock);
+    std::map< BlockKey, BlockList::iterator >::iterator it =
+        mData->index.find(key);
+
+    // another thread got here first
+    if (it != mData->index.end())
+    {
+        mData->blocks.splice(mData->blocks.begin(), mData->blocks,
+                             it->second);
+        return;
+    }
+
+    mData->blocks.push_front(CachedBlock());
+    mData->blocks.front().key = key;
+    mData->blocks.front().data.assign(iData, iData + iSize);
+    mData->index[key] = mData->blocks.begin();
+    mData->numBytes += iSize;
+    evict();
+}
+
+bool BlockCache::contains(const std::string & iKey,
+                          Alembic::Util::uint64_t iBlock)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->index.count(BlockKey(iKey, iBlock)) > 0;
+}
+
+void BlockCache::clear()
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    mData->blocks.clear();
+    mData->index.clear();
+    mData->numHits = 0;
+    mData->numMisses = 0;
+    mData->numBytes = 0;
+}
+
+void BlockCache::evict()
+{
+    while (mData->numBytes > mData->maxBytes && !mData->blocks.empty())
+    {
+        CachedBlock & block = mData->blocks.back();
+        mData->numBytes -= block.data.size();
+        mData->index.erase(block.key);
+        mData->blocks.pop_back();
+    }
+}
+
+Alembic::Util::uint64_t BlockCache::getNumHits() const
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->numHits;
+}
+
+Alembic::Util::uint64_t BlockCache::getNumMisses() const
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->numMisses;
+}
+
+Alembic::Util::uint64_t BlockCache::getNumBytes() const
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->numBytes;
+}
+
+std::size_t BlockCache::getNumBlocks() const
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    return mData->blocks.size();
+}
+
+BlockCachePtr BlockCache::getShared()
+{
+    Alembic::Util::scoped_lock l(g_sharedLock);
+    if (!g_sharedCache)
+    {
+        g_sharedCache.reset(new BlockCache());
+    }
+    return g_sharedCache;
+}
+
+void BlockCache::setShared(BlockCachePtr iCache)
+{
+    Alembic::Util::scoped_lock l(g_sharedLock);
+    g_sharedCache = iCache;
+}
+
+//-*****************************************************************************
+class CachedStreamReader::PrivateData
+{
+public:
+    IStreamReaderPtr source;
+    BlockCachePtr cache;
+    std::string key;
+    Alembic::Util::uint64_t size;
+
+    // the last block each thread read, to spot sequential access
+    std::vector< Alembic::Util::uint64_t > lastBlocks;
+    Alembic::Util::mutex lock;
+};
+
+CachedStreamReader::CachedStreamReader(IStreamReaderPtr iSource,
+                                       const std::string & iKey,
+                                       BlockCachePtr iCache) :
+    mData(new CachedStreamReader::PrivateData())
+{
+    mData->source = iSource;
+    mData->cache = iCache;
+    mData->size = iSource ? iSource->getSize() : 0;
+
+    std::stringstream strm;
+    strm << iKey << ":" << mData->size;
+    if (iSource)
+    {
+        strm << ":" << iSource->getGeneration();
+    }
+    mData->key = strm.str();
+}
+
+CachedStreamReader::~CachedStreamReader()
+{
+}
+
+BlockCachePtr CachedStreamReader::getCache() const
+{
+    return mData->cache;
+}
+
+Alembic::Util::uint64_t CachedStreamReader::getSize()
+{
+    return mData->size;
+}
+
+bool CachedStreamReader::read(std::size_t iThreadId,
+                              Alembic::Util::uint64_t iPos,
+                              Alembic::Util::uint64_t iSize, void * oBuf)
+{
+    if (!mData->source || iPos + iSize > mData->size)
+    {
+        return false;
+    }
+
+    if (iSize == 0)
+    {
+        return true;
+    }
+
+    if (!mData->cache)
+    {
+        return mData->source->read(iThreadId, iPos, iSize, oBuf);
+    }
+
+    Alembic::Util::uint64_t blockSize = mData->cache->getBlockSize();
+    Alembic::Util::uint64_t firstBlock = iPos / blockSize;
+    Alembic::Util::uint64_t lastBlock = (iPos + iSize - 1) / blockSize;
+    Alembic::Util::uint64_t numBlocks =
+        (mData->size + blockSize - 1) / blockSize;
+
+    bool sequential = false;
+    {
+        Alembic::Util::scoped_lock l(mData->lock);
+        if (iThreadId >= mData->lastBlocks.size())
+        {
+            mData->lastBlocks.resize(iThreadId + 1, NO_BLOCK);
+        }
+
+        Alembic::Util::uint64_t prevBlock = mData->lastBlocks[iThreadId];
+        sequential = (prevBlock != NO_BLOCK && firstBlock >= prevBlock &&
+                      firstBlock <= prevBlock + 1);
+        mData->lastBlocks[iThreadId] = lastBlock;
+    }
+
+    char * out = (char *) oBuf;
+    Alembic::Util::uint64_t endPos = iPos + iSize;
+    std::vector<char> fetched;
+
+    for (Alembic::Util::uint64_t b = firstBlock; b <= lastBlock; ++b)
+    {
+        Alembic::Util::uint64_t blockPos = b * blockSize;
+        Alembic::Util::uint64_t start = std::max(iPos, blockPos);
+        Alembic::Util::uint64_t end = std::min(endPos, blockPos + blockSize);
+
+        if (mData->cache->get(mData->key, b, start - blockPos, end - start,
+                              out + (start - iPos)))
+        {
+            continue;
+        }
+
+        // fetch this block and the missing ones after it in one read
+        Alembic::Util::uint64_t runEnd = b + 1;
+        while (runEnd <= lastBlock && runEnd - b < MAX_FETCH_BLOCKS &&
+               !mData->cache->contains(mData->key, runEnd))
+        {
+            ++runEnd;
+        }
+
+        if (sequential && runEnd > lastBlock)
+        {
+            runEnd = std::min(runEnd + mData->cache->getReadAheadBlocks(),
+                              numBlocks);
+        }
+
+        Alembic::Util::uint64_t fetchSize =
+            std::min(runEnd * blockSize, mData->size) - blockPos;
+        fetched.resize(fetchSize);
+        if (!mData->source->read(iThreadId, blockPos, fetchSize,
+                                 &fetched.front()))
+        {
+            return false;
+        }
+
+        for (Alembic::Util::uint64_t f = b; f < runEnd; ++f)
+        {
+            Alembic::Util::uint64_t offset = (f - b) * blockSize;
+            Alembic::Util::uint64_t size =
+                std::min(blockSize, fetchSize - offset);
+            mData->cache->put(mData->key, f, &fetched[offset], size);
+
+            if (f <= lastBlock)
+            {
+                start = std::max(iPos, f * blockSize);
+                end = std::min(endPos, f * blockSize + size);
+                memcpy(out + (start - iPos),
+                       &fetched[start - blockPos], end - start);
+            }
+        }
+
+        b = std::min(runEnd, lastBlock + 1) - 1;
+    }
+
+    return true;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Ogawa
+} // End namespace Alembic
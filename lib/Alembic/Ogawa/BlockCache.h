@@ -0,0 +1,140 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Industrial Light & Magic nor the names of
+// its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_Ogawa_BlockCache_h_
+#define _Alembic_Ogawa_BlockCache_h_
+
+#include <Alembic/Ogawa/Foundation.h>
+#include <Alembic/Ogawa/IStreamReader.h>
+
+namespace Alembic {
+namespace Ogawa {
+namespace ALEMBIC_VERSION_NS {
+
+// A least recently used cache of fixed size, block aligned pieces of Ogawa
+// data, keyed by the source they came from.  Archives which read the same
+// source through a CachedStreamReader share blocks, so reopening a file or
+// revisiting its hierarchy doesn't go back to slow storage.
+class BlockCache
+{
+public:
+    // iBlockSize is the granularity of reads from the source, iMaxBytes the
+    // budget for all of the cached blocks, and sequential reads fetch
+    // iReadAheadBlocks more blocks than they need.
+    BlockCache(Alembic::Util::uint64_t iBlockSize = 64 * 1024,
+               Alembic::Util::uint64_t iMaxBytes = 64 * 1024 * 1024,
+               std::size_t iReadAheadBlocks = 4);
+    ~BlockCache();
+
+    Alembic::Util::uint64_t getBlockSize() const;
+    std::size_t getReadAheadBlocks() const;
+
+    // lowering the budget evicts blocks right away
+    Alembic::Util::uint64_t getMaxBytes() const;
+    void setMaxBytes(Alembic::Util::uint64_t iMaxBytes);
+
+    // copies the block if it is cached and marks it as recently used
+    bool get(const std::string & iKey, Alembic::Util::uint64_t iBlock,
+             Alembic::Util::uint64_t iOffset, Alembic::Util::uint64_t iSize,
+             void * oBuf);
+
+    // iData is at most one block, only the last block of a source is shorter
+    void put(const std::string & iKey, Alembic::Util::uint64_t iBlock,
+             const char * iData, Alembic::Util::uint64_t iSize);
+
+    bool contains(const std::string & iKey, Alembic::Util::uint64_t iBlock);
+
+    // drops every block, and resets the counters
+    void clear();
+
+    Alembic::Util::uint64_t getNumHits() const;
+    Alembic::Util::uint64_t getNumMisses() const;
+    Alembic::Util::uint64_t getNumBytes() const;
+    std::size_t getNumBlocks() const;
+
+    // the cache shared by everything in the process which doesn't bring its
+    // own, it is made with the default settings when first asked for
+    static Alembic::Util::shared_ptr< BlockCache > getShared();
+    static void setShared(Alembic::Util::shared_ptr< BlockCache > iCache);
+
+private:
+    // noncopyable
+    BlockCache(const BlockCache &);
+    const BlockCache & operator=(const BlockCache &);
+
+    void evict();
+
+    class PrivateData;
+    Alembic::Util::auto_ptr< PrivateData > mData;
+};
+
+typedef Alembic::Util::shared_ptr< BlockCache > BlockCachePtr;
+
+// Reads through a BlockCache.  iKey names the data in the cache, readers of
+// the same file should use the same key, like its absolute path.  The size
+// and generation of the source are added to it so a rewritten file isn't
+// mistaken for the old one.  Large reads are fetched a few blocks at a time.
+class CachedStreamReader : public IStreamReader
+{
+public:
+    CachedStreamReader(IStreamReaderPtr iSource, const std::string & iKey,
+                       BlockCachePtr iCache = BlockCache::getShared());
+    virtual ~CachedStreamReader();
+
+    BlockCachePtr getCache() const;
+
+    virtual Alembic::Util::uint64_t getSize();
+
+    virtual bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+                      Alembic::Util::uint64_t iSize, void * oBuf);
+
+private:
+    // noncopyable
+    CachedStreamReader(const CachedStreamReader &);
+    const CachedStreamReader & operator=(const CachedStreamReader &);
+
+    class PrivateData;
+    Alembic::Util::auto_ptr< PrivateData > mData;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace Ogawa
+
+} // End namespace Alembic
+
+#endif
@@ -51,6 +51,12 @@ IArchive::IArchive(const std::vector< std::istream * > & iStreams) :
     init();
 }
 
+IArchive::IArchive(IStreamReaderPtr iReader) :
+    mStreams(new IStreams(iReader))
+{
+    init();
+}
+
 void IArchive::init()
 {
     if (mStreams->isValid())
@@ -51,6 +51,7 @@ class IArchive
 public:
     IArchive(const std::string & iFileName, std::size_t iNumStreams=1);
     IArchive(const std::vector< std::istream * > & iStreams);
+    IArchive(IStreamReaderPtr iReader);
     ~IArchive();
 
     bool isValid() const;
@@ -0,0 +1,188 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Industrial Light & Magic nor the names of
+// its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+
+#include <Alembic/Ogawa/IStreamReader.h>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined _WIN32 || defined _WIN64
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Alembic {
+namespace Ogawa {
+namespace ALEMBIC_VERSION_NS {
+
+std::string IStreamReader::getGeneration()
+{
+    return std::string();
+}
+
+#if defined _WIN32 || defined _WIN64
+
+// no positioned reads here, so fall back to one locked stream
+class FileStreamReader::PrivateData
+{
+public:
+    PrivateData(const std::string & iFileName) : size(0)
+    {
+        stream.open(iFileName.c_str(), std::ios::binary);
+        if (stream.is_open())
+        {
+            stream.seekg(0, std::ios_base::end);
+            size = stream.tellg();
+
+            struct _stat64 st;
+            if (_stat64(iFileName.c_str(), &st) == 0)
+            {
+                std::stringstream strm;
+                strm << st.st_dev << ":" << st.st_ino << ":" << st.st_mtime;
+                generation = strm.str();
+            }
+        }
+    }
+
+    std::ifstream stream;
+    Alembic::Util::uint64_t size;
+    std::string generation;
+    Alembic::Util::mutex lock;
+};
+
+bool FileStreamReader::isValid() const
+{
+    return mData->stream.is_open();
+}
+
+bool FileStreamReader::read(std::size_t iThreadId,
+                            Alembic::Util::uint64_t iPos,
+                            Alembic::Util::uint64_t iSize, void * oBuf)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    mData->stream.clear();
+    mData->stream.seekg(iPos);
+    mData->stream.read((char *)oBuf, iSize);
+    return !mData->stream.fail();
+}
+
+#else
+
+class FileStreamReader::PrivateData
+{
+public:
+    PrivateData(const std::string & iFileName) : size(0)
+    {
+        fd = open(iFileName.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0)
+        {
+            size = st.st_size;
+
+            std::stringstream strm;
+            strm << st.st_dev << ":" << st.st_ino << ":" << st.st_mtime;
+#if defined __APPLE__
+            strm << "." << st.st_mtimespec.tv_nsec;
+#elif defined __linux__
+            strm << "." << st.st_mtim.tv_nsec;
+#endif
+            generation = strm.str();
+        }
+    }
+
+    ~PrivateData()
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+
+    int fd;
+    Alembic::Util::uint64_t size;
+    std::string generation;
+};
+
+bool FileStreamReader::isValid() const
+{
+    return mData->fd >= 0;
+}
+
+bool FileStreamReader::read(std::size_t iThreadId,
+                            Alembic::Util::uint64_t iPos,
+                            Alembic::Util::uint64_t iSize, void * oBuf)
+{
+    char * buf = (char *)oBuf;
+    while (iSize > 0)
+    {
+        ssize_t numRead = pread(mData->fd, buf, iSize, iPos);
+        if (numRead <= 0)
+        {
+            return false;
+        }
+        buf += numRead;
+        iPos += numRead;
+        iSize -= numRead;
+    }
+    return true;
+}
+
+#endif
+
+FileStreamReader::FileStreamReader(const std::string & iFileName) :
+    mData(new PrivateData(iFileName))
+{
+}
+
+FileStreamReader::~FileStreamReader()
+{
+}
+
+Alembic::Util::uint64_t FileStreamReader::getSize()
+{
+    return mData->size;
+}
+
+std::string FileStreamReader::getGeneration()
+{
+    return mData->generation;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Ogawa
+} // End namespace Alembic
@@ -0,0 +1,107 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Industrial Light & Magic nor the names of
+// its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+
+#ifndef _Alembic_Ogawa_IStreamReader_h_
+#define _Alembic_Ogawa_IStreamReader_h_
+
+#include <Alembic/Ogawa/Foundation.h>
+
+namespace Alembic {
+namespace Ogawa {
+namespace ALEMBIC_VERSION_NS {
+
+// A random access source of Ogawa data, for storage which doesn't look like
+// a file (caches, object stores, encrypted containers).  Unlike istreams
+// there is no seek position, so IStreams calls it from many threads at once
+// without any locking; implementations have to be thread safe.
+class IStreamReader
+{
+public:
+    virtual ~IStreamReader() {}
+
+    // the total number of bytes which can be read
+    virtual Alembic::Util::uint64_t getSize() = 0;
+
+    // reads iSize bytes at iPos into oBuf, returns false if they couldn't
+    // all be read.  iThreadId is the reading thread's stream index which
+    // can be used to pick a per thread handle or connection.
+    virtual bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+                      Alembic::Util::uint64_t iSize, void * oBuf) = 0;
+
+    // identifies this revision of the data, like a file's inode and
+    // modification time, so caches can tell a rewritten source from the old
+    // one.  The default is empty.
+    virtual std::string getGeneration();
+};
+
+typedef Alembic::Util::shared_ptr< IStreamReader > IStreamReaderPtr;
+
+// Reads a local file with positioned reads, so no locking is needed.
+class FileStreamReader : public IStreamReader
+{
+public:
+    FileStreamReader(const std::string & iFileName);
+    virtual ~FileStreamReader();
+
+    // whether the file could be opened
+    bool isValid() const;
+
+    virtual Alembic::Util::uint64_t getSize();
+
+    virtual bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+                      Alembic::Util::uint64_t iSize, void * oBuf);
+
+    // the device, inode and modification time of the file
+    virtual std::string getGeneration();
+
+private:
+    // noncopyable
+    FileStreamReader(const FileStreamReader &);
+    const FileStreamReader & operator=(const FileStreamReader &);
+
+    class PrivateData;
+    Alembic::Util::auto_ptr< PrivateData > mData;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace Ogawa
+
+} // End namespace Alembic
+
+#endif
@@ -35,12 +35,19 @@
 
 #include <Alembic/Ogawa/IStreams.h>
 #include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <string.h>
 
 namespace Alembic {
 namespace Ogawa {
 namespace ALEMBIC_VERSION_NS {
 
+// The region from the top group to the end of the file is read into memory
+// when it is at most this big.  Writers which defer their hierarchy put all
+// of it there, otherwise it is just the top group.
+static const Alembic::Util::uint64_t MAX_TAIL_SIZE = 64 * 1024 * 1024;
+
 class IStreams::PrivateData
 {
 public:
@@ -50,6 +57,7 @@ public:
         valid = false;
         frozen = false;
         version = 0;
+        tailPos = 0;
     }
 
     ~PrivateData()
@@ -77,11 +85,20 @@ public:
 
     std::vector<std::istream *> streams;
     std::vector<Alembic::Util::uint64_t> offsets;
+
+    // used instead of the streams, and without the locks, when set
+    IStreamReaderPtr reader;
+
     Alembic::Util::mutex * locks;
     std::string fileName;
     bool valid;
     bool frozen;
     Alembic::Util::uint16_t version;
+
+    // read only once init is done, so it doesn't need the locks
+    char header[16];
+    std::vector<char> tail;
+    Alembic::Util::uint64_t tailPos;
 };
 
 IStreams::IStreams(const std::string & iFileName, std::size_t iNumStreams) :
@@ -137,6 +154,18 @@ IStreams::IStreams(const std::vector< std::istream * > & iStreams) :
     mData->locks = new Alembic::Util::mutex[mData->streams.size()];
 }
 
+IStreams::IStreams(IStreamReaderPtr iReader) :
+    mData(new IStreams::PrivateData())
+{
+    mData->reader = iReader;
+    init();
+    if (!mData->valid || mData->version != 1)
+    {
+        mData->valid = false;
+        mData->reader.reset();
+    }
+}
+
 void IStreams::init()
 {
     // simple temporary endian check
@@ -153,18 +182,30 @@ void IStreams::init()
             "Ogawa currently only supports little-endian reading.");
     }
 
-    if (mData->streams.empty())
+    if (mData->streams.empty() && !mData->reader)
     {
         return;
     }
 
     Alembic::Util::uint64_t firstGroupPos = 0;
 
-    for (std::size_t i = 0; i < mData->streams.size(); ++i)
+    std::size_t numSources = mData->reader ? 1 : mData->streams.size();
+    for (std::size_t i = 0; i < numSources; ++i)
     {
         char header[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-        mData->offsets.push_back(mData->streams[i]->tellg());
-        mData->streams[i]->read(header, 16);
+        if (mData->reader)
+        {
+            if (mData->reader->getSize() < 16 ||
+                !mData->reader->read(0, 0, 16, header))
+            {
+                return;
+            }
+        }
+        else
+        {
+            mData->offsets.push_back(mData->streams[i]->tellg());
+            mData->streams[i]->read(header, 16);
+        }
         std::string magicStr(header, 5);
         if (magicStr != "Ogawa")
         {
@@ -181,6 +222,7 @@ void IStreams::init()
         if (i == 0)
         {
             firstGroupPos = groupPos;
+            memcpy(mData->header, header, 16);
             mData->frozen = frozen;
             mData->version = version;
         }
@@ -195,6 +237,53 @@ void IStreams::init()
         }
     }
     mData->valid = true;
+
+    if (mData->frozen)
+    {
+        readTail(firstGroupPos);
+    }
+}
+
+void IStreams::readTail(Alembic::Util::uint64_t iPos)
+{
+    if (mData->reader)
+    {
+        Alembic::Util::uint64_t endPos = mData->reader->getSize();
+        if (iPos >= 16 && iPos < endPos && endPos - iPos <= MAX_TAIL_SIZE)
+        {
+            mData->tail.resize(endPos - iPos);
+            mData->tailPos = iPos;
+            if (!mData->reader->read(0, iPos, mData->tail.size(),
+                                     &mData->tail.front()))
+            {
+                mData->tail.clear();
+            }
+        }
+        return;
+    }
+
+    std::istream * stream = mData->streams[0];
+    Alembic::Util::uint64_t offset = mData->offsets[0];
+
+    stream->seekg(0, std::ios_base::end);
+    Alembic::Util::uint64_t endPos = stream->tellg();
+
+    if (!stream->fail() && endPos != INVALID_DATA &&
+        iPos >= 16 && offset + iPos < endPos &&
+        endPos - offset - iPos <= MAX_TAIL_SIZE)
+    {
+        mData->tail.resize(endPos - offset - iPos);
+        stream->seekg(offset + iPos);
+        stream->read(&mData->tail.front(), mData->tail.size());
+        mData->tailPos = iPos;
+    }
+
+    // on any failure fall back to reading from the stream
+    if (stream->fail())
+    {
+        mData->tail.clear();
+    }
+    stream->clear();
 }
 
 IStreams::~IStreams()
@@ -224,6 +313,32 @@ void IStreams::read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
         return;
     }
 
+    // so was the header
+    if (iPos + iSize <= 16)
+    {
+        memcpy(oBuf, &mData->header[iPos], iSize);
+        return;
+    }
+
+    // the top of the hierarchy was read up front
+    if (!mData->tail.empty() && iPos >= mData->tailPos &&
+        iPos + iSize <= mData->tailPos + mData->tail.size())
+    {
+        memcpy(oBuf, &mData->tail[iPos - mData->tailPos], iSize);
+        return;
+    }
+
+    if (mData->reader)
+    {
+        if (!mData->reader->read(iThreadId, iPos, iSize, oBuf))
+        {
+            std::stringstream msg;
+            msg << "Ogawa failed to read " << iSize << " bytes at " << iPos;
+            throw std::runtime_error(msg.str());
+        }
+        return;
+    }
+
     std::size_t threadId = 0;
     if (iThreadId < mData->streams.size())
     {
@@ -37,6 +37,7 @@
 #define _Alembic_Ogawa_IStreams_h_
 
 #include <Alembic/Ogawa/Foundation.h>
+#include <Alembic/Ogawa/IStreamReader.h>
 
 #include <istream>
 
@@ -49,6 +50,9 @@ class IStreams
 public:
     IStreams(const std::string & iFileName, std::size_t iNumStreams=1);
     IStreams(const std::vector< std::istream * > & iStreams);
+
+    // read through iReader, which has to be thread safe, instead of streams
+    IStreams(IStreamReaderPtr iReader);
     ~IStreams();
 
     bool isValid();
@@ -56,6 +60,7 @@ public:
     Alembic::Util::uint16_t getVersion();
 
     // locks on the threadId, seeks to iPos, and reads iSize bytes into oBuf
+    // unless they were already read with the top of the hierarchy
     void read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
               Alembic::Util::uint64_t iSize, void * oBuf);
 
@@ -66,6 +71,8 @@ private:
 
     void init();
 
+    void readTail(Alembic::Util::uint64_t iPos);
+
     class PrivateData;
     Alembic::Util::auto_ptr< PrivateData > mData;
 };
@@ -41,14 +41,15 @@ namespace Alembic {
 namespace Ogawa {
 namespace ALEMBIC_VERSION_NS {
 
-OArchive::OArchive(const std::string & iFileName) :
-    mStream(new OStream(iFileName))
+OArchive::OArchive(const std::string & iFileName, bool iDeferHierarchy) :
+    mStream(new OStream(iFileName, iDeferHierarchy))
 {
     mGroup.reset(new OGroup(mStream));
 }
 
-OArchive::OArchive(std::ostream * iStream) :
-    mStream(new OStream(iStream)), mGroup(new OGroup(mStream))
+OArchive::OArchive(std::ostream * iStream, bool iDeferHierarchy) :
+    mStream(new OStream(iStream, iDeferHierarchy)),
+    mGroup(new OGroup(mStream))
 {
 }
 
@@ -47,8 +47,10 @@ namespace ALEMBIC_VERSION_NS {
 class OArchive
 {
 public:
-    OArchive(const std::string & iFileName);
-    OArchive(std::ostream * iStream);
+    // iDeferHierarchy writes all the groups and hierarchy data in one
+    // contiguous region at the end of the archive, see OStream
+    OArchive(const std::string & iFileName, bool iDeferHierarchy=false);
+    OArchive(std::ostream * iStream, bool iDeferHierarchy=false);
     ~OArchive();
 
     OGroupPtr getGroup();
@@ -187,6 +187,27 @@ ODataPtr OGroup::addData(Alembic::Util::uint64_t iNumData,
     return child;
 }
 
+void OGroup::addHierarchyData(Alembic::Util::uint64_t iSize,
+                              const void * iData)
+{
+    if (!mData->stream->isDeferringHierarchy())
+    {
+        addData(iSize, iData);
+    }
+    else if (!isFrozen())
+    {
+        if (iSize == 0)
+        {
+            mData->childVec.push_back(EMPTY_DATA);
+        }
+        else
+        {
+            mData->childVec.push_back(
+                mData->stream->deferData(iSize, iData) | EMPTY_DATA);
+        }
+    }
+}
+
 void OGroup::addData(ODataPtr iData)
 {
     if (!isFrozen())
@@ -243,6 +264,10 @@ void OGroup::freeze()
     {
         mData->pos = 0;
     }
+    else if (mData->stream->isDeferringHierarchy())
+    {
+        mData->pos = mData->stream->deferGroup(mData->childVec);
+    }
     else
     {
         mData->pos = mData->stream->getAndSeekEndPos();
@@ -258,10 +283,23 @@ void OGroup::freeze()
         // special group owned by the archive
         if (!it->first && it->second == 0)
         {
-            mData->stream->seek(8);
-            mData->stream->write(&mData->pos, 8);
+            if (mData->stream->isDeferringHierarchy())
+            {
+                mData->stream->setDeferredTopGroup(mData->pos);
+            }
+            else
+            {
+                mData->stream->seek(8);
+                mData->stream->write(&mData->pos, 8);
+            }
             continue;
         }
+        else if (it->first->isFrozen() &&
+                 mData->stream->isDeferringHierarchy())
+        {
+            mData->stream->updateDeferredGroup(it->first->mData->pos,
+                                               it->second, mData->pos);
+        }
         else if (it->first->isFrozen())
         {
             mData->stream->seek(it->first->mData->pos + (it->second + 1) * 8);
@@ -316,7 +354,11 @@ void OGroup::replaceData(Alembic::Util::uint64_t iIndex, ODataPtr iData)
     }
 
     Alembic::Util::uint64_t pos = iData->getPos() | 0x8000000000000000ULL;
-    if (isFrozen())
+    if (isFrozen() && mData->stream->isDeferringHierarchy())
+    {
+        mData->stream->updateDeferredGroup(mData->pos, iIndex, pos);
+    }
+    else if (isFrozen())
     {
         mData->stream->seek(mData->pos + (iIndex + 1) * 8);
         mData->stream->write(&pos, 8);
@@ -77,6 +77,11 @@ public:
                         const Alembic::Util::uint64_t * iSizes,
                         const void ** iDatas);
 
+    // add hierarchy data (headers and the like) as a child to this group,
+    // when the stream is deferring its hierarchy it is written with the
+    // groups at the end of the stream, otherwise this is the same as addData
+    void addHierarchyData(Alembic::Util::uint64_t iSize, const void * iData);
+
     // reference existing data
     void addData(ODataPtr iData);
 
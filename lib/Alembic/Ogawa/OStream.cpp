@@ -41,11 +41,15 @@ namespace Alembic {
 namespace Ogawa {
 namespace ALEMBIC_VERSION_NS {
 
+// marks a group or data position as an index into the deferred hierarchy
+static const Alembic::Util::uint64_t DEFERRED_POS = 0x4000000000000000ULL;
+
 class OStream::PrivateData
 {
 public:
-    PrivateData(const std::string & iFileName) :
-        stream(NULL), fileName(iFileName), startPos(0)
+    PrivateData(const std::string & iFileName, bool iDeferHierarchy) :
+        stream(NULL), fileName(iFileName), startPos(0),
+        deferHierarchy(iDeferHierarchy), topGroup(EMPTY_GROUP)
     {
         std::ofstream * filestream = new std::ofstream(fileName.c_str(),
             std::ios_base::trunc | std::ios_base::binary);
@@ -62,7 +66,9 @@ public:
         }
     }
 
-    PrivateData(std::ostream * iStream) : stream(iStream), startPos(0)
+    PrivateData(std::ostream * iStream, bool iDeferHierarchy) :
+        stream(iStream), startPos(0), deferHierarchy(iDeferHierarchy),
+        topGroup(EMPTY_GROUP)
     {
         if (stream)
         {
@@ -95,16 +101,22 @@ public:
     std::string fileName;
     Alembic::Util::uint64_t startPos;
     Alembic::Util::mutex lock;
+
+    bool deferHierarchy;
+    std::vector< std::vector< Alembic::Util::uint64_t > > groups;
+    std::vector< std::vector< char > > datas;
+    Alembic::Util::uint64_t topGroup;
 };
 
-OStream::OStream(const std::string & iFileName) :
-    mData(new PrivateData(iFileName))
+OStream::OStream(const std::string & iFileName, bool iDeferHierarchy) :
+    mData(new PrivateData(iFileName, iDeferHierarchy))
 {
     init();
 }
 
 // we'll be writing from this already open stream which we don't own
-OStream::OStream(std::ostream * iStream) : mData(new PrivateData(iStream))
+OStream::OStream(std::ostream * iStream, bool iDeferHierarchy) :
+    mData(new PrivateData(iStream, iDeferHierarchy))
 {
     init();
 }
@@ -114,6 +126,8 @@ OStream::~OStream()
     // write our "frozen" byte (totally done writing)
     if (isValid())
     {
+        writeDeferredHierarchy();
+
         char frozen = 0xff;
         mData->stream->seekp(mData->startPos + 5).write(&frozen, 1).flush();
     }
@@ -188,6 +202,140 @@ void OStream::write(const void * iBuf, Alembic::Util::uint64_t iSize)
     }
 }
 
+bool OStream::isDeferringHierarchy()
+{
+    return mData->deferHierarchy;
+}
+
+Alembic::Util::uint64_t OStream::deferGroup(
+    const std::vector< Alembic::Util::uint64_t > & iChildren)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    mData->groups.push_back(iChildren);
+    return (mData->groups.size() - 1) | DEFERRED_POS;
+}
+
+void OStream::updateDeferredGroup(Alembic::Util::uint64_t iGroupPos,
+                                  Alembic::Util::uint64_t iIndex,
+                                  Alembic::Util::uint64_t iChild)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    Alembic::Util::uint64_t index = iGroupPos & ~DEFERRED_POS;
+    if ((iGroupPos & DEFERRED_POS) && index < mData->groups.size() &&
+        iIndex < mData->groups[index].size())
+    {
+        mData->groups[index][iIndex] = iChild;
+    }
+}
+
+Alembic::Util::uint64_t OStream::deferData(Alembic::Util::uint64_t iSize,
+                                           const void * iData)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    const char * data = (const char *)iData;
+    mData->datas.push_back(std::vector< char >(data, data + iSize));
+    return (mData->datas.size() - 1) | DEFERRED_POS;
+}
+
+void OStream::setDeferredTopGroup(Alembic::Util::uint64_t iGroupPos)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    mData->topGroup = iGroupPos;
+}
+
+void OStream::writeDeferredHierarchy()
+{
+    if (!mData->deferHierarchy)
+    {
+        return;
+    }
+
+    // the top group goes first, then the rest of the groups in the reverse
+    // order they were frozen so parents tend to come before their children,
+    // and then the data
+    bool hasTop = (mData->topGroup & DEFERRED_POS) != 0;
+    Alembic::Util::uint64_t topIndex = mData->topGroup & ~DEFERRED_POS;
+
+    std::vector< Alembic::Util::uint64_t > order;
+    if (hasTop)
+    {
+        order.push_back(topIndex);
+    }
+
+    for (std::size_t i = mData->groups.size(); i > 0; --i)
+    {
+        if (!hasTop || i - 1 != topIndex)
+        {
+            order.push_back(i - 1);
+        }
+    }
+
+    Alembic::Util::uint64_t pos = getAndSeekEndPos();
+
+    std::vector< Alembic::Util::uint64_t > groupPos(mData->groups.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        groupPos[order[i]] = pos;
+        pos += 8 * (mData->groups[order[i]].size() + 1);
+    }
+
+    std::vector< Alembic::Util::uint64_t > dataPos(mData->datas.size());
+    for (std::size_t i = 0; i < mData->datas.size(); ++i)
+    {
+        dataPos[i] = pos;
+        pos += 8 + mData->datas[i].size();
+    }
+
+    std::vector< char > buf;
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        std::vector< Alembic::Util::uint64_t > & children =
+            mData->groups[order[i]];
+
+        Alembic::Util::uint64_t size = children.size();
+        buf.insert(buf.end(), (char *)&size, (char *)&size + 8);
+
+        for (std::size_t j = 0; j < children.size(); ++j)
+        {
+            Alembic::Util::uint64_t child = children[j];
+            Alembic::Util::uint64_t index = child & ~(EMPTY_DATA |
+                                                      DEFERRED_POS);
+            if ((child & DEFERRED_POS) && (child & EMPTY_DATA))
+            {
+                child = dataPos[index] | EMPTY_DATA;
+            }
+            else if (child & DEFERRED_POS)
+            {
+                child = groupPos[index];
+            }
+            buf.insert(buf.end(), (char *)&child, (char *)&child + 8);
+        }
+    }
+
+    for (std::size_t i = 0; i < mData->datas.size(); ++i)
+    {
+        Alembic::Util::uint64_t size = mData->datas[i].size();
+        buf.insert(buf.end(), (char *)&size, (char *)&size + 8);
+        buf.insert(buf.end(), mData->datas[i].begin(), mData->datas[i].end());
+    }
+
+    if (!buf.empty())
+    {
+        write(&buf.front(), buf.size());
+    }
+
+    Alembic::Util::uint64_t topGroup = mData->topGroup;
+    if (hasTop)
+    {
+        topGroup = groupPos[topIndex];
+    }
+    seek(8);
+    write(&topGroup, 8);
+
+    mData->groups.clear();
+    mData->datas.clear();
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Ogawa
 } // End namespace Alembic
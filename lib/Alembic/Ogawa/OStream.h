@@ -39,6 +39,7 @@
 #include <Alembic/Ogawa/Foundation.h>
 
 #include <ostream>
+#include <vector>
 
 namespace Alembic {
 namespace Ogawa {
@@ -47,8 +48,8 @@ namespace ALEMBIC_VERSION_NS {
 class OStream
 {
 public:
-    OStream(const std::string & iFileName);
-    OStream(std::ostream * iStream);
+    OStream(const std::string & iFileName, bool iDeferHierarchy=false);
+    OStream(std::ostream * iStream, bool iDeferHierarchy=false);
     ~OStream();
 
     bool isValid();
@@ -57,6 +58,25 @@ public:
     void write(const void * iBuf, Alembic::Util::uint64_t iSize);
     void seek(Alembic::Util::uint64_t iPos);
 
+    // When deferring the hierarchy, frozen groups and hierarchy data are
+    // held in memory and written as one contiguous region at the end of the
+    // stream, starting with the top group, so that readers can load them
+    // with one read.  The positions returned are placeholders which are
+    // resolved when that region is written.
+    bool isDeferringHierarchy();
+
+    Alembic::Util::uint64_t deferGroup(
+        const std::vector< Alembic::Util::uint64_t > & iChildren);
+
+    void updateDeferredGroup(Alembic::Util::uint64_t iGroupPos,
+                             Alembic::Util::uint64_t iIndex,
+                             Alembic::Util::uint64_t iChild);
+
+    Alembic::Util::uint64_t deferData(Alembic::Util::uint64_t iSize,
+                                      const void * iData);
+
+    void setDeferredTopGroup(Alembic::Util::uint64_t iGroupPos);
+
 private:
     // noncopyable
     OStream(const OStream &);
@@ -66,6 +86,8 @@ private:
     Alembic::Util::auto_ptr< PrivateData > mData;
 
     void init();
+
+    void writeDeferredHierarchy();
 };
 
 typedef Alembic::Util::shared_ptr< OStream > OStreamPtr;
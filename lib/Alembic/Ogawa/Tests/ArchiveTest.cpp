@@ -77,9 +77,78 @@ void stringStreamTest()
     TESTING_ASSERT(ia.getGroup()->getNumChildren() == 0);
 }
 
+void deferredHierarchyTest()
+{
+    {
+        Alembic::Ogawa::OArchive oa("deferredTest.ogawa", true);
+        TESTING_ASSERT(oa.isValid());
+        Alembic::Ogawa::OGroupPtr top = oa.getGroup();
+
+        char sample[6] = {1, 2, 3, 4, 5, 6};
+        Alembic::Ogawa::OGroupPtr a = top->addGroup();
+        Alembic::Ogawa::ODataPtr ad = a->addData(6, sample);
+        a->addHierarchyData(3, "abc");
+        a->addHierarchyData(0, NULL);
+
+        // frozen before its child group is
+        Alembic::Ogawa::OGroupPtr b = top->addGroup();
+        Alembic::Ogawa::OGroupPtr ba = b->addGroup();
+        b->addData(ad);
+        b->freeze();
+
+        ba->addHierarchyData(4, "defg");
+        ba->freeze();
+
+        char other[2] = {7, 8};
+        a->freeze();
+        a->replaceData(0, top->createData(2, other));
+
+        top->addHierarchyData(5, "hijkl");
+    }
+
+    Alembic::Ogawa::IArchive ia("deferredTest.ogawa");
+    TESTING_ASSERT(ia.isValid());
+    TESTING_ASSERT(ia.isFrozen());
+
+    Alembic::Ogawa::IGroupPtr top = ia.getGroup();
+    TESTING_ASSERT(top->getNumChildren() == 3);
+
+    // the sample data shared with b was written before any hierarchy
+    Alembic::Ogawa::IGroupPtr b = top->getGroup(1, false, 0);
+    Alembic::Util::uint64_t samplePos = b->getData(1, 0)->getPos();
+
+    Alembic::Ogawa::IGroupPtr a = top->getGroup(0, false, 0);
+    TESTING_ASSERT(a->getNumChildren() == 3);
+    TESTING_ASSERT(a->isEmptyChildData(2));
+
+    char buf[6] = {0, 0, 0, 0, 0, 0};
+    a->getData(0, 0)->read(2, buf, 0, 0);
+    TESTING_ASSERT(buf[0] == 7 && buf[1] == 8);
+
+    // hierarchy data comes after all of the sample data
+    Alembic::Ogawa::IDataPtr header = a->getData(1, 0);
+    TESTING_ASSERT(header->getSize() == 3);
+    TESTING_ASSERT(header->getPos() > samplePos);
+    header->read(3, buf, 0, 0);
+    TESTING_ASSERT(std::string(buf, 3) == "abc");
+
+    TESTING_ASSERT(b->getNumChildren() == 2);
+    b->getData(1, 0)->read(6, buf, 0, 0);
+    TESTING_ASSERT(buf[0] == 1 && buf[5] == 6);
+
+    Alembic::Ogawa::IGroupPtr ba = b->getGroup(0, true, 0);
+    TESTING_ASSERT(ba->getNumChildren() == 1);
+    ba->getData(0, 0)->read(4, buf, 0, 0);
+    TESTING_ASSERT(std::string(buf, 4) == "defg");
+
+    top->getData(2, 0)->read(5, buf, 0, 0);
+    TESTING_ASSERT(std::string(buf, 5) == "hijkl");
+}
+
 int main ( int argc, char *argv[] )
 {
     test();
     stringStreamTest();
+    deferredHierarchyTest();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,339 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+#include <Alembic/Ogawa/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include <unistd.h>
+
+//-*****************************************************************************
+// A local source with artificial latency, which counts how often it is hit.
+class SlowReader : public Alembic::Ogawa::IStreamReader
+{
+public:
+    SlowReader(const std::string & iFileName, unsigned int iLatencyUsec) :
+        mFile(iFileName), mLatency(iLatencyUsec), mNumReads(0)
+    {
+    }
+
+    Alembic::Util::uint64_t getSize()
+    {
+        return mFile.getSize();
+    }
+
+    bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+              Alembic::Util::uint64_t iSize, void * oBuf)
+    {
+        ++mNumReads;
+        usleep(mLatency);
+        return mFile.read(iThreadId, iPos, iSize, oBuf);
+    }
+
+    std::size_t getNumReads() const
+    {
+        return mNumReads;
+    }
+
+private:
+    Alembic::Ogawa::FileStreamReader mFile;
+    unsigned int mLatency;
+    std::size_t mNumReads;
+};
+
+typedef Alembic::Util::shared_ptr< SlowReader > SlowReaderPtr;
+
+static const std::size_t g_numChildren = 64;
+static const unsigned int g_latency = 1000;
+static const std::string g_fileName = "blockCacheTest.ogawa";
+
+//-*****************************************************************************
+double now()
+{
+    timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//-*****************************************************************************
+void writeArchive()
+{
+    Alembic::Ogawa::OArchive oa(g_fileName);
+    Alembic::Ogawa::OGroupPtr top = oa.getGroup();
+    for (std::size_t i = 0; i < g_numChildren; ++i)
+    {
+        std::vector< Alembic::Util::uint64_t > vals(100 + i * 10);
+        for (std::size_t j = 0; j < vals.size(); ++j)
+        {
+            vals[j] = i * 10000 + j;
+        }
+        top->addGroup()->addData(vals.size() * 8, &vals.front());
+    }
+}
+
+//-*****************************************************************************
+void readArchive(Alembic::Ogawa::IStreamReaderPtr iReader)
+{
+    Alembic::Ogawa::IArchive ia(iReader);
+    TESTING_ASSERT(ia.isValid());
+    Alembic::Ogawa::IGroupPtr top = ia.getGroup();
+    TESTING_ASSERT(top->getNumChildren() == g_numChildren);
+
+    for (std::size_t i = 0; i < g_numChildren; ++i)
+    {
+        Alembic::Ogawa::IDataPtr data =
+            top->getGroup(i, false, 0)->getData(0, 0);
+        std::vector< Alembic::Util::uint64_t > vals(100 + i * 10);
+        TESTING_ASSERT(data->getSize() == vals.size() * 8);
+        data->read(vals.size() * 8, &vals.front(), 0, 0);
+        TESTING_ASSERT(vals.front() == i * 10000);
+        TESTING_ASSERT(vals.back() == i * 10000 + vals.size() - 1);
+    }
+}
+
+//-*****************************************************************************
+void cacheTest()
+{
+    // room for three full blocks
+    Alembic::Ogawa::BlockCache cache(16, 48, 0);
+    char block[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    char buf[16];
+
+    TESTING_ASSERT(!cache.get("a", 0, 0, 4, buf));
+    cache.put("a", 0, block, 16);
+    cache.put("a", 1, block, 16);
+    cache.put("b", 0, block, 16);
+    TESTING_ASSERT(cache.getNumBlocks() == 3);
+    TESTING_ASSERT(cache.getNumBytes() == 48);
+
+    // using the oldest block keeps it around
+    TESTING_ASSERT(cache.get("a", 0, 4, 8, buf));
+    TESTING_ASSERT(buf[0] == 4 && buf[7] == 11);
+    cache.put("a", 2, block, 16);
+    TESTING_ASSERT(cache.contains("a", 0));
+    TESTING_ASSERT(!cache.contains("a", 1));
+    TESTING_ASSERT(cache.contains("b", 0));
+
+    // a short block at the end of a source
+    cache.put("b", 1, block, 5);
+    TESTING_ASSERT(!cache.contains("b", 0));
+    TESTING_ASSERT(cache.getNumBytes() == 37);
+    TESTING_ASSERT(cache.get("b", 1, 0, 5, buf));
+    TESTING_ASSERT(!cache.get("b", 1, 2, 4, buf));
+
+    TESTING_ASSERT(cache.getNumHits() == 2);
+    TESTING_ASSERT(cache.getNumMisses() == 2);
+
+    cache.setMaxBytes(16);
+    TESTING_ASSERT(cache.getNumBlocks() == 1);
+    TESTING_ASSERT(cache.contains("b", 1));
+
+    cache.clear();
+    TESTING_ASSERT(cache.getNumBlocks() == 0);
+    TESTING_ASSERT(cache.getNumBytes() == 0);
+    TESTING_ASSERT(cache.getNumHits() == 0);
+
+    // one cache for everybody unless it is replaced
+    Alembic::Ogawa::BlockCachePtr shared =
+        Alembic::Ogawa::BlockCache::getShared();
+    TESTING_ASSERT(shared && shared == Alembic::Ogawa::BlockCache::getShared());
+    Alembic::Ogawa::BlockCachePtr other(new Alembic::Ogawa::BlockCache());
+    Alembic::Ogawa::BlockCache::setShared(other);
+    TESTING_ASSERT(Alembic::Ogawa::BlockCache::getShared() == other);
+    Alembic::Ogawa::BlockCache::setShared(shared);
+}
+
+//-*****************************************************************************
+void sharedArchiveTest()
+{
+    Alembic::Ogawa::BlockCachePtr cache(
+        new Alembic::Ogawa::BlockCache(4096, 1024 * 1024, 0));
+
+    SlowReaderPtr direct(new SlowReader(g_fileName, g_latency));
+    double start = now();
+    readArchive(direct);
+    double directTime = now() - start;
+
+    SlowReaderPtr first(new SlowReader(g_fileName, g_latency));
+    start = now();
+    readArchive(Alembic::Ogawa::IStreamReaderPtr(
+        new Alembic::Ogawa::CachedStreamReader(first, g_fileName, cache)));
+    double firstTime = now() - start;
+    TESTING_ASSERT(first->getNumReads() < direct->getNumReads());
+    TESTING_ASSERT(cache->getNumMisses() > 0);
+
+    // a second archive of the same file is served from memory
+    SlowReaderPtr second(new SlowReader(g_fileName, g_latency));
+    Alembic::Util::uint64_t misses = cache->getNumMisses();
+    start = now();
+    readArchive(Alembic::Ogawa::IStreamReaderPtr(
+        new Alembic::Ogawa::CachedStreamReader(second, g_fileName, cache)));
+    double secondTime = now() - start;
+    TESTING_ASSERT(second->getNumReads() == 0);
+    TESTING_ASSERT(cache->getNumMisses() == misses);
+
+    std::cout << "Reading " << g_numChildren << " children with "
+              << g_latency << " usec latency" << std::endl
+              << "  direct:       " << direct->getNumReads() << " reads, "
+              << directTime * 1000.0 << " ms" << std::endl
+              << "  cold cache:   " << first->getNumReads() << " reads, "
+              << firstTime * 1000.0 << " ms" << std::endl
+              << "  shared cache: " << second->getNumReads() << " reads, "
+              << secondTime * 1000.0 << " ms" << std::endl
+              << "  " << cache->getNumHits() << " hits, "
+              << cache->getNumMisses() << " misses" << std::endl;
+
+    // a different key doesn't share the blocks
+    Alembic::Ogawa::CachedStreamReader renamed(second, "otherFile", cache);
+    char header[16];
+    TESTING_ASSERT(renamed.read(0, 0, 16, header));
+    TESTING_ASSERT(second->getNumReads() == 1);
+}
+
+//-*****************************************************************************
+void readAheadTest()
+{
+    Alembic::Ogawa::FileStreamReader file(g_fileName);
+    std::vector< char > expected(file.getSize());
+    TESTING_ASSERT(file.read(0, 0, expected.size(), &expected.front()));
+
+    std::size_t numReads[2];
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        Alembic::Ogawa::BlockCachePtr cache(
+            new Alembic::Ogawa::BlockCache(1024, 1024 * 1024, i * 8));
+        SlowReaderPtr slow(new SlowReader(g_fileName, 0));
+        Alembic::Ogawa::CachedStreamReader reader(slow, g_fileName, cache);
+
+        // small reads which straddle the block boundaries
+        std::vector< char > buf(expected.size());
+        for (std::size_t pos = 0; pos < buf.size(); pos += 300)
+        {
+            std::size_t size = std::min< std::size_t >(300, buf.size() - pos);
+            TESTING_ASSERT(reader.read(0, pos, size, &buf[pos]));
+        }
+        TESTING_ASSERT(buf == expected);
+        numReads[i] = slow->getNumReads();
+
+        // a big read is served from the cached blocks too
+        TESTING_ASSERT(reader.read(1, 0, 8 * 1024, &buf.front()));
+        TESTING_ASSERT(slow->getNumReads() == numReads[i]);
+
+        TESTING_ASSERT(!reader.read(0, buf.size() - 4, 8, &buf.front()));
+    }
+
+    std::cout << "Sequential scan of " << expected.size() << " bytes: "
+              << numReads[0] << " reads, " << numReads[1]
+              << " with read ahead" << std::endl;
+    TESTING_ASSERT(numReads[1] * 4 < numReads[0]);
+}
+
+//-*****************************************************************************
+void largeReadTest()
+{
+    Alembic::Ogawa::FileStreamReader file(g_fileName);
+    std::vector< char > expected(file.getSize());
+    TESTING_ASSERT(file.read(0, 0, expected.size(), &expected.front()));
+
+    Alembic::Ogawa::BlockCachePtr cache(
+        new Alembic::Ogawa::BlockCache(1024, 1024 * 1024, 0));
+    SlowReaderPtr slow(new SlowReader(g_fileName, 0));
+    Alembic::Ogawa::CachedStreamReader reader(slow, g_fileName, cache);
+
+    // fetched a bounded number of blocks at a time, and all of them kept
+    std::size_t numBlocks = (expected.size() + 1023) / 1024;
+    std::vector< char > buf(expected.size());
+    TESTING_ASSERT(reader.read(0, 0, buf.size(), &buf.front()));
+    TESTING_ASSERT(buf == expected);
+    TESTING_ASSERT(slow->getNumReads() > 1);
+    TESTING_ASSERT(slow->getNumReads() < numBlocks);
+    TESTING_ASSERT(cache->getNumBlocks() == numBlocks);
+
+    std::size_t numReads = slow->getNumReads();
+    TESTING_ASSERT(reader.read(0, 100, buf.size() - 200, &buf[100]));
+    TESTING_ASSERT(slow->getNumReads() == numReads);
+    TESTING_ASSERT(buf == expected);
+}
+
+//-*****************************************************************************
+void generationTest()
+{
+    Alembic::Ogawa::FileStreamReader first(g_fileName);
+    Alembic::Ogawa::FileStreamReader second(g_fileName);
+    TESTING_ASSERT(!first.getGeneration().empty());
+    TESTING_ASSERT(first.getGeneration() == second.getGeneration());
+
+    // another file of the same size
+    {
+        std::vector< char > data(first.getSize());
+        TESTING_ASSERT(first.read(0, 0, data.size(), &data.front()));
+        std::ofstream copy("blockCacheCopy.ogawa", std::ios::binary);
+        copy.write(&data.front(), data.size());
+    }
+
+    Alembic::Ogawa::FileStreamReader copy("blockCacheCopy.ogawa");
+    TESTING_ASSERT(copy.getSize() == first.getSize());
+    TESTING_ASSERT(copy.getGeneration() != first.getGeneration());
+
+    // so the same key doesn't share the cached blocks
+    Alembic::Ogawa::BlockCachePtr cache(
+        new Alembic::Ogawa::BlockCache(4096, 1024 * 1024, 0));
+    char header[16];
+    Alembic::Ogawa::CachedStreamReader firstReader(
+        Alembic::Ogawa::IStreamReaderPtr(
+            new Alembic::Ogawa::FileStreamReader(g_fileName)),
+        g_fileName, cache);
+    TESTING_ASSERT(firstReader.read(0, 0, 16, header));
+    Alembic::Ogawa::CachedStreamReader copyReader(
+        Alembic::Ogawa::IStreamReaderPtr(
+            new Alembic::Ogawa::FileStreamReader("blockCacheCopy.ogawa")),
+        g_fileName, cache);
+    TESTING_ASSERT(copyReader.read(0, 0, 16, header));
+    TESTING_ASSERT(cache->getNumBlocks() == 2);
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+    writeArchive();
+    cacheTest();
+    sharedArchiveTest();
+    readAheadTest();
+    largeReadTest();
+    generationTest();
+    return 0;
+}
@@ -0,0 +1,289 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+#include <Alembic/Ogawa/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+#include <Alembic/Util/Tasks.h>
+
+#include <iostream>
+#include <sys/time.h>
+#include <unistd.h>
+
+//-*****************************************************************************
+// Stands in for a remote source: every call sleeps for a fixed latency before
+// reading from the wrapped reader, and the calls are counted.
+class DelayedReader : public Alembic::Ogawa::IStreamReader
+{
+public:
+    DelayedReader(Alembic::Ogawa::IStreamReaderPtr iReader,
+                  unsigned int iLatencyUsec) :
+        mReader(iReader), mLatency(iLatencyUsec), mNumReads(0)
+    {
+    }
+
+    Alembic::Util::uint64_t getSize()
+    {
+        return mReader->getSize();
+    }
+
+    bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+              Alembic::Util::uint64_t iSize, void * oBuf)
+    {
+        {
+            Alembic::Util::scoped_lock l(mLock);
+            ++mNumReads;
+        }
+        usleep(mLatency);
+        return mReader->read(iThreadId, iPos, iSize, oBuf);
+    }
+
+    std::size_t getNumReads()
+    {
+        Alembic::Util::scoped_lock l(mLock);
+        return mNumReads;
+    }
+
+private:
+    Alembic::Ogawa::IStreamReaderPtr mReader;
+    unsigned int mLatency;
+    Alembic::Util::mutex mLock;
+    std::size_t mNumReads;
+};
+
+//-*****************************************************************************
+// Passes reads through to the wrapped reader until told to fail them.
+class FailingReader : public Alembic::Ogawa::IStreamReader
+{
+public:
+    FailingReader(Alembic::Ogawa::IStreamReaderPtr iReader) :
+        mReader(iReader), mFail(false)
+    {
+    }
+
+    Alembic::Util::uint64_t getSize()
+    {
+        return mReader->getSize();
+    }
+
+    bool read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
+              Alembic::Util::uint64_t iSize, void * oBuf)
+    {
+        if (mFail)
+        {
+            return false;
+        }
+        return mReader->read(iThreadId, iPos, iSize, oBuf);
+    }
+
+    void setFail(bool iFail)
+    {
+        mFail = iFail;
+    }
+
+private:
+    Alembic::Ogawa::IStreamReaderPtr mReader;
+    bool mFail;
+};
+
+static const std::size_t g_numChildren = 64;
+static const std::size_t g_numThreads = 8;
+static const unsigned int g_latency = 2000;
+
+//-*****************************************************************************
+double now()
+{
+    timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+//-*****************************************************************************
+void writeArchive(const std::string & iName)
+{
+    Alembic::Ogawa::OArchive oa(iName);
+    TESTING_ASSERT(oa.isValid());
+    Alembic::Ogawa::OGroupPtr top = oa.getGroup();
+    for (std::size_t i = 0; i < g_numChildren; ++i)
+    {
+        Alembic::Util::uint64_t vals[16];
+        for (std::size_t j = 0; j < 16; ++j)
+        {
+            vals[j] = i * 16 + j;
+        }
+        top->addGroup()->addData(sizeof(vals), vals);
+    }
+}
+
+//-*****************************************************************************
+void checkChild(Alembic::Ogawa::IGroupPtr iTop, std::size_t iIndex,
+                std::size_t iThreadId)
+{
+    Alembic::Ogawa::IGroupPtr child = iTop->getGroup(iIndex, false,
+                                                     iThreadId);
+    TESTING_ASSERT(child && child->getNumChildren() == 1);
+
+    Alembic::Ogawa::IDataPtr data = child->getData(0, iThreadId);
+    TESTING_ASSERT(data->getSize() == 16 * 8);
+
+    Alembic::Util::uint64_t vals[16];
+    data->read(sizeof(vals), vals, 0, iThreadId);
+    for (std::size_t j = 0; j < 16; ++j)
+    {
+        TESTING_ASSERT(vals[j] == iIndex * 16 + j);
+    }
+}
+
+//-*****************************************************************************
+// Task t reads every g_numThreads'th child on stream t, so no two running
+// tasks share a stream.
+class ReadChildren : public Alembic::Util::Tasks
+{
+public:
+    ReadChildren(Alembic::Ogawa::IGroupPtr iTop) : m_top(iTop) {}
+
+    virtual void run(std::size_t iIndex)
+    {
+        for (std::size_t i = iIndex; i < g_numChildren; i += g_numThreads)
+        {
+            checkChild(m_top, i, iIndex);
+        }
+    }
+
+private:
+    Alembic::Ogawa::IGroupPtr m_top;
+};
+
+void readThreaded(Alembic::Ogawa::IGroupPtr iTop)
+{
+    ReadChildren tasks(iTop);
+    Alembic::Util::runTasks(tasks, g_numThreads, g_numThreads);
+}
+
+//-*****************************************************************************
+void fileReaderTest()
+{
+    writeArchive("streamReaderTest.ogawa");
+
+    Alembic::Util::shared_ptr< Alembic::Ogawa::FileStreamReader > fileReader(
+        new Alembic::Ogawa::FileStreamReader("streamReaderTest.ogawa"));
+    TESTING_ASSERT(fileReader->isValid());
+
+    Alembic::Ogawa::IArchive ia(fileReader);
+    TESTING_ASSERT(ia.isValid());
+    TESTING_ASSERT(ia.isFrozen());
+    TESTING_ASSERT(ia.getVersion() == 1);
+    TESTING_ASSERT(ia.getGroup()->getNumChildren() == g_numChildren);
+
+    for (std::size_t i = 0; i < g_numChildren; ++i)
+    {
+        checkChild(ia.getGroup(), i, 0);
+    }
+
+    // reading past the end fails instead of returning garbage
+    char buf[8];
+    TESTING_ASSERT(!fileReader->read(0, fileReader->getSize() - 4, 8, buf));
+
+    // a reader which starts failing after the archive is open
+    Alembic::Util::shared_ptr< FailingReader > failing(
+        new FailingReader(fileReader));
+    Alembic::Ogawa::IArchive failingArchive(failing);
+    TESTING_ASSERT(failingArchive.isValid());
+    failing->setFail(true);
+    bool threw = false;
+    try
+    {
+        checkChild(failingArchive.getGroup(), 0, 0);
+    }
+    catch (std::exception &)
+    {
+        threw = true;
+    }
+    TESTING_ASSERT(threw);
+
+    // not Ogawa data, or no data at all
+    Alembic::Ogawa::IStreamReaderPtr missing(
+        new Alembic::Ogawa::FileStreamReader("noSuchFile.ogawa"));
+    TESTING_ASSERT(!Alembic::Ogawa::IArchive(missing).isValid());
+}
+
+//-*****************************************************************************
+void latencyTest()
+{
+    Alembic::Ogawa::IStreamReaderPtr fileReader(
+        new Alembic::Ogawa::FileStreamReader("streamReaderTest.ogawa"));
+
+    Alembic::Util::shared_ptr< DelayedReader > serialReader(
+        new DelayedReader(fileReader, g_latency));
+    Alembic::Ogawa::IArchive serialArchive(serialReader);
+    TESTING_ASSERT(serialArchive.isValid());
+
+    // the header and the hierarchy at the end of the file are two reads
+    TESTING_ASSERT(serialReader->getNumReads() == 2);
+
+    double start = now();
+    for (std::size_t i = 0; i < g_numChildren; ++i)
+    {
+        checkChild(serialArchive.getGroup(), i, 0);
+    }
+    double serialTime = now() - start;
+    std::size_t serialReads = serialReader->getNumReads();
+
+    Alembic::Util::shared_ptr< DelayedReader > threadedReader(
+        new DelayedReader(fileReader, g_latency));
+    Alembic::Ogawa::IArchive threadedArchive(threadedReader);
+
+    // nothing serializes the reader so the latency overlaps
+    start = now();
+    readThreaded(threadedArchive.getGroup());
+    double threadedTime = now() - start;
+
+    TESTING_ASSERT(threadedReader->getNumReads() == serialReads);
+
+    std::cout << serialReads << " reads with " << g_latency
+              << " usec latency" << std::endl
+              << "  1 thread:  " << serialTime * 1000.0 << " ms" << std::endl
+              << "  " << g_numThreads << " threads: "
+              << threadedTime * 1000.0 << " ms" << std::endl;
+
+    TESTING_ASSERT(threadedTime * 2.0 < serialTime);
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+    fileReaderTest();
+    latencyTest();
+    return 0;
+}
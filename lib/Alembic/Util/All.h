@@ -42,6 +42,7 @@
 #include <Alembic/Util/Exception.h>
 #include <Alembic/Util/Murmur3.h>
 #include <Alembic/Util/Naming.h>
+#include <Alembic/Util/Tasks.h>
 #include <Alembic/Util/OperatorBool.h>
 #include <Alembic/Util/PlainOldDataType.h>
 #include <Alembic/Util/TokenMap.h>
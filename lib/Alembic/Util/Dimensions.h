@@ -39,93 +39,135 @@
 #include <Alembic/Util/Foundation.h>
 #include <Alembic/Util/PlainOldDataType.h>
 
+#include <algorithm>
+
 namespace Alembic {
 namespace Util {
 namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
+//! The extents of an array sample, one per rank. Almost all data is rank 1,
+//! so low ranks are stored inline and only ranks above kInlineRank go to
+//! the heap, which keeps the many Dimensions created while reading samples
+//! free of allocations.
 template <class T>
 class BaseDimensions
 {
 private:
-    typedef std::vector<T> SizeVec;
-    SizeVec m_vector;
+    static const size_t kInlineRank = 4;
+
+    size_t m_rank;
+    T m_inline[kInlineRank];
+
+    //! Only used when m_rank > kInlineRank
+    std::vector<T> m_spill;
+
+    T *data()
+    { return m_rank > kInlineRank ? &( m_spill.front() ) : m_inline; }
+
+    const T *data() const
+    { return m_rank > kInlineRank ? &( m_spill.front() ) : m_inline; }
+
+    template <class Y>
+    void assign( const BaseDimensions<Y> &copy )
+    {
+        setRank( copy.rank() );
+        T *dst = data();
+        for ( size_t i = 0; i < m_rank; ++i )
+        {
+            Y val = copy[i];
+            dst[i] = static_cast<T>( val );
+        }
+    }
 
 public:
     // Default is for a rank-0 dimension.
     BaseDimensions()
-      : m_vector()
+      : m_rank( 0 )
     {}
 
     // When you specify a single thing, you're specifying a rank-1
     // dimension of a certain size.
     explicit BaseDimensions( const T& t )
-      : m_vector( 1, t )
-    {}
+      : m_rank( 1 )
+    {
+        m_inline[0] = t;
+    }
 
     BaseDimensions( const BaseDimensions &copy )
-      : m_vector( copy.m_vector )
-    {}
+      : m_rank( 0 )
+    {
+        assign( copy );
+    }
 
     template <class Y>
     BaseDimensions( const BaseDimensions<Y> &copy )
+      : m_rank( 0 )
     {
-        m_vector.resize( copy.rank() );
-        for ( size_t i = 0; i < copy.rank(); ++i )
-        {
-            Y val = copy[i];
-            m_vector[i] = static_cast<T>( val );
-        }
+        assign( copy );
     }
 
     BaseDimensions& operator=( const BaseDimensions &copy )
     {
-        m_vector = copy.m_vector;
+        assign( copy );
         return *this;
     }
 
     template <class Y>
     BaseDimensions& operator=( const BaseDimensions<Y> &copy )
     {
-        m_vector.resize( copy.rank() );
-        for ( size_t i = 0; i < copy.rank(); ++i )
-        {
-            Y val = copy[i];
-            m_vector[i] = static_cast<T>( val );
-        }
+        assign( copy );
         return *this;
     }
 
-    size_t rank() const { return m_vector.size(); }
+    size_t rank() const { return m_rank; }
     void setRank( size_t r )
     {
-        size_t oldSize = m_vector.size();
-        m_vector.resize( r );
-        for ( size_t s = oldSize; s < r; ++s )
+        if ( r > kInlineRank )
+        {
+            if ( m_rank <= kInlineRank )
+            {
+                m_spill.assign( m_inline, m_inline + m_rank );
+            }
+            m_spill.resize( r, ( T )0 );
+        }
+        else
         {
-            m_vector[s] = ( T )0;
+            if ( m_rank > kInlineRank )
+            {
+                std::copy( m_spill.begin(), m_spill.begin() + r, m_inline );
+                m_spill.clear();
+            }
+            else
+            {
+                for ( size_t s = m_rank; s < r; ++s )
+                {
+                    m_inline[s] = ( T )0;
+                }
+            }
         }
+        m_rank = r;
     }
 
     T &operator[]( size_t i )
-    { return m_vector[i]; }
+    { return data()[i]; }
 
     const T &operator[]( size_t i ) const
-    { return m_vector[i]; }
+    { return data()[i]; }
 
-    T *rootPtr() { return ( T * )( &( m_vector.front() ) ); }
-    const T *rootPtr() const
-    { return ( const T * )( &( m_vector.front() ) ); }
+    T *rootPtr() { return data(); }
+    const T *rootPtr() const { return data(); }
 
     size_t numPoints() const
     {
-        if ( m_vector.size() == 0 ) { return 0; }
+        if ( m_rank == 0 ) { return 0; }
         else
         {
+            const T *dims = data();
             size_t npoints = 1;
-            for ( size_t i = 0 ; i < m_vector.size() ; i++ )
+            for ( size_t i = 0 ; i < m_rank ; i++ )
             {
-                npoints *= (size_t)m_vector[i];
+                npoints *= (size_t)dims[i];
             }
             return npoints;
         }
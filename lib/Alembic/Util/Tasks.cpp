@@ -0,0 +1,160 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Industrial Light & Magic nor the names of
+// its contributors may be used to endorse or promote products derived
+// from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Util/Exception.h>
+#include <Alembic/Util/Tasks.h>
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/tss.hpp>
+
+namespace Alembic {
+namespace Util {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+void noCleanup( bool * ) {}
+
+// Set while a thread runs tasks, so nested calls don't start more threads.
+boost::thread_specific_ptr<bool> g_inTasks( noCleanup );
+bool g_true = true;
+
+class TaskQueue : noncopyable
+{
+public:
+    TaskQueue( Tasks &iTasks, size_t iNumTasks )
+      : m_tasks( iTasks )
+      , m_numTasks( iNumTasks )
+      , m_next( 0 )
+    {}
+
+    void run()
+    {
+        bool *outer = g_inTasks.get();
+        g_inTasks.reset( &g_true );
+
+        size_t index;
+        while ( nextTask( index ) )
+        {
+            try
+            {
+                m_tasks.run( index );
+            }
+            catch ( std::exception &exc )
+            {
+                setError( exc.what() );
+            }
+            catch ( ... )
+            {
+                setError( "Unknown exception in a task" );
+            }
+        }
+
+        g_inTasks.reset( outer );
+    }
+
+    const std::string &getError() const { return m_error; }
+
+private:
+    bool nextTask( size_t &oIndex )
+    {
+        scoped_lock l( m_lock );
+        if ( m_next >= m_numTasks || !m_error.empty() )
+        {
+            return false;
+        }
+        oIndex = m_next++;
+        return true;
+    }
+
+    void setError( const std::string &iError )
+    {
+        scoped_lock l( m_lock );
+        if ( m_error.empty() )
+        {
+            m_error = iError.empty() ? "Unknown error in a task" : iError;
+        }
+    }
+
+    Tasks &m_tasks;
+    size_t m_numTasks;
+
+    mutex m_lock;
+    size_t m_next;
+    std::string m_error;
+};
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+void runTasks( Tasks &iTasks, size_t iNumTasks, size_t iNumThreads )
+{
+    TaskQueue queue( iTasks, iNumTasks );
+
+    size_t numThreads = std::min( iNumThreads, iNumTasks );
+    if ( g_inTasks.get() )
+    {
+        numThreads = 1;
+    }
+
+    boost::thread_group threads;
+    for ( size_t i = 1; i < numThreads; ++i )
+    {
+        // the calling thread still gets through all of the tasks on its own
+        try
+        {
+            threads.create_thread( boost::bind( &TaskQueue::run, &queue ) );
+        }
+        catch ( boost::thread_resource_error & )
+        {
+            break;
+        }
+    }
+
+    queue.run();
+    threads.join_all();
+
+    if ( !queue.getError().empty() )
+    {
+        ABC_THROW( queue.getError() );
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Util
+} // End namespace Alembic
@@ -0,0 +1,149 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Util/All.h>
+
+#include <boost/thread/thread.hpp>
+
+#include <vector>
+#include <assert.h>
+
+using namespace Alembic::Util;
+
+// Counts how often each task ran.
+class CountTasks : public Tasks
+{
+public:
+    CountTasks( size_t iNumTasks ) : counts( iNumTasks, 0 ) {}
+
+    virtual void run( size_t iIndex )
+    {
+        scoped_lock l( lock );
+        ++counts[iIndex];
+    }
+
+    mutex lock;
+    std::vector<int> counts;
+};
+
+// Throws from one task, the others just count.
+class ThrowTasks : public CountTasks
+{
+public:
+    ThrowTasks( size_t iNumTasks ) : CountTasks( iNumTasks ) {}
+
+    virtual void run( size_t iIndex )
+    {
+        if ( iIndex == 3 )
+        {
+            ABC_THROW( "task 3 failed" );
+        }
+        CountTasks::run( iIndex );
+    }
+};
+
+// Runs tasks from within a task, which should stay on the same thread.
+class NestedTasks : public Tasks
+{
+public:
+    class Inner : public Tasks
+    {
+    public:
+        virtual void run( size_t iIndex )
+        {
+            assert( boost::this_thread::get_id() == outer );
+        }
+
+        boost::thread::id outer;
+    };
+
+    virtual void run( size_t iIndex )
+    {
+        Inner inner;
+        inner.outer = boost::this_thread::get_id();
+        runTasks( inner, 8, 4 );
+    }
+};
+
+void testAllRunOnce( size_t iNumThreads )
+{
+    CountTasks tasks( 100 );
+    runTasks( tasks, tasks.counts.size(), iNumThreads );
+    for ( size_t i = 0; i < tasks.counts.size(); ++i )
+    {
+        assert( tasks.counts[i] == 1 );
+    }
+}
+
+void testError()
+{
+    ThrowTasks tasks( 100 );
+    bool caught = false;
+    try
+    {
+        runTasks( tasks, tasks.counts.size(), 4 );
+    }
+    catch ( Exception &exc )
+    {
+        caught = true;
+        assert( std::string( exc.what() ) == "task 3 failed" );
+    }
+    assert( caught );
+
+    for ( size_t i = 0; i < tasks.counts.size(); ++i )
+    {
+        assert( tasks.counts[i] <= 1 );
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    testAllRunOnce( 0 );
+    testAllRunOnce( 1 );
+    testAllRunOnce( 4 );
+
+    // no tasks at all
+    CountTasks none( 0 );
+    runTasks( none, 0, 4 );
+
+    testError();
+
+    NestedTasks nested;
+    runTasks( nested, 16, 4 );
+
+    std::cout << "Success!" << std::endl;
+    return 0;
+}
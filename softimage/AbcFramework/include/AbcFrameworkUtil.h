@@ -14,6 +14,12 @@
 #define ABCFRAMEWORK_UTIL_H
 
 #include "IAbcInput.h"
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define ABCFRAMEWORK_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 //*****************************************************************************
 /*! \class CAbcPtr
@@ -363,6 +369,74 @@ namespace AbcLerp
 		for (size_t i = 0; i < num; i++)
 			dest[i] = InterpolateSingle<T>( from[i], to[i], f );
 	}
+
+	/*! Float specialization of InterpolateArray, processes 4 floats at a time when SSE2 is available.
+	    dest may alias from or to, which allows interpolating in place.
+	*/
+	template<>
+	inline void InterpolateArray<float>(float* dest, const float* from, const float* to, float f, size_t num)
+	{
+		size_t i = 0;
+#ifdef ABCFRAMEWORK_USE_SSE2
+		const __m128 l_f = _mm_set1_ps( f );
+		for ( ; i + 4 <= num; i += 4 )
+		{
+			const __m128 l_from = _mm_loadu_ps( from + i );
+			const __m128 l_to = _mm_loadu_ps( to + i );
+			_mm_storeu_ps( dest + i, _mm_add_ps( l_from, _mm_mul_ps( _mm_sub_ps( l_to, l_from ), l_f ) ) );
+		}
+#endif
+		for ( ; i < num; i++ )
+			dest[i] = InterpolateSingle<float>( from[i], to[i], f );
+	}
+
+	/*! Double specialization of InterpolateArray, processes 2 doubles at a time when SSE2 is available.
+	    dest may alias from or to, which allows interpolating in place.
+	*/
+	template<>
+	inline void InterpolateArray<double>(double* dest, const double* from, const double* to, float f, size_t num)
+	{
+		size_t i = 0;
+#ifdef ABCFRAMEWORK_USE_SSE2
+		const __m128d l_f = _mm_set1_pd( f );
+		for ( ; i + 2 <= num; i += 2 )
+		{
+			const __m128d l_from = _mm_loadu_pd( from + i );
+			const __m128d l_to = _mm_loadu_pd( to + i );
+			_mm_storeu_pd( dest + i, _mm_add_pd( l_from, _mm_mul_pd( _mm_sub_pd( l_to, l_from ), l_f ) ) );
+		}
+#endif
+		for ( ; i < num; i++ )
+			dest[i] = InterpolateSingle<double>( from[i], to[i], f );
+	}
+
+	/*! Interpolates between arrays of quaternions stored as (r, x, y, z), taking the shortest
+	    path and renormalizing the result. A component-wise lerp would shrink the quaternions
+	    and flip through the long way when the two samples lie on opposite hemispheres.
+	\param dest Pre-allocated destination array, 4 * num values
+	\param from Array to interpolate from
+	\param to Array to interpolate to
+	\param f The interpolation value
+	\param num The number of quaternions in the array
+	*/
+	template<typename T>
+	void InterpolateQuatArray(T* dest, const T* from, const T* to, float f, size_t num)
+	{
+		for (size_t i = 0; i < num; i++, dest += 4, from += 4, to += 4)
+		{
+			const T l_dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+			const T l_sign = l_dot < 0 ? (T)-1 : (T)1;
+
+			T l_q[4];
+			for (int j = 0; j < 4; j++)
+				l_q[j] = from[j] + ( l_sign * to[j] - from[j] ) * f;
+
+			const T l_len = (T)sqrt( l_q[0] * l_q[0] + l_q[1] * l_q[1] + l_q[2] * l_q[2] + l_q[3] * l_q[3] );
+			const T l_inv = l_len > 0 ? (T)1 / l_len : (T)0;
+			for (int j = 0; j < 4; j++)
+				dest[j] = l_q[j] * l_inv;
+		}
+	}
 }
 
 #endif
\ No newline at end of file
@@ -14,8 +14,12 @@
 #include "CRefCount.h"
 #include "IAbcFramework.h"
 #include "CAbcUtils.h"
+#include "CAbcWorkerPool.h"
 #include <map>
+#include <ctime>
+#include <Alembic/Util/Foundation.h>
 #include <boost/filesystem/path.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 
 class CAbcFramework : public IAbcFramework, private CRefCount
@@ -30,7 +34,14 @@ public:
 	EAbcResult		OpenOArchive( const char* in_pszFileName, IAbcOArchive** out_ppArchive, EAbcArchiveType in_eArchiveType );
 	EAbcResult		RemoveOArchiveFromMap( IAbcOArchive* in_pArchive );
 	EAbcResult		RemoveIArchiveFromMap( IAbcIArchive* in_pArchive );
+	void			ReleaseIArchive( class CAbcIArchive* in_pArchive );
 	const IAbcUtils& GetUtils() const;
+	CAbcWorkerPool&	GetWorkerPool() { return m_WorkerPool; }
+	void			SetNumReaderStreams( unsigned int in_uiNumStreams );
+	unsigned int	GetNumReaderStreams() const;
+	void			SetFileCheckInterval( unsigned int in_uiSeconds );
+	unsigned int	GetFileCheckInterval() const;
+	EAbcResult		GetIArchiveStats( const char* in_pszFileName, SAbcIArchiveStats* out_pStats ) const;
 	static CAbcFramework*	GetInstance() { return ms_pInstance;}
 	static EAbcResult		Init();
 	static EAbcResult		Destroy();
@@ -51,14 +62,39 @@ private:
 	{
 		class IAbcIArchive* m_pArchive;
 		std::time_t m_timeLastWrite;
-		SAbcIArchiveInfo() : m_pArchive(0) {}
+		std::time_t m_timeLastCheck;
+		// Set while the first thread opening the file does so, m_pArchive is NULL until then
+		bool m_bOpening;
+		SAbcIArchiveStats m_Stats;
+		SAbcIArchiveInfo();
 		SAbcIArchiveInfo( class IAbcIArchive* in_pArchive, const std::time_t& in_time );
 		~SAbcIArchiveInfo();
 	};
 
 	typedef std::map< boost::filesystem::path, SAbcIArchiveInfo > IArchiveMap;
-	IArchiveMap m_IArchiveMap;
+
+	// The IArchive map is split by file name hash into shards with a lock each, so threads
+	// opening or releasing different archives rarely wait on each other
+	enum { NUM_IARCHIVE_SHARDS = 16 };
+	struct SIArchiveShard
+	{
+		Alembic::Util::mutex m_Mutex;
+		IArchiveMap m_Map;
+		// Notified whenever an entry of this shard is done opening
+		boost::condition_variable_any m_Opened;
+	};
+	mutable SIArchiveShard m_IArchiveShards[ NUM_IARCHIVE_SHARDS ];
+	SIArchiveShard& GetIArchiveShard( const std::string& in_strFileName ) const;
+
+	// Settings for the archives opened from now on, set and read under m_SettingsMutex since
+	// OpenIArchive may run on other threads
+	enum { DEFAULT_NUM_READER_STREAMS = 4 };
+	mutable Alembic::Util::mutex m_SettingsMutex;
+	unsigned int m_uiNumReaderStreams;
+	unsigned int m_uiFileCheckInterval;
+
 	CAbcUtils m_Utils;
+	CAbcWorkerPool m_WorkerPool;
 };
 
 
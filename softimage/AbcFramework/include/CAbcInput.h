@@ -52,9 +52,14 @@ public:
 
 class CAbcIArchive : public IAbcIArchive, protected CRefCount
 {
-	IMPL_REFCOUNT;
+	friend class CAbcFramework;
 public:
-	CAbcIArchive( const char* in_szFilename );
+	// The last Release goes through the framework, so that it can't race with OpenIArchive handing out this archive
+	void			AddRef() { CRefCount::AddRef(); }
+	void			Release();
+	int				GetRefCount() const { return CRefCount::GetRefCount(); }
+
+	CAbcIArchive( const char* in_szFilename, unsigned int in_uiNumStreams = 1 );
 	~CAbcIArchive();
 	EAbcResult		GetTop(IAbcIObject** out_ppObject) const;
 	const char*		GetName() const;
@@ -63,6 +68,8 @@ public:
 	EAbcResult		CreateSampleSelector( IAbcISampleSelector** out_ppSelector ) const;
 
 	EAbcResult		FindObject( const char* in_pszName, IAbcIObject** out_ppObject );
+	EAbcResult		FindObjects( const char** in_ppszNames, size_t in_szNumNames, IAbcIObject** out_ppObjects );
+	EAbcResult		CreateReadBatch( IAbcIReadBatch** out_ppBatch ) const;
 
 	// Archive Info
 	void			GetArchiveStartAndEndTime( double* out_ppdStartTime, double* out_ppdEndTime ) const;
@@ -73,6 +80,8 @@ public:
 	const char*		GetUserDescription() const;
 
 	Alembic::Abc::IArchive*	GetInternalArchive();
+	unsigned int	GetNumStreams() const;
+	void			GetObjectStats( uint64_t& out_ulNumLookups, uint64_t& out_ulNumCacheHits ) const;
 protected:
 	Alembic::Abc::IArchive m_Archive;
 	std::string m_strApplicationWriter;
@@ -82,11 +91,24 @@ protected:
 	double		m_dStartTime;
 	double		m_dEndTime;
 	unsigned int m_uiAbcApiVersion;
+	unsigned int m_uiNumStreams;
 
 	typedef std::map<std::string, IAbcIObject*> TObjectMap;
 	typedef std::pair<std::string, IAbcIObject*> TStringObjectPair;
 	TObjectMap m_mapObjects;
 	void GetArchiveStartAndEndTimeManually( Alembic::Abc::IObject in_Object );
+
+	// Guards the object map and the lookup counters, the archive is shared by ICE threads
+	mutable Alembic::Util::mutex m_ObjectMutex;
+	uint64_t	m_ulNumObjectLookups;
+	uint64_t	m_ulNumObjectCacheHits;
+	EAbcResult		FindObjectNoLock( const char* in_pszName, IAbcIObject** out_ppObject );
+	EAbcResult		AddObjectNoLock( const char* in_pszName, const Alembic::Abc::IObject& in_Object, IAbcIObject** out_ppObject );
+
+	// Looks up a batch of paths in one walk which only visits their branches, wide levels are read in parallel.
+	// Called without m_ObjectMutex, so that other lookups aren't held up.
+	void ResolvePaths( const std::vector<std::string>& in_Paths, std::vector<Alembic::Abc::IObject>& out_Objects );
+	bool ResolvePath( const std::string& in_strPath, Alembic::Abc::IObject& out_Object );
 };
 
 template<typename TSamplePtrType, typename TSampleType>
@@ -173,9 +195,100 @@ private:
 	bool m_bIndexRequested;
 };
 
+// Expansion buffers for a geom param, each one used by one caller at a time. The sample handed out points
+// straight into its buffer and hands it back to the pool when the last reference to it goes away, so
+// several threads can expand the same param at once, and steady playback reuses the same storage.
+// Buffers remember the samples they were last filled from, so expanding the same frame again is free.
+template< typename TGeomParam, typename TSampleType >
+class CExpandedBufferPool
+{
+public:
+	typedef typename TGeomParam::ExpandedBuffer TBuffer;
+	typedef Alembic::Util::shared_ptr< TSampleType > TSamplePtr;
+
+	CExpandedBufferPool() : m_pData( new SData ) {}
+
+	TSamplePtr GetExpandedSample( const TGeomParam& in_param, const Alembic::Abc::ISampleSelector& in_selector ) const
+	{
+		TBuffer* l_pBuffer = m_pData->Acquire();
+		try
+		{
+			in_param.getExpanded( *l_pBuffer, in_selector );
+			return TSamplePtr( new TSampleType( l_pBuffer->get(), Alembic::Util::Dimensions( l_pBuffer->size() ) ),
+				SReleaser( m_pData, l_pBuffer ) );
+		}
+		catch ( ... )
+		{
+			m_pData->Release( l_pBuffer );
+			throw;
+		}
+	}
+
+private:
+	// More than this many idle buffers are freed
+	static const size_t MAX_FREE_BUFFERS = 4;
+
+	struct SData
+	{
+		~SData()
+		{
+			for ( size_t i = 0; i < m_FreeBuffers.size(); ++i )
+				delete m_FreeBuffers[i];
+		}
+
+		TBuffer* Acquire()
+		{
+			{
+				Alembic::Util::scoped_lock l_lock( m_Mutex );
+				if ( !m_FreeBuffers.empty() )
+				{
+					TBuffer* l_pBuffer = m_FreeBuffers.back();
+					m_FreeBuffers.pop_back();
+					return l_pBuffer;
+				}
+			}
+			return new TBuffer;
+		}
+
+		void Release( TBuffer* in_pBuffer )
+		{
+			{
+				Alembic::Util::scoped_lock l_lock( m_Mutex );
+				if ( m_FreeBuffers.size() < MAX_FREE_BUFFERS )
+				{
+					m_FreeBuffers.push_back( in_pBuffer );
+					return;
+				}
+			}
+			delete in_pBuffer;
+		}
+
+		Alembic::Util::mutex	m_Mutex;
+		std::vector<TBuffer*>	m_FreeBuffers;
+	};
+
+	// Deletes the sample and gives its buffer back, the pool outlives the mesh if samples are still out
+	struct SReleaser
+	{
+		SReleaser( const Alembic::Util::shared_ptr<SData>& in_pData, TBuffer* in_pBuffer ) : m_pData( in_pData ), m_pBuffer( in_pBuffer ) {}
+
+		void operator()( TSampleType* in_pSample )
+		{
+			delete in_pSample;
+			m_pData->Release( m_pBuffer );
+		}
+
+		Alembic::Util::shared_ptr<SData>	m_pData;
+		TBuffer*							m_pBuffer;
+	};
+
+	Alembic::Util::shared_ptr<SData> m_pData;
+};
+
 class CAbcIPolyMesh : public CAbcISchemaObjectImpl< Alembic::AbcGeom::IPolyMesh, IAbcIPolyMesh, EIObject_Polymesh >, protected CRefCount
 {
 	IMPL_REFCOUNT;
+	friend class CAbcIReadBatch;
 
 public:
 	CAbcIPolyMesh( Alembic::Abc::IObject in_object );
@@ -194,12 +307,15 @@ public:
 	EAbcResult			GetNormalsParam( IAbcIGeomParam** out_ppGeomParam );
 
 protected:
-	
+	// Expanded UVs and normals are read into these, the mesh is shared between ICE threads and read batches
+	CExpandedBufferPool< Alembic::AbcGeom::IV2fGeomParam, Alembic::AbcGeom::V2fArraySample >	m_UVsBuffers;
+	CExpandedBufferPool< Alembic::AbcGeom::IN3fGeomParam, Alembic::AbcGeom::N3fArraySample >	m_NormalsBuffers;
 };
 
 class CAbcIPoints : public CAbcISchemaObjectImpl< Alembic::AbcGeom::IPoints, IAbcIPoints, EIObject_Points >, protected CRefCount
 {
 	IMPL_REFCOUNT;
+	friend class CAbcIReadBatch;
 
 public:
 	CAbcIPoints( Alembic::Abc::IObject in_object );
@@ -318,4 +434,48 @@ public:
 	EAbcResult				GetSample( IAbcISampleSelector* in_pSampleSelector, IAbcSampleBuffer** out_ppBuffer );
 };
 
+class CAbcIReadBatch : public IAbcIReadBatch, protected CRefCount
+{
+	IMPL_REFCOUNT;
+public:
+	CAbcIReadBatch( Alembic::AbcCoreAbstract::ArchiveReaderPtr in_spArchive, unsigned int in_uiNumStreams );
+	~CAbcIReadBatch();
+
+	EAbcResult	AddRequest( IAbcIObject* in_pObject, EAbcBatchData in_eData, size_t* out_pIndex );
+	size_t		GetNumRequests() const;
+	void			SetNumThreads( unsigned int in_uiNumThreads );
+	EAbcResult	Read( IAbcISampleSelector* in_pSampleSelector );
+	EAbcResult	GetResult( size_t in_Index, IAbcSampleBuffer** out_ppBuffer ) const;
+
+protected:
+	struct SRequest
+	{
+		IAbcISchemaObject*	m_pObject;
+		std::string			m_strFullName;
+		EAbcBatchData		m_eData;
+		// Child indices from the top object, exporters usually write a frame in hierarchy order
+		std::vector<size_t>	m_Position;
+		IAbcSampleBuffer*	m_pBuffer;
+		EAbcResult			m_eResult;
+	};
+	std::vector<SRequest>	m_Requests;
+	std::vector<size_t>		m_Order;			// Request indices sorted by position in the hierarchy
+	bool					m_bOrderDirty;		// Requests were added since m_Order was sorted
+
+	// The requests of each object by full name, at most one per EAbcBatchData
+	typedef Alembic::Util::unordered_map<std::string, std::vector<size_t> > TRequestMap;
+	TRequestMap				m_RequestMap;
+
+	// Only objects of this archive can be added
+	Alembic::AbcCoreAbstract::ArchiveReaderPtr m_spArchive;
+	unsigned int			m_uiNumStreams;
+	unsigned int			m_uiNumThreads;
+
+	struct SPositionLess;
+	void					SortOrder();
+	void					ReadTask( IAbcISampleSelector* in_pSampleSelector, size_t in_NumTasks, size_t in_Task );
+	void					ReadRange( IAbcISampleSelector* in_pSampleSelector, size_t in_Begin, size_t in_End );
+	static EAbcResult	ReadRequest( SRequest& io_Request, IAbcISampleSelector* in_pSampleSelector );
+};
+
 #endif
@@ -31,6 +31,7 @@ public:
 	bool IsValidArray2DProp( IAbcOProperty* in_pOProp, IAbcOProperty** out_ppValProp, IAbcOProperty** out_ppSubArrayIndicesProp ) const;
 	bool IsValidArray2DProp( IAbcIPropertyAccessor* in_pOProp, IAbcIPropertyAccessor** out_ppValProp, IAbcIPropertyAccessor** out_ppSubArrayIndicesProp ) const;
 	EAbcResult ReverseFaceWinding( IAbcSampleBuffer* io_pBuffer, const Alembic::Util::int32_t* in_pFaceCounts, size_t in_szNbFaces ) const;
+	EAbcResult GetInterpolatedBuffer( const class IAbcSampleBuffer* in_pBufferFrom, const class IAbcSampleBuffer* in_pBufferTo, void* out_pDest, size_t in_szDestNumElements, float in_fAlpha, size_t* out_pNumElements ) const;
 };
 
 #endif // CABCUTILS_H
@@ -0,0 +1,80 @@
+//*****************************************************************************
+/*!
+	Copyright 2013 Autodesk, Inc.  All rights reserved.
+	Use of this software is subject to the terms of the Autodesk license agreement
+	provided at the time of installation or download, or which otherwise accompanies
+	this software in either electronic or hard copy form.
+*/
+//*
+
+#ifndef CABCWORKERPOOL_H
+#define CABCWORKERPOOL_H
+
+#include <list>
+#include <string>
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+//*****************************************************************************
+/*! \class CAbcWorkerPool
+	\brief Persistent threads shared by the framework's parallel loops
+
+	The threads are started on the first ParallelFor() and live until the pool is destroyed,
+	so per-frame work doesn't pay for creating and joining threads. The calling thread runs
+	tasks too, which also makes nested ParallelFor() calls from inside a task safe.
+ */
+//*****************************************************************************
+class CAbcWorkerPool
+{
+public:
+	typedef boost::function<void ( size_t )> TaskFunc;
+
+	CAbcWorkerPool();
+	~CAbcWorkerPool();
+
+	/*! Runs in_Task( i ) for every i in [0, in_NumTasks) and returns once all of them are done.
+		Once a task throws no more are started, and when the running ones are done ParallelFor()
+		throws a std::runtime_error with the first task's error, whichever thread ran it.
+	\param in_NumTasks The number of tasks
+	\param in_Task The task function
+	\param in_uiMaxThreads The maximum number of threads working on these tasks, including the caller. 0 for all of them
+	*/
+	void ParallelFor( size_t in_NumTasks, const TaskFunc& in_Task, unsigned int in_uiMaxThreads = 0 );
+
+	//! The number of threads a ParallelFor() can use, including the caller
+	unsigned int GetNumThreads() const;
+
+private:
+	CAbcWorkerPool( const CAbcWorkerPool& );
+	CAbcWorkerPool& operator=( const CAbcWorkerPool& );
+
+	struct SJob
+	{
+		const TaskFunc* m_pTask;
+		size_t m_NumTasks;
+		size_t m_NextTask;
+		size_t m_NumDone;
+		unsigned int m_uiNumHelpers;
+		unsigned int m_uiMaxHelpers;
+		bool m_bFailed;
+		std::string m_strError;
+	};
+
+	static bool RunTask( const TaskFunc& in_Task, size_t in_Index, std::string& out_strError );
+	void StartThreads();
+	void WorkerMain();
+	void RunTasks( SJob& io_Job, boost::unique_lock<boost::mutex>& io_Lock );
+
+	boost::mutex m_Mutex;
+	boost::condition_variable m_WorkAvailable;
+	boost::condition_variable m_JobDone;
+	std::list<SJob*> m_Jobs;
+	boost::thread_group m_Threads;
+	unsigned int m_uiNumWorkers;
+	bool m_bStarted;
+	bool m_bStop;
+};
+
+#endif // CABCWORKERPOOL_H
@@ -11,17 +11,22 @@
 #define REFCOUNT_H
 
 #include <assert.h>
+#include <boost/smart_ptr/detail/atomic_count.hpp>
+
+// The count is atomic, ICE evaluates on many threads which share archives and objects
 class CRefCount
 {
 public:
 	CRefCount() : m_iRefCount(0) {}
+	CRefCount( const CRefCount& ) : m_iRefCount(0) {}
+	CRefCount& operator=( const CRefCount& ) { return *this; }
 	virtual ~CRefCount()
 	{
 		assert( m_iRefCount == 0 );
 	}
 	void AddRef()
 	{
-		m_iRefCount++;
+		++m_iRefCount;
 	}
 	void Release()
 	{
@@ -32,10 +37,10 @@ public:
 	}
 	int GetRefCount() const
 	{
-		return m_iRefCount;
+		return (int)m_iRefCount;
 	}
 protected:
-	int m_iRefCount;
+	boost::detail::atomic_count m_iRefCount;
 };
 
 #define IMPL_REFCOUNT				\
@@ -430,6 +430,32 @@ public:
 	\return Returns ::EResult_Success if successful. For other return codes, please see ::EAbcResult
 	*/
 	virtual EAbcResult ReverseFaceWinding( IAbcSampleBuffer* io_pBuffer, const Alembic::Util::int32_t* in_pFaceCounts, size_t in_szNbFaces ) const = 0;
+
+	/*! Linearly interpolates from a source buffer to a target buffer into caller-owned memory, so repeated
+	    subframe evaluations can reuse the same destination instead of allocating a new buffer every time.
+	    Quaternion buffers are interpolated along the shortest path and renormalized.
+	\param in_pBufferFrom The source buffer
+	\param in_pBufferTo The target buffer, should be the same type as the source buffer
+	\param out_pDest The destination memory, may be the buffer of in_pBufferFrom or in_pBufferTo to interpolate in place
+	\param in_szDestNumElements The number of elements out_pDest can hold
+	\param in_fAlpha The amount of interpolation
+	\param out_pNumElements Optional, receives the number of elements interpolated, which is the size of the smaller buffer
+	\return Returns ::EResult_Success if successful, ::EResult_OutOfRange if out_pDest is too small. For other return codes, please see ::EAbcResult
+	*/
+	virtual EAbcResult GetInterpolatedBuffer( const class IAbcSampleBuffer* in_pBufferFrom, const class IAbcSampleBuffer* in_pBufferTo, void* out_pDest, size_t in_szDestNumElements, float in_fAlpha, size_t* out_pNumElements ) const = 0;
+};
+
+/*! Reader statistics of an archive held by the framework, see IAbcFramework::GetIArchiveStats() */
+struct SAbcIArchiveStats
+{
+	unsigned int	m_uiNumStreams;			/*!< Number of Ogawa streams the archive was opened with */
+	int				m_iRefCount;				/*!< Number of references currently held on the archive */
+	uint64_t		m_ulNumOpens;				/*!< Number of IAbcFramework::OpenIArchive() calls for the file */
+	uint64_t		m_ulNumCacheHits;			/*!< Number of opens served by the already opened archive */
+	uint64_t		m_ulNumFileChecks;		/*!< Number of times the file was checked for changes on disk */
+	uint64_t		m_ulNumReloads;			/*!< Number of times the archive was reopened because the file changed */
+	uint64_t		m_ulNumObjectLookups;		/*!< Number of IAbcIArchive::FindObject() lookups */
+	uint64_t		m_ulNumObjectCacheHits;	/*!< Number of lookups served by the archive's object cache */
 };
 
 //*****************************************************************************
@@ -511,6 +537,32 @@ public:
 	\return A reference to an IAbcUtils object
 	*/
 	virtual const IAbcUtils&	GetUtils() const = 0;
+
+	/*! Sets the number of Ogawa streams archives are opened with, so that many threads can read
+		the same archive without waiting on each other. Each stream holds its own file handle.
+		Archives already opened keep their streams until they are reopened.
+	\param in_uiNumStreams The number of streams, 0 to match the number of hardware threads. The default is 4.
+	*/
+	virtual void				SetNumReaderStreams( unsigned int in_uiNumStreams ) = 0;
+
+	/*! Returns the number of Ogawa streams new archives are opened with */
+	virtual unsigned int		GetNumReaderStreams() const = 0;
+
+	/*! Sets how often an already opened archive is checked for changes on disk. Within the interval,
+		IAbcFramework::OpenIArchive() returns the opened archive without touching the file system.
+	\param in_uiSeconds The interval in seconds, 0 to check on every open. The default is 1 second.
+	*/
+	virtual void				SetFileCheckInterval( unsigned int in_uiSeconds ) = 0;
+
+	/*! Returns the interval in seconds between checks of opened archives for changes on disk */
+	virtual unsigned int		GetFileCheckInterval() const = 0;
+
+	/*! Gets the reader statistics of an archive opened with IAbcFramework::OpenIArchive()
+	\param in_pszFileName The filename of the archive, as passed to IAbcFramework::OpenIArchive()
+	\param out_pStats The returned statistics
+	\return Returns ::EResult_Success if successful, ::EResult_Fail if the archive isn't opened. For other return codes, please see ::EAbcResult
+	*/
+	virtual EAbcResult			GetIArchiveStats( const char* in_pszFileName, SAbcIArchiveStats* out_pStats ) const = 0;
 };
 
 #endif // ABCFRAMEWORKINTERFACE_H
@@ -41,7 +41,21 @@ enum EAbcIFaceSetExclusivity
 	EIFaceSet_Exclusive,		/*! Faces are exclusive to this face set */
 };
 
+/*! Enumeration for the data an IAbcIReadBatch request reads from an object */
+enum EAbcBatchData
+{
+	EBatchData_Positions,		/*! Positions of a poly mesh or points object, see IAbcIPolyMesh::GetPositions() */
+	EBatchData_Velocities,	/*! Velocities of a poly mesh or points object */
+	EBatchData_Normals,		/*! Expanded normals of a poly mesh, see IAbcIPolyMesh::GetNormals() */
+	EBatchData_UVs,			/*! Expanded UVs of a poly mesh, see IAbcIPolyMesh::GetUVs() */
+	EBatchData_FaceCounts,	/*! Face counts of a poly mesh */
+	EBatchData_FaceIndices,	/*! Face indices of a poly mesh */
+	EBatchData_Ids			/*! Ids of a points object */
+};
+
 class IAbcIPolyMesh;
+class IAbcIReadBatch;
+class IAbcSampleBuffer;
 class IAbcISchemaObject;
 class IAbcICompoundPropertyAccessor;
 
@@ -321,6 +335,15 @@ public:
 	*/
 	virtual EAbcResult		FindObject( const char* in_pszObject, IAbcIObject** out_ppObject ) = 0;
 
+	/*! Finds several objects at once. The paths which weren't looked up before are resolved together,
+	    reading each object along the way once and only the requested branches of the hierarchy.
+	\param in_ppszNames The full paths of the objects to find, separated by '/'
+	\param in_szNumNames The number of paths in in_ppszNames
+	\param out_ppObjects Array of in_szNumNames pointers receiving the objects. Paths that are not found are set to NULL
+	\return ::EResult_Success if every object was found, ::EResult_Fail if at least one was not found. Please see ::EAbcResult for more return code information
+	*/
+	virtual EAbcResult		FindObjects( const char** in_ppszNames, size_t in_szNumNames, IAbcIObject** out_ppObjects ) = 0;
+
 	/*! Gets the start and end times of the archive
 	\param out_ppdStartTime		Optional. The time at the earliest sample in the archive
 	\param out_ppdEndTime		Optional. The time at the latest sample in the archive
@@ -351,6 +374,72 @@ public:
 	\return A const char* string containing the description
 	*/
 	virtual const char*		GetUserDescription() const = 0;
+
+	/*! Creates an empty read batch, which reads the samples of many objects of this archive at once
+	\param out_ppBatch The returned batch
+	\return ::EResult_Success on success, please see ::EAbcResult for more return code information
+	*/
+	virtual EAbcResult		CreateReadBatch( IAbcIReadBatch** out_ppBatch ) const = 0;
+};
+
+//*****************************************************************************
+/*! \class IAbcIReadBatch
+	\brief Reads the samples of a set of objects of an archive at a given time in one call.
+	The requests are registered once, then every IAbcIReadBatch::Read() fetches all of them across
+	several threads, in the order they are laid out in the archive, using one stream per thread.
+
+	\eg Usage:
+	\code
+		IAbcIArchive* pArchive; // Assume pArchive points to a valid archive
+		CAbcPtr<IAbcIReadBatch> spBatch;
+		pArchive->CreateReadBatch( &spBatch );
+
+		size_t posIndex, normalIndex;
+		spBatch->AddRequest( pMesh, EBatchData_Positions, &posIndex );
+		spBatch->AddRequest( pMesh, EBatchData_Normals, &normalIndex );
+
+		// Every frame
+		if ( spBatch->Read( pSelector ) == EResult_Success )
+		{
+			CAbcPtr<IAbcSampleBuffer> spPositions;
+			spBatch->GetResult( posIndex, &spPositions );
+		}
+	\endcode
+*/
+//*****************************************************************************
+class IAbcIReadBatch : public IBase
+{
+public:
+	/*! Registers the data of an object to read with the batch. Registering the same data twice returns the first request.
+	\param in_pObject A poly mesh or points object of the archive
+	\param in_eData The data to read, see ::EAbcBatchData
+	\param out_pIndex Optional. The returned index of the request, to use with IAbcIReadBatch::GetResult()
+	\return ::EResult_Success on success, ::EResult_NotApplicable if the object doesn't have the data, ::EResult_InvalidPtr if it belongs to another archive. Please see ::EAbcResult for more return code information
+	*/
+	virtual EAbcResult	AddRequest( IAbcIObject* in_pObject, EAbcBatchData in_eData, size_t* out_pIndex ) = 0;
+
+	/*! Gets the number of requests registered with the batch
+	\return The number of requests
+	*/
+	virtual size_t		GetNumRequests() const = 0;
+
+	/*! Sets the maximum number of threads IAbcIReadBatch::Read() uses
+	\param in_uiNumThreads The number of threads, 0 to use as many threads as the archive has streams (the default)
+	*/
+	virtual void			SetNumThreads( unsigned int in_uiNumThreads ) = 0;
+
+	/*! Reads the samples of every request at the time of the sample selector. The buffers of the previous read are released.
+	\param in_pSampleSelector Optional. A sample selector object to determine which time to get the samples from.
+	\return ::EResult_Success if every request was read, ::EResult_Fail if at least one failed. Please see ::EAbcResult for more return code information
+	*/
+	virtual EAbcResult	Read( IAbcISampleSelector* in_pSampleSelector ) = 0;
+
+	/*! Gets the sample buffer of a request read by the last IAbcIReadBatch::Read()
+	\param in_Index The index of the request, as returned by IAbcIReadBatch::AddRequest()
+	\param out_ppBuffer The returned sample buffer
+	\return ::EResult_Success on success, the error of the request if it failed to read. Please see ::EAbcResult for more return code information
+	*/
+	virtual EAbcResult	GetResult( size_t in_Index, IAbcSampleBuffer** out_ppBuffer ) const = 0;
 };
 
 //*****************************************************************************
@@ -18,7 +18,11 @@
 // the HDF5 implementation, currently the only one available.
 #include <Alembic/AbcCoreHDF5/All.h>
 #include <boost/filesystem/operations.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
 #include <exception>
+#include <string.h>
 
 CAbcPtr<CAbcFramework> CAbcFramework::ms_pInstance = NULL;
 
@@ -39,11 +43,11 @@ ABCFRAMEWORK_API IAbcFramework* GetFrameworkInterface()
 	return l_pInterface;
 }
 
-CAbcFramework::CAbcFramework()
+CAbcFramework::CAbcFramework() : m_uiNumReaderStreams( DEFAULT_NUM_READER_STREAMS ), m_uiFileCheckInterval( 1 )
 {
 }
 
-CAbcFramework::CAbcFramework( const CAbcFramework& in_other )
+CAbcFramework::CAbcFramework( const CAbcFramework& in_other ) : m_uiNumReaderStreams( DEFAULT_NUM_READER_STREAMS ), m_uiFileCheckInterval( 1 )
 {
 
 }
@@ -115,67 +119,113 @@ EAbcResult CAbcFramework::OpenOArchive( const char* in_pszFileName, IAbcOArchive
 }
 
 
+CAbcFramework::SIArchiveShard& CAbcFramework::GetIArchiveShard( const std::string& in_strFileName ) const
+{
+	return m_IArchiveShards[ boost::hash<std::string>()( in_strFileName ) % NUM_IARCHIVE_SHARDS ];
+}
+
 EAbcResult CAbcFramework::OpenIArchive( const char* in_pszFileName, IAbcIArchive** out_ppArchive )
 {
-	if (out_ppArchive == NULL)
+	if (out_ppArchive == NULL || in_pszFileName == NULL)
 		return EResult_InvalidPtr;
 
-	boost::filesystem::path l_path( in_pszFileName );
-	IArchiveMap::iterator it = m_IArchiveMap.end();
-	bool l_bExists = boost::filesystem::exists( l_path );
-	if ( l_bExists )
-	{
-		it = m_IArchiveMap.find( l_path );
-	}
-	
-	CAbcIArchive* l_pIArchive = NULL;
-	
-	std::time_t l_timeLastWrite;
-	if ( l_bExists )
-		l_timeLastWrite = boost::filesystem::last_write_time( l_path );
-
-	if ( it != m_IArchiveMap.end() )
+	try
 	{
-		// Has the cached file changed?
-		bool l_bChanged = !l_bExists || l_timeLastWrite != it->second.m_timeLastWrite;
+		boost::filesystem::path l_path( in_pszFileName );
+		std::string l_strFileName = l_path.string();
+
+		const unsigned int l_uiFileCheckInterval = GetFileCheckInterval();
+
+		SIArchiveShard& l_shard = GetIArchiveShard( l_strFileName );
+		SAbcIArchiveStats l_stats;
+		memset( &l_stats, 0, sizeof( l_stats ) );
 
-		// Update our map if the file has changed
-		if ( l_bChanged )
-		{
-			m_IArchiveMap.erase(it);
-			it = m_IArchiveMap.end();
-			if ( !l_bExists )
-				return EResult_Fail;
-		}
-		else
 		{
-			l_pIArchive = (CAbcIArchive*)it->second.m_pArchive;
+			Alembic::Util::scoped_lock l_lock( l_shard.m_Mutex );
+
+			const std::time_t l_timeNow = std::time( NULL );
+			IArchiveMap::iterator it = l_shard.m_Map.find( l_path );
+
+			// Threads opening the same file wait here until the first one has opened it
+			while ( it != l_shard.m_Map.end() && it->second.m_bOpening )
+			{
+				l_shard.m_Opened.wait( l_shard.m_Mutex );
+				it = l_shard.m_Map.find( l_path );
+			}
+
+			if ( it != l_shard.m_Map.end() )
+			{
+				SAbcIArchiveInfo& l_info = it->second;
+				++l_info.m_Stats.m_ulNumOpens;
+
+				// Stat calls are slow on network drives, the file is checked at most once per interval
+				bool l_bChanged = false;
+				if ( l_timeNow < l_info.m_timeLastCheck || l_timeNow - l_info.m_timeLastCheck >= (std::time_t)l_uiFileCheckInterval )
+				{
+					++l_info.m_Stats.m_ulNumFileChecks;
+					l_info.m_timeLastCheck = l_timeNow;
+					l_bChanged = !boost::filesystem::exists( l_path ) || boost::filesystem::last_write_time( l_path ) != l_info.m_timeLastWrite;
+				}
+
+				if ( !l_bChanged )
+				{
+					++l_info.m_Stats.m_ulNumCacheHits;
+					*out_ppArchive = l_info.m_pArchive;
+					l_info.m_pArchive->AddRef();
+					return EResult_Success;
+				}
+
+				// The file has changed, the old archive stays valid for its users until their last Release
+				l_stats = l_info.m_Stats;
+				++l_stats.m_ulNumReloads;
+				l_shard.m_Map.erase( it );
+			}
+			else
+			{
+				l_stats.m_ulNumOpens = 1;
+			}
+
+			// Reserve the entry, the archive itself is opened without holding the shard lock
+			SAbcIArchiveInfo& l_info = l_shard.m_Map[ l_path ];
+			l_info.m_bOpening = true;
 		}
-	}
 
-	if ( it == m_IArchiveMap.end() )
-	{
+		++l_stats.m_ulNumFileChecks;
+		CAbcIArchive* l_pIArchive = NULL;
+		std::time_t l_timeLastWrite = 0;
 		try
 		{
-			std::string l_strFileName = l_path.string();
-			l_pIArchive = new CAbcIArchive( l_strFileName.c_str() );
+			if ( boost::filesystem::exists( l_path ) )
+			{
+				l_timeLastWrite = boost::filesystem::last_write_time( l_path );
+				l_pIArchive = new CAbcIArchive( l_strFileName.c_str(), GetNumReaderStreams() );
+			}
 		}
 		catch ( std::exception& )
 		{
-			return EResult_Fail;
+			l_pIArchive = NULL;
 		}
 
-		// Add this new entry to our map
-		m_IArchiveMap[l_path] = SAbcIArchiveInfo( l_pIArchive, l_timeLastWrite );
-	}
+		Alembic::Util::scoped_lock l_lock( l_shard.m_Mutex );
+		if ( l_pIArchive )
+		{
+			SAbcIArchiveInfo& l_info = l_shard.m_Map[ l_path ];
+			l_info = SAbcIArchiveInfo( l_pIArchive, l_timeLastWrite );
+			l_info.m_Stats = l_stats;
+
+			*out_ppArchive = l_pIArchive;
+			l_pIArchive->AddRef();
+		}
+		else
+			l_shard.m_Map.erase( l_path );
 
-	if ( l_pIArchive )
+		l_shard.m_Opened.notify_all();
+		return l_pIArchive ? EResult_Success : EResult_Fail;
+	}
+	catch ( std::exception& )
 	{
-		*out_ppArchive = l_pIArchive;
-		l_pIArchive->AddRef();
-		return EResult_Success;
+		return EResult_Fail;
 	}
-	return EResult_Fail;
 }
 
 EAbcResult CAbcFramework::RemoveOArchiveFromMap( IAbcOArchive* in_pArchive )
@@ -195,17 +245,89 @@ EAbcResult CAbcFramework::RemoveOArchiveFromMap( IAbcOArchive* in_pArchive )
 
 EAbcResult CAbcFramework::RemoveIArchiveFromMap( IAbcIArchive* in_pArchive )
 {
-	for ( IArchiveMap::iterator it = m_IArchiveMap.begin(); it != m_IArchiveMap.end(); ++it )
+	SIArchiveShard& l_shard = GetIArchiveShard( in_pArchive->GetName() );
+	Alembic::Util::scoped_lock l_lock( l_shard.m_Mutex );
+
+	IArchiveMap::iterator it = l_shard.m_Map.find( boost::filesystem::path( in_pArchive->GetName() ) );
+	if ( it != l_shard.m_Map.end() && it->second.m_pArchive == in_pArchive )
 	{
-		if ( it->second.m_pArchive == in_pArchive )
-		{
-			m_IArchiveMap.erase( it );
-			return EResult_Success;
-		}
+		l_shard.m_Map.erase( it );
+		return EResult_Success;
 	}
 	return EResult_Fail;
 }
 
+void CAbcFramework::ReleaseIArchive( CAbcIArchive* in_pArchive )
+{
+	{
+		// Under the shard lock, OpenIArchive can't hand out the archive between the last Release and its removal
+		SIArchiveShard& l_shard = GetIArchiveShard( in_pArchive->GetName() );
+		Alembic::Util::scoped_lock l_lock( l_shard.m_Mutex );
+
+		if ( --in_pArchive->m_iRefCount > 0 )
+			return;
+
+		// A changed file may already have a newer archive under the same name
+		IArchiveMap::iterator it = l_shard.m_Map.find( boost::filesystem::path( in_pArchive->GetName() ) );
+		if ( it != l_shard.m_Map.end() && it->second.m_pArchive == in_pArchive )
+			l_shard.m_Map.erase( it );
+	}
+
+	delete in_pArchive;
+}
+
+void CAbcFramework::SetNumReaderStreams( unsigned int in_uiNumStreams )
+{
+	Alembic::Util::scoped_lock l_lock( m_SettingsMutex );
+	m_uiNumReaderStreams = in_uiNumStreams;
+}
+
+unsigned int CAbcFramework::GetNumReaderStreams() const
+{
+	unsigned int l_uiNumStreams;
+	{
+		Alembic::Util::scoped_lock l_lock( m_SettingsMutex );
+		l_uiNumStreams = m_uiNumReaderStreams;
+	}
+
+	if ( l_uiNumStreams == 0 )
+		return std::max<unsigned int>( boost::thread::hardware_concurrency(), 1 );
+	return l_uiNumStreams;
+}
+
+void CAbcFramework::SetFileCheckInterval( unsigned int in_uiSeconds )
+{
+	Alembic::Util::scoped_lock l_lock( m_SettingsMutex );
+	m_uiFileCheckInterval = in_uiSeconds;
+}
+
+unsigned int CAbcFramework::GetFileCheckInterval() const
+{
+	Alembic::Util::scoped_lock l_lock( m_SettingsMutex );
+	return m_uiFileCheckInterval;
+}
+
+EAbcResult CAbcFramework::GetIArchiveStats( const char* in_pszFileName, SAbcIArchiveStats* out_pStats ) const
+{
+	if ( in_pszFileName == NULL || out_pStats == NULL )
+		return EResult_InvalidPtr;
+
+	boost::filesystem::path l_path( in_pszFileName );
+	SIArchiveShard& l_shard = GetIArchiveShard( l_path.string() );
+	Alembic::Util::scoped_lock l_lock( l_shard.m_Mutex );
+
+	IArchiveMap::const_iterator it = l_shard.m_Map.find( l_path );
+	if ( it == l_shard.m_Map.end() || it->second.m_bOpening )
+		return EResult_Fail;
+
+	const CAbcIArchive* l_pIArchive = (const CAbcIArchive*)it->second.m_pArchive;
+	*out_pStats = it->second.m_Stats;
+	out_pStats->m_uiNumStreams = l_pIArchive->GetNumStreams();
+	out_pStats->m_iRefCount = l_pIArchive->GetRefCount();
+	l_pIArchive->GetObjectStats( out_pStats->m_ulNumObjectLookups, out_pStats->m_ulNumObjectCacheHits );
+	return EResult_Success;
+}
+
 EAbcResult CAbcFramework::Init()
 {
 	if ( ms_pInstance == NULL )
@@ -235,8 +357,14 @@ const IAbcUtils& CAbcFramework::GetUtils() const
 	return m_Utils;
 }
 
-CAbcFramework::SAbcIArchiveInfo::SAbcIArchiveInfo( class IAbcIArchive* in_pArchive, const std::time_t& in_time ) : m_pArchive( in_pArchive ), m_timeLastWrite( in_time )
+CAbcFramework::SAbcIArchiveInfo::SAbcIArchiveInfo() : m_pArchive( 0 ), m_timeLastWrite( 0 ), m_timeLastCheck( 0 ), m_bOpening( false )
+{
+	memset( &m_Stats, 0, sizeof( m_Stats ) );
+}
+
+CAbcFramework::SAbcIArchiveInfo::SAbcIArchiveInfo( class IAbcIArchive* in_pArchive, const std::time_t& in_time ) : m_pArchive( in_pArchive ), m_timeLastWrite( in_time ), m_timeLastCheck( std::time( NULL ) ), m_bOpening( false )
 {
+	memset( &m_Stats, 0, sizeof( m_Stats ) );
 }
 
 CAbcFramework::SAbcIArchiveInfo::~SAbcIArchiveInfo()
@@ -10,6 +10,7 @@
 #include "CAbcInput.h"
 #include "CAbcFramework.h"
 #include <assert.h>
+#include <algorithm>
 
 // Alembic Includes
 #include <Alembic/Abc/ArchiveInfo.h>
@@ -19,7 +20,6 @@
 // the HDF5 implementation, currently the only one available.
 #include <Alembic/AbcCoreHDF5/All.h>
 #include <Alembic/AbcCoreFactory/IFactory.h>
-#include <boost/xpressive/xpressive.hpp>
 
 using namespace Alembic;
 using namespace Alembic::Abc;
@@ -30,12 +30,22 @@ using namespace Alembic::AbcCoreAbstract;
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // CAbcIArchve
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-CAbcIArchive::CAbcIArchive( const char* in_szFilename )
+CAbcIArchive::CAbcIArchive( const char* in_szFilename, unsigned int in_uiNumStreams )
+	: m_uiNumStreams( in_uiNumStreams > 0 ? in_uiNumStreams : 1 )
+	, m_ulNumObjectLookups( 0 )
+	, m_ulNumObjectCacheHits( 0 )
 {
 	try
 	{
+		// One stream per evaluation thread, threads reading an Ogawa archive through a single stream take turns
 		Alembic::AbcCoreFactory::IFactory l_factory;
-		m_Archive = l_factory.getArchive( in_szFilename );
+		Alembic::AbcCoreFactory::IFactory::CoreType l_coreType;
+		l_factory.setOgawaNumStreams( m_uiNumStreams );
+		m_Archive = l_factory.getArchive( in_szFilename, l_coreType );
+
+		// HDF5 archives are read by one thread at a time
+		if ( l_coreType != Alembic::AbcCoreFactory::IFactory::kOgawa )
+			m_uiNumStreams = 1;
 		GetArchiveInfo( m_Archive, m_strApplicationWriter, m_strAbcVersion, m_uiAbcApiVersion, m_strDateWritten, m_strUserDescription );
 		if ( !m_Archive )
 		{
@@ -62,7 +72,15 @@ CAbcIArchive::~CAbcIArchive()
 	{
 		it->second->Release();
 	}
-	CAbcFramework::GetInstance()->RemoveIArchiveFromMap( this );
+}
+
+void CAbcIArchive::Release()
+{
+	CAbcFramework* l_pFramework = CAbcFramework::GetInstance();
+	if ( l_pFramework )
+		l_pFramework->ReleaseIArchive( this );
+	else
+		CRefCount::Release();
 }
 
 EAbcResult CAbcIArchive::GetTop( IAbcIObject** out_ppObject ) const
@@ -97,6 +115,18 @@ Alembic::Abc::IArchive* CAbcIArchive::GetInternalArchive()
 	return &m_Archive;
 }
 
+unsigned int CAbcIArchive::GetNumStreams() const
+{
+	return m_uiNumStreams;
+}
+
+void CAbcIArchive::GetObjectStats( uint64_t& out_ulNumLookups, uint64_t& out_ulNumCacheHits ) const
+{
+	Alembic::Util::scoped_lock l_lock( m_ObjectMutex );
+	out_ulNumLookups = m_ulNumObjectLookups;
+	out_ulNumCacheHits = m_ulNumObjectCacheHits;
+}
+
 EAbcResult CAbcIArchive::CreateSampleSelector( IAbcISampleSelector** out_ppSelector ) const
 {
 	CAbcISampleSelector* l_pNewSelector = new CAbcISampleSelector();
@@ -109,53 +139,285 @@ EAbcResult CAbcIArchive::CreateSampleSelector( IAbcISampleSelector** out_ppSelec
 	return EResult_OutOfMemory;
 }
 
+// Splits a path on '/' and rebuilds it in the form returned by IObject::getFullName(), ignoring empty tokens
+static void SplitObjectPath( const std::string& in_strPath, std::vector<std::string>& out_Names, std::string& out_strFullName )
+{
+	out_Names.clear();
+	out_strFullName.clear();
+
+	size_t l_start = 0;
+	while ( l_start <= in_strPath.size() )
+	{
+		size_t l_end = in_strPath.find( '/', l_start );
+		if ( l_end == std::string::npos )
+			l_end = in_strPath.size();
+
+		if ( l_end > l_start )
+		{
+			out_Names.push_back( in_strPath.substr( l_start, l_end - l_start ) );
+			out_strFullName += '/';
+			out_strFullName += out_Names.back();
+		}
+		l_start = l_end + 1;
+	}
+
+	if ( out_strFullName.empty() )
+		out_strFullName = "/";
+}
+
+// Levels of the requested paths with at least this many objects are looked up on the framework's worker threads
+static const size_t PATH_INDEX_MIN_PARALLEL_WIDTH = 64;
+static const size_t PATH_INDEX_PARENTS_PER_TASK = 16;
+
+// One object of the requested paths, with the requested children below it
+struct SPathNode
+{
+	std::string m_strName;
+	IObject m_Object;
+	std::map<std::string, size_t> m_Children;
+};
+
+static void ResolveChildren( std::vector<SPathNode>& io_Nodes, size_t in_Parent )
+{
+	const SPathNode& l_Parent = io_Nodes[ in_Parent ];
+	for ( std::map<std::string, size_t>::const_iterator it = l_Parent.m_Children.begin(); it != l_Parent.m_Children.end(); ++it )
+	{
+		if ( l_Parent.m_Object.valid() )
+			io_Nodes[ it->second ].m_Object = l_Parent.m_Object.getChild( it->first );
+	}
+}
+
+// Looks up the children of a slice of one level, errors are rethrown by ParallelFor()
+struct SResolveLevelTask
+{
+	std::vector<SPathNode>* m_pNodes;
+	const std::vector<size_t>* m_pLevel;
+	size_t m_NumTasks;
+
+	void operator()( size_t in_Task ) const
+	{
+		const size_t l_Begin = m_pLevel->size() * in_Task / m_NumTasks;
+		const size_t l_End = m_pLevel->size() * ( in_Task + 1 ) / m_NumTasks;
+		for ( size_t i = l_Begin; i < l_End; ++i )
+			ResolveChildren( *m_pNodes, (*m_pLevel)[i] );
+	}
+};
+
+void CAbcIArchive::ResolvePaths( const std::vector<std::string>& in_Paths, std::vector<IObject>& out_Objects )
+{
+	// A tree of only the requested paths, so that shared parents are looked up once and nothing else is read
+	std::vector<SPathNode> l_Nodes( 1 );
+	l_Nodes[0].m_Object = IObject( m_Archive, kTop );
+	std::vector<size_t> l_PathNodes( in_Paths.size() );
+
+	std::vector<std::string> l_Names;
+	std::string l_strFullName;
+	for ( size_t p = 0; p < in_Paths.size(); ++p )
+	{
+		SplitObjectPath( in_Paths[p], l_Names, l_strFullName );
+
+		size_t l_Node = 0;
+		for ( size_t i = 0; i < l_Names.size(); ++i )
+		{
+			std::map<std::string, size_t>::iterator it = l_Nodes[ l_Node ].m_Children.find( l_Names[i] );
+			if ( it == l_Nodes[ l_Node ].m_Children.end() )
+			{
+				const size_t l_Child = l_Nodes.size();
+				l_Nodes[ l_Node ].m_Children[ l_Names[i] ] = l_Child;
+				l_Nodes.push_back( SPathNode() );
+				l_Nodes.back().m_strName = l_Names[i];
+				l_Node = l_Child;
+			}
+			else
+				l_Node = it->second;
+		}
+		l_PathNodes[p] = l_Node;
+	}
+
+	// Breadth first, so that the lookups of a wide level can read on several streams at once.
+	// Each object is only looked into by one task.
+	CAbcFramework* l_pFramework = CAbcFramework::GetInstance();
+	std::vector<size_t> l_Level( 1, 0 );
+	std::vector<size_t> l_NextLevel;
+	while ( !l_Level.empty() )
+	{
+		if ( l_pFramework && m_uiNumStreams > 1 && l_Level.size() >= PATH_INDEX_MIN_PARALLEL_WIDTH )
+		{
+			CAbcWorkerPool& l_Pool = l_pFramework->GetWorkerPool();
+			SResolveLevelTask l_Task;
+			l_Task.m_pNodes = &l_Nodes;
+			l_Task.m_pLevel = &l_Level;
+			l_Task.m_NumTasks = std::min<size_t>( l_Level.size() / PATH_INDEX_PARENTS_PER_TASK, 4 * l_Pool.GetNumThreads() );
+			l_Pool.ParallelFor( l_Task.m_NumTasks, l_Task, m_uiNumStreams );
+		}
+		else
+		{
+			for ( size_t i = 0; i < l_Level.size(); ++i )
+				ResolveChildren( l_Nodes, l_Level[i] );
+		}
+
+		l_NextLevel.clear();
+		for ( size_t i = 0; i < l_Level.size(); ++i )
+		{
+			const SPathNode& l_Parent = l_Nodes[ l_Level[i] ];
+			for ( std::map<std::string, size_t>::const_iterator it = l_Parent.m_Children.begin(); it != l_Parent.m_Children.end(); ++it )
+				l_NextLevel.push_back( it->second );
+		}
+		l_Level.swap( l_NextLevel );
+	}
+
+	out_Objects.resize( in_Paths.size() );
+	for ( size_t p = 0; p < in_Paths.size(); ++p )
+		out_Objects[p] = l_Nodes[ l_PathNodes[p] ].m_Object;
+}
+
+bool CAbcIArchive::ResolvePath( const std::string& in_strPath, IObject& out_Object )
+{
+	std::vector<std::string> l_Names;
+	std::string l_strFullName;
+	SplitObjectPath( in_strPath, l_Names, l_strFullName );
+
+	IObject l_curObj( m_Archive, kTop );
+	for ( size_t i = 0; i < l_Names.size(); ++i )
+	{
+		IObject l_child = l_curObj.getChild( l_Names[i] );
+		if ( !l_child.valid() )
+			return false;
+		l_curObj = l_child;
+	}
+
+	out_Object = l_curObj;
+	return l_curObj.valid();
+}
+
 EAbcResult CAbcIArchive::FindObject( const char* in_pszName, IAbcIObject** out_ppObject )
 {
-	using namespace boost::xpressive;
+	if ( !in_pszName || !out_ppObject )
+		return EResult_InvalidPtr;
+
+	Alembic::Util::scoped_lock l_lock( m_ObjectMutex );
+	return FindObjectNoLock( in_pszName, out_ppObject );
+}
 
+EAbcResult CAbcIArchive::FindObjectNoLock( const char* in_pszName, IAbcIObject** out_ppObject )
+{
+	++m_ulNumObjectLookups;
 	TObjectMap::iterator it = m_mapObjects.find( in_pszName );
 
 	if ( it != m_mapObjects.end() )
 	{
+		++m_ulNumObjectCacheHits;
 		*out_ppObject = it->second;
 		it->second->AddRef();
 		return EResult_Success;
 	}
 	else
 	{
-		const sregex reName = (alpha | as_xpr('_') | as_xpr('-') | as_xpr(':')) >> (*( alnum | as_xpr('_') | as_xpr('-') | as_xpr(':')));
-	
-		const std::string l_sFullName( in_pszName );
-		sregex_token_iterator l_curNameIt( l_sFullName.begin(), l_sFullName.end(), reName );
-		sregex_token_iterator l_end;
+		IObject l_curObj;
+		if ( ResolvePath( in_pszName, l_curObj ) )
+			return AddObjectNoLock( in_pszName, l_curObj, out_ppObject );
+	}
+	return EResult_Fail;
+}
 
-		IObject l_curObj( m_Archive, kTop );
+EAbcResult CAbcIArchive::AddObjectNoLock( const char* in_pszName, const IObject& in_Object, IAbcIObject** out_ppObject )
+{
+	EAbcResult l_result = CreateFromInternal( in_Object, out_ppObject );
+	if ( l_result == EResult_Success )
+	{
+		// Add this to our map
+		m_mapObjects[in_pszName] = *out_ppObject;
+		// AddRef again for our object map
+		(*out_ppObject)->AddRef();
+	}
+	return l_result;
+}
 
-		for ( ; l_curNameIt != l_end; ++l_curNameIt )
+EAbcResult CAbcIArchive::FindObjects( const char** in_ppszNames, size_t in_szNumNames, IAbcIObject** out_ppObjects )
+{
+	if ( !in_ppszNames || !out_ppObjects )
+		return EResult_InvalidPtr;
+
+	// Objects found before are handed out right away, the rest are looked up without holding the lock
+	std::vector<size_t> l_Missing;
+	std::vector<std::string> l_Paths;
+	{
+		Alembic::Util::scoped_lock l_lock( m_ObjectMutex );
+		for ( size_t i = 0; i < in_szNumNames; ++i )
 		{
-			const std::string l_curName( *l_curNameIt );
+			out_ppObjects[i] = NULL;
+			if ( !in_ppszNames[i] )
+				continue;
 
-			IObject l_child = l_curObj.getChild( l_curName );
-			if ( l_child.valid() )
-				l_curObj = l_child;
+			++m_ulNumObjectLookups;
+			TObjectMap::iterator it = m_mapObjects.find( in_ppszNames[i] );
+			if ( it != m_mapObjects.end() )
+			{
+				++m_ulNumObjectCacheHits;
+				out_ppObjects[i] = it->second;
+				it->second->AddRef();
+			}
 			else
-				return EResult_Fail;
+			{
+				l_Missing.push_back( i );
+				l_Paths.push_back( in_ppszNames[i] );
+			}
 		}
+	}
 
-		if ( l_curObj.valid() )
+	if ( !l_Missing.empty() )
+	{
+		std::vector<IObject> l_Objects;
+		try
+		{
+			ResolvePaths( l_Paths, l_Objects );
+		}
+		catch ( std::exception& )
 		{
-			EAbcResult l_result = CreateFromInternal( l_curObj, out_ppObject );
-			if ( l_result == EResult_Success )
+			l_Objects.assign( l_Paths.size(), IObject() );
+		}
+
+		// Another thread may have added some of them in the meantime
+		Alembic::Util::scoped_lock l_lock( m_ObjectMutex );
+		for ( size_t m = 0; m < l_Missing.size(); ++m )
+		{
+			const size_t i = l_Missing[m];
+			if ( !l_Objects[m].valid() )
+				continue;
+
+			TObjectMap::iterator it = m_mapObjects.find( in_ppszNames[i] );
+			if ( it != m_mapObjects.end() )
 			{
-				// Add this to our map
-				m_mapObjects[in_pszName] = *out_ppObject;
-				// AddRef again for our object map
-				(*out_ppObject)->AddRef();
+				out_ppObjects[i] = it->second;
+				it->second->AddRef();
 			}
-			return l_result;
+			else if ( AddObjectNoLock( in_ppszNames[i], l_Objects[m], &out_ppObjects[i] ) != EResult_Success )
+				out_ppObjects[i] = NULL;
 		}
 	}
-	return EResult_Fail;
+
+	for ( size_t i = 0; i < in_szNumNames; ++i )
+	{
+		if ( !out_ppObjects[i] )
+			return EResult_Fail;
+	}
+	return EResult_Success;
+}
+
+EAbcResult CAbcIArchive::CreateReadBatch( IAbcIReadBatch** out_ppBatch ) const
+{
+	if ( !out_ppBatch )
+		return EResult_InvalidPtr;
+
+	// getPtr() isn't const, the batch only uses the archive to check that requests belong to it
+	Alembic::AbcCoreAbstract::ArchiveReaderPtr l_spArchive = const_cast<Alembic::Abc::IArchive&>( m_Archive ).getPtr();
+	CAbcIReadBatch* l_pBatch = new CAbcIReadBatch( l_spArchive, m_uiNumStreams );
+	if ( !l_pBatch )
+		return EResult_OutOfMemory;
+
+	l_pBatch->AddRef();
+	*out_ppBatch = l_pBatch;
+	return EResult_Success;
 }
 
 void CAbcIArchive::GetArchiveStartAndEndTime( double* out_ppdStartTime, double* out_ppdEndTime ) const
@@ -53,8 +53,15 @@ EAbcResult CAbcIPolyMesh::GetUVs( bool in_bExpand, IAbcISampleSelector* in_pSamp
 		if ( in_pSampleSelector )
 			( ( CAbcISampleSelector* )in_pSampleSelector )->GetSampleSelector( l_Selector );
 
-		IV2fGeomParam::Sample l_uvSamp = in_bExpand ? l_uvParams.getExpandedValue( l_Selector ) : l_uvParams.getIndexedValue( l_Selector );
-		V2fArraySamplePtr l_values = l_uvSamp.getVals();
+		V2fArraySamplePtr l_values;
+		if ( in_bExpand )
+		{
+			l_values = m_UVsBuffers.GetExpandedSample( l_uvParams, l_Selector );
+		}
+		else
+		{
+			l_values = l_uvParams.getIndexedValue( l_Selector ).getVals();
+		}
 
 		return CreateBuffer<V2fArraySamplePtr, V2fArraySample>( l_values, (EAbcGeomScope)l_uvParams.getScope(), l_uvParams.isIndexed(), out_ppBuffer );
 	}
@@ -73,8 +80,15 @@ EAbcResult CAbcIPolyMesh::GetNormals( bool in_bExpand, IAbcISampleSelector* in_p
 		if ( in_pSampleSelector )
 			( ( CAbcISampleSelector* )in_pSampleSelector )->GetSampleSelector( l_Selector );
 
-		IN3fGeomParam::Sample l_normalSamp = in_bExpand ? l_normalParam.getExpandedValue( l_Selector ) : l_normalParam.getIndexedValue( l_Selector );	
-		N3fArraySamplePtr l_values = l_normalSamp.getVals();
+		N3fArraySamplePtr l_values;
+		if ( in_bExpand )
+		{
+			l_values = m_NormalsBuffers.GetExpandedSample( l_normalParam, l_Selector );
+		}
+		else
+		{
+			l_values = l_normalParam.getIndexedValue( l_Selector ).getVals();
+		}
 
 		return CreateBuffer<N3fArraySamplePtr, N3fArraySample>( l_values, (EAbcGeomScope)l_normalParam.getScope(), l_normalParam.isIndexed(), out_ppBuffer );
 	}
@@ -0,0 +1,297 @@
+//*****************************************************************************
+/*!
+	Copyright 2013 Autodesk, Inc.  All rights reserved.
+	Use of this software is subject to the terms of the Autodesk license agreement
+	provided at the time of installation or download, or which otherwise accompanies
+	this software in either electronic or hard copy form.
+*/
+//*
+
+#include "CAbcInput.h"
+#include "CAbcFramework.h"
+#include <algorithm>
+#include <exception>
+#include <boost/bind.hpp>
+
+// Alembic Includes
+#include <Alembic/AbcGeom/All.h>
+
+using namespace Alembic;
+using namespace Alembic::Abc;
+using namespace Alembic::AbcGeom;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CAbcIReadBatch
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Fills out_Position with the child indices leading from the top object to in_Object
+static void GetHierarchyPosition( IObject in_Object, std::vector<size_t>& out_Position )
+{
+	out_Position.clear();
+
+	IObject l_Parent = in_Object.getParent();
+	while ( l_Parent.valid() )
+	{
+		const std::string& l_strName = in_Object.getName();
+		const size_t l_NumChildren = l_Parent.getNumChildren();
+		for ( size_t i = 0; i < l_NumChildren; ++i )
+		{
+			if ( l_Parent.getChildHeader( i ).getName() == l_strName )
+			{
+				out_Position.push_back( i );
+				break;
+			}
+		}
+		in_Object = l_Parent;
+		l_Parent = in_Object.getParent();
+	}
+
+	std::reverse( out_Position.begin(), out_Position.end() );
+}
+
+// Orders request indices by the hierarchy position of their objects
+struct CAbcIReadBatch::SPositionLess
+{
+	const std::vector<SRequest>& m_Requests;
+	SPositionLess( const std::vector<SRequest>& in_Requests ) : m_Requests( in_Requests ) {}
+	bool operator()( size_t in_A, size_t in_B ) const { return m_Requests[in_A].m_Position < m_Requests[in_B].m_Position; }
+};
+
+CAbcIReadBatch::CAbcIReadBatch( Alembic::AbcCoreAbstract::ArchiveReaderPtr in_spArchive, unsigned int in_uiNumStreams ) :
+	m_bOrderDirty( false ), m_spArchive( in_spArchive ), m_uiNumStreams( in_uiNumStreams > 0 ? in_uiNumStreams : 1 ), m_uiNumThreads( 0 )
+{
+}
+
+CAbcIReadBatch::~CAbcIReadBatch()
+{
+	for ( size_t i = 0; i < m_Requests.size(); ++i )
+	{
+		if ( m_Requests[i].m_pBuffer )
+			m_Requests[i].m_pBuffer->Release();
+		m_Requests[i].m_pObject->Release();
+	}
+}
+
+EAbcResult CAbcIReadBatch::AddRequest( IAbcIObject* in_pObject, EAbcBatchData in_eData, size_t* out_pIndex )
+{
+	if ( !in_pObject )
+		return EResult_InvalidPtr;
+
+	const std::string l_strFullName = in_pObject->GetFullName();
+	TRequestMap::const_iterator l_itObject = m_RequestMap.find( l_strFullName );
+	if ( l_itObject != m_RequestMap.end() )
+	{
+		for ( size_t i = 0; i < l_itObject->second.size(); ++i )
+		{
+			const size_t l_Index = l_itObject->second[i];
+			if ( m_Requests[l_Index].m_eData == in_eData )
+			{
+				if ( out_pIndex )
+					*out_pIndex = l_Index;
+				return EResult_Success;
+			}
+		}
+	}
+
+	IAbcISchemaObject* l_pSchemaObject = NULL;
+	EAbcResult l_result = in_pObject->GetSchemaObject( &l_pSchemaObject );
+	if ( l_result != EResult_Success )
+		return l_result;
+
+	// Check the data exists now rather than failing every Read()
+	bool l_bValid = false;
+	IObject l_Object;
+	if ( l_pSchemaObject->GetType() == EIObject_Polymesh )
+	{
+		IPolyMesh* l_pMesh = static_cast<CAbcIPolyMesh*>( static_cast<IAbcIPolyMesh*>( l_pSchemaObject ) )->GetInternalObject();
+		IPolyMeshSchema& l_Schema = l_pMesh->getSchema();
+		switch ( in_eData )
+		{
+		case EBatchData_Positions:		l_bValid = l_Schema.getPositionsProperty().valid(); break;
+		case EBatchData_Velocities:	l_bValid = l_Schema.getVelocitiesProperty().valid(); break;
+		case EBatchData_Normals:		l_bValid = l_Schema.getNormalsParam().valid(); break;
+		case EBatchData_UVs:			l_bValid = l_Schema.getUVsParam().valid(); break;
+		case EBatchData_FaceCounts:	l_bValid = l_Schema.getFaceCountsProperty().valid(); break;
+		case EBatchData_FaceIndices:	l_bValid = l_Schema.getFaceIndicesProperty().valid(); break;
+		default:					break;
+		}
+		l_Object = *l_pMesh;
+	}
+	else if ( l_pSchemaObject->GetType() == EIObject_Points )
+	{
+		IPoints* l_pPoints = static_cast<CAbcIPoints*>( static_cast<IAbcIPoints*>( l_pSchemaObject ) )->GetInternalObject();
+		IPointsSchema& l_Schema = l_pPoints->getSchema();
+		switch ( in_eData )
+		{
+		case EBatchData_Positions:		l_bValid = l_Schema.getPositionsProperty().valid(); break;
+		case EBatchData_Velocities:	l_bValid = l_Schema.getVelocitiesProperty().valid(); break;
+		case EBatchData_Ids:			l_bValid = l_Schema.getIdsProperty().valid(); break;
+		default:					break;
+		}
+		l_Object = *l_pPoints;
+	}
+
+	if ( !l_bValid )
+	{
+		l_pSchemaObject->Release();
+		return EResult_NotApplicable;
+	}
+
+	// The read threads are sized for this archive's streams
+	if ( l_Object.getPtr()->getArchive() != m_spArchive )
+	{
+		l_pSchemaObject->Release();
+		return EResult_InvalidPtr;
+	}
+
+	SRequest l_Request;
+	l_Request.m_pObject = l_pSchemaObject;
+	l_Request.m_strFullName = l_strFullName;
+	l_Request.m_eData = in_eData;
+	l_Request.m_pBuffer = NULL;
+	l_Request.m_eResult = EResult_Fail;
+	GetHierarchyPosition( l_Object, l_Request.m_Position );
+
+	const size_t l_Index = m_Requests.size();
+	m_Requests.push_back( l_Request );
+	m_RequestMap[ l_strFullName ].push_back( l_Index );
+
+	// Sorted once by the next Read(), rather than on every request
+	m_Order.push_back( l_Index );
+	m_bOrderDirty = true;
+
+	if ( out_pIndex )
+		*out_pIndex = l_Index;
+	return EResult_Success;
+}
+
+size_t CAbcIReadBatch::GetNumRequests() const
+{
+	return m_Requests.size();
+}
+
+void CAbcIReadBatch::SetNumThreads( unsigned int in_uiNumThreads )
+{
+	m_uiNumThreads = in_uiNumThreads;
+}
+
+EAbcResult CAbcIReadBatch::ReadRequest( SRequest& io_Request, IAbcISampleSelector* in_pSampleSelector )
+{
+	// Samples are read through the public accessors so that expanded normals and UVs share their caches
+	try
+	{
+		if ( io_Request.m_pObject->GetType() == EIObject_Polymesh )
+		{
+			IAbcIPolyMesh* l_pMesh = static_cast<IAbcIPolyMesh*>( io_Request.m_pObject );
+			switch ( io_Request.m_eData )
+			{
+			case EBatchData_Positions:		return l_pMesh->GetPositions( in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_Velocities:	return l_pMesh->GetVelocities( in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_Normals:		return l_pMesh->GetNormals( true, in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_UVs:			return l_pMesh->GetUVs( true, in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_FaceCounts:	return l_pMesh->GetFaceCounts( in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_FaceIndices:	return l_pMesh->GetFaceIndices( in_pSampleSelector, &io_Request.m_pBuffer );
+			default:					break;
+			}
+		}
+		else
+		{
+			IAbcIPoints* l_pPoints = static_cast<IAbcIPoints*>( io_Request.m_pObject );
+			switch ( io_Request.m_eData )
+			{
+			case EBatchData_Positions:		return l_pPoints->GetPositions( in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_Velocities:	return l_pPoints->GetVelocities( in_pSampleSelector, &io_Request.m_pBuffer );
+			case EBatchData_Ids:			return l_pPoints->GetIds( in_pSampleSelector, &io_Request.m_pBuffer );
+			default:					break;
+			}
+		}
+	}
+	catch ( ... )
+	{
+		// A failed read only fails its own request, not the rest of the batch
+		io_Request.m_pBuffer = NULL;
+		return EResult_Fail;
+	}
+	return EResult_NotApplicable;
+}
+
+void CAbcIReadBatch::SortOrder()
+{
+	// Stable, so requests of the same object stay in the order they were added
+	std::stable_sort( m_Order.begin(), m_Order.end(), SPositionLess( m_Requests ) );
+	m_bOrderDirty = false;
+}
+
+void CAbcIReadBatch::ReadTask( IAbcISampleSelector* in_pSampleSelector, size_t in_NumTasks, size_t in_Task )
+{
+	// Each task reads a contiguous range of the sorted requests, so that it reads neighbouring samples
+	const size_t l_NumRequests = m_Requests.size();
+	ReadRange( in_pSampleSelector, l_NumRequests * in_Task / in_NumTasks, l_NumRequests * ( in_Task + 1 ) / in_NumTasks );
+}
+
+void CAbcIReadBatch::ReadRange( IAbcISampleSelector* in_pSampleSelector, size_t in_Begin, size_t in_End )
+{
+	for ( size_t i = in_Begin; i < in_End; ++i )
+	{
+		SRequest& l_Request = m_Requests[ m_Order[i] ];
+		l_Request.m_eResult = ReadRequest( l_Request, in_pSampleSelector );
+	}
+}
+
+EAbcResult CAbcIReadBatch::Read( IAbcISampleSelector* in_pSampleSelector )
+{
+	const size_t l_NumRequests = m_Requests.size();
+	for ( size_t i = 0; i < l_NumRequests; ++i )
+	{
+		if ( m_Requests[i].m_pBuffer )
+		{
+			m_Requests[i].m_pBuffer->Release();
+			m_Requests[i].m_pBuffer = NULL;
+		}
+	}
+
+	// More threads than streams would only wait for a free stream
+	size_t l_NumThreads = m_uiNumStreams;
+	if ( m_uiNumThreads > 0 && m_uiNumThreads < l_NumThreads )
+		l_NumThreads = m_uiNumThreads;
+	if ( l_NumThreads > l_NumRequests )
+		l_NumThreads = l_NumRequests;
+
+	if ( m_bOrderDirty )
+		SortOrder();
+
+	// The framework's persistent threads do the reading, without a framework instance it's done here
+	CAbcFramework* l_pFramework = CAbcFramework::GetInstance();
+	if ( l_NumThreads <= 1 || !l_pFramework )
+	{
+		ReadRange( in_pSampleSelector, 0, l_NumRequests );
+	}
+	else
+	{
+		l_pFramework->GetWorkerPool().ParallelFor( l_NumThreads,
+			boost::bind( &CAbcIReadBatch::ReadTask, this, in_pSampleSelector, l_NumThreads, _1 ), (unsigned int)l_NumThreads );
+	}
+
+	for ( size_t i = 0; i < l_NumRequests; ++i )
+	{
+		if ( m_Requests[i].m_eResult != EResult_Success )
+			return EResult_Fail;
+	}
+	return EResult_Success;
+}
+
+EAbcResult CAbcIReadBatch::GetResult( size_t in_Index, IAbcSampleBuffer** out_ppBuffer ) const
+{
+	if ( !out_ppBuffer )
+		return EResult_InvalidPtr;
+	if ( in_Index >= m_Requests.size() )
+		return EResult_OutOfRange;
+
+	const SRequest& l_Request = m_Requests[ in_Index ];
+	if ( !l_Request.m_pBuffer )
+		return l_Request.m_eResult == EResult_Success ? EResult_Fail : l_Request.m_eResult;
+
+	*out_ppBuffer = l_Request.m_pBuffer;
+	l_Request.m_pBuffer->AddRef();
+	return EResult_Success;
+}
@@ -9,8 +9,12 @@
 
 #include "AbcFrameworkUtil.h"
 #include "CAbcUtils.h"
+#include "CAbcFramework.h"
 #include <math.h>
+#include <string.h>
+#include <algorithm>
 #include <string>
+#include <OpenEXR/ImathMatrixAlgo.h>
 #include "IAbcInput.h"
 #include "IAbcOProperty.h"
 #include "CAbcIPropertyAccessor.h"
@@ -160,72 +164,189 @@ private:
 	EAbcGeomScope m_GeomScope;
 };
 
+static bool AreBuffersCompatible( const IAbcSampleBuffer* in_pBufferFrom, const IAbcSampleBuffer* in_pBufferTo )
+{
+	return in_pBufferFrom->GetDataType() == in_pBufferTo->GetDataType() &&
+		in_pBufferFrom->GetGeomScope() == in_pBufferTo->GetGeomScope() &&
+		in_pBufferFrom->IsIndexed() == in_pBufferTo->IsIndexed();
+}
+
+// Interpolates 4x4 transforms through their scale, shear, rotation and translation, so that a rotating
+// transform keeps its scale instead of shrinking half way. Matrices that don't decompose fall back to a lerp.
+template< typename T >
+static void InterpolateMatrixArray( T* out_pDest, const T* in_pFrom, const T* in_pTo, float in_fAlpha, size_t in_numMatrices )
+{
+	for ( size_t i = 0; i < in_numMatrices; ++i, out_pDest += 16, in_pFrom += 16, in_pTo += 16 )
+	{
+		Imath::Matrix44<T> l_mFrom( (const T(*)[4])in_pFrom );
+		Imath::Matrix44<T> l_mTo( (const T(*)[4])in_pTo );
+		Imath::Vec3<T> l_vScaleFrom, l_vShearFrom, l_vScaleTo, l_vShearTo;
+
+		const bool l_bAffine = in_pFrom[3] == 0 && in_pFrom[7] == 0 && in_pFrom[11] == 0 && in_pFrom[15] == 1 &&
+			in_pTo[3] == 0 && in_pTo[7] == 0 && in_pTo[11] == 0 && in_pTo[15] == 1;
+		if ( !l_bAffine ||
+			!Imath::extractAndRemoveScalingAndShear( l_mFrom, l_vScaleFrom, l_vShearFrom, false ) ||
+			!Imath::extractAndRemoveScalingAndShear( l_mTo, l_vScaleTo, l_vShearTo, false ) )
+		{
+			AbcLerp::InterpolateArray<T>( out_pDest, in_pFrom, in_pTo, in_fAlpha, 16 );
+			continue;
+		}
+
+		const Imath::Quat<T> l_qFrom = Imath::extractQuat( l_mFrom );
+		const Imath::Quat<T> l_qTo = Imath::extractQuat( l_mTo );
+		const T l_quatFrom[4] = { l_qFrom.r, l_qFrom.v.x, l_qFrom.v.y, l_qFrom.v.z };
+		const T l_quatTo[4] = { l_qTo.r, l_qTo.v.x, l_qTo.v.y, l_qTo.v.z };
+		T l_quat[4];
+		AbcLerp::InterpolateQuatArray<T>( l_quat, l_quatFrom, l_quatTo, in_fAlpha, 1 );
+
+		Imath::Matrix44<T> l_mScale, l_mShear, l_mTranslate;
+		l_mScale.setScale( l_vScaleFrom + ( l_vScaleTo - l_vScaleFrom ) * (T)in_fAlpha );
+		l_mShear.setShear( l_vShearFrom + ( l_vShearTo - l_vShearFrom ) * (T)in_fAlpha );
+		const Imath::Vec3<T> l_vTransFrom( l_mFrom[3][0], l_mFrom[3][1], l_mFrom[3][2] );
+		const Imath::Vec3<T> l_vTransTo( l_mTo[3][0], l_mTo[3][1], l_mTo[3][2] );
+		l_mTranslate.setTranslation( l_vTransFrom + ( l_vTransTo - l_vTransFrom ) * (T)in_fAlpha );
+		const Imath::Matrix44<T> l_mRotate = Imath::Quat<T>( l_quat[0], l_quat[1], l_quat[2], l_quat[3] ).toMatrix44();
+
+		// Same order as Imath::extractSHRT
+		const Imath::Matrix44<T> l_mResult = l_mScale * l_mShear * l_mRotate * l_mTranslate;
+		memcpy( out_pDest, l_mResult.getValue(), 16 * sizeof( T ) );
+	}
+}
+
+static bool IsInterpolable( const SAbcDataType& in_DataType )
+{
+	switch ( in_DataType.m_eType )
+	{
+	case EPodType_Float32: case EPodType_Float64:
+	case EPodType_UInt8: case EPodType_UInt16: case EPodType_UInt32: case EPodType_UInt64:
+	case EPodType_Int8: case EPodType_Int16: case EPodType_Int32: case EPodType_Int64:
+		return true;
+	default:
+		return false;
+	}
+}
+
+// Interpolates elements [in_Begin, in_End) of two compatible buffers into out_pDest, which may be one of the source buffers
+static void InterpolateRange( const IAbcSampleBuffer* in_pBufferFrom, const IAbcSampleBuffer* in_pBufferTo, void* out_pDest, size_t in_Begin, size_t in_End, float in_fAlpha )
+{
+	const SAbcDataType& l_DataType = in_pBufferFrom->GetDataType();
+	const size_t l_numElems = in_End - in_Begin;
+	const size_t l_numValues = l_numElems * l_DataType.m_ucExtent;
+	const size_t l_Offset = in_Begin * l_DataType.m_numBytes;
+	void* l_pDest = (char*)out_pDest + l_Offset;
+	const void* l_pFrom = (const char*)in_pBufferFrom->GetBuffer() + l_Offset;
+	const void* l_pTo = (const char*)in_pBufferTo->GetBuffer() + l_Offset;
+
+	// Quaternions and matrices are not interpolated component-wise
+	switch ( l_DataType.m_eTraits )
+	{
+	case EDataTraits_Quatf:
+		AbcLerp::InterpolateQuatArray<float32_t>( (float32_t*)l_pDest, (const float32_t*)l_pFrom, (const float32_t*)l_pTo, in_fAlpha, l_numElems );
+		return;
+	case EDataTraits_Quatd:
+		AbcLerp::InterpolateQuatArray<float64_t>( (float64_t*)l_pDest, (const float64_t*)l_pFrom, (const float64_t*)l_pTo, in_fAlpha, l_numElems );
+		return;
+	case EDataTraits_M44f:
+		InterpolateMatrixArray<float32_t>( (float32_t*)l_pDest, (const float32_t*)l_pFrom, (const float32_t*)l_pTo, in_fAlpha, l_numElems );
+		return;
+	case EDataTraits_M44d:
+		InterpolateMatrixArray<float64_t>( (float64_t*)l_pDest, (const float64_t*)l_pFrom, (const float64_t*)l_pTo, in_fAlpha, l_numElems );
+		return;
+	default:
+		break;
+	}
+
+	switch ( l_DataType.m_eType )
+	{
+#define CASE_POD(POD, TYPE) \
+	case EPodType_##POD: \
+		AbcLerp::InterpolateArray<TYPE>( (TYPE*)l_pDest, (const TYPE*)l_pFrom, (const TYPE*)l_pTo, in_fAlpha, l_numValues ); \
+		return
+
+		CASE_POD(Float32, float32_t);
+		CASE_POD(Float64, float64_t);
+		CASE_POD(UInt8, uint8_t);
+		CASE_POD(UInt16, uint16_t);
+		CASE_POD(UInt32, uint32_t);
+		CASE_POD(UInt64, uint64_t);
+		CASE_POD(Int8, int8_t);
+		CASE_POD(Int16, int16_t);
+		CASE_POD(Int32, int32_t);
+		CASE_POD(Int64, int64_t);
+
+#undef CASE_POD
+	default:
+		break;
+	}
+}
+
+// Buffers smaller than this are interpolated on the calling thread, waking the workers would cost more
+static const size_t INTERPOLATE_MIN_PARALLEL_VALUES = 256 * 1024;
+static const size_t INTERPOLATE_VALUES_PER_TASK = 64 * 1024;
+
+struct SInterpolateTask
+{
+	const IAbcSampleBuffer* m_pBufferFrom;
+	const IAbcSampleBuffer* m_pBufferTo;
+	void* m_pDest;
+	size_t m_numElems;
+	size_t m_numElemsPerTask;
+	float m_fAlpha;
+
+	void operator()( size_t in_Task ) const
+	{
+		const size_t l_Begin = in_Task * m_numElemsPerTask;
+		const size_t l_End = std::min<size_t>( l_Begin + m_numElemsPerTask, m_numElems );
+		InterpolateRange( m_pBufferFrom, m_pBufferTo, m_pDest, l_Begin, l_End, m_fAlpha );
+	}
+};
+
+// Interpolates the first in_numElems elements of two compatible buffers into out_pDest, which may be one of the source buffers.
+// Large buffers are split into ranges interpolated on the framework's worker threads.
+static EAbcResult InterpolateBufferInto( const IAbcSampleBuffer* in_pBufferFrom, const IAbcSampleBuffer* in_pBufferTo, void* out_pDest, size_t in_numElems, float in_fAlpha )
+{
+	const SAbcDataType& l_DataType = in_pBufferFrom->GetDataType();
+	if ( !IsInterpolable( l_DataType ) )
+		return EResult_NotApplicable;
+
+	const size_t l_numValues = in_numElems * l_DataType.m_ucExtent;
+	CAbcFramework* l_pFramework = CAbcFramework::GetInstance();
+	if ( l_numValues < INTERPOLATE_MIN_PARALLEL_VALUES || l_pFramework == NULL )
+	{
+		InterpolateRange( in_pBufferFrom, in_pBufferTo, out_pDest, 0, in_numElems, in_fAlpha );
+		return EResult_Success;
+	}
+
+	SInterpolateTask l_Task;
+	l_Task.m_pBufferFrom = in_pBufferFrom;
+	l_Task.m_pBufferTo = in_pBufferTo;
+	l_Task.m_pDest = out_pDest;
+	l_Task.m_numElems = in_numElems;
+	l_Task.m_numElemsPerTask = std::max<size_t>( INTERPOLATE_VALUES_PER_TASK / std::max<size_t>( l_DataType.m_ucExtent, 1 ), 1 );
+	l_Task.m_fAlpha = in_fAlpha;
+
+	const size_t l_numTasks = ( in_numElems + l_Task.m_numElemsPerTask - 1 ) / l_Task.m_numElemsPerTask;
+	l_pFramework->GetWorkerPool().ParallelFor( l_numTasks, l_Task );
+	return EResult_Success;
+}
+
 EAbcResult CAbcUtils::GetInterpolatedBuffer( const IAbcSampleBuffer* in_pBufferFrom, const IAbcSampleBuffer* in_pBufferTo, IAbcSampleBuffer** out_ppBufferDest, float in_fAlpha ) const
 {
 	if ( in_pBufferFrom == 0 || in_pBufferTo == 0 || out_ppBufferDest == 0 )
 		return EResult_InvalidPtr;
 
-	if ( in_pBufferFrom->GetDataType() == in_pBufferTo->GetDataType() &&
-		 in_pBufferFrom->GetGeomScope() == in_pBufferTo->GetGeomScope() &&
-		 in_pBufferFrom->IsIndexed() == in_pBufferTo->IsIndexed() )
+	if ( AreBuffersCompatible( in_pBufferFrom, in_pBufferTo ) )
 	{
 		size_t l_numElems = std::min<size_t>( in_pBufferFrom->GetNumElements(), in_pBufferTo->GetNumElements() );
 		void* l_pArray = malloc( in_pBufferFrom->GetDataType().m_numBytes * l_numElems );
 		
-		if( in_pBufferFrom->GetDataType().m_eType == EPodType_Float32 )
-		{
-			Alembic::Util::float32_t* l_pDest = (Alembic::Util::float32_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::float32_t>( l_pDest, (const Alembic::Util::float32_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::float32_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_Float64 )
-		{
-			Alembic::Util::float64_t* l_pDest = (Alembic::Util::float64_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::float64_t>( l_pDest, (const Alembic::Util::float64_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::float64_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_UInt8 )
-		{
-			Alembic::Util::uint8_t* l_pDest = (Alembic::Util::uint8_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::uint8_t>( l_pDest, (const Alembic::Util::uint8_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::uint8_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_UInt16 )
-		{
-			Alembic::Util::uint16_t* l_pDest = (Alembic::Util::uint16_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::uint16_t>( l_pDest, (const Alembic::Util::uint16_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::uint16_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_UInt32 )
-		{
-			Alembic::Util::uint32_t* l_pDest = (Alembic::Util::uint32_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::uint32_t>( l_pDest, (const Alembic::Util::uint32_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::uint32_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_UInt64 )
-		{
-			Alembic::Util::uint64_t* l_pDest = (Alembic::Util::uint64_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::uint64_t>( l_pDest, (const Alembic::Util::uint64_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::uint64_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_Int8 )
-		{
-			Alembic::Util::int8_t* l_pDest = (Alembic::Util::int8_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::int8_t>( l_pDest, (const Alembic::Util::int8_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::int8_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_Int16 )
+		EAbcResult l_Result = InterpolateBufferInto( in_pBufferFrom, in_pBufferTo, l_pArray, l_numElems, in_fAlpha );
+		if ( l_Result != EResult_Success )
 		{
-			Alembic::Util::int16_t* l_pDest = (short *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::int16_t>( l_pDest, (const Alembic::Util::int16_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::int16_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_Int32 )
-		{
-			Alembic::Util::int32_t* l_pDest = (Alembic::Util::int32_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::int32_t>( l_pDest, (const Alembic::Util::int32_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::int32_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else if ( in_pBufferFrom->GetDataType().m_eType == EPodType_Int64 )
-		{
-			Alembic::Util::int64_t* l_pDest = (Alembic::Util::int64_t *)l_pArray;
-			AbcLerp::InterpolateArray<Alembic::Util::int64_t>( l_pDest, (const Alembic::Util::int64_t*)in_pBufferFrom->GetBuffer(), (const Alembic::Util::int64_t*)in_pBufferTo->GetBuffer(), in_fAlpha, l_numElems * in_pBufferFrom->GetDataType().m_ucExtent );
-		}
-		else
-		{
-			return EResult_NotApplicable;
+			free( l_pArray );
+			return l_Result;
 		}
+
 		CAbcRawBufferSampleBuffer* l_pNewBuffer = new CAbcRawBufferSampleBuffer( in_pBufferFrom, l_pArray, l_numElems );
 		if ( l_pNewBuffer )
 		{
@@ -241,6 +362,24 @@ EAbcResult CAbcUtils::GetInterpolatedBuffer( const IAbcSampleBuffer* in_pBufferF
 	return EResult_Fail;
 }
 
+EAbcResult CAbcUtils::GetInterpolatedBuffer( const IAbcSampleBuffer* in_pBufferFrom, const IAbcSampleBuffer* in_pBufferTo, void* out_pDest, size_t in_szDestNumElements, float in_fAlpha, size_t* out_pNumElements ) const
+{
+	if ( in_pBufferFrom == 0 || in_pBufferTo == 0 || out_pDest == 0 )
+		return EResult_InvalidPtr;
+
+	if ( !AreBuffersCompatible( in_pBufferFrom, in_pBufferTo ) )
+		return EResult_Fail;
+
+	size_t l_numElems = std::min<size_t>( in_pBufferFrom->GetNumElements(), in_pBufferTo->GetNumElements() );
+	if ( out_pNumElements )
+		*out_pNumElements = l_numElems;
+
+	if ( in_szDestNumElements < l_numElems )
+		return EResult_OutOfRange;
+
+	return InterpolateBufferInto( in_pBufferFrom, in_pBufferTo, out_pDest, l_numElems, in_fAlpha );
+}
+
 EAbcResult CAbcUtils::GetInterpolatedTransformMat44( const class IAbcIXformSample* in_pBufferFrom, const class IAbcIXformSample* in_pBufferTo, double* out_pdMat, float in_fAlpha ) const
 {
 	if ( in_pBufferFrom == NULL || in_pBufferTo == NULL || out_pdMat == NULL )
@@ -249,7 +388,7 @@ EAbcResult CAbcUtils::GetInterpolatedTransformMat44( const class IAbcIXformSampl
 	const double* l_pdSrc = in_pBufferFrom->GetMatrix4x4();
 	const double* l_pdDst = in_pBufferTo->GetMatrix4x4();
 
-	AbcLerp::InterpolateArray< double >( out_pdMat, l_pdSrc, l_pdDst, in_fAlpha, 16 );
+	InterpolateMatrixArray< double >( out_pdMat, l_pdSrc, l_pdDst, in_fAlpha, 1 );
 
 	return EResult_Success;
 }
@@ -0,0 +1,158 @@
+//*****************************************************************************
+/*!
+	Copyright 2013 Autodesk, Inc.  All rights reserved.
+	Use of this software is subject to the terms of the Autodesk license agreement
+	provided at the time of installation or download, or which otherwise accompanies
+	this software in either electronic or hard copy form.
+*/
+//*
+
+#include "CAbcWorkerPool.h"
+#include <stdexcept>
+#include <boost/bind.hpp>
+
+CAbcWorkerPool::CAbcWorkerPool() : m_uiNumWorkers( 0 ), m_bStarted( false ), m_bStop( false )
+{
+	const unsigned int l_uiNumCores = boost::thread::hardware_concurrency();
+	m_uiNumWorkers = l_uiNumCores > 1 ? l_uiNumCores - 1 : 0;
+}
+
+CAbcWorkerPool::~CAbcWorkerPool()
+{
+	{
+		boost::lock_guard<boost::mutex> l_lock( m_Mutex );
+		m_bStop = true;
+	}
+	m_WorkAvailable.notify_all();
+	m_Threads.join_all();
+}
+
+unsigned int CAbcWorkerPool::GetNumThreads() const
+{
+	return m_uiNumWorkers + 1;
+}
+
+void CAbcWorkerPool::StartThreads()
+{
+	// Called with m_Mutex held, the new threads block on it until the caller waits or unlocks
+	m_bStarted = true;
+	for ( unsigned int i = 0; i < m_uiNumWorkers; ++i )
+		m_Threads.create_thread( boost::bind( &CAbcWorkerPool::WorkerMain, this ) );
+}
+
+bool CAbcWorkerPool::RunTask( const TaskFunc& in_Task, size_t in_Index, std::string& out_strError )
+{
+	// An escaping exception must not kill a worker, it is handed back to the caller instead
+	try
+	{
+		in_Task( in_Index );
+		return true;
+	}
+	catch ( std::exception& e )
+	{
+		out_strError = e.what();
+	}
+	catch ( ... )
+	{
+		out_strError = "Unknown exception in a worker pool task";
+	}
+	return false;
+}
+
+void CAbcWorkerPool::RunTasks( SJob& io_Job, boost::unique_lock<boost::mutex>& io_Lock )
+{
+	while ( io_Job.m_NextTask < io_Job.m_NumTasks )
+	{
+		const size_t l_Task = io_Job.m_NextTask++;
+		io_Lock.unlock();
+		std::string l_strError;
+		const bool l_bSucceeded = RunTask( *io_Job.m_pTask, l_Task, l_strError );
+		io_Lock.lock();
+
+		if ( !l_bSucceeded && !io_Job.m_bFailed )
+		{
+			// The tasks which haven't started are skipped, and count as done
+			io_Job.m_bFailed = true;
+			io_Job.m_strError = l_strError;
+			io_Job.m_NumDone += io_Job.m_NumTasks - io_Job.m_NextTask;
+			io_Job.m_NextTask = io_Job.m_NumTasks;
+		}
+		if ( ++io_Job.m_NumDone == io_Job.m_NumTasks )
+			m_JobDone.notify_all();
+	}
+}
+
+void CAbcWorkerPool::WorkerMain()
+{
+	boost::unique_lock<boost::mutex> l_lock( m_Mutex );
+	while ( !m_bStop )
+	{
+		SJob* l_pJob = NULL;
+		for ( std::list<SJob*>::iterator it = m_Jobs.begin(); it != m_Jobs.end(); ++it )
+		{
+			if ( (*it)->m_NextTask < (*it)->m_NumTasks && (*it)->m_uiNumHelpers < (*it)->m_uiMaxHelpers )
+			{
+				l_pJob = *it;
+				break;
+			}
+		}
+
+		if ( !l_pJob )
+		{
+			m_WorkAvailable.wait( l_lock );
+			continue;
+		}
+
+		++l_pJob->m_uiNumHelpers;
+		RunTasks( *l_pJob, l_lock );
+		// The job lives on the caller's stack, it can return once the last helper has left
+		if ( --l_pJob->m_uiNumHelpers == 0 )
+			m_JobDone.notify_all();
+	}
+}
+
+void CAbcWorkerPool::ParallelFor( size_t in_NumTasks, const TaskFunc& in_Task, unsigned int in_uiMaxThreads )
+{
+	if ( in_NumTasks == 0 )
+		return;
+
+	unsigned int l_uiMaxHelpers = m_uiNumWorkers;
+	if ( in_uiMaxThreads > 0 && in_uiMaxThreads - 1 < l_uiMaxHelpers )
+		l_uiMaxHelpers = in_uiMaxThreads - 1;
+	if ( l_uiMaxHelpers >= in_NumTasks )
+		l_uiMaxHelpers = (unsigned int)( in_NumTasks - 1 );
+
+	if ( l_uiMaxHelpers == 0 )
+	{
+		std::string l_strError;
+		for ( size_t i = 0; i < in_NumTasks; ++i )
+		{
+			if ( !RunTask( in_Task, i, l_strError ) )
+				throw std::runtime_error( l_strError );
+		}
+		return;
+	}
+
+	SJob l_Job;
+	l_Job.m_pTask = &in_Task;
+	l_Job.m_NumTasks = in_NumTasks;
+	l_Job.m_NextTask = 0;
+	l_Job.m_NumDone = 0;
+	l_Job.m_uiNumHelpers = 0;
+	l_Job.m_uiMaxHelpers = l_uiMaxHelpers;
+	l_Job.m_bFailed = false;
+
+	boost::unique_lock<boost::mutex> l_lock( m_Mutex );
+	if ( !m_bStarted )
+		StartThreads();
+	std::list<SJob*>::iterator l_itJob = m_Jobs.insert( m_Jobs.end(), &l_Job );
+	m_WorkAvailable.notify_all();
+
+	RunTasks( l_Job, l_lock );
+	while ( l_Job.m_NumDone < l_Job.m_NumTasks || l_Job.m_uiNumHelpers > 0 )
+		m_JobDone.wait( l_lock );
+	m_Jobs.erase( l_itJob );
+
+	if ( l_Job.m_bFailed )
+		throw std::runtime_error( l_Job.m_strError );
+}